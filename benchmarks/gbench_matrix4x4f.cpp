@@ -1,5 +1,7 @@
 #include "benchmark/benchmark.h"
 #include <ncine/Matrix4x4.h>
+#include <ncine/Quaternion.h>
+#include <ncine/simd.h>
 
 const unsigned int Repetitions = 12;
 
@@ -11,6 +13,46 @@ const float scalingY = 1.5f;
 const float anchorX = -5.0f;
 const float anchorY = 10.0f;
 
+namespace {
+
+/// The matrix multiplication of the generic template, a scalar reference for the float specialization
+void scalarMultiply(const ncine::Matrix4x4f &m1, const ncine::Matrix4x4f &m2, ncine::Matrix4x4f &result)
+{
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		for (unsigned int j = 0; j < 4; j++)
+			result[i][j] = m1[0][j] * m2[i][0] + m1[1][j] * m2[i][1] + m1[2][j] * m2[i][2] + m1[3][j] * m2[i][3];
+	}
+}
+
+/// The matrix and vector multiplication of the generic template, a scalar reference for the float specialization
+void scalarMultiply(const ncine::Matrix4x4f &m, const ncine::Vector4f &v, ncine::Vector4f &result)
+{
+	for (unsigned int i = 0; i < 4; i++)
+		result[i] = m[i][0] * v[0] + m[i][1] * v[1] + m[i][2] * v[2] + m[i][3] * v[3];
+}
+
+/// The matrix transposition of the generic template, a scalar reference for the float specialization
+void scalarTranspose(const ncine::Matrix4x4f &m, ncine::Matrix4x4f &result)
+{
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		for (unsigned int j = 0; j < 4; j++)
+			result[i][j] = m[j][i];
+	}
+}
+
+/// The quaternion multiplication of the generic template, a scalar reference for the float specialization
+void scalarMultiply(const ncine::Quaternionf &q0, const ncine::Quaternionf &q, ncine::Quaternionf &result)
+{
+	result.set(q0.w * q.x + q0.x * q.w + q0.y * q.z - q0.z * q.y,
+	           q0.w * q.y + q0.y * q.w + q0.z * q.x - q0.x * q.z,
+	           q0.w * q.z + q0.z * q.w + q0.x * q.y - q0.y * q.x,
+	           q0.w * q.w - q0.x * q.x - q0.y * q.y - q0.z * q.z);
+}
+
+}
+
 static void BM_TransformNodeFromIdentity(benchmark::State &state)
 {
 	ncine::Matrix4x4f matrix;
@@ -128,4 +170,138 @@ static void BM_ManyTransformationsInPlace(benchmark::State &state)
 }
 BENCHMARK(BM_ManyTransformationsInPlace)->Arg(Repetitions / 4)->Arg(Repetitions / 2)->Arg(Repetitions);
 
-BENCHMARK_MAIN();
+static void BM_MatrixMultiplyScalar(benchmark::State &state)
+{
+	const ncine::Matrix4x4f rotation = ncine::Matrix4x4f::rotationZ(rotationZ);
+	ncine::Matrix4x4f matrix = ncine::Matrix4x4f::rotationX(rotationZ);
+	ncine::Matrix4x4f result;
+
+	for (auto _ : state)
+	{
+		scalarMultiply(matrix, rotation, result);
+		matrix = result;
+		benchmark::DoNotOptimize(matrix);
+	}
+}
+BENCHMARK(BM_MatrixMultiplyScalar);
+
+static void BM_MatrixMultiply(benchmark::State &state)
+{
+	const ncine::Matrix4x4f rotation = ncine::Matrix4x4f::rotationZ(rotationZ);
+	ncine::Matrix4x4f matrix = ncine::Matrix4x4f::rotationX(rotationZ);
+
+	for (auto _ : state)
+	{
+		matrix = matrix * rotation;
+		benchmark::DoNotOptimize(matrix);
+	}
+}
+BENCHMARK(BM_MatrixMultiply);
+
+static void BM_MatrixVectorMultiplyScalar(benchmark::State &state)
+{
+	const ncine::Matrix4x4f rotation = ncine::Matrix4x4f::rotationZ(rotationZ);
+	ncine::Vector4f vector(translationX, translationY, 0.0f, 1.0f);
+	ncine::Vector4f result;
+
+	for (auto _ : state)
+	{
+		scalarMultiply(rotation, vector, result);
+		vector = result;
+		benchmark::DoNotOptimize(vector);
+	}
+}
+BENCHMARK(BM_MatrixVectorMultiplyScalar);
+
+static void BM_MatrixVectorMultiply(benchmark::State &state)
+{
+	const ncine::Matrix4x4f rotation = ncine::Matrix4x4f::rotationZ(rotationZ);
+	ncine::Vector4f vector(translationX, translationY, 0.0f, 1.0f);
+
+	for (auto _ : state)
+	{
+		vector = rotation * vector;
+		benchmark::DoNotOptimize(vector);
+	}
+}
+BENCHMARK(BM_MatrixVectorMultiply);
+
+static void BM_MatrixTransposeScalar(benchmark::State &state)
+{
+	ncine::Matrix4x4f matrix = ncine::Matrix4x4f::rotationZ(rotationZ);
+	ncine::Matrix4x4f result;
+
+	for (auto _ : state)
+	{
+		scalarTranspose(matrix, result);
+		matrix = result;
+		benchmark::DoNotOptimize(matrix);
+	}
+}
+BENCHMARK(BM_MatrixTransposeScalar);
+
+static void BM_MatrixTranspose(benchmark::State &state)
+{
+	ncine::Matrix4x4f matrix = ncine::Matrix4x4f::rotationZ(rotationZ);
+
+	for (auto _ : state)
+	{
+		matrix = matrix.transposed();
+		benchmark::DoNotOptimize(matrix);
+	}
+}
+BENCHMARK(BM_MatrixTranspose);
+
+static void BM_MatrixInverse(benchmark::State &state)
+{
+	ncine::Matrix4x4f matrix = ncine::Matrix4x4f::rotationZ(rotationZ);
+
+	for (auto _ : state)
+	{
+		matrix = matrix.inverse();
+		benchmark::DoNotOptimize(matrix);
+	}
+}
+BENCHMARK(BM_MatrixInverse);
+
+static void BM_QuaternionMultiplyScalar(benchmark::State &state)
+{
+	const ncine::Quaternionf rotation = ncine::Quaternionf::fromZAxisAngle(rotationZ);
+	ncine::Quaternionf quaternion = ncine::Quaternionf::fromXAxisAngle(rotationZ);
+	ncine::Quaternionf result;
+
+	for (auto _ : state)
+	{
+		scalarMultiply(quaternion, rotation, result);
+		quaternion = result;
+		benchmark::DoNotOptimize(quaternion);
+	}
+}
+BENCHMARK(BM_QuaternionMultiplyScalar);
+
+static void BM_QuaternionMultiply(benchmark::State &state)
+{
+	const ncine::Quaternionf rotation = ncine::Quaternionf::fromZAxisAngle(rotationZ);
+	ncine::Quaternionf quaternion = ncine::Quaternionf::fromXAxisAngle(rotationZ);
+
+	for (auto _ : state)
+	{
+		quaternion = quaternion * rotation;
+		benchmark::DoNotOptimize(quaternion);
+	}
+}
+BENCHMARK(BM_QuaternionMultiply);
+
+int main(int argc, char **argv)
+{
+	// Reporting which instruction set has been used by the float specializations
+	benchmark::AddCustomContext("simd", ncine::simd::instructionSet());
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include "benchmark/benchmark.h"
+#include <ncine/ParticleArrays.h>
+#include <ncine/ParticleAffectors.h>
+#include <ncine/Random.h>
+
+namespace nc = ncine;
+
+const unsigned int MaxParticles = 100000;
+
+nc::ParticleArrays particles(MaxParticles);
+nc::ColorAffector colorAffector;
+nc::SizeAffector sizeAffector(0.45f);
+nc::RotationAffector rotationAffector;
+nc::VelocityAffector velocityAffector;
+nc::ParticleAffector *affectors[] = { &colorAffector, &sizeAffector, &rotationAffector, &velocityAffector };
+
+void initParticles(unsigned int count)
+{
+	static bool affectorsInitialized = false;
+	if (affectorsInitialized == false)
+	{
+		// The same steps used by `apptest_particles`
+		colorAffector.addColorStep(0.0f, nc::Colorf(0.0f, 0.0f, 1.0f, 0.9f));
+		colorAffector.addColorStep(0.3f, nc::Colorf(0.86f, 0.7f, 0.0f, 0.65f));
+		colorAffector.addColorStep(0.35f, nc::Colorf(0.86f, 0.59f, 0.0f, 0.8f));
+		colorAffector.addColorStep(1.0f, nc::Colorf(0.86f, 0.39f, 0.0f, 0.75f));
+		sizeAffector.addSizeStep(0.0f, 0.4f);
+		sizeAffector.addSizeStep(0.3f, 1.7f);
+		sizeAffector.addSizeStep(1.0f, 0.01f);
+		rotationAffector.addRotationStep(0.0f, 0.0f);
+		rotationAffector.addRotationStep(1.0f, 360.0f);
+		velocityAffector.addVelocityStep(0.0f, 0.0f, 0.0f);
+		velocityAffector.addVelocityStep(0.5f, 0.5f, -1.0f);
+		velocityAffector.addVelocityStep(1.0f, 0.0f, 0.0f);
+		affectorsInitialized = true;
+	}
+
+	nc::random().init(0, 0);
+	particles.clear();
+	for (unsigned int i = 0; i < count; i++)
+	{
+		const unsigned int index = particles.add();
+		particles.startingLife[index] = 1.0f;
+		particles.life[index] = nc::random().real(0.0f, 1.0f);
+		particles.normalizedAge[index] = 1.0f - particles.life[index];
+		particles.startingRotation[index] = nc::random().real(0.0f, 360.0f);
+		particles.velocityX[index] = 0.0f;
+		particles.velocityY[index] = 0.0f;
+	}
+}
+
+static void BM_AffectParticlesOneByOne(benchmark::State &state)
+{
+	const unsigned int count = state.range(0);
+	initParticles(count);
+
+	for (auto _ : state)
+	{
+		for (nc::ParticleAffector *affector : affectors)
+		{
+			for (unsigned int i = 0; i < count; i++)
+				affector->affect(particles, i, particles.normalizedAge[i]);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_AffectParticlesOneByOne)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_AffectParticlesBatch(benchmark::State &state)
+{
+	const unsigned int count = state.range(0);
+	initParticles(count);
+
+	for (auto _ : state)
+	{
+		for (nc::ParticleAffector *affector : affectors)
+			affector->affectBatch(particles, 0, count);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_AffectParticlesBatch)->Arg(1000)->Arg(10000)->Arg(100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,102 @@
+#include "benchmark/benchmark.h"
+#include <nctl/algorithms.h>
+#include <nctl/Array.h>
+#include <ncine/Random.h>
+
+namespace nc = ncine;
+
+/// A stand-in for a render command, with the sorting keys far apart in memory like in the real class
+struct FakeCommand
+{
+	uint64_t materialSortKey;
+	uint32_t idSortKey;
+	unsigned char payload[240];
+};
+
+const unsigned int MaxCommands = 200000;
+const unsigned int NumLayers = 4;
+
+nctl::Array<FakeCommand> commands(MaxCommands);
+nctl::Array<FakeCommand *> initQueue(MaxCommands);
+
+bool descendingOrder(const FakeCommand *a, const FakeCommand *b)
+{
+	return (a->materialSortKey != b->materialSortKey)
+	           ? a->materialSortKey > b->materialSortKey
+	           : a->idSortKey > b->idSortKey;
+}
+
+void initQueueRandom(unsigned int count)
+{
+	static bool commandsInitialized = false;
+	if (commandsInitialized == false)
+	{
+		nc::random().init(0, 0);
+		for (unsigned int i = 0; i < MaxCommands; i++)
+		{
+			// Layer and visit order in the upper 32 bits and a material hash in the lower ones
+			const uint64_t upper = (static_cast<uint64_t>(nc::random().integer(0, NumLayers)) << 16) + nc::random().integer(0, 1024);
+			commands.emplaceBack();
+			commands[i].materialSortKey = (upper << 32) + nc::random().integer();
+			commands[i].idSortKey = i;
+		}
+		commandsInitialized = true;
+	}
+
+	initQueue.clear();
+	for (unsigned int i = 0; i < count; i++)
+		initQueue.pushBack(&commands[nc::random().integer(0, MaxCommands)]);
+}
+
+static void BM_IntroSortCommands(benchmark::State &state)
+{
+	const unsigned int count = state.range(0);
+	initQueueRandom(count);
+	nctl::Array<FakeCommand *> queue(count);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		queue = initQueue;
+		state.ResumeTiming();
+
+		nctl::sort(queue.begin(), queue.end(), descendingOrder);
+		benchmark::DoNotOptimize(queue);
+	}
+}
+BENCHMARK(BM_IntroSortCommands)->Arg(1000)->Arg(10000)->Arg(50000)->Arg(100000)->Arg(200000);
+
+static void BM_RadixSortCommands(benchmark::State &state)
+{
+	const unsigned int count = state.range(0);
+	initQueueRandom(count);
+	nctl::Array<FakeCommand *> queue(count);
+	nctl::Array<FakeCommand *> sortedQueue(count);
+	nctl::Array<nctl::RadixSortItem> items(count);
+	nctl::Array<nctl::RadixSortItem> tempItems(count);
+	items.setSize(count);
+	tempItems.setSize(count);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		queue = initQueue;
+		sortedQueue.setSize(count);
+		state.ResumeTiming();
+
+		// Keys are gathered once, then the sorted order is applied to the array of pointers
+		for (unsigned int i = 0; i < count; i++)
+		{
+			items[i].key = queue[i]->materialSortKey;
+			items[i].subKey = queue[i]->idSortKey;
+			items[i].index = i;
+		}
+		nctl::radixSortDesc(items.data(), tempItems.data(), count);
+		for (unsigned int i = 0; i < count; i++)
+			sortedQueue[i] = queue[items[i].index];
+		benchmark::DoNotOptimize(sortedQueue);
+	}
+}
+BENCHMARK(BM_RadixSortCommands)->Arg(1000)->Arg(10000)->Arg(50000)->Arg(100000)->Arg(200000);
+
+BENCHMARK_MAIN();
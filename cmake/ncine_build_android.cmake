@@ -37,6 +37,7 @@ if(NCINE_BUILD_ANDROID)
 		-DNCINE_WITH_THREADS=${NCINE_WITH_THREADS} -DNCINE_WITH_JOBSYSTEM=${NCINE_WITH_JOBSYSTEM}
 		-DNCINE_WITH_LUA=${NCINE_WITH_LUA} -DNCINE_WITH_SCRIPTING_API=${NCINE_WITH_SCRIPTING_API}
 		-DNCINE_WITH_SCENEGRAPH=${NCINE_WITH_SCENEGRAPH} -DNCINE_WITH_ALLOCATORS=${NCINE_WITH_ALLOCATORS}
+		-DNCINE_WITH_SIMD=${NCINE_WITH_SIMD} -DNCINE_WITH_COMPACT_TRANSFORMS=${NCINE_WITH_COMPACT_TRANSFORMS}
 		-DNCINE_WITH_IMGUI=${NCINE_WITH_IMGUI} -DIMGUI_SOURCE_DIR=${IMGUI_SOURCE_DIR}
 		-DNCINE_WITH_NUKLEAR=${NCINE_WITH_NUKLEAR} -DNUKLEAR_SOURCE_DIR=${NUKLEAR_SOURCE_DIR}
 		-DNCINE_WITH_TRACY=${NCINE_WITH_TRACY} -DTRACY_SOURCE_DIR=${TRACY_SOURCE_DIR}
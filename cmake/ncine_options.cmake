@@ -44,6 +44,8 @@ endif()
 
 option(NCINE_WITH_SCENEGRAPH "Enable the scenegraph, with nodes and render commands" ON)
 option(NCINE_WITH_ALLOCATORS "Enable the custom memory allocators" OFF)
+option(NCINE_WITH_SIMD "Enable SSE or NEON versions of float vector, matrix and quaternion operations" ON)
+option(NCINE_WITH_COMPACT_TRANSFORMS "Store 2D affine transformations instead of four by four matrices in nodes and render commands" OFF)
 option(NCINE_WITH_IMGUI "Enable the integration with Dear ImGui" ON)
 option(NCINE_WITH_NUKLEAR "Enable the integration with Nuklear" OFF)
 option(NCINE_WITH_TRACY "Enable the integration with the Tracy frame profiler" OFF)
@@ -4,11 +4,14 @@ list(APPEND HEADERS
 	${NCINE_ROOT}/include/ncine/common_macros.h
 	${NCINE_ROOT}/include/ncine/tracy.h
 	${NCINE_ROOT}/include/ncine/tracy_opengl.h
+	${NCINE_ROOT}/include/ncine/simd.h
 	${NCINE_ROOT}/include/ncine/Random.h
 	${NCINE_ROOT}/include/ncine/Hash64.h
 	${NCINE_ROOT}/include/ncine/Rect.h
 	${NCINE_ROOT}/include/ncine/Color.h
 	${NCINE_ROOT}/include/ncine/Colorf.h
+	${NCINE_ROOT}/include/ncine/TransformBatch2D.h
+	${NCINE_ROOT}/include/ncine/BufferRing.h
 	${NCINE_ROOT}/include/ncine/ColorHdr.h
 	${NCINE_ROOT}/include/ncine/IAppEventHandler.h
 	${NCINE_ROOT}/include/ncine/IInputEventHandler.h
@@ -19,6 +22,7 @@ list(APPEND HEADERS
 	${NCINE_ROOT}/include/ncine/Vector3.h
 	${NCINE_ROOT}/include/ncine/Vector4.h
 	${NCINE_ROOT}/include/ncine/Matrix4x4.h
+	${NCINE_ROOT}/include/ncine/AffineTransform2D.h
 	${NCINE_ROOT}/include/ncine/Quaternion.h
 	${NCINE_ROOT}/include/ncine/IIndexer.h
 	${NCINE_ROOT}/include/ncine/ILogger.h
@@ -77,6 +81,8 @@ list(APPEND SOURCES
 	${NCINE_ROOT}/src/threading/IJobSystem.cpp
 	${NCINE_ROOT}/src/graphics/Color.cpp
 	${NCINE_ROOT}/src/graphics/Colorf.cpp
+	${NCINE_ROOT}/src/graphics/TransformBatch2D.cpp
+	${NCINE_ROOT}/src/graphics/BufferRing.cpp
 	${NCINE_ROOT}/src/graphics/ColorHdr.cpp
 	${NCINE_ROOT}/src/graphics/IGfxDevice.cpp
 	${NCINE_ROOT}/src/graphics/IImageLoader.cpp
@@ -408,6 +408,12 @@ if(EXISTS ${CMAKE_SOURCE_DIR}/config.h.in)
 	if(NCINE_WITH_ALLOCATORS)
 		message(STATUS "NCINE_WITH_ALLOCATORS: " ${NCINE_WITH_ALLOCATORS})
 	endif()
+	if(NCINE_WITH_SIMD)
+		message(STATUS "NCINE_WITH_SIMD: " ${NCINE_WITH_SIMD})
+	endif()
+	if(NCINE_WITH_COMPACT_TRANSFORMS)
+		message(STATUS "NCINE_WITH_COMPACT_TRANSFORMS: " ${NCINE_WITH_COMPACT_TRANSFORMS})
+	endif()
 	if(NCINE_WITH_IMGUI)
 		message(STATUS "NCINE_WITH_IMGUI: " ${NCINE_WITH_IMGUI})
 	endif()
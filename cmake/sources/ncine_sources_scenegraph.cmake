@@ -13,6 +13,7 @@ if(NCINE_WITH_SCENEGRAPH)
 		${NCINE_ROOT}/include/ncine/MeshSprite.h
 		${NCINE_ROOT}/include/ncine/Particle.h
 		${NCINE_ROOT}/include/ncine/ParticleAffectors.h
+		${NCINE_ROOT}/include/ncine/ParticleArrays.h
 		${NCINE_ROOT}/include/ncine/ParticleSystem.h
 		${NCINE_ROOT}/include/ncine/ParticleInitializer.h
 		${NCINE_ROOT}/include/ncine/TextNode.h
@@ -29,8 +30,13 @@ if(NCINE_WITH_SCENEGRAPH)
 		${NCINE_ROOT}/src/include/RenderQueue.h
 		${NCINE_ROOT}/src/include/Material.h
 		${NCINE_ROOT}/src/include/Geometry.h
+		${NCINE_ROOT}/src/include/ParticleInstances.h
 		${NCINE_ROOT}/src/include/RenderBatcher.h
 		${NCINE_ROOT}/src/include/RenderCommandPool.h
+		${NCINE_ROOT}/src/include/SpatialGrid.h
+		${NCINE_ROOT}/src/include/SceneTraversal.h
+		${NCINE_ROOT}/src/include/FrameArena.h
+		${NCINE_ROOT}/src/include/RenderStateTracker.h
 		${NCINE_ROOT}/src/include/ScreenViewport.h
 	)
 
@@ -52,6 +58,8 @@ if(NCINE_WITH_SCENEGRAPH)
 		${NCINE_ROOT}/src/graphics/MeshSprite.cpp
 		${NCINE_ROOT}/src/graphics/Particle.cpp
 		${NCINE_ROOT}/src/graphics/ParticleAffectors.cpp
+		${NCINE_ROOT}/src/graphics/ParticleArrays.cpp
+		${NCINE_ROOT}/src/graphics/ParticleInstances.cpp
 		${NCINE_ROOT}/src/graphics/ParticleSystem.cpp
 		${NCINE_ROOT}/src/graphics/ParticleInitializer.cpp
 		${NCINE_ROOT}/src/graphics/TextNode.cpp
@@ -59,6 +67,10 @@ if(NCINE_WITH_SCENEGRAPH)
 		${NCINE_ROOT}/src/graphics/AnimatedSprite.cpp
 		${NCINE_ROOT}/src/graphics/RenderBatcher.cpp
 		${NCINE_ROOT}/src/graphics/RenderCommandPool.cpp
+		${NCINE_ROOT}/src/graphics/SpatialGrid.cpp
+		${NCINE_ROOT}/src/graphics/SceneTraversal.cpp
+		${NCINE_ROOT}/src/graphics/FrameArena.cpp
+		${NCINE_ROOT}/src/graphics/RenderStateTracker.cpp
 		${NCINE_ROOT}/src/graphics/Viewport.cpp
 		${NCINE_ROOT}/src/graphics/ScreenViewport.cpp
 		${NCINE_ROOT}/src/graphics/Camera.cpp
@@ -0,0 +1,207 @@
+#ifndef CLASS_NCINE_AFFINETRANSFORM2D
+#define CLASS_NCINE_AFFINETRANSFORM2D
+
+#include "common_constants.h"
+#include "Vector2.h"
+#include "Matrix4x4.h"
+
+namespace ncine {
+
+/// A compact 2D affine transformation based on templates
+/*! It stores only the six elements of a four by four matrix that can change in 2D, as three columns:
+ *  the first two are the transformed axes and the third one is the translation. */
+template <class T>
+class AffineTransform2D
+{
+  public:
+	AffineTransform2D()
+	    : vecs_{ Vector2<T>(1, 0), Vector2<T>(0, 1), Vector2<T>(0, 0) } {}
+	AffineTransform2D(const Vector2<T> &v0, const Vector2<T> &v1, const Vector2<T> &v2);
+	/// Creates a transformation from the 2D elements of a four by four matrix
+	explicit AffineTransform2D(const Matrix4x4<T> &m);
+
+	void set(const Vector2<T> &v0, const Vector2<T> &v1, const Vector2<T> &v2);
+
+	T *data();
+	const T *data() const;
+
+	Vector2<T> &operator[](unsigned int index);
+	const Vector2<T> &operator[](unsigned int index) const;
+
+	bool operator==(const AffineTransform2D &m) const;
+	bool operator!=(const AffineTransform2D &m) const;
+
+	/// Transforms a point, as the multiplication of a vector by a `Matrix4x4`
+	template <class S>
+	friend Vector2<S> operator*(const Vector2<S> &v, const AffineTransform2D<S> &m);
+	AffineTransform2D operator*(const AffineTransform2D &m) const;
+
+	AffineTransform2D &translate(T xx, T yy);
+	AffineTransform2D &rotate(T degrees);
+	AffineTransform2D &scale(T xx, T yy);
+
+	static AffineTransform2D translation(T xx, T yy);
+	static AffineTransform2D rotation(T degrees);
+	static AffineTransform2D scaling(T xx, T yy);
+
+	/// Returns the equivalent four by four matrix, with the specified translation on the Z axis
+	Matrix4x4<T> toMatrix4x4(T zz = 0) const;
+
+	/// An identity transformation
+	static const AffineTransform2D Identity;
+
+  private:
+	Vector2<T> vecs_[3];
+};
+
+using AffineTransform2Df = AffineTransform2D<float>;
+static_assert(sizeof(AffineTransform2Df) == sizeof(float) * 6, "AffineTransform2Df should be 6*4 bytes");
+
+template <class T>
+inline AffineTransform2D<T>::AffineTransform2D(const Vector2<T> &v0, const Vector2<T> &v1, const Vector2<T> &v2)
+{
+	set(v0, v1, v2);
+}
+
+template <class T>
+inline AffineTransform2D<T>::AffineTransform2D(const Matrix4x4<T> &m)
+{
+	set(Vector2<T>(m[0][0], m[0][1]), Vector2<T>(m[1][0], m[1][1]), Vector2<T>(m[3][0], m[3][1]));
+}
+
+template <class T>
+inline void AffineTransform2D<T>::set(const Vector2<T> &v0, const Vector2<T> &v1, const Vector2<T> &v2)
+{
+	vecs_[0] = v0;
+	vecs_[1] = v1;
+	vecs_[2] = v2;
+}
+
+template <class T>
+inline T *AffineTransform2D<T>::data()
+{
+	return &vecs_[0][0];
+}
+
+template <class T>
+inline const T *AffineTransform2D<T>::data() const
+{
+	return &vecs_[0][0];
+}
+
+template <class T>
+inline Vector2<T> &AffineTransform2D<T>::operator[](unsigned int index)
+{
+	index = (index < 3) ? index : 2;
+	return vecs_[index];
+}
+
+template <class T>
+inline const Vector2<T> &AffineTransform2D<T>::operator[](unsigned int index) const
+{
+	index = (index < 3) ? index : 2;
+	return vecs_[index];
+}
+
+template <class T>
+inline bool AffineTransform2D<T>::operator==(const AffineTransform2D &m) const
+{
+	return (vecs_[0] == m[0] && vecs_[1] == m[1] && vecs_[2] == m[2]);
+}
+
+template <class T>
+inline bool AffineTransform2D<T>::operator!=(const AffineTransform2D &m) const
+{
+	return (vecs_[0] != m[0] || vecs_[1] != m[1] || vecs_[2] != m[2]);
+}
+
+template <class S>
+inline Vector2<S> operator*(const Vector2<S> &v, const AffineTransform2D<S> &m)
+{
+	return m[0] * v.x + m[1] * v.y + m[2];
+}
+
+/*! \note The products are summed in the same order of the `Matrix4x4` multiplication */
+template <class T>
+inline AffineTransform2D<T> AffineTransform2D<T>::operator*(const AffineTransform2D &m2) const
+{
+	const AffineTransform2D &m1 = *this;
+
+	return AffineTransform2D(m1[0] * m2[0].x + m1[1] * m2[0].y,
+	                         m1[0] * m2[1].x + m1[1] * m2[1].y,
+	                         m1[0] * m2[2].x + m1[1] * m2[2].y + m1[2]);
+}
+
+template <class T>
+inline AffineTransform2D<T> &AffineTransform2D<T>::translate(T xx, T yy)
+{
+	AffineTransform2D &m = *this;
+	m[2] = m[2] + m[0] * xx + m[1] * yy;
+
+	return *this;
+}
+
+template <class T>
+inline AffineTransform2D<T> &AffineTransform2D<T>::rotate(T degrees)
+{
+	AffineTransform2D &m = *this;
+	const Vector2<T> m0 = m[0];
+	const Vector2<T> m1 = m[1];
+
+	const T radians = degrees * (static_cast<T>(Pi) / 180);
+	const T c = cos(radians);
+	const T s = sin(radians);
+
+	m[0] = m0 * c + m1 * s;
+	m[1] = m0 * -s + m1 * c;
+
+	return *this;
+}
+
+template <class T>
+inline AffineTransform2D<T> &AffineTransform2D<T>::scale(T xx, T yy)
+{
+	AffineTransform2D &m = *this;
+	m[0] *= xx;
+	m[1] *= yy;
+
+	return *this;
+}
+
+template <class T>
+inline AffineTransform2D<T> AffineTransform2D<T>::translation(T xx, T yy)
+{
+	return AffineTransform2D(Vector2<T>(1, 0), Vector2<T>(0, 1), Vector2<T>(xx, yy));
+}
+
+template <class T>
+inline AffineTransform2D<T> AffineTransform2D<T>::rotation(T degrees)
+{
+	const T radians = degrees * (static_cast<T>(Pi) / 180);
+	const T c = cos(radians);
+	const T s = sin(radians);
+
+	return AffineTransform2D(Vector2<T>(c, s), Vector2<T>(-s, c), Vector2<T>(0, 0));
+}
+
+template <class T>
+inline AffineTransform2D<T> AffineTransform2D<T>::scaling(T xx, T yy)
+{
+	return AffineTransform2D(Vector2<T>(xx, 0), Vector2<T>(0, yy), Vector2<T>(0, 0));
+}
+
+template <class T>
+inline Matrix4x4<T> AffineTransform2D<T>::toMatrix4x4(T zz) const
+{
+	return Matrix4x4<T>(Vector4<T>(vecs_[0].x, vecs_[0].y, 0, 0),
+	                    Vector4<T>(vecs_[1].x, vecs_[1].y, 0, 0),
+	                    Vector4<T>(0, 0, 1, 0),
+	                    Vector4<T>(vecs_[2].x, vecs_[2].y, zz, 1));
+}
+
+template <class T>
+const AffineTransform2D<T> AffineTransform2D<T>::Identity(Vector2<T>(1, 0), Vector2<T>(0, 1), Vector2<T>(0, 0));
+
+}
+
+#endif
@@ -80,6 +80,7 @@ class DLL_PUBLIC AppConfiguration
 			/// Enables the OpenGL debug context for additional validation and diagnostics
 			bool debugContext = false;
 			/// Enables buffer mapping for updating OpenGL buffers
+			/*! \note With OpenGL 4.4 or `GL_ARB_buffer_storage` the buffers are persistently mapped and written as a ring of regions */
 			bool useBufferMapping = false;
 
 			/** @name Resources */
@@ -93,6 +94,9 @@ class DLL_PUBLIC AppConfiguration
 			unsigned int vaoPoolSize = 16;
 			/// The initial size for the pool of render commands
 			unsigned int renderCommandPoolSize = 32;
+			/// The size in bytes of the arena for the transient rendering allocations of a frame
+			/*! \note When the arena is full the allocations fall back to memory that is not reset every frame */
+			unsigned long frameArenaSize = 1024 * 1024;
 
 			///@}
 
@@ -151,6 +155,15 @@ class DLL_PUBLIC AppConfiguration
 		bool enabled = true;
 		/// The number of threads in the job system pool, or 0 for an automatic value
 		unsigned int numThreads = 0;
+		/// The number of times an idle worker thread spins looking for a job before starting to yield
+		unsigned int spinCount = 256;
+		/// The number of times an idle worker thread yields looking for a job before going to sleep
+		unsigned int yieldCount = 16;
+		/// Whether a worker thread steals jobs first from the threads running on cores that share its caches
+		bool topologyAwareStealing = true;
+		/// Whether worker threads only run on the cores of the highest performance tier
+		/*! \note When the number of threads is automatic, it becomes the number of physical performance cores. */
+		bool performanceCoresOnly = false;
 	};
 
 	/// Feature switches
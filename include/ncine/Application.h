@@ -32,7 +32,9 @@ class DLL_PUBLIC Application
 	{
 		RenderingSettings()
 		    : batchingEnabled(true), batchingWithIndices(false), instancingEnabled(true), cullingEnabled(true),
-		      minBatchSize(4), maxBatchSize(1024), minInstancedBatchSize(4), maxInstancedBatchSize(4096) {}
+		      spatialIndexEnabled(false), spatialIndexCellSize(512.0f), minBatchSize(4), maxBatchSize(1024), minInstancedBatchSize(4), maxInstancedBatchSize(4096), incrementalSortEnabled(false),
+		      batchTransformEnabled(false), minBatchTransformSize(64), cleanSubtreeSkipEnabled(false), linearTraversalEnabled(false), parallelUpdateEnabled(false), minParallelUpdateSize(512), parallelUpdateSplitSize(128),
+		      parallelVisitEnabled(false), minParallelVisitSize(1024), parallelVisitSplitSize(256) {}
 
 		/// Enables batching with uniforms
 		bool batchingEnabled;
@@ -42,6 +44,10 @@ class DLL_PUBLIC Application
 		bool instancingEnabled;
 		/// Enables node culling
 		bool cullingEnabled;
+		/// Enables the culling of drawable nodes through a grid that indexes their bounding boxes
+		bool spatialIndexEnabled;
+		/// Side of a cell of the spatial index grid in world units
+		float spatialIndexCellSize;
 		/// Minimum size for a batch with uniforms to be collected
 		unsigned int minBatchSize;
 		/// Maximum size for a batch with uniforms before a forced split
@@ -50,6 +56,31 @@ class DLL_PUBLIC Application
 		unsigned int minInstancedBatchSize;
 		/// Maximum size for a batch with instances before a forced split
 		unsigned int maxInstancedBatchSize;
+		/// Enables the repair of the previous frame sorted order instead of a full sort of the render queues
+		bool incrementalSortEnabled;
+		/// Enables the calculation of the matrices of sibling nodes in a single vectorized pass
+		/*! \note The rotation is calculated with an approximated sine and cosine, the matrices are not bit-identical to the ones of the non-batched path */
+		bool batchTransformEnabled;
+		/// Minimum number of sibling nodes with a dirty transformation for their matrices to be calculated in a batch
+		unsigned int minBatchTransformSize;
+		/// Enables skipping the update of subtrees in which nothing has changed
+		/*! \note Nodes that change their own properties in an overridden `update()` method should be set as always updated */
+		bool cleanSubtreeSkipEnabled;
+		/// Enables the update and the visit of the scene by iterating on a pre-order array of nodes, rebuilt on topology changes
+		/*! \note Sibling subtrees are not updated in parallel, and only always updated nodes have their `update()` and `visit()` methods called */
+		bool linearTraversalEnabled;
+		/// Enables the update of sibling subtrees in parallel on the job system
+		bool parallelUpdateEnabled;
+		/// Minimum number of children of a node for their subtrees to be updated in parallel
+		unsigned int minParallelUpdateSize;
+		/// Maximum number of sibling subtrees updated by a single job
+		unsigned int parallelUpdateSplitSize;
+		/// Enables the recording of render commands in parallel on the job system after the visit
+		bool parallelVisitEnabled;
+		/// Minimum number of visited drawable nodes for their render commands to be recorded in parallel
+		unsigned int minParallelVisitSize;
+		/// Maximum number of render commands recorded by a single job
+		unsigned int parallelVisitSplitSize;
 	};
 
 	/// GUI settings (for ImGui and Nuklear) that can be changed at run-time
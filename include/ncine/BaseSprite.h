@@ -7,7 +7,6 @@
 namespace ncine {
 
 class Texture;
-class GLUniformBlockCache;
 
 /// The base class for sprites
 /*! \note Users cannot create instances of this class */
@@ -56,8 +55,6 @@ class DLL_PUBLIC BaseSprite : public DrawableNode
 	/// A flag indicating if the sprite texture is vertically flipped
 	bool flippedY_;
 
-	GLUniformBlockCache *instanceBlock_;
-
 	/// Protected constructor accessible only by derived sprite classes
 	BaseSprite(SceneNode *parent, Texture *texture, float xx, float yy);
 	/// Protected constructor accessible only by derived sprite classes
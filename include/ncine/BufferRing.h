@@ -0,0 +1,70 @@
+#ifndef CLASS_NCINE_BUFFERRING
+#define CLASS_NCINE_BUFFERRING
+
+#include <cstdint>
+#include "common_defines.h"
+
+namespace ncine {
+
+/// The bookkeeping of persistently mapped buffers divided in regions that are written in turn, one per frame
+/*! While the CPU writes the region of the current frame, the GPU might still be reading the regions of the previous ones.
+ *  A fence is inserted after the commands of every frame, and a region is written again only after its fence has been signaled.
+ *  The fence operations are performed by a backend, so that the bookkeeping can be tested without a graphics context. */
+class DLL_PUBLIC BufferRing
+{
+  public:
+	/// The number of regions, one for the frame being written and two for the frames the GPU might still be reading
+	static const unsigned int NumRegions = 3;
+
+	/// The interface of the fence operations used by a buffer ring
+	class DLL_PUBLIC Backend
+	{
+	  public:
+		virtual ~Backend() {}
+
+		/// Inserts a fence after the commands that read the specified region
+		virtual void insertFence(unsigned int region) = 0;
+		/// Returns true if the fence of the specified region has been signaled, waiting at most the specified nanoseconds
+		virtual bool waitFence(unsigned int region, uint64_t timeout) = 0;
+		/// Deletes the fence of the specified region
+		virtual void deleteFence(unsigned int region) = 0;
+	};
+
+	/// The number of nanoseconds of every wait when the fence of the next region has not been signaled yet
+	static const uint64_t WaitTimeout = 1000000;
+
+	explicit BufferRing(Backend &backend);
+	~BufferRing();
+
+	/// Returns the index of the region written in the current frame
+	inline unsigned int currentRegion() const { return currentRegion_; }
+	/// Returns the offset of the current region in a buffer made of regions of the specified size
+	inline unsigned long regionOffset(unsigned long regionSize) const { return currentRegion_ * regionSize; }
+	/// Returns true if the fence of the specified region has been inserted and not yet deleted
+	inline bool isFencePending(unsigned int region) const { return fencePending_[region]; }
+
+	/// Returns the number of times the ring has moved to the next region
+	inline unsigned long numAdvances() const { return numAdvances_; }
+	/// Returns the number of times the CPU had to wait for the GPU before writing the next region
+	inline unsigned long numBlockingWaits() const { return numBlockingWaits_; }
+
+	/// Fences the current region and moves to the next one, waiting for its fence only if the GPU is still reading it
+	void advance();
+
+  private:
+	Backend &backend_;
+	unsigned int currentRegion_;
+	bool fencePending_[NumRegions];
+
+	unsigned long numAdvances_;
+	unsigned long numBlockingWaits_;
+
+	/// Deleted copy constructor
+	BufferRing(const BufferRing &) = delete;
+	/// Deleted assignment operator
+	BufferRing &operator=(const BufferRing &) = delete;
+};
+
+}
+
+#endif
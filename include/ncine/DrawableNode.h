@@ -60,10 +60,10 @@ class DLL_PUBLIC DrawableNode : public SceneNode
 	DrawableNode();
 	~DrawableNode() override;
 
-	/// Default move constructor
-	DrawableNode(DrawableNode &&);
-	/// Default move assignment operator
-	DrawableNode &operator=(DrawableNode &&);
+	/// Move constructor
+	DrawableNode(DrawableNode &&other);
+	/// Move assignment operator
+	DrawableNode &operator=(DrawableNode &&other);
 
 	/// Updates the draw command and adds it to the queue
 	bool draw(RenderQueue &renderQueue) override;
@@ -135,6 +135,8 @@ class DLL_PUBLIC DrawableNode : public SceneNode
 	unsigned long int lastFrameRendered_;
 	/// Axis-aligned bounding box of the node area
 	Rectf aabb_;
+	/// The range of spatial index cells that contain the node, with a zero width when it is not indexed
+	Recti spatialGridCells_;
 	/// Calculates updated values for the AABB
 	virtual void updateAabb();
 	/// Called by each viewport update method to update a node culling state
@@ -153,8 +155,13 @@ class DLL_PUBLIC DrawableNode : public SceneNode
 	/// Deleted assignment operator
 	DrawableNode &operator=(const DrawableNode &) = delete;
 
+	/// Updates the render command and resets the upload dirty bits
+	void prepareRenderCommand();
+
 	friend class ShaderState;
 	friend class Viewport;
+	friend class RenderQueue;
+	friend class SpatialGrid;
 };
 
 }
@@ -71,6 +71,7 @@ class DLL_PUBLIC IGfxCapabilities
 			AMD_COMPRESSED_ATC_TEXTURE,
 			IMG_TEXTURE_COMPRESSION_PVRTC,
 			KHR_TEXTURE_COMPRESSION_ASTC_LDR,
+			ARB_BUFFER_STORAGE,
 
 			COUNT
 		};
@@ -6,7 +6,13 @@
 
 namespace ncine {
 
-static const uint16_t MaxNumJobs = 8192;
+/// The number of jobs in every block of the job pool, the pool grows one block at a time when it is exhausted
+static const uint16_t JobPoolBlockSize = 8192;
+/// The maximum number of blocks of the job pool
+/*! \note The last 16-bit index is never reached, so that no job id can be equal to `InvalidJobId`. */
+static const uint16_t MaxNumJobPoolBlocks = 7;
+/// The maximum number of jobs that can be allocated at the same time
+static const uint16_t MaxNumJobs = JobPoolBlockSize * MaxNumJobPoolBlocks;
 
 using JobId = uint32_t;
 static const JobId InvalidJobId = static_cast<JobId>(~0u);
@@ -14,6 +20,40 @@ using JobFunction = void (*)(JobId, const void *);
 static const uint32_t JobDataSize = 36;
 static const uint32_t JobNumContinuations = 2;
 static_assert(JobDataSize >= sizeof(uintptr_t), "At least one user pointer should fit the Job structure");
+/// The maximum size of the job data that is copied to an arena of the creating thread when it does not fit the `Job` structure
+/*! \note Bigger job data, or job data created when the arena of the thread is full, is allocated on the heap. */
+static const uint32_t JobArenaDataSize = 256;
+static_assert(JobArenaDataSize > JobDataSize, "The job data arena should hold data that does not fit the Job structure");
+
+/// The priority levels of jobs, a thread always looks for a job in the higher levels first
+struct JobPriority
+{
+	enum Enum
+	{
+		/// Frame-critical jobs, like the parallel update and visit of the scene
+		HIGH = 0,
+		/// The default priority
+		NORMAL,
+		/// Long running jobs, like asset loading, that should never delay the frame
+		BACKGROUND,
+
+		COUNT
+	};
+};
+
+/// The order in which a thread looks into the queues of the other threads to steal a job
+struct JobStealPolicy
+{
+	enum Enum
+	{
+		/// The main thread first, then all the others in turn
+		ROUND_ROBIN = 0,
+		/// The threads running on cores that share the most caches with the calling one first
+		TOPOLOGY,
+
+		COUNT
+	};
+};
 
 /// The interface for the multi-threaded job system
 class DLL_PUBLIC IJobSystem
@@ -27,11 +67,20 @@ class DLL_PUBLIC IJobSystem
 
 	virtual ~IJobSystem() = 0;
 
-	/// Creates an id for a new job, with optional custom data
-	virtual JobId createJob(JobFunction function, const void *data, unsigned int dataSize) = 0;
+	/// Creates an id for a new job with the specified priority, with optional custom data
+	/*! \note The data is copied, in the job itself if it fits `JobDataSize` bytes, and it is freed when the job is finished or cancelled.
+	 *  \note If the job pool is exhausted, `InvalidJobId` is returned and the function is not executed. */
+	virtual JobId createJob(JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority) = 0;
 	/// Creates an id for a new job as a child of the specified one, with optional custom data
+	/*! \note The child job has the same priority of its parent.
+	 *  \note If the job pool is exhausted, `InvalidJobId` is returned and the function is not executed.
+	 *  Only the sub-ranges of `parallelFor()` and the jobs of `JobHandle::submitChildOrExecute()` fall back to `executeInPlace()`. */
 	virtual JobId createJobAsChild(JobId parentId, JobFunction function, const void *data, unsigned int dataSize) = 0;
 
+	/// Creates an id for a new job with normal priority, with optional custom data
+	inline JobId createJob(JobFunction function, const void *data, unsigned int dataSize) { return createJob(function, data, dataSize, JobPriority::NORMAL); }
+	/// Creates an id for a new job with the specified priority
+	inline JobId createJob(JobFunction function, JobPriority::Enum priority) { return createJob(function, nullptr, 0, priority); }
 	/// Creates an id for a new job
 	inline JobId createJob(JobFunction function) { return createJob(function, nullptr, 0); }
 	/// Creates an id for a new job as a child of the specified one
@@ -39,6 +88,9 @@ class DLL_PUBLIC IJobSystem
 
 	/// Adds a previously created job as a continuation for the specified ancestor one
 	virtual bool addContinuation(JobId ancestorId, JobId continuationId) = 0;
+	/// Sets the priority of a job that has not been submitted yet
+	/*! \returns True if the priority has been set. */
+	virtual bool setPriority(JobId jobId, JobPriority::Enum priority) = 0;
 
 	/// Submits the specified job to the calling thread queue
 	/*! \returns True if the job has been submitted. */
@@ -47,7 +99,8 @@ class DLL_PUBLIC IJobSystem
 	/*! \returns The number of jobs that have been submitted. */
 	virtual uint16_t submit(const JobId *jobIds, uint16_t count) = 0;
 	/// Attempts to cancel a job, returning it to the pool
-	/*! \returns True if the job can be cancelled. */
+	/*! \returns True if the job can be cancelled.
+	 *  \note A child job that has not been submitted yet is no longer waited for by its parent. */
 	virtual bool cancel(JobId jobId) = 0;
 	/// Waits until the specified job has finished, while carrying on other jobs
 	/*! \note If the job has already finished, this method will simply return. */
@@ -58,6 +111,15 @@ class DLL_PUBLIC IJobSystem
 	/// Returns the number of continuation jobs for the specified job
 	virtual uint16_t continuationCount(JobId jobId) = 0;
 
+	/// Sets how many times an idle worker thread spins and then yields looking for a job before going to sleep
+	/*! \note A zero count disables the corresponding phase. */
+	virtual void setIdleBackoff(unsigned int spinCount, unsigned int yieldCount) = 0;
+
+	/// Returns the order in which threads steal jobs from each other
+	virtual JobStealPolicy::Enum stealPolicy() const = 0;
+	/// Sets the order in which threads steal jobs from each other
+	virtual void setStealPolicy(JobStealPolicy::Enum policy) = 0;
+
 	/// Returns the total number of threads executing jobs (workers + main)
 	inline unsigned char numThreads() const { return numThreads_; }
 
@@ -68,6 +130,10 @@ class DLL_PUBLIC IJobSystem
 	/// Returns `true` if called from the main thread
 	static bool isMainThread();
 
+	/// Executes a job function in place on behalf of the specified job, when a child job cannot be created or submitted
+	/*! \note The function receives the id of the specified job, as the child job does not exist. */
+	static void executeInPlace(JobId jobId, JobFunction function, const void *data);
+
   protected:
 	/// Total number of threads executing jobs (workers + main)
 	unsigned char numThreads_;
@@ -89,10 +155,11 @@ inline IJobSystem::~IJobSystem() {}
 class DLL_PUBLIC NullJobSystem : public IJobSystem
 {
   public:
-	inline JobId createJob(JobFunction function, const void *data, unsigned int dataSize) override { return InvalidJobId; }
+	inline JobId createJob(JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority) override { return InvalidJobId; }
 	inline JobId createJobAsChild(JobId parentId, JobFunction function, const void *data, unsigned int dataSize) override { return InvalidJobId; }
 
 	inline bool addContinuation(JobId ancestorId, JobId continuationId) override { return false; }
+	inline bool setPriority(JobId jobId, JobPriority::Enum priority) override { return false; }
 
 	inline bool submit(JobId jobId) override { return false; }
 	uint16_t submit(const JobId *jobIds, uint16_t count) override { return 0; }
@@ -101,6 +168,11 @@ class DLL_PUBLIC NullJobSystem : public IJobSystem
 
 	inline uint16_t unfinishedJobs(JobId jobId) override { return 0; }
 	inline uint16_t continuationCount(JobId jobId) override { return 0; }
+
+	inline void setIdleBackoff(unsigned int spinCount, unsigned int yieldCount) override {}
+
+	inline JobStealPolicy::Enum stealPolicy() const override { return JobStealPolicy::ROUND_ROBIN; }
+	inline void setStealPolicy(JobStealPolicy::Enum policy) override {}
 };
 
 }
@@ -1,11 +1,31 @@
 #ifndef CLASS_NCINE_JOBHANDLE
 #define CLASS_NCINE_JOBHANDLE
 
+#include <cstring> // for memcpy()
+#include <nctl/type_traits.h>
 #include <ncine/IJobSystem.h>
 #include <ncine/ParallelForJob.h>
 
 namespace ncine {
 
+/// The job function that calls a callable object, like a lambda, stored as job data
+/*! \note The callable is copied to local storage before being called, so that it is always correctly aligned and it can be mutable. */
+template <typename F>
+void callableJob(JobId job, const void *jobData)
+{
+	alignas(F) unsigned char storage[sizeof(F)];
+	memcpy(storage, jobData, sizeof(F));
+	F &function = *reinterpret_cast<F *>(storage);
+	function(job);
+}
+
+/// Evaluates to `true` for the callable objects that are not convertible to a `JobFunction`
+template <typename F>
+struct isJobCallable
+{
+	static constexpr bool value = (nctl::isConvertible<F, JobFunction>::value == false);
+};
+
 /// A wrapper class around the job system `JobId`
 class DLL_PUBLIC JobHandle
 {
@@ -30,20 +50,51 @@ class DLL_PUBLIC JobHandle
 	NODISCARD static JobHandle createJob(JobFunction function, const void *data, unsigned int dataSize);
 	//// Creates a job handle for a new job
 	NODISCARD static inline JobHandle createJob(JobFunction function) { return createJob(function, nullptr, 0); }
+	/// Creates a job handle for a new job with the specified priority, with optional custom data
+	NODISCARD static JobHandle createJob(JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority);
+	/// Creates a job handle for a new job with the specified priority
+	NODISCARD static inline JobHandle createJob(JobFunction function, JobPriority::Enum priority) { return createJob(function, nullptr, 0, priority); }
+	/// Creates a job handle for a new job that calls a copy of a callable object, like a lambda, with the id of the job
+	/*! \note The callable is copied like any other job data, so it should be trivially copyable, like a lambda that only captures pointers and values.
+	 *  \note If the callable does not fit the job, it is stored in the job data arena of the calling thread until the job is finished. */
+	template <typename F, nctl::enableIfT<isJobCallable<F>::value, int> = 0>
+	NODISCARD static JobHandle createJob(const F &function, JobPriority::Enum priority = JobPriority::NORMAL);
 
 	/// Creates a job handle for a new parallel for job
 	template <typename T, typename S>
 	NODISCARD static JobHandle createParallelForJob(T *data, unsigned int count, void (*function)(T *, unsigned int), const S &splitter);
+	/// Creates a job handle for a new parallel for job, with a context passed to every function call
+	template <typename T, typename C, typename S>
+	NODISCARD static JobHandle createParallelForJob(T *data, unsigned int count, void (*function)(T *, unsigned int, C *), C *context, const S &splitter);
+	/// Creates a job handle for a new parallel for job that calls a copy of a callable object on every sub-range
+	template <typename T, typename F, typename S>
+	NODISCARD static JobHandle createParallelForJob(T *data, unsigned int count, const F &function, const S &splitter);
 
 	/// Creates a job handle for a new child job, with optional custom data
 	JobHandle createChildJob(JobFunction function, const void *data, unsigned int dataSize);
 	//// Creates a job handle for a new child job
 	JobHandle inline createChildJob(JobFunction function) { return createChildJob(function, nullptr, 0); }
+	/// Creates a job handle for a new child job that calls a copy of a callable object with the id of the job
+	template <typename F, nctl::enableIfT<isJobCallable<F>::value, int> = 0>
+	JobHandle createChildJob(const F &function);
+	/// Creates and submits a new child job, or executes the function in place if the child cannot be created or submitted
+	/*! \returns True if the child job has been submitted, false if the function has been executed in place.
+	 *  \note When executed in place, the function receives the id of this job. */
+	bool submitChildOrExecute(JobFunction function, const void *data, unsigned int dataSize);
+	/// Creates and submits a new child job that calls a copy of a callable object, or calls it in place if the child cannot be created or submitted
+	template <typename F, nctl::enableIfT<isJobCallable<F>::value, int> = 0>
+	bool submitChildOrExecute(const F &function);
 
 	/// Creates a job handle for a new continuation job, with optional custom data
 	JobHandle createContinuationJob(JobFunction function, const void *data, unsigned int dataSize);
 	/// Creates a job handle for a new continuation job
 	JobHandle inline createContinuationJob(JobFunction function) { return createContinuationJob(function, nullptr, 0); }
+	/// Creates a job handle for a new continuation job that calls a copy of a callable object with the id of the job
+	template <typename F, nctl::enableIfT<isJobCallable<F>::value, int> = 0>
+	JobHandle createContinuationJob(const F &function);
+
+	/// Changes the priority of the job, it is only possible before submitting it
+	bool setPriority(JobPriority::Enum priority);
 
 	/// Submits the job to the calling thread queue
 	bool submit();
@@ -100,9 +151,16 @@ class DLL_PUBLIC ScopedJobHandle : public JobHandle
 	NODISCARD static ScopedJobHandle createJob(JobFunction function, const void *data, unsigned int dataSize);
 	/// Creates a scoped job handle for a new job
 	NODISCARD static inline ScopedJobHandle createJob(JobFunction function) { return createJob(function, nullptr, 0); }
+	/// Creates a scoped job handle for a new job that calls a copy of a callable object, like a lambda, with the id of the job
+	template <typename F, nctl::enableIfT<isJobCallable<F>::value, int> = 0>
+	NODISCARD static ScopedJobHandle createJob(const F &function);
 
 	template <typename T, typename S>
 	NODISCARD static ScopedJobHandle createParallelForJob(T *data, unsigned int count, void (*function)(T *, unsigned int), const S &splitter);
+	template <typename T, typename C, typename S>
+	NODISCARD static ScopedJobHandle createParallelForJob(T *data, unsigned int count, void (*function)(T *, unsigned int, C *), C *context, const S &splitter);
+	template <typename T, typename F, typename S>
+	NODISCARD static ScopedJobHandle createParallelForJob(T *data, unsigned int count, const F &function, const S &splitter);
 
   private:
 	/// Tries to cancel a job, if it cannot it waits on it
@@ -114,26 +172,75 @@ class DLL_PUBLIC ScopedJobHandle : public JobHandle
 	ScopedJobHandle &operator=(const ScopedJobHandle &) = delete;
 };
 
+template <typename F, nctl::enableIfT<isJobCallable<F>::value, int>>
+JobHandle JobHandle::createJob(const F &function, JobPriority::Enum priority)
+{
+	static_assert(nctl::isTriviallyCopyable<F>::value, "The callable of a job should be trivially copyable");
+	return createJob(&callableJob<F>, &function, sizeof(F), priority);
+}
+
+template <typename F, nctl::enableIfT<isJobCallable<F>::value, int>>
+JobHandle JobHandle::createChildJob(const F &function)
+{
+	static_assert(nctl::isTriviallyCopyable<F>::value, "The callable of a job should be trivially copyable");
+	return createChildJob(&callableJob<F>, &function, sizeof(F));
+}
+
+template <typename F, nctl::enableIfT<isJobCallable<F>::value, int>>
+bool JobHandle::submitChildOrExecute(const F &function)
+{
+	static_assert(nctl::isTriviallyCopyable<F>::value, "The callable of a job should be trivially copyable");
+	return submitChildOrExecute(&callableJob<F>, &function, sizeof(F));
+}
+
+template <typename F, nctl::enableIfT<isJobCallable<F>::value, int>>
+JobHandle JobHandle::createContinuationJob(const F &function)
+{
+	static_assert(nctl::isTriviallyCopyable<F>::value, "The callable of a job should be trivially copyable");
+	return createContinuationJob(&callableJob<F>, &function, sizeof(F));
+}
+
+template <typename F, nctl::enableIfT<isJobCallable<F>::value, int>>
+ScopedJobHandle ScopedJobHandle::createJob(const F &function)
+{
+	static_assert(nctl::isTriviallyCopyable<F>::value, "The callable of a job should be trivially copyable");
+	return createJob(&callableJob<F>, &function, sizeof(F));
+}
+
 template <typename T, typename S>
 JobHandle JobHandle::createParallelForJob(T *data, unsigned int count, void (*function)(T *, unsigned int), const S &splitter)
 {
-	typedef parallelForJobData<T, S> JobData;
-	static_assert(sizeof(JobData) <= JobDataSize, "The embedded Job data buffer is too small for parallelFor");
-	const JobData jobData(data, count, function, splitter);
-
-	JobId jobId = theServiceLocator().jobSystem().createJob(&parallelForJob<JobData>, &jobData, sizeof(JobData));
-	return JobHandle(jobId);
+	return JobHandle(parallelFor(data, count, function, splitter));
 }
 
 template <typename T, typename S>
 ScopedJobHandle ScopedJobHandle::createParallelForJob(T *data, unsigned int count, void (*function)(T *, unsigned int), const S &splitter)
 {
-	typedef parallelForJobData<T, S> JobData;
-	static_assert(sizeof(JobData) <= JobDataSize, "The embedded Job data buffer is too small for parallelFor");
-	const JobData jobData(data, count, function, splitter);
+	return ScopedJobHandle(parallelFor(data, count, function, splitter));
+}
 
-	JobId jobId = theServiceLocator().jobSystem().createJob(&parallelForJob<JobData>, &jobData, sizeof(JobData));
-	return ScopedJobHandle(jobId);
+template <typename T, typename C, typename S>
+JobHandle JobHandle::createParallelForJob(T *data, unsigned int count, void (*function)(T *, unsigned int, C *), C *context, const S &splitter)
+{
+	return JobHandle(parallelFor(data, count, function, context, splitter));
+}
+
+template <typename T, typename C, typename S>
+ScopedJobHandle ScopedJobHandle::createParallelForJob(T *data, unsigned int count, void (*function)(T *, unsigned int, C *), C *context, const S &splitter)
+{
+	return ScopedJobHandle(parallelFor(data, count, function, context, splitter));
+}
+
+template <typename T, typename F, typename S>
+JobHandle JobHandle::createParallelForJob(T *data, unsigned int count, const F &function, const S &splitter)
+{
+	return JobHandle(parallelFor(data, count, function, splitter));
+}
+
+template <typename T, typename F, typename S>
+ScopedJobHandle ScopedJobHandle::createParallelForJob(T *data, unsigned int count, const F &function, const S &splitter)
+{
+	return ScopedJobHandle(parallelFor(data, count, function, splitter));
 }
 
 }
@@ -21,6 +21,21 @@ class DLL_PUBLIC JobStatistics
 		uint32_t childJobsFinished = 0;
 		uint32_t continuationJobsPushed = 0;
 		uint32_t parentJobsFinished = 0;
+		uint32_t jobsExecutedInline = 0;
+		/// Number of times an idle worker found a job while spinning
+		uint32_t spinWakeUps = 0;
+		/// Number of times an idle worker found a job while yielding
+		uint32_t yieldWakeUps = 0;
+		/// Number of times an idle worker found a job after sleeping on the semaphore
+		uint32_t sleepWakeUps = 0;
+		/// Time spent by idle workers spinning or yielding, in nanoseconds
+		uint64_t spinNanoseconds = 0;
+		/// Time spent by idle workers sleeping on the semaphore, in nanoseconds
+		uint64_t sleepNanoseconds = 0;
+		/// Sum of the times between the signal of a job submission and the wake-up of a worker, in nanoseconds
+		uint64_t wakeUpLatencyNanoseconds = 0;
+		/// Maximum time between the signal of a job submission and the wake-up of a worker, in nanoseconds
+		uint64_t maxWakeUpLatencyNanoseconds = 0;
 
 		void incrementJobsCreated();
 		void incrementChildJobsCreated();
@@ -30,6 +45,13 @@ class DLL_PUBLIC JobStatistics
 		void incrementChildJobsFinished();
 		void incrementContinuationJobsPushed();
 		void incrementParentJobsFinished();
+		void incrementJobsExecutedInline();
+		void incrementSpinWakeUps();
+		void incrementYieldWakeUps();
+		void incrementSleepWakeUps();
+		void addSpinTime(uint64_t nanoseconds);
+		void addSleepTime(uint64_t nanoseconds);
+		void addWakeUpLatency(uint64_t nanoseconds);
 
 		void add(const JobSystemStats &other);
 		void reset();
@@ -45,6 +67,9 @@ class DLL_PUBLIC JobStatistics
 		uint32_t jobRetrievalFails = 0;
 		uint32_t threadCacheEmpty = 0;
 		uint32_t threadCacheFull = 0;
+		uint32_t blocksAdded = 0;
+		uint32_t arenaDataAllocations = 0;
+		uint32_t heapDataAllocations = 0;
 
 		void incrementJobsAllocated();
 		void incrementJobAllocationFails();
@@ -53,6 +78,9 @@ class DLL_PUBLIC JobStatistics
 		void incrementJobRetrievalFails();
 		void incrementThreadCacheEmpty();
 		void incrementThreadCacheFull();
+		void incrementBlocksAdded();
+		void incrementArenaDataAllocations();
+		void incrementHeapDataAllocations();
 
 		void add(const JobPoolStats &other);
 		void reset();
@@ -135,6 +163,7 @@ class DLL_PUBLIC JobStatistics
 	JobQueueStats &jobQueueStatsMut();
 
 	friend class JobSystemStatsHelper;
+	friend class IJobSystem;
 	friend class JobSystem;
 	friend class SerialJobSystem;
 	friend class JobPool;
@@ -393,6 +393,82 @@ inline Matrix4x4<T> &Matrix4x4<T>::transpose()
 	return *this;
 }
 
+// The generic versions are the scalar fallback for the float specializations
+#if NCINE_SIMD_FLOAT4
+
+// The matrix by vector multiplication is not specialized, as it sums along rows that are not contiguous in memory
+
+template <>
+inline Vector4<float> operator*(const Vector4<float> &v, const Matrix4x4<float> &m)
+{
+	const simd::Float4 vec = simd::load(v.data());
+	simd::Float4 r = simd::mul(simd::load(m[0].data()), simd::broadcast<0>(vec));
+	r = simd::add(r, simd::mul(simd::load(m[1].data()), simd::broadcast<1>(vec)));
+	r = simd::add(r, simd::mul(simd::load(m[2].data()), simd::broadcast<2>(vec)));
+	r = simd::add(r, simd::mul(simd::load(m[3].data()), simd::broadcast<3>(vec)));
+
+	Vector4<float> result;
+	simd::store(result.data(), r);
+	return result;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::operator*(const Matrix4x4 &m2) const
+{
+	const simd::Float4 c0 = simd::load(vecs_[0].data());
+	const simd::Float4 c1 = simd::load(vecs_[1].data());
+	const simd::Float4 c2 = simd::load(vecs_[2].data());
+	const simd::Float4 c3 = simd::load(vecs_[3].data());
+
+	Matrix4x4 result;
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		const simd::Float4 v = simd::load(m2.vecs_[i].data());
+		simd::Float4 r = simd::mul(c0, simd::broadcast<0>(v));
+		r = simd::add(r, simd::mul(c1, simd::broadcast<1>(v)));
+		r = simd::add(r, simd::mul(c2, simd::broadcast<2>(v)));
+		r = simd::add(r, simd::mul(c3, simd::broadcast<3>(v)));
+		simd::store(result.vecs_[i].data(), r);
+	}
+
+	return result;
+}
+
+template <>
+inline Matrix4x4<float> Matrix4x4<float>::transposed() const
+{
+	simd::Float4 v0 = simd::load(vecs_[0].data());
+	simd::Float4 v1 = simd::load(vecs_[1].data());
+	simd::Float4 v2 = simd::load(vecs_[2].data());
+	simd::Float4 v3 = simd::load(vecs_[3].data());
+	simd::transpose(v0, v1, v2, v3);
+
+	Matrix4x4 result;
+	simd::store(result.vecs_[0].data(), v0);
+	simd::store(result.vecs_[1].data(), v1);
+	simd::store(result.vecs_[2].data(), v2);
+	simd::store(result.vecs_[3].data(), v3);
+	return result;
+}
+
+template <>
+inline Matrix4x4<float> &Matrix4x4<float>::transpose()
+{
+	simd::Float4 v0 = simd::load(vecs_[0].data());
+	simd::Float4 v1 = simd::load(vecs_[1].data());
+	simd::Float4 v2 = simd::load(vecs_[2].data());
+	simd::Float4 v3 = simd::load(vecs_[3].data());
+	simd::transpose(v0, v1, v2, v3);
+
+	simd::store(vecs_[0].data(), v0);
+	simd::store(vecs_[1].data(), v1);
+	simd::store(vecs_[2].data(), v2);
+	simd::store(vecs_[3].data(), v3);
+	return *this;
+}
+
+#endif
+
 template <class T>
 inline Matrix4x4<T> Matrix4x4<T>::inverse() const
 {
@@ -1,6 +1,7 @@
 #ifndef CLASS_NCINE_PARALLELFORJOB
 #define CLASS_NCINE_PARALLELFORJOB
 
+#include <nctl/type_traits.h>
 #include "ServiceLocator.h"
 
 namespace ncine {
@@ -33,6 +34,25 @@ class DataSizeSplitter
 	unsigned int size_;
 };
 
+template <typename JobData>
+void parallelForJob(JobId job, const void *jobData);
+
+/// Creates and submits a child job for a sub-range, or executes it in place if the job cannot be created or submitted
+/*! \note A sub-range is never dropped, even when the job pool is exhausted. */
+template <typename JobData>
+void parallelForSubmitOrExecute(JobId job, const JobData &subData)
+{
+	IJobSystem &jobSystem = theServiceLocator().jobSystem();
+
+	JobId child = jobSystem.createJobAsChild(job, &parallelForJob<JobData>, &subData, sizeof(JobData));
+	if (child == InvalidJobId || jobSystem.submit(child) == false)
+	{
+		if (child != InvalidJobId)
+			jobSystem.cancel(child);
+		IJobSystem::executeInPlace(job, &parallelForJob<JobData>, &subData);
+	}
+}
+
 /// The parallel for job that either splits the workload in two or executes it, based on a `Splitter` policy class
 template <typename JobData>
 void parallelForJob(JobId job, const void *jobData)
@@ -42,23 +62,17 @@ void parallelForJob(JobId job, const void *jobData)
 
 	if (splitter.template split<typename JobData::DataType>(data->count))
 	{
-		IJobSystem &jobSystem = theServiceLocator().jobSystem();
-
 		// Splits in two
 		const unsigned int leftCount = data->count / 2u;
-		const JobData leftData(data->data, leftCount, data->function, splitter);
-		JobId left = jobSystem.createJobAsChild(job, &parallelForJob<JobData>, &leftData, sizeof(JobData));
-		jobSystem.submit(left);
+		parallelForSubmitOrExecute(job, JobData(*data, 0, leftCount));
 
 		const unsigned int rightCount = data->count - leftCount;
-		const JobData rightData(data->data + leftCount, rightCount, data->function, splitter);
-		JobId right = jobSystem.createJobAsChild(job, &parallelForJob<JobData>, &rightData, sizeof(JobData));
-		jobSystem.submit(right);
+		parallelForSubmitOrExecute(job, JobData(*data, leftCount, rightCount));
 	}
 	else
 	{
 		// Executes the function on the range of data
-		(data->function)(data->data, data->count);
+		data->execute();
 	}
 }
 
@@ -73,18 +87,74 @@ struct parallelForJobData
 	    : data(data), count(count), function(function), splitter(splitter)
 	{}
 
+	/// Constructs the data for a sub-range of another job data
+	parallelForJobData(const parallelForJobData &other, unsigned int offset, unsigned int count)
+	    : data(other.data + offset), count(count), function(other.function), splitter(other.splitter)
+	{}
+
+	inline void execute() const { function(data, count); }
+
 	DataType *data;
 	unsigned int count;
 	void (*function)(DataType *, unsigned int);
 	SplitterType splitter;
 };
 
+/// The data for the parallel for job with a context shared by all the sub-ranges
+template <typename T, typename C, typename S>
+struct parallelForContextJobData
+{
+	typedef T DataType;
+	typedef S SplitterType;
+
+	parallelForContextJobData(DataType *data, unsigned int count, void (*function)(DataType *, unsigned int, C *),
+	                          C *context, const SplitterType &splitter)
+	    : data(data), function(function), context(context), count(count), splitter(splitter)
+	{}
+
+	/// Constructs the data for a sub-range of another job data
+	parallelForContextJobData(const parallelForContextJobData &other, unsigned int offset, unsigned int count)
+	    : data(other.data + offset), function(other.function), context(other.context), count(count), splitter(other.splitter)
+	{}
+
+	inline void execute() const { function(data, count, context); }
+
+	DataType *data;
+	void (*function)(DataType *, unsigned int, C *);
+	C *context;
+	unsigned int count;
+	SplitterType splitter;
+};
+
+/// The data for the parallel for job that calls a copy of a callable object, like a lambda, on every sub-range
+template <typename T, typename F, typename S>
+struct parallelForCallableJobData
+{
+	typedef T DataType;
+	typedef S SplitterType;
+
+	parallelForCallableJobData(DataType *data, unsigned int count, const F &function, const SplitterType &splitter)
+	    : data(data), count(count), function(function), splitter(splitter)
+	{}
+
+	/// Constructs the data for a sub-range of another job data
+	parallelForCallableJobData(const parallelForCallableJobData &other, unsigned int offset, unsigned int count)
+	    : data(other.data + offset), count(count), function(other.function), splitter(other.splitter)
+	{}
+
+	inline void execute() const { function(data, count); }
+
+	DataType *data;
+	unsigned int count;
+	F function;
+	SplitterType splitter;
+};
+
 /// Creates a parallel job to automatically divide data processing
 template <typename T, typename S>
 JobId parallelFor(T *data, unsigned int count, void (*function)(T *, unsigned int), const S &splitter)
 {
 	typedef parallelForJobData<T, S> JobData;
-	static_assert(sizeof(JobData) <= JobDataSize, "The embedded Job data buffer is too small for parallelFor");
 	const JobData jobData(data, count, function, splitter);
 
 	IJobSystem &jobSystem = theServiceLocator().jobSystem();
@@ -93,6 +163,35 @@ JobId parallelFor(T *data, unsigned int count, void (*function)(T *, unsigned in
 	return job;
 }
 
+/// Creates a parallel job to automatically divide data processing, passing the same context to every function call
+/*! \warning The context is not copied, it should be kept alive until the job has finished. */
+template <typename T, typename C, typename S>
+JobId parallelFor(T *data, unsigned int count, void (*function)(T *, unsigned int, C *), C *context, const S &splitter)
+{
+	typedef parallelForContextJobData<T, C, S> JobData;
+	const JobData jobData(data, count, function, context, splitter);
+
+	IJobSystem &jobSystem = theServiceLocator().jobSystem();
+	JobId job = jobSystem.createJob(&parallelForJob<JobData>, &jobData, sizeof(JobData));
+
+	return job;
+}
+
+/// Creates a parallel job to automatically divide data processing, calling a copy of a callable object on every sub-range
+/*! \note The callable is copied like any other job data, so it should be trivially copyable, like a lambda that only captures pointers and values.
+ *  \note The data of the job is stored in the job data arena of the calling thread if the callable does not fit the job. */
+template <typename T, typename F, typename S>
+JobId parallelFor(T *data, unsigned int count, const F &function, const S &splitter)
+{
+	typedef parallelForCallableJobData<T, F, S> JobData;
+	static_assert(nctl::isTriviallyCopyable<JobData>::value, "The callable of a parallelFor job should be trivially copyable");
+	const JobData jobData(data, count, function, splitter);
+
+	IJobSystem &jobSystem = theServiceLocator().jobSystem();
+	JobId job = jobSystem.createJob(&parallelForJob<JobData>, &jobData, sizeof(JobData));
+
+	return job;
+}
 }
 
 #endif
@@ -8,6 +8,7 @@
 namespace ncine {
 
 class Particle;
+class ParticleArrays;
 
 const unsigned int StepsInitialSize = 4;
 
@@ -33,6 +34,10 @@ class DLL_PUBLIC ParticleAffector
 	void affect(Particle *particle);
 	/// Affects a property of the specified particle, without calculating the normalized age
 	virtual void affect(Particle *particle, float normalizedAge) = 0;
+	/// Affects a property of the particle at the specified index of a structure of arrays
+	virtual void affect(ParticleArrays &particles, unsigned int index, float normalizedAge) = 0;
+	/// Affects a property of a span of particles of a structure of arrays, reading their precalculated normalized age
+	virtual void affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count);
 
 	/// Returns the affector type
 	inline Type type() const { return type_; }
@@ -87,6 +92,10 @@ class DLL_PUBLIC ColorAffector : public ParticleAffector
 
 	/// Affects the color of the specified particle
 	void affect(Particle *particle, float normalizedAge) override;
+	/// Affects the color of the particle at the specified index of a structure of arrays
+	void affect(ParticleArrays &particles, unsigned int index, float normalizedAge) override;
+	/// Affects the color of a span of particles of a structure of arrays
+	void affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count) override;
 	void addColorStep(float age, const Colorf &color);
 	inline void addColorStep(const ColorStep &step) { addColorStep(step.age, step.color); }
 
@@ -103,6 +112,9 @@ class DLL_PUBLIC ColorAffector : public ParticleAffector
 
   private:
 	nctl::Array<ColorStep> colorSteps_;
+
+	/// Returns the interpolated color at the specified normalized age
+	Colorf colorAt(float normalizedAge) const;
 };
 
 /// Particle size affector
@@ -147,6 +159,10 @@ class DLL_PUBLIC SizeAffector : public ParticleAffector
 
 	/// Affects the size of the specified particle
 	void affect(Particle *particle, float normalizedAge) override;
+	/// Affects the size of the particle at the specified index of a structure of arrays
+	void affect(ParticleArrays &particles, unsigned int index, float normalizedAge) override;
+	/// Affects the size of a span of particles of a structure of arrays
+	void affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count) override;
 	inline void addSizeStep(float age, float scale) { addSizeStep(age, scale, scale); }
 	void addSizeStep(float age, float scaleX, float scaleY);
 	inline void addSizeStep(float age, const Vector2f &scale) { addSizeStep(age, scale.x, scale.y); }
@@ -178,6 +194,9 @@ class DLL_PUBLIC SizeAffector : public ParticleAffector
   private:
 	nctl::Array<SizeStep> sizeSteps_;
 	Vector2f baseScale_;
+
+	/// Returns the interpolated scale factor at the specified normalized age, multiplied by the base one
+	Vector2f scaleAt(float normalizedAge) const;
 };
 
 /// Particle rotation affector
@@ -208,6 +227,10 @@ class DLL_PUBLIC RotationAffector : public ParticleAffector
 
 	/// Affects the rotation of the specified particle
 	void affect(Particle *particle, float normalizedAge) override;
+	/// Affects the rotation of the particle at the specified index of a structure of arrays
+	void affect(ParticleArrays &particles, unsigned int index, float normalizedAge) override;
+	/// Affects the rotation of a span of particles of a structure of arrays
+	void affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count) override;
 	void addRotationStep(float age, float angle);
 	inline void addRotationStep(const RotationStep &step) { addRotationStep(step.age, step.angle); }
 
@@ -224,6 +247,9 @@ class DLL_PUBLIC RotationAffector : public ParticleAffector
 
   private:
 	nctl::Array<RotationStep> rotationSteps_;
+
+	/// Returns the interpolated angle at the specified normalized age
+	float angleAt(float normalizedAge) const;
 };
 
 /// Particle position affector
@@ -254,6 +280,10 @@ class DLL_PUBLIC PositionAffector : public ParticleAffector
 
 	/// Affects the position of the specified particle
 	void affect(Particle *particle, float normalizedAge) override;
+	/// Affects the position of the particle at the specified index of a structure of arrays
+	void affect(ParticleArrays &particles, unsigned int index, float normalizedAge) override;
+	/// Affects the position of a span of particles of a structure of arrays
+	void affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count) override;
 	void addPositionStep(float age, float posX, float posY);
 	inline void addPositionStep(float age, const Vector2f &position) { addPositionStep(age, position.x, position.y); }
 	inline void addPositionStep(const PositionStep &step) { addPositionStep(step.age, step.position); }
@@ -271,6 +301,9 @@ class DLL_PUBLIC PositionAffector : public ParticleAffector
 
   private:
 	nctl::Array<PositionStep> positionSteps_;
+
+	/// Returns the interpolated position displacement at the specified normalized age
+	Vector2f positionAt(float normalizedAge) const;
 };
 
 /// Particle velocity affector
@@ -301,6 +334,10 @@ class DLL_PUBLIC VelocityAffector : public ParticleAffector
 
 	/// Affects the velocity of the specified particle
 	void affect(Particle *particle, float normalizedAge) override;
+	/// Affects the velocity of the particle at the specified index of a structure of arrays
+	void affect(ParticleArrays &particles, unsigned int index, float normalizedAge) override;
+	/// Affects the velocity of a span of particles of a structure of arrays
+	void affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count) override;
 	void addVelocityStep(float age, float velX, float velY);
 	inline void addVelocityStep(float age, const Vector2f &velocity) { addVelocityStep(age, velocity.x, velocity.y); }
 	inline void addVelocityStep(const VelocityStep &step) { addVelocityStep(step.age, step.velocity); }
@@ -318,6 +355,9 @@ class DLL_PUBLIC VelocityAffector : public ParticleAffector
 
   private:
 	nctl::Array<VelocityStep> velocitySteps_;
+
+	/// Returns the interpolated velocity increment at the specified normalized age
+	Vector2f velocityAt(float normalizedAge) const;
 };
 
 }
@@ -0,0 +1,91 @@
+#ifndef CLASS_NCINE_PARTICLEARRAYS
+#define CLASS_NCINE_PARTICLEARRAYS
+
+#include "common_defines.h"
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+/// The structure of arrays holding the properties of the particles of a `ParticleSystem`
+/*!
+ * Every property is stored in its own contiguous array of floats, with alive particles packed at the beginning.
+ * \note Arrays are padded to a multiple of four elements and can be processed four floats at a time.
+ */
+class DLL_PUBLIC ParticleArrays
+{
+  public:
+	/// Current particles remaining life in seconds
+	float *life;
+	/// Initial particles remaining life
+	float *startingLife;
+	/// Initial particles rotation
+	float *startingRotation;
+	/// Particles position on the X axis
+	float *positionX;
+	/// Particles position on the Y axis
+	float *positionY;
+	/// Particles velocity on the X axis
+	float *velocityX;
+	/// Particles velocity on the Y axis
+	float *velocityY;
+	/// Particles scale factor on the X axis
+	float *scaleX;
+	/// Particles scale factor on the Y axis
+	float *scaleY;
+	/// Particles rotation in degrees
+	float *rotation;
+	/// Particles red color component
+	float *colorR;
+	/// Particles green color component
+	float *colorG;
+	/// Particles blue color component
+	float *colorB;
+	/// Particles alpha color component
+	float *colorA;
+	/// Particles normalized age, calculated by the particle system before running the affectors
+	float *normalizedAge;
+
+	/// Creates empty arrays with zero capacity
+	ParticleArrays();
+	/// Creates arrays with the specified capacity
+	explicit ParticleArrays(unsigned int capacity);
+
+	/// Default move constructor
+	ParticleArrays(ParticleArrays &&) = default;
+	/// Default move assignment operator
+	ParticleArrays &operator=(ParticleArrays &&) = default;
+
+	/// Returns the maximum number of particles
+	inline unsigned int capacity() const { return capacity_; }
+	/// Returns the number of alive particles
+	inline unsigned int size() const { return size_; }
+	/// Returns true if there are no alive particles
+	inline bool isEmpty() const { return size_ == 0; }
+
+	/// Adds a new particle at the end of the alive ones and returns its index
+	/*! \note The properties of the new particle are not initialized */
+	unsigned int add();
+	/// Removes the particle at the specified index by moving the last alive particle in its place
+	void remove(unsigned int index);
+	/// Removes all alive particles
+	inline void clear() { size_ = 0; }
+
+  private:
+	static const unsigned int NumArrays = 15;
+
+	/// Maximum number of particles
+	unsigned int capacity_;
+	/// Number of alive particles
+	unsigned int size_;
+	/// The single allocation that backs every array
+	nctl::UniquePtr<float[]> buffer_;
+
+	/// Deleted copy constructor
+	ParticleArrays(const ParticleArrays &) = delete;
+	/// Deleted assignment operator
+	ParticleArrays &operator=(const ParticleArrays &) = delete;
+};
+
+}
+
+#endif
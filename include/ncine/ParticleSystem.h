@@ -7,21 +7,38 @@
 #include "SceneNode.h"
 #include "ParticleAffectors.h"
 #include "Particle.h"
+#include "ParticleArrays.h"
 #include "DrawableNode.h"
 
 namespace ncine {
 
 class Texture;
 struct ParticleInitializer;
+class ParticleInstances;
 
 /// The class representing a particle system
 class DLL_PUBLIC ParticleSystem : public SceneNode
 {
   public:
+	/// The way particles are stored and rendered
+	enum class StorageMode
+	{
+		/// Every particle is a sprite node with its own render command
+		NODES,
+		/// Particle properties are stored in a structure of arrays and rendered with a single instanced command
+		ARRAYS
+	};
+
+	/// The minimum number of alive particles for a parallel update to be used
+	static const unsigned int MinParallelUpdateParticles = 2048;
+
 	/// Constructs a particle system with the specified maximum amount of particles
 	ParticleSystem(SceneNode *parent, unsigned int count, Texture *texture);
 	/// Constructs a particle system with the specified maximum amount of particles and the specified texture rectangle
 	ParticleSystem(SceneNode *parent, unsigned int count, Texture *texture, Recti texRect);
+	/// Constructs a particle system with the specified maximum amount of particles, texture rectangle and storage mode
+	ParticleSystem(SceneNode *parent, unsigned int count, Texture *texture, Recti texRect, StorageMode storageMode);
+	~ParticleSystem() override;
 
 	/// Default move constructor
 	ParticleSystem(ParticleSystem &&);
@@ -45,9 +62,15 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	/// Returns the constant array of particle affectors
 	inline const nctl::Array<nctl::UniquePtr<ParticleAffector>> &affectors() const { return affectors_; }
 
+	/// Returns the storage mode of the particles
+	inline StorageMode storageMode() const { return storageMode_; }
+	/// Returns the structure of arrays holding the particles in `StorageMode::ARRAYS`
+	inline const ParticleArrays &particleArrays() const { return particleArrays_; }
+
 	/// Returns true if particles are positioned using the particle system as their origin
 	inline bool inLocalSpace(void) const { return inLocalSpace_; }
 	/// Sets or clears the local space flag, to move particles around the particle system or freely
+	/*! \note In `StorageMode::ARRAYS` the flag is applied to all particles at once, including the alive ones */
 	inline void setInLocalSpace(bool inLocalSpace) { inLocalSpace_ = inLocalSpace; }
 
 	/// Returns true if particles are updating
@@ -60,10 +83,16 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	/// Enables or disables affectors modifying particles properties
 	inline void setAffectorsEnabled(bool affectorsEnabled) { affectorsEnabled_ = affectorsEnabled; }
 
+	/// Returns true if alive particles are split in jobs and updated in parallel
+	inline bool isParallelUpdateEnabled(void) const { return parallelUpdateEnabled_; }
+	/// Enables or disables the parallel update of alive particles
+	/*! \note Jobs are only created when there are at least `MinParallelUpdateParticles` alive particles */
+	inline void setParallelUpdateEnabled(bool parallelUpdateEnabled) { parallelUpdateEnabled_ = parallelUpdateEnabled; }
+
 	/// Returns the total number of particles in the system
-	inline unsigned int numParticles() const { return particleArray_.size(); }
+	inline unsigned int numParticles() const { return (storageMode_ == StorageMode::NODES) ? particleArray_.size() : particleArrays_.capacity(); }
 	/// Returns the number of particles currently alive
-	inline unsigned int numAliveParticles() const { return particleArray_.size() - poolTop_ - 1; }
+	inline unsigned int numAliveParticles() const { return (storageMode_ == StorageMode::NODES) ? particleArray_.size() - poolTop_ - 1 : particleArrays_.size(); }
 
 	/// Sets the texture object for every particle in the system
 	void setTexture(Texture *texture);
@@ -97,6 +126,9 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	ParticleSystem(const ParticleSystem &other);
 
   private:
+	/// The storage mode of the particles
+	StorageMode storageMode_;
+
 	/// The particle pool size
 	unsigned int poolSize_;
 	/// The index of the next free particle in the pool
@@ -106,6 +138,11 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	/// The array containing every particle (dead or alive)
 	nctl::Array<nctl::UniquePtr<Particle>> particleArray_;
 
+	/// The structure of arrays containing alive particles in `StorageMode::ARRAYS`
+	ParticleArrays particleArrays_;
+	/// The child node that renders all particles in `StorageMode::ARRAYS`
+	nctl::UniquePtr<ParticleInstances> instances_;
+
 	/// The array of particle affectors
 	nctl::Array<nctl::UniquePtr<ParticleAffector>> affectors_;
 
@@ -114,6 +151,29 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 
 	bool particlesUpdateEnabled_;
 	bool affectorsEnabled_;
+	bool parallelUpdateEnabled_;
+
+	/// The data shared by all the jobs of a parallel update
+	struct UpdateJobContext;
+
+	/// Returns true if the alive particles should be updated by parallel jobs
+	bool shouldUpdateInParallel() const;
+
+	/// Applies the affectors to an alive particle node and updates it, returning false if it has just died
+	bool updateParticle(Particle *particle, float frameTime);
+	/// Updates the particle nodes in parallel jobs, returning false if the jobs could not be submitted
+	bool updateNodesInParallel(float frameTime);
+	/// The function executed by the parallel update jobs on a range of particle nodes
+	static void updateNodesJob(SceneNode **nodes, unsigned int count, UpdateJobContext *context);
+
+	/// Updates the particles stored in the structure of arrays
+	void updateArrays(float frameTime);
+	/// Applies the affectors to a range of particles in the structure of arrays and integrates their motion
+	void updateArraysRange(unsigned int first, unsigned int count, float frameTime);
+	/// Updates the particles in the structure of arrays in parallel jobs, returning false if the jobs could not be submitted
+	bool updateArraysInParallel(float frameTime);
+	/// The function executed by the parallel update jobs on a range of particles in the structure of arrays
+	static void updateArraysJob(float *lives, unsigned int count, UpdateJobContext *context);
 
 	/// Deleted assignment operator
 	ParticleSystem &operator=(const ParticleSystem &) = delete;
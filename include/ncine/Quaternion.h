@@ -220,6 +220,34 @@ inline Quaternion<T> Quaternion<T>::operator*(const Quaternion &q) const
 	                  w * q.w - x * q.x - y * q.y - z * q.z);
 }
 
+// The generic versions are the scalar fallback for the float specializations
+#if NCINE_SIMD_FLOAT4
+
+template <>
+inline Quaternion<float> Quaternion<float>::operator*(const Quaternion &q) const
+{
+	const simd::Float4 q0 = simd::load(data());
+	const simd::Float4 q1 = simd::load(q.data());
+
+	// Each element of the first quaternion multiplies a permutation of the second one, with alternating signs
+	simd::Float4 r = simd::mul(simd::broadcast<3>(q0), q1);
+	r = simd::add(r, simd::mul(simd::mul(simd::broadcast<0>(q0), simd::reverse(q1)), simd::set(1.0f, -1.0f, 1.0f, -1.0f)));
+	r = simd::add(r, simd::mul(simd::mul(simd::broadcast<1>(q0), simd::swapHalves(q1)), simd::set(1.0f, 1.0f, -1.0f, -1.0f)));
+	r = simd::add(r, simd::mul(simd::mul(simd::broadcast<2>(q0), simd::swapPairs(q1)), simd::set(-1.0f, 1.0f, 1.0f, -1.0f)));
+
+	Quaternion result;
+	simd::store(result.data(), r);
+	return result;
+}
+
+template <>
+inline Quaternion<float> &Quaternion<float>::operator*=(const Quaternion &q)
+{
+	return (*this = *this * q);
+}
+
+#endif
+
 template <class T>
 inline Quaternion<T> Quaternion<T>::operator*(T s) const
 {
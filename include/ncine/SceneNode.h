@@ -1,11 +1,14 @@
 #ifndef CLASS_NCINE_SCENENODE
 #define CLASS_NCINE_SCENENODE
 
+#include <ncine/config.h>
 #include "Object.h"
 #include <nctl/Array.h>
 #include <nctl/BitSet.h>
+#include <nctl/UniquePtr.h>
 #include "Vector2.h"
 #include "Matrix4x4.h"
+#include "AffineTransform2D.h"
 #include "Color.h"
 #include "Colorf.h"
 
@@ -13,6 +16,7 @@ namespace ncine {
 
 class RenderQueue;
 class Viewport;
+struct FrozenCommands;
 
 /// The base class for the transformation nodes hierarchy
 class DLL_PUBLIC SceneNode : public Object
@@ -82,13 +86,15 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Returns true if the node visit order is used together with the layer
 	inline enum VisitOrderState visitOrderState() const { return visitOrderState_; }
 	/// Enables the use of the node visit order together with the layer
-	inline void setVisitOrderState(enum VisitOrderState visitOrderState) { visitOrderState_ = visitOrderState; }
+	void setVisitOrderState(enum VisitOrderState visitOrderState);
 	/// Returns the visit drawing order of the node
 	inline uint16_t visitOrderIndex() const { return visitOrderIndex_; }
 
 	/// Called once every frame to update the node
+	/*! \note When parallel update is enabled, sibling subtrees might be updated concurrently by different threads. */
 	virtual void update(float frameTime);
 	/// Draws the node and visits its children
+	/*! \note The linear traversal of a scene does not call this method, except for always updated and frozen nodes */
 	virtual void visit(RenderQueue &renderQueue, unsigned int &visitOrderIndex);
 	/// Renders the node
 	virtual bool draw(RenderQueue &renderQueue) { return false; }
@@ -97,10 +103,29 @@ class DLL_PUBLIC SceneNode : public Object
 	inline bool isUpdateEnabled() const { return updateEnabled_; }
 	/// Enables or disables node updating
 	inline void setUpdateEnabled(bool updateEnabled) { updateEnabled_ = updateEnabled; }
+	/// Returns true if the node is updated every frame, even when nothing has changed in its subtree
+	inline bool isAlwaysUpdated() const { return alwaysUpdated_; }
+	/// Sets whether the node is updated every frame, even when nothing has changed in its subtree
+	/*! \note It should be enabled for nodes that override the `update()` method, as their subtree might otherwise be skipped
+	 *  when the skipping of clean subtrees is enabled, and the method would not be called by the linear traversal.
+	 *  The subtree of an always updated node is updated and visited recursively by the node itself. */
+	void setAlwaysUpdated(bool alwaysUpdated);
+	/// Returns true if the render commands of the subtree are recorded once and replayed until the subtree changes
+	inline bool isFrozen() const { return frozen_; }
+	/// Sets whether the render commands of the subtree are recorded once and replayed until the subtree changes
+	/*! \note The visit of a frozen subtree and the sorting of its commands are skipped until the drawing of a node in it changes,
+	 *  like its transformation, color, size, texture, blending or visibility, or until a node is added to or removed from it.
+	 *  Changes made directly to a render command or a material, like the values of custom uniforms, need a call to `invalidateFrozenCommands()`. */
+	void setFrozen(bool frozen);
+	/// Discards the recorded render commands of a frozen node, so that they are recorded again by the next visit
+	void invalidateFrozenCommands();
+	/// Returns true if the node is frozen and the render commands recorded by its last visit have not been discarded since then
+	/*! \note The commands are replayed by the next visit if it is made by the same viewport, with the same culling rectangle. */
+	bool hasRecordedCommands() const;
 	/// Returns true if the node is drawing
 	inline bool isDrawEnabled() const { return drawEnabled_; }
 	/// Enables or disables node drawing
-	inline void setDrawEnabled(bool drawEnabled) { drawEnabled_ = drawEnabled; }
+	void setDrawEnabled(bool drawEnabled);
 	/// Returns true if the node is both updating and drawing
 	inline bool isEnabled() const { return (updateEnabled_ == true && drawEnabled_ == true); }
 	/// Enables or disables both node updating and drawing
@@ -181,16 +206,30 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Sets the node rendering layer
 	/*! \note The lowest value (bottom) is 0 and the highest one (top) is 65535.
 	 *  When the value is 0, the final layer value is inherited from the parent. */
-	void setLayer(uint16_t layer) { layer_ = layer; }
+	void setLayer(uint16_t layer);
 
+#if NCINE_WITH_COMPACT_TRANSFORMS
+	/// Gets the node world matrix, expanded from the stored 2D affine transformation
+	inline Matrix4x4f worldMatrix() const { return worldMatrix_.toMatrix4x4(); }
+#else
 	/// Gets the node world matrix
 	inline const Matrix4x4f &worldMatrix() const { return worldMatrix_; }
+#endif
 	/// Sets the node world matrix (only useful when called inside `onPostUpdate()`)
+	/*! \note Only the 2D part of the matrix is kept when compact transformations are enabled */
 	void setWorldMatrix(const Matrix4x4f &worldMatrix);
+	/// Gets the 2D affine part of the node world matrix
+	inline AffineTransform2Df worldTransform() const { return AffineTransform2Df(worldMatrix_); }
 
+#if NCINE_WITH_COMPACT_TRANSFORMS
+	/// Gets the node local matrix, expanded from the stored 2D affine transformation
+	inline Matrix4x4f localMatrix() const { return localMatrix_.toMatrix4x4(); }
+#else
 	/// Gets the node local matrix
 	inline const Matrix4x4f &localMatrix() const { return localMatrix_; }
+#endif
 	/// Sets the node local matrix
+	/*! \note Only the 2D part of the matrix is kept when compact transformations are enabled */
 	void setLocalMatrix(const Matrix4x4f &localMatrix);
 
 	/// Gets the delete children on destruction flag
@@ -218,10 +257,19 @@ class DLL_PUBLIC SceneNode : public Object
 		// They are both used for OpenGL GPU uploading.
 		TransformationUploadBit = 5,
 		ColorUploadBit = 6,
+		// Set on the node and its ancestors by any change that needs an update, reset by `SceneNode::update()`
+		// when nothing in the subtree needs to be updated anymore. It is only reset if clean subtrees are skipped.
+		SubtreeBit = 7
 	};
 
 	bool updateEnabled_;
 	bool drawEnabled_;
+	/// When enabled the node is updated every frame, even if nothing has changed in its subtree
+	bool alwaysUpdated_;
+	/// When enabled the render commands of the subtree are recorded once and replayed until the subtree changes
+	bool frozen_;
+	/// The render commands recorded by the last visit of a frozen node
+	nctl::UniquePtr<FrozenCommands> frozenCommands_;
 
 	/// A pointer to the parent node
 	SceneNode *parent_;
@@ -272,19 +320,31 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Absolute node rendering layer as calculated by the `transform()` function
 	uint16_t absLayer_;
 
+#if NCINE_WITH_COMPACT_TRANSFORMS
+	/// The type of the node matrices, only storing their 2D affine part
+	using NodeMatrix = AffineTransform2Df;
+#else
+	/// The type of the node matrices
+	using NodeMatrix = Matrix4x4f;
+#endif
+
 	/// World transformation matrix (calculated from local and parent's world)
-	Matrix4x4f worldMatrix_;
+	NodeMatrix worldMatrix_;
 	/// Local transformation matrix
-	Matrix4x4f localMatrix_;
+	NodeMatrix localMatrix_;
 
 	/// A flag indicating whether the destructor should also delete all children
 	bool shouldDeleteChildrenOnDestruction_;
 
 	/// Bitset that stores the various dirty states bits
 	nctl::BitSet<uint8_t> dirtyBits_;
+	/// Set when the matrices have been calculated by the batched transformation of the parent, reset by `transform()`
+	bool transformedInBatch_;
 
 	/// The last frame any viewport updated this node
 	unsigned long int lastFrameUpdated_;
+	/// The last frame the spatial index found a node of this subtree overlapping any viewport
+	unsigned long int lastFrameSubtreeRendered_;
 
 	/// Deleted assignment operator
 	SceneNode &operator=(const SceneNode &) = delete;
@@ -298,7 +358,45 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Called right after the anchor point has been set directly as an absolute value
 	virtual void absAnchorPointHasChanged() {}
 
+	/// Marks the transformation as dirty, together with the bounding box and the subtree
+	void setTransformationDirty();
+	/// Marks the color as dirty, together with the subtree
+	void setColorDirty();
+	/// Marks this node and its ancestors as having a change in their subtree that needs an update
+	void setSubtreeDirty();
+	/// Returns true if the parent has a dirty transformation or color that this node should inherit during the update
+	bool inheritsDirtyState() const;
+	/// Discards the recorded render commands of this node and of its ancestors that are frozen, as the drawing of this node has changed
+	void drawingHasChanged();
+
+	/// Marks this node and its ancestors as having a node in their subtree that overlaps a viewport in the specified frame
+	void setSubtreeRendered(unsigned long int frame);
+	/// Returns true if the visit of the subtree is skipped, as the spatial index has found no node in it overlapping a viewport
+	bool skipVisitIfCulled() const;
+	/// Returns true if the update of the subtree is skipped, as nothing has changed in it
+	bool skipUpdateIfClean(bool skipCleanSubtrees);
+	/// Transforms the node before its children are updated
+	void beginUpdate();
+	/// Resets the dirty bits of the node after its children have been updated
+	void endUpdate(bool skipCleanSubtrees);
+	/// Draws the node and assigns its visit order index, without visiting the children
+	void visitNode(RenderQueue &renderQueue, unsigned int &visitOrderIndex);
+
 	virtual void transform();
+	/// Updates all children, either serially or splitting sibling subtrees into parallel jobs
+	void updateChildren(float frameTime);
+	/// Calculates the matrices of the children with a dirty transformation in a single vectorized pass
+	void transformChildrenInBatch(unsigned int minBatchSize);
+
+  private:
+	/// Returns a number that changes every time the topology of a linearized scene might have changed
+	static unsigned int topologyVersion();
+	/// Records a change in the children of this node, unless it happens in a subtree that is not linearized
+	void topologyHasChanged();
+	/// Replays the recorded render commands of a frozen node, or records them again by visiting its subtree
+	void visitFrozen(RenderQueue &renderQueue, unsigned int &visitOrderIndex);
+
+	friend class SceneTraversal;
 };
 
 inline const nctl::Array<const SceneNode *> &SceneNode::children() const
@@ -309,158 +407,193 @@ inline const nctl::Array<const SceneNode *> &SceneNode::children() const
 inline void SceneNode::setEnabled(bool enabled)
 {
 	updateEnabled_ = enabled;
-	drawEnabled_ = enabled;
+	setDrawEnabled(enabled);
+}
+
+inline void SceneNode::setVisitOrderState(enum VisitOrderState visitOrderState)
+{
+	visitOrderState_ = visitOrderState;
+	// The visit order flag is derived by the children during their update, like a transformation
+	dirtyBits_.set(DirtyBitPositions::TransformationBit);
+	setSubtreeDirty();
+}
+
+inline void SceneNode::setLayer(uint16_t layer)
+{
+	layer_ = layer;
+	// The absolute layer is inherited by the children during their update, like a transformation
+	dirtyBits_.set(DirtyBitPositions::TransformationBit);
+	setSubtreeDirty();
 }
 
 inline void SceneNode::setPosition(float x, float y)
 {
 	position_.set(x, y);
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::setPosition(const Vector2f &position)
 {
 	position_ = position;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::setPositionX(float x)
 {
 	position_.x = x;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::setPositionY(float y)
 {
 	position_.y = y;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::move(float x, float y)
 {
 	position_.x += x;
 	position_.y += y;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::move(const Vector2f &position)
 {
 	position_ += position;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::moveX(float x)
 {
 	position_.x += x;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::moveY(float y)
 {
 	position_.y += y;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::setAbsAnchorPoint(float x, float y)
 {
 	anchorPoint_.set(x, y);
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 	absAnchorPointHasChanged();
 }
 
 inline void SceneNode::setAbsAnchorPoint(const Vector2f &point)
 {
 	anchorPoint_ = point;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 	absAnchorPointHasChanged();
 }
 
 inline void SceneNode::setScale(float scaleFactor)
 {
 	scaleFactor_.set(scaleFactor, scaleFactor);
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::setScale(float scaleFactorX, float scaleFactorY)
 {
 	scaleFactor_.set(scaleFactorX, scaleFactorY);
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::setScale(const Vector2f &scaleFactor)
 {
 	scaleFactor_ = scaleFactor;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::setRotation(float rotation)
 {
 	rotation_ = fmodf(rotation, 360.0f);
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 }
 
 inline void SceneNode::setColor(Color color)
 {
 	color_ = color;
-	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	setColorDirty();
 }
 
 inline void SceneNode::setColorF(Colorf color)
 {
 	color_ = color;
-	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	setColorDirty();
 }
 
 inline void SceneNode::setColor(unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha)
 {
 	color_.set(red, green, blue, alpha);
-	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	setColorDirty();
 }
 
 inline void SceneNode::setColorF(float red, float green, float blue, float alpha)
 {
 	color_ = Colorf(red, green, blue, alpha);
-	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	setColorDirty();
 }
 
 inline void SceneNode::setAlpha(unsigned char alpha)
 {
 	color_.setAlpha(alpha);
-	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	setColorDirty();
 }
 
 inline void SceneNode::setAlphaF(float alpha)
 {
 	color_.setAlpha(static_cast<unsigned char>(alpha * 255));
-	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	setColorDirty();
 }
 
 inline void SceneNode::setWorldMatrix(const Matrix4x4f &worldMatrix)
 {
-	worldMatrix_ = worldMatrix;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	worldMatrix_ = NodeMatrix(worldMatrix);
+	setTransformationDirty();
 }
 
 inline void SceneNode::setLocalMatrix(const Matrix4x4f &localMatrix)
 {
-	localMatrix_ = localMatrix;
+	localMatrix_ = NodeMatrix(localMatrix);
+	setTransformationDirty();
+}
+
+inline void SceneNode::setTransformationDirty()
+{
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setSubtreeDirty();
+}
+
+inline void SceneNode::setColorDirty()
+{
+	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	setSubtreeDirty();
+}
+
+/*! \note The walk stops at the first marked ancestor, as all of its ancestors are marked as well */
+inline void SceneNode::setSubtreeDirty()
+{
+	dirtyBits_.set(DirtyBitPositions::SubtreeBit);
+	for (SceneNode *node = parent_; node != nullptr && node->dirtyBits_.test(DirtyBitPositions::SubtreeBit) == false; node = node->parent_)
+		node->dirtyBits_.set(DirtyBitPositions::SubtreeBit);
+	drawingHasChanged();
+}
+
+/*! \note The walk stops at the first marked ancestor, as all of its ancestors are marked as well */
+inline void SceneNode::setSubtreeRendered(unsigned long int frame)
+{
+	for (SceneNode *node = this; node != nullptr && node->lastFrameSubtreeRendered_ < frame; node = node->parent_)
+		node->lastFrameSubtreeRendered_ = frame;
+}
+
+inline bool SceneNode::inheritsDirtyState() const
+{
+	return (parent_ != nullptr && (parent_->dirtyBits_.test(DirtyBitPositions::TransformationBit) ||
+	                               parent_->dirtyBits_.test(DirtyBitPositions::ColorBit)));
 }
 
 }
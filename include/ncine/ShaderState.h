@@ -4,17 +4,41 @@
 #include "common_defines.h"
 #include "Vector4.h"
 #include "Colorf.h"
+#include <nctl/Array.h>
+#include <nctl/String.h>
 
 namespace ncine {
 
 class DrawableNode;
 class Shader;
 class Texture;
+class GLUniformCache;
+class GLUniformBlockCache;
 
 /// Shader state class for the user to use custom shaders
 class DLL_PUBLIC ShaderState
 {
   public:
+	/// A handle to a uniform or to a uniform block, resolved by name only once
+	/*! \note A handle stays valid when the node or the shader change, as it is resolved again on the new material */
+	class UniformHandle
+	{
+	  public:
+		UniformHandle()
+		    : index_(-1) {}
+
+		/// Returns true if the handle has been returned by a shader state
+		inline bool isValid() const { return index_ >= 0; }
+
+	  private:
+		explicit UniformHandle(int index)
+		    : index_(index) {}
+
+		int index_;
+
+		friend class ShaderState;
+	};
+
 	ShaderState();
 	/// Constructs a shader state object and assigns to it a node and a shader
 	ShaderState(DrawableNode *node, Shader *shader);
@@ -69,11 +93,72 @@ class DLL_PUBLIC ShaderState
 	bool copyToUniformBlock(const char *blockName, unsigned char *src, unsigned int numBytes);
 	bool copyToUniformBlock(const char *blockName, unsigned char *src);
 
+	/// Returns a handle to a uniform, to set its value without looking it up by name each time
+	UniformHandle uniformHandle(const char *blockName, const char *name);
+	/// Returns a handle to a uniform block, to copy data to it without looking it up by name each time
+	UniformHandle uniformBlockHandle(const char *blockName);
+
+	bool setUniformInt(UniformHandle handle, const int *vector);
+	bool setUniformInt(UniformHandle handle, int value0);
+	bool setUniformInt(UniformHandle handle, int value0, int value1);
+	bool setUniformInt(UniformHandle handle, int value0, int value1, int value2);
+	bool setUniformInt(UniformHandle handle, int value0, int value1, int value2, int value3);
+
+	bool setUniformInt(UniformHandle handle, const Vector2i &vector);
+	bool setUniformInt(UniformHandle handle, const Vector3i &vector);
+	bool setUniformInt(UniformHandle handle, const Vector4i &vector);
+
+	bool setUniformUint(UniformHandle handle, const unsigned int *vector);
+	bool setUniformUint(UniformHandle handle, unsigned int value0);
+	bool setUniformUint(UniformHandle handle, unsigned int value0, unsigned int value1);
+	bool setUniformUint(UniformHandle handle, unsigned int value0, unsigned int value1, unsigned int value2);
+	bool setUniformUint(UniformHandle handle, unsigned int value0, unsigned int value1, unsigned int value2, unsigned int value3);
+
+	bool setUniformFloat(UniformHandle handle, const float *vector);
+	bool setUniformFloat(UniformHandle handle, float value0);
+	bool setUniformFloat(UniformHandle handle, float value0, float value1);
+	bool setUniformFloat(UniformHandle handle, float value0, float value1, float value2);
+	bool setUniformFloat(UniformHandle handle, float value0, float value1, float value2, float value3);
+
+	bool setUniformFloat(UniformHandle handle, const Vector2f &vector);
+	bool setUniformFloat(UniformHandle handle, const Vector3f &vector);
+	bool setUniformFloat(UniformHandle handle, const Vector4f &vector);
+	bool setUniformFloat(UniformHandle handle, const Colorf &color);
+
+	unsigned int uniformBlockSize(UniformHandle handle);
+	bool copyToUniformBlock(UniformHandle handle, unsigned int destIndex, unsigned char *src, unsigned int numBytes);
+	bool copyToUniformBlock(UniformHandle handle, unsigned char *src, unsigned int numBytes);
+	bool copyToUniformBlock(UniformHandle handle, unsigned char *src);
+
   private:
 	DrawableNode *node_;
 	Shader *shader_;
 	int previousShaderType_;
 
+	/// The names of a uniform or of a uniform block requested through a handle, together with their resolved caches
+	struct ResolvedUniform
+	{
+		ResolvedUniform()
+		    : uniform(nullptr), uniformBlock(nullptr) {}
+
+		nctl::String blockName;
+		nctl::String name;
+		GLUniformCache *uniform;
+		GLUniformBlockCache *uniformBlock;
+	};
+
+	/// The array of uniforms and uniform blocks requested through handles
+	nctl::Array<ResolvedUniform> resolvedUniforms_;
+
+	/// Resolves all handles again on the material of the current node
+	void resolveUniforms();
+	/// Resolves the handle at the specified index on the material of the current node
+	void resolveUniform(unsigned int index);
+	/// Returns the uniform cache associated with a handle, if any
+	GLUniformCache *handleUniform(UniformHandle handle);
+	/// Returns the uniform block cache associated with a handle, if any
+	GLUniformBlockCache *handleUniformBlock(UniformHandle handle);
+
 	/// Deleted copy constructor
 	ShaderState(const ShaderState &) = delete;
 	/// Deleted assignment operator
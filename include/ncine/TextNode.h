@@ -8,7 +8,6 @@
 
 namespace ncine {
 
-class GLUniformBlockCache;
 class FontGlyph;
 
 /// A scene node to draw a text label
@@ -159,8 +158,6 @@ class DLL_PUBLIC TextNode : public DrawableNode
 	/// The amount of whitespaces displayed where a "tab" character is encountered
 	unsigned int tabSize_;
 
-	GLUniformBlockCache *instanceBlock_;
-
 	/// Deleted assignment operator
 	TextNode &operator=(const TextNode &) = delete;
 
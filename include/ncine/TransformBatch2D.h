@@ -0,0 +1,106 @@
+#ifndef CLASS_NCINE_TRANSFORMBATCH2D
+#define CLASS_NCINE_TRANSFORMBATCH2D
+
+#include "common_defines.h"
+#include <nctl/UniquePtr.h>
+#include "Matrix4x4.h"
+
+namespace ncine {
+
+/// The structure of arrays used to calculate the 2D affine matrices of many sibling nodes in a single pass
+/*! The transformation properties of the nodes are written in the input arrays, then `transform()` calculates
+ *  the local and world matrices of every node with loops that the compiler can vectorize.
+ *  \note Sine and cosine are approximated with polynomials. The results are the same of `SceneNode::transform()` within
+ *  a small tolerance, when rotations are in the range kept by `SceneNode::setRotation()`. */
+class DLL_PUBLIC TransformBatch2D
+{
+  public:
+	/// Nodes position on the X axis
+	float *positionX;
+	/// Nodes position on the Y axis
+	float *positionY;
+	/// Nodes rotation in degrees
+	float *rotation;
+	/// Nodes scale factor on the X axis
+	float *scaleX;
+	/// Nodes scale factor on the Y axis
+	float *scaleY;
+	/// Nodes anchor point on the X axis, in pixels
+	float *anchorX;
+	/// Nodes anchor point on the Y axis, in pixels
+	float *anchorY;
+
+	/// Creates empty arrays with zero capacity
+	TransformBatch2D();
+	/// Creates arrays with the specified capacity
+	explicit TransformBatch2D(unsigned int capacity);
+
+	/// Default move constructor
+	TransformBatch2D(TransformBatch2D &&) = default;
+	/// Default move assignment operator
+	TransformBatch2D &operator=(TransformBatch2D &&) = default;
+
+	/// Returns the maximum number of nodes before the arrays need to grow
+	inline unsigned int capacity() const { return capacity_; }
+	/// Returns the number of nodes in the batch
+	inline unsigned int size() const { return size_; }
+
+	/// Sets the number of nodes in the batch, growing the arrays if needed
+	/*! \note The content of the arrays is not preserved when they grow */
+	void resize(unsigned int size);
+
+	/// Calculates the local and world matrices of every node in the batch from the world matrix of their parent
+	void transform(const Matrix4x4f &parentWorldMatrix);
+
+	/// Returns the local matrix of the node at the specified index, as calculated by `transform()`
+	Matrix4x4f localMatrix(unsigned int index) const;
+	/// Returns the world matrix of the node at the specified index, as calculated by `transform()`
+	Matrix4x4f worldMatrix(unsigned int index) const;
+
+  private:
+	static const unsigned int NumInputArrays = 7;
+	/// The four 2D elements of the local matrices plus their translation
+	static const unsigned int NumLocalArrays = 6;
+	/// The first, second and fourth columns of the world matrices
+	static const unsigned int NumWorldArrays = 12;
+	static const unsigned int NumArrays = NumInputArrays + NumLocalArrays + NumWorldArrays;
+
+	/// Maximum number of nodes
+	unsigned int capacity_;
+	/// Number of nodes in the batch
+	unsigned int size_;
+	/// The single allocation that backs every array
+	nctl::UniquePtr<float[]> buffer_;
+
+	/// The elements of the local matrices that are not constant
+	float *local_[NumLocalArrays];
+	/// The elements of the world matrices that depend on the local ones
+	float *world_[NumWorldArrays];
+	/// The third column of the world matrices, copied from the parent one
+	Vector4f worldColumn2_;
+
+	/// Deleted copy constructor
+	TransformBatch2D(const TransformBatch2D &) = delete;
+	/// Deleted assignment operator
+	TransformBatch2D &operator=(const TransformBatch2D &) = delete;
+};
+
+inline Matrix4x4f TransformBatch2D::localMatrix(unsigned int index) const
+{
+	return Matrix4x4f(Vector4f(local_[0][index], local_[1][index], 0.0f, 0.0f),
+	                  Vector4f(local_[2][index], local_[3][index], 0.0f, 0.0f),
+	                  Vector4f(0.0f, 0.0f, 1.0f, 0.0f),
+	                  Vector4f(local_[4][index], local_[5][index], 0.0f, 1.0f));
+}
+
+inline Matrix4x4f TransformBatch2D::worldMatrix(unsigned int index) const
+{
+	return Matrix4x4f(Vector4f(world_[0][index], world_[1][index], world_[2][index], world_[3][index]),
+	                  Vector4f(world_[4][index], world_[5][index], world_[6][index], world_[7][index]),
+	                  worldColumn2_,
+	                  Vector4f(world_[8][index], world_[9][index], world_[10][index], world_[11][index]));
+}
+
+}
+
+#endif
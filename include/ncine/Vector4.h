@@ -4,6 +4,7 @@
 #include <cstddef>
 #include "Vector2.h"
 #include "Vector3.h"
+#include "simd.h"
 
 namespace ncine {
 
@@ -415,6 +416,139 @@ inline S dot(const Vector4<S> &v1, const Vector4<S> &v2)
 	                      v1.w * v2.w);
 }
 
+// The generic versions are the scalar fallback for the float specializations
+#if NCINE_SIMD_FLOAT4
+
+template <>
+inline Vector4<float> &Vector4<float>::operator+=(const Vector4 &v)
+{
+	simd::store(data(), simd::add(simd::load(data()), simd::load(v.data())));
+	return *this;
+}
+
+template <>
+inline Vector4<float> &Vector4<float>::operator-=(const Vector4 &v)
+{
+	simd::store(data(), simd::sub(simd::load(data()), simd::load(v.data())));
+	return *this;
+}
+
+template <>
+inline Vector4<float> &Vector4<float>::operator*=(const Vector4 &v)
+{
+	simd::store(data(), simd::mul(simd::load(data()), simd::load(v.data())));
+	return *this;
+}
+
+template <>
+inline Vector4<float> &Vector4<float>::operator/=(const Vector4 &v)
+{
+	simd::store(data(), simd::div(simd::load(data()), simd::load(v.data())));
+	return *this;
+}
+
+template <>
+inline Vector4<float> &Vector4<float>::operator+=(float s)
+{
+	simd::store(data(), simd::add(simd::load(data()), simd::splat(s)));
+	return *this;
+}
+
+template <>
+inline Vector4<float> &Vector4<float>::operator-=(float s)
+{
+	simd::store(data(), simd::sub(simd::load(data()), simd::splat(s)));
+	return *this;
+}
+
+template <>
+inline Vector4<float> &Vector4<float>::operator*=(float s)
+{
+	simd::store(data(), simd::mul(simd::load(data()), simd::splat(s)));
+	return *this;
+}
+
+template <>
+inline Vector4<float> &Vector4<float>::operator/=(float s)
+{
+	simd::store(data(), simd::div(simd::load(data()), simd::splat(s)));
+	return *this;
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator+(const Vector4 &v) const
+{
+	Vector4 result;
+	simd::store(result.data(), simd::add(simd::load(data()), simd::load(v.data())));
+	return result;
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator-(const Vector4 &v) const
+{
+	Vector4 result;
+	simd::store(result.data(), simd::sub(simd::load(data()), simd::load(v.data())));
+	return result;
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator*(const Vector4 &v) const
+{
+	Vector4 result;
+	simd::store(result.data(), simd::mul(simd::load(data()), simd::load(v.data())));
+	return result;
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator/(const Vector4 &v) const
+{
+	Vector4 result;
+	simd::store(result.data(), simd::div(simd::load(data()), simd::load(v.data())));
+	return result;
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator+(float s) const
+{
+	Vector4 result;
+	simd::store(result.data(), simd::add(simd::load(data()), simd::splat(s)));
+	return result;
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator-(float s) const
+{
+	Vector4 result;
+	simd::store(result.data(), simd::sub(simd::load(data()), simd::splat(s)));
+	return result;
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator*(float s) const
+{
+	Vector4 result;
+	simd::store(result.data(), simd::mul(simd::load(data()), simd::splat(s)));
+	return result;
+}
+
+template <>
+inline Vector4<float> Vector4<float>::operator/(float s) const
+{
+	Vector4 result;
+	simd::store(result.data(), simd::div(simd::load(data()), simd::splat(s)));
+	return result;
+}
+
+template <>
+inline Vector4<float> operator*(float s, const Vector4<float> &v)
+{
+	Vector4<float> result;
+	simd::store(result.data(), simd::mul(simd::splat(s), simd::load(v.data())));
+	return result;
+}
+
+#endif
+
 template <class T>
 const Vector4<T> Vector4<T>::Zero(0, 0, 0, 0);
 template <class T>
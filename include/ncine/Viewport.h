@@ -14,6 +14,7 @@ namespace ncine {
 class SceneNode;
 class Camera;
 class RenderQueue;
+class SceneTraversal;
 class GLFramebufferObject;
 class Texture;
 
@@ -198,6 +199,8 @@ class DLL_PUBLIC Viewport
 
 	/// The root scene node for this viewport/RT
 	SceneNode *rootNode_;
+	/// The linearized traversal of the scene of the root node
+	nctl::UniquePtr<SceneTraversal> sceneTraversal_;
 
 	/// The camera used by this viewport
 	/*! \note If set to `nullptr` it will use the default camera */
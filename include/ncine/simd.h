@@ -0,0 +1,119 @@
+#ifndef NCINE_SIMD
+#define NCINE_SIMD
+
+#include <ncine/config.h>
+
+#if NCINE_WITH_SIMD
+	#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+		#include <xmmintrin.h>
+		#define NCINE_SIMD_SSE 1
+	// The 32-bit NEON instruction set has no vector division and it is not used
+	#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (defined(__aarch64__) || defined(_M_ARM64))
+		#include <arm_neon.h>
+		#define NCINE_SIMD_NEON 1
+	#endif
+#endif
+
+#if defined(NCINE_SIMD_SSE) || defined(NCINE_SIMD_NEON)
+	/// Defined when `Vector4f`, `Matrix4x4f` and `Quaternionf` operations use SIMD instructions
+	#define NCINE_SIMD_FLOAT4 1
+#endif
+
+namespace ncine {
+
+/// Thin wrappers around the SIMD instructions used by the float math classes
+namespace simd {
+
+	/// Returns the name of the instruction set used by the float math classes
+	inline const char *instructionSet()
+	{
+#if defined(NCINE_SIMD_SSE)
+		return "SSE";
+#elif defined(NCINE_SIMD_NEON)
+		return "NEON";
+#else
+		return "None";
+#endif
+	}
+
+#if defined(NCINE_SIMD_SSE)
+	using Float4 = __m128;
+
+	/// Loads four floats from memory that does not need to be aligned
+	inline Float4 load(const float *values) { return _mm_loadu_ps(values); }
+	/// Stores four floats to memory that does not need to be aligned
+	inline void store(float *values, Float4 v) { _mm_storeu_ps(values, v); }
+	/// Returns a vector with the specified four values
+	inline Float4 set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+	/// Returns a vector with the same value in every element
+	inline Float4 splat(float s) { return _mm_set1_ps(s); }
+
+	inline Float4 add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+	inline Float4 sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+	inline Float4 mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+	inline Float4 div(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+
+	/// Returns a vector with the element at the specified index in every element
+	template <int Index>
+	inline Float4 broadcast(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Index, Index, Index, Index)); }
+	/// Returns the elements in reverse order (`wzyx`)
+	inline Float4 reverse(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3)); }
+	/// Returns the elements with the two halves swapped (`zwxy`)
+	inline Float4 swapHalves(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)); }
+	/// Returns the elements with each pair swapped (`yxwz`)
+	inline Float4 swapPairs(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+	/// Transposes the four by four matrix made by the four vectors
+	inline void transpose(Float4 &v0, Float4 &v1, Float4 &v2, Float4 &v3) { _MM_TRANSPOSE4_PS(v0, v1, v2, v3); }
+#elif defined(NCINE_SIMD_NEON)
+	using Float4 = float32x4_t;
+
+	/// Loads four floats from memory that does not need to be aligned
+	inline Float4 load(const float *values) { return vld1q_f32(values); }
+	/// Stores four floats to memory that does not need to be aligned
+	inline void store(float *values, Float4 v) { vst1q_f32(values, v); }
+	/// Returns a vector with the specified four values
+	inline Float4 set(float x, float y, float z, float w)
+	{
+		const float values[4] = { x, y, z, w };
+		return vld1q_f32(values);
+	}
+	/// Returns a vector with the same value in every element
+	inline Float4 splat(float s) { return vdupq_n_f32(s); }
+
+	inline Float4 add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+	inline Float4 sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+	inline Float4 mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+	inline Float4 div(Float4 a, Float4 b) { return vdivq_f32(a, b); }
+
+	/// Returns a vector with the element at the specified index in every element
+	template <int Index>
+	inline Float4 broadcast(Float4 v) { return vdupq_laneq_f32(v, Index); }
+	/// Returns the elements in reverse order (`wzyx`)
+	inline Float4 reverse(Float4 v)
+	{
+		const Float4 swapped = vrev64q_f32(v);
+		return vcombine_f32(vget_high_f32(swapped), vget_low_f32(swapped));
+	}
+	/// Returns the elements with the two halves swapped (`zwxy`)
+	inline Float4 swapHalves(Float4 v) { return vcombine_f32(vget_high_f32(v), vget_low_f32(v)); }
+	/// Returns the elements with each pair swapped (`yxwz`)
+	inline Float4 swapPairs(Float4 v) { return vrev64q_f32(v); }
+
+	/// Transposes the four by four matrix made by the four vectors
+	inline void transpose(Float4 &v0, Float4 &v1, Float4 &v2, Float4 &v3)
+	{
+		const float32x4x2_t t01 = vtrnq_f32(v0, v1);
+		const float32x4x2_t t23 = vtrnq_f32(v2, v3);
+		v0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		v1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		v2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		v3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	}
+#endif
+
+}
+
+}
+
+#endif
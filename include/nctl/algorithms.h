@@ -2,6 +2,8 @@
 #define NCTL_ALGORITHMS
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include "iterator.h"
 #include "utility.h"
 
@@ -950,6 +952,107 @@ inline void sortDesc(Iterator first, Iterator last)
 	introsort(first, last, IsNotLess<typename IteratorTraits<Iterator>::ValueType>, maxDepth);
 }
 
+
+/// An element to be sorted by `radixSort()`, with a 64 bits key, a 32 bits secondary key that breaks ties and an index
+struct RadixSortItem
+{
+	uint64_t key;
+	uint32_t subKey;
+	uint32_t index;
+};
+
+namespace {
+
+	/// Number of key bits processed by each radix sort pass
+	const unsigned int RadixSortDigitBits = 8;
+	/// Number of buckets for each radix sort pass
+	const unsigned int RadixSortNumBuckets = 1u << RadixSortDigitBits;
+	/// Number of radix sort passes for the secondary key
+	const unsigned int RadixSortNumSubKeyPasses = 32 / RadixSortDigitBits;
+	/// Total number of radix sort passes, secondary key passes first
+	const unsigned int RadixSortNumPasses = RadixSortNumSubKeyPasses + 64 / RadixSortDigitBits;
+
+	/// Returns the digit of a radix sort item for the specified pass, after flipping the keys bits with the masks
+	inline unsigned int radixSortDigit(const RadixSortItem &item, unsigned int pass, uint64_t keyMask, uint32_t subKeyMask)
+	{
+		if (pass < RadixSortNumSubKeyPasses)
+			return ((item.subKey ^ subKeyMask) >> (pass * RadixSortDigitBits)) & (RadixSortNumBuckets - 1);
+		else
+			return ((item.key ^ keyMask) >> ((pass - RadixSortNumSubKeyPasses) * RadixSortDigitBits)) & (RadixSortNumBuckets - 1);
+	}
+
+	/// Least significant digit radix sort implementation, sorting in descending order by flipping the bits of both keys
+	inline void radixSort(RadixSortItem *items, RadixSortItem *temp, unsigned int count, bool descending)
+	{
+		if (count < 2)
+			return;
+
+		const uint64_t keyMask = descending ? ~uint64_t(0) : 0;
+		const uint32_t subKeyMask = descending ? ~uint32_t(0) : 0;
+
+		// Counting the occurrences of every digit for all passes with a single read of the items
+		unsigned int histograms[RadixSortNumPasses][RadixSortNumBuckets];
+		memset(histograms, 0, sizeof(histograms));
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const uint32_t subKey = items[i].subKey ^ subKeyMask;
+			for (unsigned int pass = 0; pass < RadixSortNumSubKeyPasses; pass++)
+				histograms[pass][(subKey >> (pass * RadixSortDigitBits)) & (RadixSortNumBuckets - 1)]++;
+
+			const uint64_t key = items[i].key ^ keyMask;
+			for (unsigned int pass = RadixSortNumSubKeyPasses; pass < RadixSortNumPasses; pass++)
+				histograms[pass][(key >> ((pass - RadixSortNumSubKeyPasses) * RadixSortDigitBits)) & (RadixSortNumBuckets - 1)]++;
+		}
+
+		RadixSortItem *source = items;
+		RadixSortItem *destination = temp;
+		for (unsigned int pass = 0; pass < RadixSortNumPasses; pass++)
+		{
+			unsigned int *histogram = histograms[pass];
+
+			// Skipping the pass if all items share the same digit
+			if (histogram[radixSortDigit(source[0], pass, keyMask, subKeyMask)] == count)
+				continue;
+
+			unsigned int offset = 0;
+			for (unsigned int i = 0; i < RadixSortNumBuckets; i++)
+			{
+				const unsigned int bucketCount = histogram[i];
+				histogram[i] = offset;
+				offset += bucketCount;
+			}
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				const unsigned int digit = radixSortDigit(source[i], pass, keyMask, subKeyMask);
+				destination[histogram[digit]++] = source[i];
+			}
+
+			RadixSortItem *swapPtr = source;
+			source = destination;
+			destination = swapPtr;
+		}
+
+		if (source != items)
+			memcpy(items, source, count * sizeof(RadixSortItem));
+	}
+
+}
+
+/// Stable radix sort of items in ascending order of key and then secondary key
+/*! \note The temporary buffer should be able to contain at least `count` items. */
+inline void radixSort(RadixSortItem *items, RadixSortItem *temp, unsigned int count)
+{
+	radixSort(items, temp, count, false);
+}
+
+/// Stable radix sort of items in descending order of key and then secondary key
+/*! \note The temporary buffer should be able to contain at least `count` items. */
+inline void radixSortDesc(RadixSortItem *items, RadixSortItem *temp, unsigned int count)
+{
+	radixSort(items, temp, count, true);
+}
+
 }
 
 #endif
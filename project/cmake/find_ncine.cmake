@@ -129,6 +129,12 @@ if(EXISTS ${NCINE_CONFIG_H})
 		elseif(NCINE_CONFIG_STRING STREQUAL "#define NCINE_WITH_ALLOCATORS 1")
 			set(NCINE_WITH_ALLOCATORS ON)
 			message(STATUS "NCINE_WITH_ALLOCATORS: " ${NCINE_WITH_ALLOCATORS})
+		elseif(NCINE_CONFIG_STRING STREQUAL "#define NCINE_WITH_SIMD 1")
+			set(NCINE_WITH_SIMD ON)
+			message(STATUS "NCINE_WITH_SIMD: " ${NCINE_WITH_SIMD})
+		elseif(NCINE_CONFIG_STRING STREQUAL "#define NCINE_WITH_COMPACT_TRANSFORMS 1")
+			set(NCINE_WITH_COMPACT_TRANSFORMS ON)
+			message(STATUS "NCINE_WITH_COMPACT_TRANSFORMS: " ${NCINE_WITH_COMPACT_TRANSFORMS})
 		elseif(NCINE_CONFIG_STRING STREQUAL "#define NCINE_WITH_IMGUI 1")
 			set(NCINE_WITH_IMGUI ON)
 			message(STATUS "NCINE_WITH_IMGUI: " ${NCINE_WITH_IMGUI})
@@ -55,6 +55,7 @@ namespace {
 	#define ENV_IBO_SIZE "IBO_SIZE"
 	#define ENV_VAO_POOL_SIZE "VAO_POOL_SIZE"
 	#define ENV_RENDER_COMMAND_POOL_SIZE "RENDER_COMMAND_POOL_SIZE"
+	#define ENV_FRAME_ARENA_SIZE "FRAME_ARENA_SIZE"
 
 	#define ENV_DEFER_SHADER_QUERIES "DEFER_SHADER_QUERIES"
 	#define ENV_FIXED_BATCH_SIZE "FIXED_BATCH_SIZE"
@@ -69,6 +70,10 @@ namespace {
 
 	// ----- Job System -----
 	#define ENV_NUM_THREADS "NUM_THREADS"
+	#define ENV_SPIN_COUNT "SPIN_COUNT"
+	#define ENV_YIELD_COUNT "YIELD_COUNT"
+	#define ENV_TOPOLOGY_AWARE_STEALING "TOPOLOGY_AWARE_STEALING"
+	#define ENV_PERFORMANCE_CORES_ONLY "PERFORMANCE_CORES_ONLY"
 
 	// ----- Features -----
 	#define ENV_SCENEGRAPH "SCENEGRAPH"
@@ -373,6 +378,7 @@ void AppConfiguration::logFields() const
 	LOGD_X("  - IBO Size: %lu bytes", graphics.opengl.iboSize);
 	LOGD_X("  - VAO Pool Size: %u", graphics.opengl.vaoPoolSize);
 	LOGD_X("  - RenderCommand Pool Size: %u", graphics.opengl.renderCommandPoolSize);
+	LOGD_X("  - Frame Arena Size: %lu bytes", graphics.opengl.frameArenaSize);
 
 	LOGD_X("  - Defer Shader Queries: %s", graphics.opengl.deferShaderQueries ? "true" : "false");
 #if defined(__EMSCRIPTEN__) || defined(WITH_ANGLE)
@@ -393,6 +399,10 @@ void AppConfiguration::logFields() const
 	LOGD("Job System Configuration");
 	LOGD_X("- Enabled: %s", jobSystem.enabled ? "true" : "false");
 	LOGD_X("- Number of Threads: %u", jobSystem.numThreads);
+	LOGD_X("- Spin Count: %u", jobSystem.spinCount);
+	LOGD_X("- Yield Count: %u", jobSystem.yieldCount);
+	LOGD_X("- Topology Aware Stealing: %s", jobSystem.topologyAwareStealing ? "true" : "false");
+	LOGD_X("- Performance Cores Only: %s", jobSystem.performanceCoresOnly ? "true" : "false");
 
 	// ----- Features -----
 	LOGD("Features Configuration");
@@ -537,6 +547,13 @@ void AppConfiguration::readEnvVariables()
 	constexpr const char EnvGLRenderCmdPool[] = ENV3(ENV_GRAPHICS, ENV_OPENGL, ENV_RENDER_COMMAND_POOL_SIZE);
 	graphics.opengl.renderCommandPoolSize = readUintEnvVar(EnvGLRenderCmdPool, graphics.opengl.renderCommandPoolSize);
 
+	// NCINE_APPCFG_GRAPHICS_OPENGL_FRAME_ARENA_SIZE
+	old_.graphics.opengl.frameArenaSize = graphics.opengl.frameArenaSize;
+	constexpr const char EnvGLFrameArenaSize[] = ENV3(ENV_GRAPHICS, ENV_OPENGL, ENV_FRAME_ARENA_SIZE);
+	graphics.opengl.frameArenaSize = readUlongEnvVar(EnvGLFrameArenaSize, graphics.opengl.frameArenaSize);
+	if (graphics.opengl.frameArenaSize == 0)
+		graphics.opengl.frameArenaSize = old_.graphics.opengl.frameArenaSize;
+
 	// ----------------------------------------------------------------
 
 	// NCINE_APPCFG_GRAPHICS_OPENGL_DEFER_SHADER_QUERIES
@@ -600,6 +617,26 @@ void AppConfiguration::readEnvVariables()
 	constexpr const char EnvJobThreads[] = ENV2(ENV_JOBSYSTEM, ENV_NUM_THREADS);
 	jobSystem.numThreads = readUintEnvVar(EnvJobThreads, jobSystem.numThreads);
 
+	// NCINE_APPCFG_JOBSYSTEM_SPIN_COUNT
+	old_.jobSystem.spinCount = jobSystem.spinCount;
+	constexpr const char EnvJobSpinCount[] = ENV2(ENV_JOBSYSTEM, ENV_SPIN_COUNT);
+	jobSystem.spinCount = readUintEnvVar(EnvJobSpinCount, jobSystem.spinCount);
+
+	// NCINE_APPCFG_JOBSYSTEM_YIELD_COUNT
+	old_.jobSystem.yieldCount = jobSystem.yieldCount;
+	constexpr const char EnvJobYieldCount[] = ENV2(ENV_JOBSYSTEM, ENV_YIELD_COUNT);
+	jobSystem.yieldCount = readUintEnvVar(EnvJobYieldCount, jobSystem.yieldCount);
+
+	// NCINE_APPCFG_JOBSYSTEM_TOPOLOGY_AWARE_STEALING
+	old_.jobSystem.topologyAwareStealing = jobSystem.topologyAwareStealing;
+	constexpr const char EnvJobTopologyStealing[] = ENV2(ENV_JOBSYSTEM, ENV_TOPOLOGY_AWARE_STEALING);
+	jobSystem.topologyAwareStealing = readBoolEnvVar(EnvJobTopologyStealing, jobSystem.topologyAwareStealing);
+
+	// NCINE_APPCFG_JOBSYSTEM_PERFORMANCE_CORES_ONLY
+	old_.jobSystem.performanceCoresOnly = jobSystem.performanceCoresOnly;
+	constexpr const char EnvJobPerformanceCores[] = ENV2(ENV_JOBSYSTEM, ENV_PERFORMANCE_CORES_ONLY);
+	jobSystem.performanceCoresOnly = readBoolEnvVar(EnvJobPerformanceCores, jobSystem.performanceCoresOnly);
+
 	// ----------------------------------------------------------------
 	// ----- Features -----
 
@@ -788,6 +825,13 @@ void AppConfiguration::logEnvVariables() const
 		       Name, graphics.opengl.renderCommandPoolSize, old_.graphics.opengl.renderCommandPoolSize);
 	}
 
+	if (graphics.opengl.frameArenaSize != old_.graphics.opengl.frameArenaSize)
+	{
+		constexpr const char Name[] = ENV3(ENV_GRAPHICS, ENV_OPENGL, ENV_FRAME_ARENA_SIZE);
+		LOGI_X("%s=%lu overrides compiled value %lu",
+		       Name, graphics.opengl.frameArenaSize, old_.graphics.opengl.frameArenaSize);
+	}
+
 	// ----------------------------------------------------------------
 
 	if (graphics.opengl.deferShaderQueries != old_.graphics.opengl.deferShaderQueries)
@@ -873,6 +917,34 @@ void AppConfiguration::logEnvVariables() const
 		       Name, jobSystem.numThreads, old_.jobSystem.numThreads);
 	}
 
+	if (jobSystem.spinCount != old_.jobSystem.spinCount)
+	{
+		constexpr const char Name[] = ENV2(ENV_JOBSYSTEM, ENV_SPIN_COUNT);
+		LOGI_X("%s=%u overrides compiled value %u",
+		       Name, jobSystem.spinCount, old_.jobSystem.spinCount);
+	}
+
+	if (jobSystem.yieldCount != old_.jobSystem.yieldCount)
+	{
+		constexpr const char Name[] = ENV2(ENV_JOBSYSTEM, ENV_YIELD_COUNT);
+		LOGI_X("%s=%u overrides compiled value %u",
+		       Name, jobSystem.yieldCount, old_.jobSystem.yieldCount);
+	}
+
+	if (jobSystem.topologyAwareStealing != old_.jobSystem.topologyAwareStealing)
+	{
+		constexpr const char Name[] = ENV2(ENV_JOBSYSTEM, ENV_TOPOLOGY_AWARE_STEALING);
+		LOGI_X("%s=%d overrides compiled value %d",
+		       Name, jobSystem.topologyAwareStealing, old_.jobSystem.topologyAwareStealing);
+	}
+
+	if (jobSystem.performanceCoresOnly != old_.jobSystem.performanceCoresOnly)
+	{
+		constexpr const char Name[] = ENV2(ENV_JOBSYSTEM, ENV_PERFORMANCE_CORES_ONLY);
+		LOGI_X("%s=%d overrides compiled value %d",
+		       Name, jobSystem.performanceCoresOnly, old_.jobSystem.performanceCoresOnly);
+	}
+
 	// ----------------------------------------------------------------
 	// ----- Features -----
 
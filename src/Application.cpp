@@ -18,6 +18,7 @@
 	#include "RenderQueue.h"
 	#include "ScreenViewport.h"
 	#include "SceneNode.h"
+	#include "FrameArena.h"
 #endif
 
 #ifdef WITH_AUDIO
@@ -268,7 +269,9 @@ void Application::initCommon()
 		if (appCfg_.jobSystem.numThreads == 1)
 			theServiceLocator().registerJobSystem(nctl::makeUnique<SerialJobSystem>());
 		else
-			theServiceLocator().registerJobSystem(nctl::makeUnique<JobSystem>(appCfg_.jobSystem.numThreads));
+			theServiceLocator().registerJobSystem(nctl::makeUnique<JobSystem>(appCfg_.jobSystem.numThreads, appCfg_.jobSystem.performanceCoresOnly));
+		theServiceLocator().jobSystem().setIdleBackoff(appCfg_.jobSystem.spinCount, appCfg_.jobSystem.yieldCount);
+		theServiceLocator().jobSystem().setStealPolicy(appCfg_.jobSystem.topologyAwareStealing ? JobStealPolicy::TOPOLOGY : JobStealPolicy::ROUND_ROBIN);
 	}
 #endif
 	theServiceLocator().registerGfxCapabilities(nctl::makeUnique<GfxCapabilities>());
@@ -344,6 +347,12 @@ void Application::step()
 	ZoneScoped;
 	frameTimer_->addFrame();
 
+#ifdef WITH_SCENEGRAPH
+	// Nothing allocated from the arena during the previous frame is referenced anymore
+	if (appCfg_.features.scenegraph)
+		RenderResources::frameArena().reset();
+#endif
+
 #ifdef WITH_IMGUI
 	{
 		ZoneScopedN("ImGui newFrame");
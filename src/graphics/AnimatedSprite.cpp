@@ -25,6 +25,8 @@ AnimatedSprite::AnimatedSprite(SceneNode *parent, Texture *texture, float xx, fl
     : Sprite(parent, texture, xx, yy), anims_(4), currentAnimIndex_(0)
 {
 	type_ = ObjectType::ANIMATED_SPRITE;
+	// Animations advance in `update()`, even when nothing else has changed
+	setAlwaysUpdated(true);
 }
 
 AnimatedSprite::AnimatedSprite(SceneNode *parent, Texture *texture, const Vector2f &position)
@@ -11,7 +11,7 @@ namespace ncine {
 
 BaseSprite::BaseSprite(SceneNode *parent, Texture *texture, float xx, float yy)
     : DrawableNode(parent, xx, yy), texture_(texture), texRect_(0, 0, 0, 0),
-      flippedX_(false), flippedY_(false), instanceBlock_(nullptr)
+      flippedX_(false), flippedY_(false)
 {
 	renderCommand_->material().setBlendingEnabled(true);
 }
@@ -33,6 +33,7 @@ void BaseSprite::setSize(float width, float height)
 	updateAnchorPoint();
 	dirtyBits_.set(DirtyBitPositions::SizeBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	drawingHasChanged();
 }
 
 /*! \note If you set a texture that is already assigned, this method would be equivalent to `resetTexture()` */
@@ -42,6 +43,7 @@ void BaseSprite::setTexture(Texture *texture)
 	textureHasChanged(texture);
 	texture_ = texture;
 	dirtyBits_.set(DirtyBitPositions::TextureBit);
+	drawingHasChanged();
 }
 
 /*! \note Use this method when the content of the currently assigned texture changes */
@@ -49,6 +51,7 @@ void BaseSprite::resetTexture()
 {
 	textureHasChanged(texture_);
 	dirtyBits_.set(DirtyBitPositions::TextureBit);
+	drawingHasChanged();
 }
 
 void BaseSprite::setTexRect(const Recti &rect)
@@ -80,6 +83,7 @@ void BaseSprite::setFlippedX(bool flippedX)
 		flippedX_ = flippedX;
 
 		dirtyBits_.set(DirtyBitPositions::TextureBit);
+		drawingHasChanged();
 	}
 }
 
@@ -92,6 +96,7 @@ void BaseSprite::setFlippedY(bool flippedY)
 		flippedY_ = flippedY;
 
 		dirtyBits_.set(DirtyBitPositions::TextureBit);
+		drawingHasChanged();
 	}
 }
 
@@ -101,7 +106,7 @@ void BaseSprite::setFlippedY(bool flippedY)
 
 BaseSprite::BaseSprite(const BaseSprite &other)
     : DrawableNode(other), texture_(other.texture_), texRect_(other.texRect_),
-      flippedX_(other.flippedX_), flippedY_(other.flippedY_), instanceBlock_(nullptr)
+      flippedX_(other.flippedX_), flippedY_(other.flippedY_)
 {
 }
 
@@ -112,13 +117,12 @@ BaseSprite::BaseSprite(const BaseSprite &other)
 void BaseSprite::shaderHasChanged()
 {
 	renderCommand_->material().reserveUniformsDataMemory();
-	instanceBlock_ = renderCommand_->material().uniformBlock(Material::InstanceBlockName);
-	GLUniformCache *textureUniform = renderCommand_->material().uniform(Material::TextureUniformName);
+	GLUniformCache *textureUniform = renderCommand_->material().builtinUniform(Material::BuiltinUniforms::TEXTURE);
 	if (textureUniform && textureUniform->intValue(0) != 0)
 		textureUniform->setIntValue(0); // GL_TEXTURE0
 
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	setColorDirty();
 	dirtyBits_.set(DirtyBitPositions::SizeBit);
 	dirtyBits_.set(DirtyBitPositions::TextureBit);
 }
@@ -132,7 +136,7 @@ void BaseSprite::updateRenderCommand()
 
 	if (dirtyBits_.test(DirtyBitPositions::ColorUploadBit))
 	{
-		GLUniformCache *colorUniform = instanceBlock_->uniform(Material::ColorUniformName);
+		GLUniformCache *colorUniform = renderCommand_->material().builtinUniform(Material::BuiltinUniforms::COLOR);
 		if (colorUniform)
 		{
 			const bool setAsUint = colorUniform->setUintValue(absColor_.abgr());
@@ -142,7 +146,7 @@ void BaseSprite::updateRenderCommand()
 	}
 	if (dirtyBits_.test(DirtyBitPositions::SizeBit))
 	{
-		GLUniformCache *spriteSizeUniform = instanceBlock_->uniform(Material::SpriteSizeUniformName);
+		GLUniformCache *spriteSizeUniform = renderCommand_->material().builtinUniform(Material::BuiltinUniforms::SPRITE_SIZE);
 		if (spriteSizeUniform)
 		{
 			const uint32_t packedSize = (uint32_t(width_) & 0xFFFFu) | ((uint32_t(height_) & 0xFFFFu) << 16);
@@ -161,8 +165,8 @@ void BaseSprite::updateRenderCommand()
 			renderCommand_->material().setTexture(*texture_);
 
 			bool setAsUint = false;
-			GLUniformCache *uvEndpointsUUniform = instanceBlock_->uniform(Material::UvEndpointsUUniformName);
-			GLUniformCache *uvEndpointsVUniform = instanceBlock_->uniform(Material::UvEndpointsVUniformName);
+			GLUniformCache *uvEndpointsUUniform = renderCommand_->material().builtinUniform(Material::BuiltinUniforms::UV_ENDPOINTS_U);
+			GLUniformCache *uvEndpointsVUniform = renderCommand_->material().builtinUniform(Material::BuiltinUniforms::UV_ENDPOINTS_V);
 			if (uvEndpointsUUniform && uvEndpointsVUniform)
 			{
 				const Vector2i texSize = texture_->size();
@@ -186,7 +190,7 @@ void BaseSprite::updateRenderCommand()
 
 			if (setAsUint == false)
 			{
-				GLUniformCache *texRectUniform = instanceBlock_->uniform(Material::TexRectUniformName);
+				GLUniformCache *texRectUniform = renderCommand_->material().builtinUniform(Material::BuiltinUniforms::TEX_RECT);
 				if (texRectUniform)
 				{
 					const Vector2i texSize = texture_->size();
@@ -0,0 +1,51 @@
+#include "BufferRing.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+BufferRing::BufferRing(Backend &backend)
+    : backend_(backend), currentRegion_(0), numAdvances_(0), numBlockingWaits_(0)
+{
+	for (unsigned int i = 0; i < NumRegions; i++)
+		fencePending_[i] = false;
+}
+
+BufferRing::~BufferRing()
+{
+	for (unsigned int i = 0; i < NumRegions; i++)
+	{
+		if (fencePending_[i])
+			backend_.deleteFence(i);
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note The fence of the next region is first polled without a timeout, with enough regions it is always already signaled. */
+void BufferRing::advance()
+{
+	backend_.insertFence(currentRegion_);
+	fencePending_[currentRegion_] = true;
+
+	currentRegion_ = (currentRegion_ + 1) % NumRegions;
+	numAdvances_++;
+
+	if (fencePending_[currentRegion_])
+	{
+		if (backend_.waitFence(currentRegion_, 0) == false)
+		{
+			numBlockingWaits_++;
+			while (backend_.waitFence(currentRegion_, WaitTimeout) == false) {}
+		}
+
+		backend_.deleteFence(currentRegion_);
+		fencePending_[currentRegion_] = false;
+	}
+}
+
+}
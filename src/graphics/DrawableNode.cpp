@@ -6,6 +6,7 @@
 #include "Viewport.h"
 #include "Application.h"
 #include "RenderStatistics.h"
+#include "SpatialGrid.h"
 #include "tracy.h"
 
 namespace ncine {
@@ -98,11 +99,44 @@ DrawableNode::DrawableNode()
 {
 }
 
-DrawableNode::~DrawableNode() = default;
+DrawableNode::~DrawableNode()
+{
+	// The spatial index refers to the node by its address
+	if (spatialGridCells_.w > 0)
+		RenderResources::spatialGrid().remove(this);
+}
 
-DrawableNode::DrawableNode(DrawableNode &&) = default;
+/*! \note The moved node leaves the spatial index, the new one is indexed by the next culling update */
+DrawableNode::DrawableNode(DrawableNode &&other)
+    : SceneNode(nctl::move(other)),
+      width_(other.width_), height_(other.height_),
+      anchorPointFraction_(other.anchorPointFraction_), anchorIsAbsolute_(other.anchorIsAbsolute_),
+      renderCommand_(nctl::move(other.renderCommand_)),
+      lastFrameRendered_(other.lastFrameRendered_), aabb_(other.aabb_)
+{
+	if (other.spatialGridCells_.w > 0)
+		RenderResources::spatialGrid().remove(&other);
+}
 
-DrawableNode &DrawableNode::operator=(DrawableNode &&) = default;
+/*! \note Both nodes leave the spatial index, as the cells of this one are not valid for the new bounding box */
+DrawableNode &DrawableNode::operator=(DrawableNode &&other)
+{
+	if (spatialGridCells_.w > 0)
+		RenderResources::spatialGrid().remove(this);
+	if (other.spatialGridCells_.w > 0)
+		RenderResources::spatialGrid().remove(&other);
+
+	SceneNode::operator=(nctl::move(other));
+	width_ = other.width_;
+	height_ = other.height_;
+	anchorPointFraction_ = other.anchorPointFraction_;
+	anchorIsAbsolute_ = other.anchorIsAbsolute_;
+	renderCommand_ = nctl::move(other.renderCommand_);
+	lastFrameRendered_ = other.lastFrameRendered_;
+	aabb_ = other.aabb_;
+
+	return *this;
+}
 
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
@@ -130,11 +164,15 @@ bool DrawableNode::draw(RenderQueue &renderQueue)
 		renderCommand_->setLayer(absLayer_);
 		renderCommand_->setVisitOrder(withVisitOrder_ ? visitOrderIndex_ : 0);
 
-		updateRenderCommand();
-		dirtyBits_.reset(DirtyBitPositions::TransformationUploadBit);
-		dirtyBits_.reset(DirtyBitPositions::ColorUploadBit);
-
-		renderQueue.addCommand(renderCommand_.get());
+		// With parallel visit the render command is updated later by the render queue, possibly on a different thread
+		// The commands of a frozen subtree are needed at the end of its recording, so they are never deferred
+		if (theApplication().renderingSettings().parallelVisitEnabled && renderQueue.isRecording() == false)
+			renderQueue.addDeferredNode(this);
+		else
+		{
+			prepareRenderCommand();
+			renderQueue.addCommand(renderCommand_.get());
+		}
 	}
 	else
 	{
@@ -164,6 +202,8 @@ bool DrawableNode::isBlendingEnabled() const
 void DrawableNode::setBlendingEnabled(bool blendingEnabled)
 {
 	renderCommand_->material().setBlendingEnabled(blendingEnabled);
+	// The blending decides the queue of the command and its sorting key
+	drawingHasChanged();
 }
 
 DrawableNode::BlendingFactor DrawableNode::srcBlendingFactor() const
@@ -196,11 +236,13 @@ void DrawableNode::setBlendingPreset(BlendingPreset blendingPreset)
 			renderCommand_->material().setBlendingFactors(toGlBlendingFactor(BlendingFactor::DST_COLOR), toGlBlendingFactor(BlendingFactor::ZERO));
 			break;
 	}
+	drawingHasChanged();
 }
 
 void DrawableNode::setBlendingFactors(BlendingFactor srcBlendingFactor, BlendingFactor destBlendingFactor)
 {
 	renderCommand_->material().setBlendingFactors(toGlBlendingFactor(srcBlendingFactor), toGlBlendingFactor(destBlendingFactor));
+	drawingHasChanged();
 }
 
 ///////////////////////////////////////////////////////////
@@ -212,7 +254,15 @@ void DrawableNode::setBlendingFactors(BlendingFactor srcBlendingFactor, Blending
 void DrawableNode::updateAnchorPoint()
 {
 	if (anchorIsAbsolute_ == false)
-		anchorPoint_.set((anchorPointFraction_.x - 0.5f) * width_, (anchorPointFraction_.y - 0.5f) * height_);
+	{
+		const Vector2f anchorPoint((anchorPointFraction_.x - 0.5f) * width_, (anchorPointFraction_.y - 0.5f) * height_);
+		if (anchorPoint != anchorPoint_)
+		{
+			anchorPoint_ = anchorPoint;
+			// The anchor point is part of the local matrix
+			setTransformationDirty();
+		}
+	}
 }
 
 void DrawableNode::updateAabb()
@@ -237,17 +287,24 @@ void DrawableNode::updateAabb()
 
 void DrawableNode::updateCulling()
 {
-	const bool cullingEnabled = theApplication().renderingSettings().cullingEnabled;
-	if (drawEnabled_ && cullingEnabled && width_ > 0 && height_ > 0)
+	const Application::RenderingSettings &settings = theApplication().renderingSettings();
+	if (drawEnabled_ && settings.cullingEnabled && width_ > 0 && height_ > 0)
 	{
-		if (dirtyBits_.test(DirtyBitPositions::AabbBit))
+		const bool aabbChanged = dirtyBits_.test(DirtyBitPositions::AabbBit);
+		if (aabbChanged)
 		{
 			updateAabb();
 			dirtyBits_.reset(DirtyBitPositions::AabbBit);
 		}
 
+		if (settings.spatialIndexEnabled)
+		{
+			// The viewport marks the overlapping nodes by querying the index after the culling update
+			if (aabbChanged || spatialGridCells_.w == 0)
+				RenderResources::spatialGrid().update(this);
+		}
 		// Check if at least one viewport in the chain overlaps with this node
-		if (lastFrameRendered_ < theApplication().numFrames())
+		else if (lastFrameRendered_ < theApplication().numFrames())
 		{
 			const Viewport *viewport = RenderResources::currentViewport();
 			const bool overlaps = aabb_.overlaps(viewport->cullingRect());
@@ -270,4 +327,16 @@ DrawableNode::DrawableNode(const DrawableNode &other)
 	setLayer(other.layer());
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note It only accesses the node and its render command, so it can be called concurrently on different nodes. */
+void DrawableNode::prepareRenderCommand()
+{
+	updateRenderCommand();
+	dirtyBits_.reset(DirtyBitPositions::TransformationUploadBit);
+	dirtyBits_.reset(DirtyBitPositions::ColorUploadBit);
+}
+
 }
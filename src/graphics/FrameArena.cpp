@@ -0,0 +1,92 @@
+#include "common_macros.h"
+#include "FrameArena.h"
+#include "RenderStatistics.h"
+#ifndef WITH_ALLOCATORS
+	#include <nctl/PointerMath.h>
+#endif
+#include "tracy.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+FrameArena::FrameArena(unsigned long size)
+    : size_(size), buffer_(nctl::makeUnique<unsigned char[]>(size)),
+#ifdef WITH_ALLOCATORS
+      allocator_("FrameArena", size, buffer_.get()),
+#else
+      offset_(0),
+#endif
+      peakBytes_(0), numAllocations_(0), numFailedAllocations_(0)
+{
+	FATAL_ASSERT_MSG(size > 0, "The size of the frame arena should be greater than zero");
+}
+
+FrameArena::~FrameArena()
+{
+#ifdef WITH_ALLOCATORS
+	// The linear allocator cannot be destroyed with active allocations
+	allocator_.clear();
+#endif
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned long FrameArena::usedBytes() const
+{
+#ifdef WITH_ALLOCATORS
+	return static_cast<unsigned long>(allocator_.usedMemory());
+#else
+	return offset_;
+#endif
+}
+
+void *FrameArena::allocate(unsigned long bytes, unsigned int alignment)
+{
+	if (bytes == 0)
+		return nullptr;
+
+#ifdef WITH_ALLOCATORS
+	void *ptr = allocator_.allocate(bytes, alignment);
+#else
+	void *ptr = nullptr;
+	const size_t adjustment = nctl::PointerMath::alignAdjustment(buffer_.get() + offset_, alignment);
+	if (offset_ + adjustment + bytes <= size_)
+	{
+		ptr = buffer_.get() + offset_ + adjustment;
+		offset_ += adjustment + bytes;
+	}
+#endif
+
+	if (ptr != nullptr)
+		numAllocations_++;
+	else
+		numFailedAllocations_++;
+
+	return ptr;
+}
+
+/*! \note The memory used at the end of a frame is the peak of that frame, as nothing is freed before the reset. */
+void FrameArena::reset()
+{
+	const unsigned long frameBytes = usedBytes();
+	if (frameBytes > peakBytes_)
+		peakBytes_ = frameBytes;
+
+	TracyPlot("Frame Arena Bytes", static_cast<int64_t>(frameBytes));
+	RenderStatistics::gatherFrameArenaStatistics(size_, frameBytes, peakBytes_, numAllocations_, numFailedAllocations_);
+
+#ifdef WITH_ALLOCATORS
+	allocator_.clear();
+#else
+	offset_ = 0;
+#endif
+	numAllocations_ = 0;
+	numFailedAllocations_ = 0;
+}
+
+}
@@ -12,7 +12,7 @@ namespace ncine {
 Geometry::Geometry()
     : primitiveType_(GL_TRIANGLES), firstVertex_(0), numVertices_(0),
       numElementsPerVertex_(2), firstIndex_(0), numIndices_(0),
-      hostVertexPointer_(nullptr), hostIndexPointer_(nullptr),
+      hostVertexPointer_(nullptr), numHostVertexFloats_(0), hostIndexPointer_(nullptr),
       vboUsageFlags_(0), sharedVboParams_(nullptr),
       iboUsageFlags_(0), sharedIboParams_(nullptr),
       hasDirtyVertices_(true), hasDirtyIndices_(true)
@@ -98,9 +98,16 @@ void Geometry::releaseVertexPointer()
 }
 
 void Geometry::setHostVertexPointer(const float *vertexPointer)
+{
+	setHostVertexPointer(vertexPointer, 0);
+}
+
+/*! \note Useful with instancing, when the amount of vertex data does not depend on the number of vertices to draw */
+void Geometry::setHostVertexPointer(const float *vertexPointer, unsigned int numFloats)
 {
 	hasDirtyVertices_ = true;
 	hostVertexPointer_ = vertexPointer;
+	numHostVertexFloats_ = numFloats;
 }
 
 void Geometry::shareVbo(const Geometry *geometry)
@@ -237,13 +244,13 @@ void Geometry::commitVertices()
 	{
 		// Checking if the common VBO is allowed to use mapping and do the same for the custom one
 		const GLenum mapFlags = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ARRAY).mapFlags;
-		const unsigned int numFloats = numVertices_ * numElementsPerVertex_;
+		const unsigned int numFloats = (numHostVertexFloats_ > 0) ? numHostVertexFloats_ : numVertices_ * numElementsPerVertex_;
 
 		if (mapFlags == 0 && vbo_)
 		{
 			// Using buffer orphaning + `glBufferSubData()` when having a custom VBO with no mapping available
 			vbo_->bufferData(vboParams_.size, nullptr, vboUsageFlags_);
-			vbo_->bufferSubData(vboParams_.offset, vboParams_.size, hostVertexPointer_);
+			vbo_->bufferSubData(vboParams_.offset, numFloats * sizeof(GLfloat), hostVertexPointer_);
 		}
 		else
 		{
@@ -117,12 +117,12 @@ void GfxCapabilities::init()
 #ifndef __EMSCRIPTEN__
 	const char *extensionNames[GLExtensions::COUNT] = {
 		"GL_KHR_debug", "GL_ARB_texture_storage", getProgramBinaryExtString, "GL_EXT_texture_compression_s3tc", "GL_OES_compressed_ETC1_RGB8_texture",
-		"GL_AMD_compressed_ATC_texture", "GL_IMG_texture_compression_pvrtc", "GL_KHR_texture_compression_astc_ldr"
+		"GL_AMD_compressed_ATC_texture", "GL_IMG_texture_compression_pvrtc", "GL_KHR_texture_compression_astc_ldr", "GL_ARB_buffer_storage"
 	};
 #else
 	const char *extensionNames[GLExtensions::COUNT] = {
 		"GL_KHR_debug", "GL_ARB_texture_storage", "UNSUPPORTED_get_program_binary", "WEBGL_compressed_texture_s3tc", "WEBGL_compressed_texture_etc1",
-		"WEBGL_compressed_texture_atc", "WEBGL_compressed_texture_pvrtc", "WEBGL_compressed_texture_astc"
+		"WEBGL_compressed_texture_atc", "WEBGL_compressed_texture_pvrtc", "WEBGL_compressed_texture_astc", "UNSUPPORTED_buffer_storage"
 	};
 #endif
 
@@ -185,6 +185,7 @@ void GfxCapabilities::logGLCaps() const
 	LOGD_X("GL_AMD_compressed_ATC_texture: %d", glExtensions_[GLExtensions::AMD_COMPRESSED_ATC_TEXTURE]);
 	LOGD_X("GL_IMG_texture_compression_pvrtc: %d", glExtensions_[GLExtensions::IMG_TEXTURE_COMPRESSION_PVRTC]);
 	LOGD_X("GL_KHR_texture_compression_astc_ldr: %d", glExtensions_[GLExtensions::KHR_TEXTURE_COMPRESSION_ASTC_LDR]);
+	LOGD_X("GL_ARB_buffer_storage: %d", glExtensions_[GLExtensions::ARB_BUFFER_STORAGE]);
 	LOGD("--- OpenGL device capabilities ---");
 }
 
@@ -11,6 +11,7 @@
 #include "Viewport.h"
 #include "Camera.h"
 #include "DrawableNode.h"
+#include "Sprite.h"
 #include "MeshSprite.h"
 #include "ParticleSystem.h"
 #include "TextNode.h"
@@ -22,6 +23,7 @@
 #include "IFrameTimer.h"
 #include "RenderStatistics.h"
 #include "RenderResources.h"
+#include "RenderCommand.h"
 #include "BinaryShaderCache.h"
 #include "Hash64.h"
 
@@ -695,6 +697,7 @@ void ImGuiDebugOverlay::guiGraphicsCapabilities()
 		ImGui::Text("GL_AMD_compressed_ATC_texture: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::AMD_COMPRESSED_ATC_TEXTURE));
 		ImGui::Text("GL_IMG_texture_compression_pvrtc: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::IMG_TEXTURE_COMPRESSION_PVRTC));
 		ImGui::Text("GL_KHR_texture_compression_astc_ldr: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::KHR_TEXTURE_COMPRESSION_ASTC_LDR));
+		ImGui::Text("GL_ARB_buffer_storage: %d", gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_BUFFER_STORAGE));
 	}
 }
 
@@ -768,6 +771,7 @@ void ImGuiDebugOverlay::guiApplicationConfiguration()
 				ImGui::Text("IBO Size: %lu bytes", appCfg.graphics.opengl.iboSize);
 				ImGui::Text("VAO Pool Size: %u", appCfg.graphics.opengl.vaoPoolSize);
 				ImGui::Text("RenderCommand Pool Size: %u", appCfg.graphics.opengl.renderCommandPoolSize);
+				ImGui::Text("Frame Arena Size: %lu bytes", appCfg.graphics.opengl.frameArenaSize);
 				ImGui::Separator();
 				ImGui::Text("Defer Shader Queries: %s", appCfg.graphics.opengl.deferShaderQueries ? "true" : "false");
 #if defined(__EMSCRIPTEN__) || defined(WITH_ANGLE)
@@ -842,6 +846,13 @@ void ImGuiDebugOverlay::guiRenderingSettings()
 		ImGui::SameLine();
 		ImGui::Checkbox("Culling", &settings.cullingEnabled);
 
+		ImGui::BeginDisabled(settings.cullingEnabled == false);
+		ImGui::Checkbox("Spatial index", &settings.spatialIndexEnabled);
+		ImGui::BeginDisabled(settings.spatialIndexEnabled == false);
+		ImGui::DragFloat("Index cell size", &settings.spatialIndexCellSize, 1.0f, 16.0f, 8192.0f, "%.0f", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::EndDisabled();
+		ImGui::EndDisabled();
+
 		int minBatchSize = settings.minBatchSize;
 		int maxBatchSize = settings.maxBatchSize;
 	#if defined(__EMSCRIPTEN__) || defined(WITH_ANGLE)
@@ -866,6 +877,40 @@ void ImGuiDebugOverlay::guiRenderingSettings()
 		ImGui::EndDisabled();
 
 		ImGui::EndDisabled();
+
+		ImGui::Checkbox("Incremental sorting", &settings.incrementalSortEnabled);
+
+		ImGui::Checkbox("Batch transform", &settings.batchTransformEnabled);
+		int minBatchTransformSize = settings.minBatchTransformSize;
+		ImGui::BeginDisabled(settings.batchTransformEnabled == false);
+		ImGui::DragInt("Min batched children", &minBatchTransformSize, 1.0f, 1, 65536, "%d", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::EndDisabled();
+		settings.minBatchTransformSize = minBatchTransformSize;
+
+		ImGui::Checkbox("Skip clean subtrees", &settings.cleanSubtreeSkipEnabled);
+		ImGui::Checkbox("Linear traversal", &settings.linearTraversalEnabled);
+
+	#ifdef WITH_JOBSYSTEM
+		ImGui::Checkbox("Parallel update", &settings.parallelUpdateEnabled);
+		int minParallelUpdateSize = settings.minParallelUpdateSize;
+		int parallelUpdateSplitSize = settings.parallelUpdateSplitSize;
+		ImGui::BeginDisabled(settings.parallelUpdateEnabled == false);
+		ImGui::DragInt("Min parallel children", &minParallelUpdateSize, 1.0f, 1, 65536, "%d", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::DragInt("Children per job", &parallelUpdateSplitSize, 1.0f, 1, 8192, "%d", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::EndDisabled();
+		settings.minParallelUpdateSize = minParallelUpdateSize;
+		settings.parallelUpdateSplitSize = parallelUpdateSplitSize;
+
+		ImGui::Checkbox("Parallel visit", &settings.parallelVisitEnabled);
+		int minParallelVisitSize = settings.minParallelVisitSize;
+		int parallelVisitSplitSize = settings.parallelVisitSplitSize;
+		ImGui::BeginDisabled(settings.parallelVisitEnabled == false);
+		ImGui::DragInt("Min parallel commands", &minParallelVisitSize, 1.0f, 1, 65536, "%d", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::DragInt("Commands per job", &parallelVisitSplitSize, 1.0f, 1, 8192, "%d", ImGuiSliderFlags_AlwaysClamp);
+		ImGui::EndDisabled();
+		settings.minParallelVisitSize = minParallelVisitSize;
+		settings.parallelVisitSplitSize = parallelVisitSplitSize;
+	#endif
 	}
 #endif
 }
@@ -1456,6 +1501,23 @@ void guiJobSystemStatsTable(const JobStatistics::JobSystemStats &systemStats, co
 		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.continuationJobsPushed);
 		ImGui::TableNextColumn(); ImGui::TextUnformatted("Parent jobs finished");
 		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.parentJobsFinished);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Jobs executed inline");
+		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.jobsExecutedInline);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Wake-ups while spinning");
+		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.spinWakeUps);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Wake-ups while yielding");
+		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.yieldWakeUps);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Wake-ups after sleeping");
+		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.sleepWakeUps);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Spin time");
+		ImGui::TableNextColumn(); ImGui::Text("%.3f ms", systemStats.spinNanoseconds / 1000000.0);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Sleep time");
+		ImGui::TableNextColumn(); ImGui::Text("%.3f ms", systemStats.sleepNanoseconds / 1000000.0);
+		const uint32_t numWakeUps = systemStats.spinWakeUps + systemStats.yieldWakeUps + systemStats.sleepWakeUps;
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Average wake-up latency");
+		ImGui::TableNextColumn(); ImGui::Text("%.3f us", (numWakeUps > 0) ? systemStats.wakeUpLatencyNanoseconds / (1000.0 * numWakeUps) : 0.0);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Maximum wake-up latency");
+		ImGui::TableNextColumn(); ImGui::Text("%.3f us", systemStats.maxWakeUpLatencyNanoseconds / 1000.0);
 
 
 		ImGui::EndTable();
@@ -1487,6 +1549,12 @@ void guiJobPoolStatsTable(const JobStatistics::JobPoolStats &poolStats, const ch
 		ImGui::TableNextColumn(); ImGui::Text("%u", poolStats.threadCacheEmpty);
 		ImGui::TableNextColumn(); ImGui::TextUnformatted("Thread cache found full");
 		ImGui::TableNextColumn(); ImGui::Text("%u", poolStats.threadCacheFull);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Blocks added");
+		ImGui::TableNextColumn(); ImGui::Text("%u", poolStats.blocksAdded);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Job data in the arena");
+		ImGui::TableNextColumn(); ImGui::Text("%u", poolStats.arenaDataAllocations);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Job data on the heap");
+		ImGui::TableNextColumn(); ImGui::Text("%u", poolStats.heapDataAllocations);
 
 		ImGui::EndTable();
 	}
@@ -2161,6 +2229,30 @@ void ImGuiDebugOverlay::guiNodeInspector()
 #ifdef WITH_SCENEGRAPH
 	if (ImGui::CollapsingHeader("Node Inspector"))
 	{
+		if (ImGui::TreeNode("Node memory"))
+		{
+			// A sprite stores its world and local matrices, and its render command stores the model one
+			const unsigned int fullMatricesBytes = 3 * sizeof(Matrix4x4f);
+			const unsigned int compactMatricesBytes = 3 * sizeof(AffineTransform2Df) + sizeof(float);
+#if NCINE_WITH_COMPACT_TRANSFORMS
+			const bool compactTransforms = true;
+#else
+			const bool compactTransforms = false;
+#endif
+			const unsigned int matricesBytes = compactTransforms ? compactMatricesBytes : fullMatricesBytes;
+			const unsigned int otherMatricesBytes = compactTransforms ? fullMatricesBytes : compactMatricesBytes;
+			const unsigned int spriteBytes = sizeof(Sprite) + sizeof(RenderCommand);
+
+			ImGui::Text("Compact transformations: %s", compactTransforms ? "enabled" : "disabled");
+			ImGui::Text("SceneNode: %u bytes", static_cast<unsigned int>(sizeof(SceneNode)));
+			ImGui::Text("Sprite: %u bytes", static_cast<unsigned int>(sizeof(Sprite)));
+			ImGui::Text("RenderCommand: %u bytes", static_cast<unsigned int>(sizeof(RenderCommand)));
+			ImGui::Text("Sprite matrices: %u bytes full, %u bytes compact", fullMatricesBytes, compactMatricesBytes);
+			ImGui::Text("Sprite and render command: %u bytes (%u with %s transformations)", spriteBytes,
+			            spriteBytes - matricesBytes + otherMatricesBytes, compactTransforms ? "full" : "compact");
+			ImGui::TreePop();
+		}
+
 		// Print viewport information in reverse order (same as chain processing one)
 		const unsigned int chainLength = Viewport::chain().size();
 		for (unsigned int i = 0; i < chainLength; i++)
@@ -2176,6 +2268,11 @@ void ImGuiDebugOverlay::guiTopLeft()
 #ifdef WITH_SCENEGRAPH
 	const RenderStatistics::CommandPool &commandPool = RenderStatistics::commandPool();
 	const RenderStatistics::Textures &textures = RenderStatistics::textures();
+	const RenderStatistics::Sorting &sorting = RenderStatistics::sorting();
+	const RenderStatistics::SpatialIndex &spatialIndex = RenderStatistics::spatialIndex();
+	const RenderStatistics::Arena &frameArena = RenderStatistics::frameArena();
+	const RenderStatistics::FrozenSubtrees &frozenSubtrees = RenderStatistics::frozenSubtrees();
+	const RenderStatistics::StateChanges &allStateChanges = RenderStatistics::allStateChanges();
 #endif
 	const RenderStatistics::CustomBuffers &customVbos = RenderStatistics::customVBOs();
 	const RenderStatistics::CustomBuffers &customIbos = RenderStatistics::customIBOs();
@@ -2208,6 +2305,24 @@ void ImGuiDebugOverlay::guiTopLeft()
 #ifdef WITH_SCENEGRAPH
 		ImGui::Text("%u/%u RenderCommands in the pool (%u retrievals)", commandPool.usedSize, commandPool.usedSize + commandPool.freeSize, commandPool.retrievals);
 		ImGui::Text("%.2f Kb in %u Texture(s)", textures.dataSize / 1024.0f, textures.count);
+		ImGui::Text("%u/%u RenderCommands moved by sorting (%u incremental sorts)", sorting.movedCommands, sorting.sortedCommands, sorting.incrementalSorts);
+		if (theApplication().renderingSettings().spatialIndexEnabled)
+		{
+			ImGui::Text("%u indexed nodes, %u cells in %u queries (%u hits, %u misses), %u subtrees skipped", spatialIndex.indexedNodes,
+			            spatialIndex.queriedCells, spatialIndex.queries, spatialIndex.hits, spatialIndex.misses, spatialIndex.skippedSubtrees);
+		}
+		ImGui::Text("%u/%u state changes avoided (%u programs, %u textures, %u blending, %u scissor)", allStateChanges.avoided(), allStateChanges.requested,
+		            RenderStatistics::stateChanges(RenderStateTracker::StateTypes::SHADER_PROGRAM).avoided(),
+		            RenderStatistics::stateChanges(RenderStateTracker::StateTypes::TEXTURE).avoided(),
+		            RenderStatistics::stateChanges(RenderStateTracker::StateTypes::BLENDING).avoided(),
+		            RenderStatistics::stateChanges(RenderStateTracker::StateTypes::SCISSOR_TEST).avoided());
+		if (frozenSubtrees.recorded + frozenSubtrees.replayed > 0)
+		{
+			ImGui::Text("%u RenderCommands from %u frozen subtree(s) (%u recorded)", frozenSubtrees.commands,
+			            frozenSubtrees.recorded + frozenSubtrees.replayed, frozenSubtrees.recorded);
+		}
+		ImGui::Text("%.2f/%lu Kb in the frame arena (%.2f Kb peak, %u allocations, %u failed)", frameArena.usedBytes / 1024.0f,
+		            frameArena.size / 1024, frameArena.peakBytes / 1024.0f, frameArena.allocations, frameArena.failedAllocations);
 #endif
 		ImGui::Text("%.2f Kb in %u custom VBO(s)", customVbos.dataSize / 1024.0f, customVbos.count);
 		ImGui::Text("%.2f Kb in %u custom IBO(s)", customIbos.dataSize / 1024.0f, customIbos.count);
@@ -2232,6 +2347,10 @@ void ImGuiDebugOverlay::guiTopLeft()
 			ImGui::PlotLines("", plotValues_[ValuesType::UBO_USED].get(), numValues_, 0, nullptr, 0.0f, uboBuffers.size / 1024.0f);
 		}
 
+		const BufferRing *bufferRing = RenderResources::buffersManager().ring();
+		if (bufferRing)
+			ImGui::Text("Buffers ring region %u (%lu blocking waits in %lu frames)", bufferRing->currentRegion(), bufferRing->numBlockingWaits(), bufferRing->numAdvances());
+
 		if (RenderResources::binaryShaderCache().isAvailable())
 			ImGui::Text("Binary Shaders: %u Kb in %u file(s)", shaderCacheStats.TotalBytesCount / 1024, shaderCacheStats.TotalFilesCount);
 #ifdef WITH_SCENEGRAPH
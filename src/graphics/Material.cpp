@@ -1,6 +1,7 @@
 #include <cstddef> // for offsetof()
 #include "Material.h"
 #include "RenderResources.h"
+#include "RenderStateTracker.h"
 #include "GLShaderProgram.h"
 #include "GLUniform.h"
 #include "GLTexture.h"
@@ -43,11 +44,14 @@ Material::Material()
 
 Material::Material(GLShaderProgram *program, GLTexture *texture)
     : isBlendingEnabled_(false), srcBlendingFactor_(GL_SRC_ALPHA), destBlendingFactor_(GL_ONE_MINUS_SRC_ALPHA),
-      shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program), uniformsHostBufferSize_(0)
+      shaderProgramType_(ShaderProgramType::CUSTOM), shaderProgram_(program),
+      instanceBlock_(nullptr), uniformsHostBufferSize_(0)
 {
 	for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
 		textures_[i] = nullptr;
 	textures_[0] = texture;
+	for (unsigned int i = 0; i < BuiltinUniforms::COUNT; i++)
+		builtinUniforms_[i] = nullptr;
 
 	if (program)
 		setShaderProgram(program);
@@ -85,6 +89,7 @@ void Material::setShaderProgram(GLShaderProgram *program)
 	// The camera uniforms are handled separately as they have a different update frequency
 	shaderUniforms_.setProgram(shaderProgram_, nullptr, ProjectionViewMatrixExcludeString);
 	shaderUniformBlocks_.setProgram(shaderProgram_);
+	resolveBuiltinUniforms();
 
 	RenderResources::setDefaultAttributesParameters(*shaderProgram_);
 }
@@ -151,21 +156,28 @@ bool Material::setTexture(unsigned int unit, const Texture &texture)
 
 void Material::bind()
 {
-	for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
-	{
-		if (textures_[i] != nullptr)
-			textures_[i]->bind(i);
-		else
-			GLTexture::unbind(i);
-	}
+	RenderStateTracker::applyTextures(textures_);
 
 	if (shaderProgram_)
 	{
-		shaderProgram_->use();
+		RenderStateTracker::applyShaderProgram(*shaderProgram_);
 		shaderUniformBlocks_.bind();
 	}
 }
 
+void Material::resolveBuiltinUniforms()
+{
+	instanceBlock_ = shaderUniformBlocks_.uniformBlock(InstanceBlockName);
+	builtinUniforms_[BuiltinUniforms::TEXTURE] = shaderUniforms_.uniform(TextureUniformName);
+
+	static const char *blockUniformNames[BuiltinUniforms::COUNT] = {
+		nullptr, ModelMatrixUniformName, ModelTransformUniformName, ModelTranslationUniformName,
+		ColorUniformName, SpriteSizeUniformName, TexRectUniformName, UvEndpointsUUniformName, UvEndpointsVUniformName
+	};
+	for (unsigned int i = BuiltinUniforms::TEXTURE + 1; i < BuiltinUniforms::COUNT; i++)
+		builtinUniforms_[i] = instanceBlock_ ? instanceBlock_->uniform(blockUniformNames[i]) : shaderUniforms_.uniform(blockUniformNames[i]);
+}
+
 void Material::defineVertexFormat(const GLBufferObject *vbo, const GLBufferObject *ibo, unsigned int vboOffset)
 {
 	shaderProgram_->defineVertexFormat(vbo, ibo, vboOffset);
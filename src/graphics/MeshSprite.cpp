@@ -65,6 +65,7 @@ void MeshSprite::copyVertices(unsigned int numVertices, unsigned int bytesPerVer
 	renderCommand_->geometry().setNumVertices(numVertices);
 	renderCommand_->geometry().setNumElementsPerVertex(floatsPerVertex);
 	renderCommand_->geometry().setHostVertexPointer(vertexDataPointer_);
+	drawingHasChanged();
 }
 
 void MeshSprite::copyVertices(unsigned int numVertices, const Vertex *vertices)
@@ -103,6 +104,7 @@ void MeshSprite::setVertices(unsigned int numVertices, unsigned int bytesPerVert
 	renderCommand_->geometry().setNumVertices(numVertices);
 	renderCommand_->geometry().setNumElementsPerVertex(floatsPerVertex);
 	renderCommand_->geometry().setHostVertexPointer(vertexDataPointer_);
+	drawingHasChanged();
 }
 
 void MeshSprite::setVertices(unsigned int numVertices, const Vertex *vertices)
@@ -143,6 +145,7 @@ float *MeshSprite::emplaceVertices(unsigned int numElements, unsigned int bytesP
 	renderCommand_->geometry().setNumVertices(numVertices);
 	renderCommand_->geometry().setNumElementsPerVertex(floatsPerVertex);
 	renderCommand_->geometry().setHostVertexPointer(vertexDataPointer_);
+	drawingHasChanged();
 
 	return vertices_.data();
 }
@@ -217,6 +220,7 @@ void MeshSprite::createVerticesFromTexels(unsigned int numVertices, const Vector
 
 	dirtyBits_.set(DirtyBitPositions::SizeBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	drawingHasChanged();
 }
 
 void MeshSprite::createVerticesFromTexels(unsigned int numVertices, const Vector2f *points)
@@ -233,6 +237,7 @@ void MeshSprite::copyIndices(unsigned int numIndices, const unsigned short *indi
 	numIndices_ = numIndices;
 	renderCommand_->geometry().setNumIndices(numIndices_);
 	renderCommand_->geometry().setHostIndexPointer(indexDataPointer_);
+	drawingHasChanged();
 }
 
 void MeshSprite::copyIndices(const MeshSprite &meshSprite)
@@ -248,6 +253,7 @@ void MeshSprite::setIndices(unsigned int numIndices, const unsigned short *indic
 	numIndices_ = numIndices;
 	renderCommand_->geometry().setNumIndices(numIndices_);
 	renderCommand_->geometry().setHostIndexPointer(indexDataPointer_);
+	drawingHasChanged();
 }
 
 void MeshSprite::setIndices(const MeshSprite &meshSprite)
@@ -267,6 +273,7 @@ unsigned short *MeshSprite::emplaceIndices(unsigned int numIndices)
 	numIndices_ = numIndices;
 	renderCommand_->geometry().setNumIndices(numIndices_);
 	renderCommand_->geometry().setHostIndexPointer(indexDataPointer_);
+	drawingHasChanged();
 
 	return indices_.data();
 }
@@ -1,9 +1,44 @@
 #include <nctl/algorithms.h>
 #include "ParticleAffectors.h"
 #include "Particle.h"
+#include "ParticleArrays.h"
 
 namespace ncine {
 
+namespace {
+	/// The number of particles processed at once by affectors that accumulate values
+	const unsigned int BatchBlockSize = 64;
+
+	/// Interpolates a component of the affector steps for a span of normalized ages
+	/*! Every interval between two steps is an age bucket that adds its share of the value difference.
+	 *  Comparisons are converted to float masks, so the loops have no branches and can be vectorized. */
+	template <class StepType, class ComponentFunc>
+	void interpolateSteps(const nctl::Array<StepType> &steps, ComponentFunc component, const float *ages, float *values, unsigned int count)
+	{
+		ASSERT(steps.isEmpty() == false);
+
+		const float firstValue = component(steps[0]);
+		for (unsigned int i = 0; i < count; i++)
+			values[i] = firstValue;
+
+		for (unsigned int s = 1; s < steps.size(); s++)
+		{
+			const float prevAge = steps[s - 1].age;
+			const float nextAge = steps[s].age;
+			const float difference = component(steps[s]) - component(steps[s - 1]);
+			const float invAgeRange = (nextAge > prevAge) ? 1.0f / (nextAge - prevAge) : 0.0f;
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				const float started = static_cast<float>(ages[i] >= prevAge);
+				const float ended = static_cast<float>(ages[i] >= nextAge);
+				const float factor = started * (ages[i] - prevAge) * invAgeRange;
+				values[i] += difference * (factor + ended * (1.0f - factor));
+			}
+		}
+	}
+}
+
 ///////////////////////////////////////////////////////////
 // PUBLIC FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -14,6 +49,15 @@ void ParticleAffector::affect(Particle *particle)
 	affect(particle, normalizedAge);
 }
 
+/*! \note The default implementation calls the single particle method for every particle in the span */
+void ParticleAffector::affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size());
+
+	for (unsigned int i = first; i < first + count; i++)
+		affect(particles, i, particles.normalizedAge[i]);
+}
+
 ///////////////////////////////////////////////////////////
 // COLOR AFFECTOR
 ///////////////////////////////////////////////////////////
@@ -51,16 +95,46 @@ void ColorAffector::affect(Particle *particle, float normalizedAge)
 	if (enabled_ == false || colorSteps_.isEmpty())
 		return;
 
-	if (normalizedAge <= colorSteps_[0].age)
-	{
-		particle->setColorF(colorSteps_[0].color);
+	particle->setColorF(colorAt(normalizedAge));
+}
+
+void ColorAffector::affect(ParticleArrays &particles, unsigned int index, float normalizedAge)
+{
+	ASSERT(index < particles.size());
+	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || colorSteps_.isEmpty())
 		return;
-	}
-	else if (normalizedAge >= colorSteps_.back().age)
-	{
-		particle->setColorF(colorSteps_.back().color);
+
+	const Colorf color = colorAt(normalizedAge);
+	particles.colorR[index] = color.r();
+	particles.colorG[index] = color.g();
+	particles.colorB[index] = color.b();
+	particles.colorA[index] = color.a();
+}
+
+void ColorAffector::affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size());
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || colorSteps_.isEmpty())
 		return;
-	}
+
+	const float *ages = particles.normalizedAge + first;
+	interpolateSteps(colorSteps_, [](const ColorStep &step) { return step.color.r(); }, ages, particles.colorR + first, count);
+	interpolateSteps(colorSteps_, [](const ColorStep &step) { return step.color.g(); }, ages, particles.colorG + first, count);
+	interpolateSteps(colorSteps_, [](const ColorStep &step) { return step.color.b(); }, ages, particles.colorB + first, count);
+	interpolateSteps(colorSteps_, [](const ColorStep &step) { return step.color.a(); }, ages, particles.colorA + first, count);
+}
+
+Colorf ColorAffector::colorAt(float normalizedAge) const
+{
+	if (normalizedAge <= colorSteps_[0].age)
+		return colorSteps_[0].color;
+	else if (normalizedAge >= colorSteps_.back().age)
+		return colorSteps_.back().color;
 
 	unsigned int index = 0;
 	for (index = 0; index < colorSteps_.size() - 1; index++)
@@ -78,9 +152,8 @@ void ColorAffector::affect(Particle *particle, float normalizedAge)
 	const float green = prevStep.color.g() + (nextStep.color.g() - prevStep.color.g()) * factor;
 	const float blue = prevStep.color.b() + (nextStep.color.b() - prevStep.color.b()) * factor;
 	const float alpha = prevStep.color.a() + (nextStep.color.a() - prevStep.color.a()) * factor;
-	const Colorf color(red, green, blue, alpha);
 
-	particle->setColorF(color);
+	return Colorf(red, green, blue, alpha);
 }
 
 ///////////////////////////////////////////////////////////
@@ -120,24 +193,66 @@ void SizeAffector::affect(Particle *particle, float normalizedAge)
 	if (enabled_ == false)
 		return;
 
-	// Zero steps in the affector
+	particle->setScale(scaleAt(normalizedAge));
+}
+
+void SizeAffector::affect(ParticleArrays &particles, unsigned int index, float normalizedAge)
+{
+	ASSERT(index < particles.size());
+	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
+
+	// Affector is disabled
+	if (enabled_ == false)
+		return;
+
+	const Vector2f scale = scaleAt(normalizedAge);
+	particles.scaleX[index] = scale.x;
+	particles.scaleY[index] = scale.y;
+}
+
+void SizeAffector::affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size());
+
+	// Affector is disabled
+	if (enabled_ == false)
+		return;
+
+	float *scaleX = particles.scaleX + first;
+	float *scaleY = particles.scaleY + first;
+
+	// Applying base scale even with no steps
 	if (sizeSteps_.isEmpty())
 	{
-		// Applying base scale even with no steps
-		particle->setScale(baseScale_);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			scaleX[i] = baseScale_.x;
+			scaleY[i] = baseScale_.y;
+		}
 		return;
 	}
 
-	if (normalizedAge <= sizeSteps_[0].age)
+	const float *ages = particles.normalizedAge + first;
+	interpolateSteps(sizeSteps_, [](const SizeStep &step) { return step.scale.x; }, ages, scaleX, count);
+	interpolateSteps(sizeSteps_, [](const SizeStep &step) { return step.scale.y; }, ages, scaleY, count);
+
+	for (unsigned int i = 0; i < count; i++)
 	{
-		particle->setScale(baseScale_ * sizeSteps_[0].scale);
-		return;
+		scaleX[i] *= baseScale_.x;
+		scaleY[i] *= baseScale_.y;
 	}
+}
+
+Vector2f SizeAffector::scaleAt(float normalizedAge) const
+{
+	// Applying base scale even with no steps
+	if (sizeSteps_.isEmpty())
+		return baseScale_;
+
+	if (normalizedAge <= sizeSteps_[0].age)
+		return baseScale_ * sizeSteps_[0].scale;
 	else if (normalizedAge >= sizeSteps_.back().age)
-	{
-		particle->setScale(baseScale_ * sizeSteps_.back().scale);
-		return;
-	}
+		return baseScale_ * sizeSteps_.back().scale;
 
 	unsigned int index = 0;
 	for (index = 0; index < sizeSteps_.size() - 1; index++)
@@ -153,7 +268,7 @@ void SizeAffector::affect(Particle *particle, float normalizedAge)
 	const float factor = (normalizedAge - prevStep.age) / (nextStep.age - prevStep.age);
 	const Vector2f newScale = prevStep.scale + (nextStep.scale - prevStep.scale) * factor;
 
-	particle->setScale(baseScale_ * newScale);
+	return baseScale_ * newScale;
 }
 
 ///////////////////////////////////////////////////////////
@@ -193,16 +308,43 @@ void RotationAffector::affect(Particle *particle, float normalizedAge)
 	if (enabled_ == false || rotationSteps_.isEmpty())
 		return;
 
-	if (normalizedAge <= rotationSteps_[0].age)
-	{
-		particle->setRotation(particle->startingRotation + rotationSteps_[0].angle);
+	particle->setRotation(particle->startingRotation + angleAt(normalizedAge));
+}
+
+void RotationAffector::affect(ParticleArrays &particles, unsigned int index, float normalizedAge)
+{
+	ASSERT(index < particles.size());
+	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || rotationSteps_.isEmpty())
 		return;
-	}
-	else if (normalizedAge >= rotationSteps_.back().age)
-	{
-		particle->setRotation(particle->startingRotation + rotationSteps_.back().angle);
+
+	particles.rotation[index] = particles.startingRotation[index] + angleAt(normalizedAge);
+}
+
+void RotationAffector::affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size());
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || rotationSteps_.isEmpty())
 		return;
-	}
+
+	float *rotation = particles.rotation + first;
+	const float *startingRotation = particles.startingRotation + first;
+	interpolateSteps(rotationSteps_, [](const RotationStep &step) { return step.angle; }, particles.normalizedAge + first, rotation, count);
+
+	for (unsigned int i = 0; i < count; i++)
+		rotation[i] += startingRotation[i];
+}
+
+float RotationAffector::angleAt(float normalizedAge) const
+{
+	if (normalizedAge <= rotationSteps_[0].age)
+		return rotationSteps_[0].angle;
+	else if (normalizedAge >= rotationSteps_.back().age)
+		return rotationSteps_.back().angle;
 
 	unsigned int index = 0;
 	for (index = 0; index < rotationSteps_.size() - 1; index++)
@@ -218,7 +360,7 @@ void RotationAffector::affect(Particle *particle, float normalizedAge)
 	const float factor = (normalizedAge - prevStep.age) / (nextStep.age - prevStep.age);
 	const float newAngle = prevStep.angle + (nextStep.angle - prevStep.angle) * factor;
 
-	particle->setRotation(particle->startingRotation + newAngle);
+	return newAngle;
 }
 
 ///////////////////////////////////////////////////////////
@@ -258,16 +400,57 @@ void PositionAffector::affect(Particle *particle, float normalizedAge)
 	if (enabled_ == false || positionSteps_.isEmpty())
 		return;
 
-	if (normalizedAge <= positionSteps_[0].age)
-	{
-		particle->move(positionSteps_[0].position);
+	particle->move(positionAt(normalizedAge));
+}
+
+void PositionAffector::affect(ParticleArrays &particles, unsigned int index, float normalizedAge)
+{
+	ASSERT(index < particles.size());
+	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || positionSteps_.isEmpty())
 		return;
-	}
-	else if (normalizedAge >= positionSteps_.back().age)
-	{
-		particle->move(positionSteps_.back().position);
+
+	const Vector2f position = positionAt(normalizedAge);
+	particles.positionX[index] += position.x;
+	particles.positionY[index] += position.y;
+}
+
+void PositionAffector::affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size());
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || positionSteps_.isEmpty())
 		return;
+
+	// Interpolated values are accumulated, a block at a time, from a temporary buffer on the stack
+	float valuesX[BatchBlockSize];
+	float valuesY[BatchBlockSize];
+	for (unsigned int blockStart = first; blockStart < first + count; blockStart += BatchBlockSize)
+	{
+		const unsigned int blockSize = nctl::min(BatchBlockSize, first + count - blockStart);
+		const float *ages = particles.normalizedAge + blockStart;
+		interpolateSteps(positionSteps_, [](const PositionStep &step) { return step.position.x; }, ages, valuesX, blockSize);
+		interpolateSteps(positionSteps_, [](const PositionStep &step) { return step.position.y; }, ages, valuesY, blockSize);
+
+		float *positionX = particles.positionX + blockStart;
+		float *positionY = particles.positionY + blockStart;
+		for (unsigned int i = 0; i < blockSize; i++)
+		{
+			positionX[i] += valuesX[i];
+			positionY[i] += valuesY[i];
+		}
 	}
+}
+
+Vector2f PositionAffector::positionAt(float normalizedAge) const
+{
+	if (normalizedAge <= positionSteps_[0].age)
+		return positionSteps_[0].position;
+	else if (normalizedAge >= positionSteps_.back().age)
+		return positionSteps_.back().position;
 
 	unsigned int index = 0;
 	for (index = 0; index < positionSteps_.size() - 1; index++)
@@ -283,7 +466,7 @@ void PositionAffector::affect(Particle *particle, float normalizedAge)
 	const float factor = (normalizedAge - prevStep.age) / (nextStep.age - prevStep.age);
 	const Vector2f newPosition = prevStep.position + (nextStep.position - prevStep.position) * factor;
 
-	particle->move(newPosition);
+	return newPosition;
 }
 
 ///////////////////////////////////////////////////////////
@@ -323,16 +506,57 @@ void VelocityAffector::affect(Particle *particle, float normalizedAge)
 	if (enabled_ == false || velocitySteps_.isEmpty())
 		return;
 
-	if (normalizedAge <= velocitySteps_[0].age)
-	{
-		particle->velocity_ += velocitySteps_[0].velocity;
+	particle->velocity_ += velocityAt(normalizedAge);
+}
+
+void VelocityAffector::affect(ParticleArrays &particles, unsigned int index, float normalizedAge)
+{
+	ASSERT(index < particles.size());
+	ASSERT(normalizedAge >= 0.0f && normalizedAge <= 1.0f);
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || velocitySteps_.isEmpty())
 		return;
-	}
-	else if (normalizedAge >= velocitySteps_.back().age)
-	{
-		particle->velocity_ += velocitySteps_.back().velocity;
+
+	const Vector2f velocity = velocityAt(normalizedAge);
+	particles.velocityX[index] += velocity.x;
+	particles.velocityY[index] += velocity.y;
+}
+
+void VelocityAffector::affectBatch(ParticleArrays &particles, unsigned int first, unsigned int count)
+{
+	ASSERT(first + count <= particles.size());
+
+	// Affector is disabled or has zero steps
+	if (enabled_ == false || velocitySteps_.isEmpty())
 		return;
+
+	// Interpolated values are accumulated, a block at a time, from a temporary buffer on the stack
+	float valuesX[BatchBlockSize];
+	float valuesY[BatchBlockSize];
+	for (unsigned int blockStart = first; blockStart < first + count; blockStart += BatchBlockSize)
+	{
+		const unsigned int blockSize = nctl::min(BatchBlockSize, first + count - blockStart);
+		const float *ages = particles.normalizedAge + blockStart;
+		interpolateSteps(velocitySteps_, [](const VelocityStep &step) { return step.velocity.x; }, ages, valuesX, blockSize);
+		interpolateSteps(velocitySteps_, [](const VelocityStep &step) { return step.velocity.y; }, ages, valuesY, blockSize);
+
+		float *velocityX = particles.velocityX + blockStart;
+		float *velocityY = particles.velocityY + blockStart;
+		for (unsigned int i = 0; i < blockSize; i++)
+		{
+			velocityX[i] += valuesX[i];
+			velocityY[i] += valuesY[i];
+		}
 	}
+}
+
+Vector2f VelocityAffector::velocityAt(float normalizedAge) const
+{
+	if (normalizedAge <= velocitySteps_[0].age)
+		return velocitySteps_[0].velocity;
+	else if (normalizedAge >= velocitySteps_.back().age)
+		return velocitySteps_.back().velocity;
 
 	unsigned int index = 0;
 	for (index = 0; index < velocitySteps_.size() - 1; index++)
@@ -348,7 +572,7 @@ void VelocityAffector::affect(Particle *particle, float normalizedAge)
 	const float factor = (normalizedAge - prevStep.age) / (nextStep.age - prevStep.age);
 	const Vector2f newVelocity = prevStep.velocity + (nextStep.velocity - prevStep.velocity) * factor;
 
-	particle->velocity_ += newVelocity;
+	return newVelocity;
 }
 
 }
@@ -0,0 +1,86 @@
+#include "common_macros.h"
+#include "ParticleArrays.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ParticleArrays::ParticleArrays()
+    : ParticleArrays(0)
+{
+}
+
+ParticleArrays::ParticleArrays(unsigned int capacity)
+    : life(nullptr), startingLife(nullptr), startingRotation(nullptr),
+      positionX(nullptr), positionY(nullptr), velocityX(nullptr), velocityY(nullptr),
+      scaleX(nullptr), scaleY(nullptr), rotation(nullptr),
+      colorR(nullptr), colorG(nullptr), colorB(nullptr), colorA(nullptr), normalizedAge(nullptr),
+      capacity_(capacity), size_(0)
+{
+	if (capacity_ == 0)
+		return;
+
+	// Every array starts at a multiple of four floats from the beginning of the buffer
+	const unsigned int stride = (capacity_ + 3) & ~3u;
+	buffer_ = nctl::makeUnique<float[]>(stride * NumArrays);
+
+	float *arrays[NumArrays];
+	for (unsigned int i = 0; i < NumArrays; i++)
+		arrays[i] = buffer_.get() + stride * i;
+
+	life = arrays[0];
+	startingLife = arrays[1];
+	startingRotation = arrays[2];
+	positionX = arrays[3];
+	positionY = arrays[4];
+	velocityX = arrays[5];
+	velocityY = arrays[6];
+	scaleX = arrays[7];
+	scaleY = arrays[8];
+	rotation = arrays[9];
+	colorR = arrays[10];
+	colorG = arrays[11];
+	colorB = arrays[12];
+	colorA = arrays[13];
+	normalizedAge = arrays[14];
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned int ParticleArrays::add()
+{
+	FATAL_ASSERT(size_ < capacity_);
+	return size_++;
+}
+
+void ParticleArrays::remove(unsigned int index)
+{
+	ASSERT(index < size_);
+
+	const unsigned int last = size_ - 1;
+	if (index != last)
+	{
+		life[index] = life[last];
+		startingLife[index] = startingLife[last];
+		startingRotation[index] = startingRotation[last];
+		positionX[index] = positionX[last];
+		positionY[index] = positionY[last];
+		velocityX[index] = velocityX[last];
+		velocityY[index] = velocityY[last];
+		scaleX[index] = scaleX[last];
+		scaleY[index] = scaleY[last];
+		rotation[index] = rotation[last];
+		colorR[index] = colorR[last];
+		colorG[index] = colorG[last];
+		colorB[index] = colorB[last];
+		colorA[index] = colorA[last];
+		// The normalized age is not moved as it is recalculated every frame
+	}
+	size_--;
+}
+
+}
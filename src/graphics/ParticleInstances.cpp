@@ -0,0 +1,246 @@
+#include <cfloat> // for FLT_MAX
+#include <nctl/algorithms.h>
+#include "ParticleInstances.h"
+#include "ParticleSystem.h"
+#include "ParticleArrays.h"
+#include "RenderCommand.h"
+#include "RenderResources.h"
+#include "Camera.h"
+#include "Texture.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+	const unsigned int MaxFloatsPerInstance = sizeof(RenderResources::InstanceFormatSprite) / sizeof(GLfloat);
+
+	/// Packs four color components in the same layout returned by `Color::abgr()`
+	inline uint32_t packColor(float red, float green, float blue, float alpha)
+	{
+		const uint32_t r = static_cast<uint32_t>(nctl::clamp(red, 0.0f, 1.0f) * 255.0f);
+		const uint32_t g = static_cast<uint32_t>(nctl::clamp(green, 0.0f, 1.0f) * 255.0f);
+		const uint32_t b = static_cast<uint32_t>(nctl::clamp(blue, 0.0f, 1.0f) * 255.0f);
+		const uint32_t a = static_cast<uint32_t>(nctl::clamp(alpha, 0.0f, 1.0f) * 255.0f);
+		return (a << 24) | (b << 16) | (g << 8) | r;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ParticleInstances::ParticleInstances(ParticleSystem *parent, unsigned int capacity, Texture *texture, const Recti &texRect)
+    : BaseSprite(parent, texture, 0.0f, 0.0f), capacity_(capacity),
+      instanceData_(nctl::makeUnique<float[]>(capacity * MaxFloatsPerInstance)),
+      minPosition_(0.0f, 0.0f), maxPosition_(0.0f, 0.0f), maxScale_(1.0f),
+      uvEndpointsU_(0), uvEndpointsV_(0)
+{
+	ZoneScoped;
+	type_ = ObjectType::PARTICLE;
+	renderCommand_->setType(RenderCommand::CommandTypes::PARTICLE);
+
+	const Material::ShaderProgramType shaderProgramType = texture_ ? Material::ShaderProgramType::SPRITE_ATTRIBS
+	                                                               : Material::ShaderProgramType::SPRITE_NO_TEXTURE_ATTRIBS;
+	renderCommand_->material().setShaderProgramType(shaderProgramType);
+	shaderHasChanged();
+
+	// A single quad is drawn once per alive particle, reading per-instance attributes from a custom VBO
+	renderCommand_->geometry().setDrawParameters(GL_TRIANGLE_STRIP, 0, 4);
+	renderCommand_->geometry().createCustomVbo(capacity_ * MaxFloatsPerInstance, GL_DYNAMIC_DRAW);
+
+	if (texture_)
+		setTexRect(texRect);
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ParticleInstances::setParticlesBounds(const Vector2f &minPosition, const Vector2f &maxPosition, float maxScale)
+{
+	minPosition_ = minPosition;
+	maxPosition_ = maxPosition;
+	maxScale_ = maxScale;
+	dirtyBits_.set(DirtyBitPositions::AabbBit);
+}
+
+bool ParticleInstances::draw(RenderQueue &renderQueue)
+{
+	// A render command with no instances would be drawn as a single quad
+	const ParticleSystem *particleSystem = static_cast<const ParticleSystem *>(parent_);
+	if (particleSystem->particleArrays().isEmpty())
+		return false;
+
+	return DrawableNode::draw(renderQueue);
+}
+
+///////////////////////////////////////////////////////////
+// PROTECTED FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ParticleInstances::shaderHasChanged()
+{
+	BaseSprite::shaderHasChanged();
+
+	GLShaderProgram *shaderProgram = renderCommand_->material().shaderProgram();
+	if (shaderProgram && renderCommand_->material().shaderProgramType() != Material::ShaderProgramType::CUSTOM)
+		RenderResources::setInstanceAttributesParameters(*shaderProgram);
+}
+
+void ParticleInstances::textureHasChanged(Texture *newTexture)
+{
+	if (renderCommand_->material().shaderProgramType() != Material::ShaderProgramType::CUSTOM)
+	{
+		const Material::ShaderProgramType shaderProgramType = newTexture ? Material::ShaderProgramType::SPRITE_ATTRIBS
+		                                                                 : Material::ShaderProgramType::SPRITE_NO_TEXTURE_ATTRIBS;
+		const bool hasChanged = renderCommand_->material().setShaderProgramType(shaderProgramType);
+		if (hasChanged)
+			shaderHasChanged();
+	}
+
+	if (newTexture && texture_ != newTexture)
+		setTexRect(Recti(0, 0, newTexture->width(), newTexture->height()));
+}
+
+void ParticleInstances::updateRenderCommand()
+{
+	ZoneScoped;
+
+	if (dirtyBits_.test(DirtyBitPositions::TextureBit))
+	{
+		if (texture_)
+		{
+			renderCommand_->material().setTexture(*texture_);
+
+			const Vector2i texSize = texture_->size();
+			const float u0 = texRect_.x / float(texSize.x);
+			const float u1 = (texRect_.x + texRect_.w) / float(texSize.x);
+			const float v0 = texRect_.y / float(texSize.y);
+			const float v1 = (texRect_.y + texRect_.h) / float(texSize.y);
+
+			const uint16_t packedU0 = uint16_t(u0 * 65535.0f + 0.5f);
+			const uint16_t packedU1 = uint16_t(u1 * 65535.0f + 0.5f);
+			const uint16_t packedV0 = uint16_t(v0 * 65535.0f + 0.5f);
+			const uint16_t packedV1 = uint16_t(v1 * 65535.0f + 0.5f);
+
+			uvEndpointsU_ = packedU0 | (uint32_t(packedU1) << 16);
+			uvEndpointsV_ = packedV0 | (uint32_t(packedV1) << 16);
+		}
+		else
+			renderCommand_->material().setTexture(nullptr);
+
+		dirtyBits_.reset(DirtyBitPositions::TextureBit);
+	}
+	// The size is packed in every instance and it does not need a separate upload
+	dirtyBits_.reset(DirtyBitPositions::SizeBit);
+
+	const ParticleSystem *particleSystem = static_cast<const ParticleSystem *>(parent_);
+	const ParticleArrays &particles = particleSystem->particleArrays();
+	const unsigned int numInstances = particles.size();
+	const unsigned int numFloats = numFloatsPerInstance();
+
+	const Camera::ProjectionValues cameraValues = RenderResources::currentCamera()->projectionValues();
+	const float depth = RenderCommand::calculateDepth(renderCommand_->layer(), cameraValues.near, cameraValues.far);
+
+	// Particles not in local space are already positioned in world coordinates
+	const bool inLocalSpace = particleSystem->inLocalSpace();
+	const AffineTransform2Df m = particleSystem->worldTransform();
+	const float m00 = inLocalSpace ? m[0].x : 1.0f;
+	const float m01 = inLocalSpace ? m[1].x : 0.0f;
+	const float m10 = inLocalSpace ? m[0].y : 0.0f;
+	const float m11 = inLocalSpace ? m[1].y : 1.0f;
+	const float tx = inLocalSpace ? m[2].x : 0.0f;
+	const float ty = inLocalSpace ? m[2].y : 0.0f;
+
+	const Colorf nodeColor(absColor_);
+	const uint32_t spriteSize = (uint32_t(width_) & 0xFFFFu) | ((uint32_t(height_) & 0xFFFFu) << 16);
+	const bool withTexture = (numFloats == MaxFloatsPerInstance);
+
+	uint8_t *instanceData = reinterpret_cast<uint8_t *>(instanceData_.get());
+	for (unsigned int i = 0; i < numInstances; i++)
+	{
+		// The structure with a texture shares its first members with the one without
+		RenderResources::InstanceFormatSprite *instance = reinterpret_cast<RenderResources::InstanceFormatSprite *>(instanceData + i * numFloats * sizeof(GLfloat));
+
+		const float sinRot = sinf(particles.rotation[i] * fDegToRad);
+		const float cosRot = cosf(particles.rotation[i] * fDegToRad);
+		// Rotation and scale of the particle, the same as in `SceneNode::transform()`
+		const float a = cosRot * particles.scaleX[i];
+		const float b = -sinRot * particles.scaleY[i];
+		const float c = sinRot * particles.scaleX[i];
+		const float d = cosRot * particles.scaleY[i];
+		const float x = particles.positionX[i] - (a * anchorPoint_.x + b * anchorPoint_.y);
+		const float y = particles.positionY[i] - (c * anchorPoint_.x + d * anchorPoint_.y);
+
+		instance->transform[0] = m00 * a + m01 * c;
+		instance->transform[1] = m00 * b + m01 * d;
+		instance->transform[2] = m10 * a + m11 * c;
+		instance->transform[3] = m10 * b + m11 * d;
+
+		instance->translation[0] = m00 * x + m01 * y + tx;
+		instance->translation[1] = m10 * x + m11 * y + ty;
+		instance->translation[2] = depth;
+		instance->translation[3] = 0.0f;
+
+		instance->color = packColor(particles.colorR[i] * nodeColor.r(), particles.colorG[i] * nodeColor.g(),
+		                            particles.colorB[i] * nodeColor.b(), particles.colorA[i] * nodeColor.a());
+		instance->spriteSize = spriteSize;
+		if (withTexture)
+		{
+			instance->uvEndpointsU = uvEndpointsU_;
+			instance->uvEndpointsV = uvEndpointsV_;
+		}
+	}
+
+	renderCommand_->geometry().setHostVertexPointer(instanceData_.get(), numInstances * numFloats);
+	renderCommand_->setNumInstances(numInstances);
+}
+
+void ParticleInstances::updateAabb()
+{
+	ZoneScoped;
+
+	// A particle can extend from its position by the half diagonal plus the anchor point offset
+	const float halfWidth = width_ * 0.5f;
+	const float halfHeight = height_ * 0.5f;
+	const float extent = maxScale_ * (sqrtf(halfWidth * halfWidth + halfHeight * halfHeight) + anchorPoint_.length());
+
+	const ParticleSystem *particleSystem = static_cast<const ParticleSystem *>(parent_);
+	if (particleSystem->inLocalSpace() == false)
+	{
+		aabb_.set(minPosition_.x - extent, minPosition_.y - extent,
+		          maxPosition_.x - minPosition_.x + 2.0f * extent, maxPosition_.y - minPosition_.y + 2.0f * extent);
+		return;
+	}
+
+	// Transforming the corners of the local bounds with the particle system world matrix
+	const AffineTransform2Df m = particleSystem->worldTransform();
+	const float xs[2] = { minPosition_.x - extent, maxPosition_.x + extent };
+	const float ys[2] = { minPosition_.y - extent, maxPosition_.y + extent };
+	Vector2f minCorner(FLT_MAX, FLT_MAX);
+	Vector2f maxCorner(-FLT_MAX, -FLT_MAX);
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		const float x = xs[i & 1];
+		const float y = ys[i >> 1];
+		const Vector2f world = Vector2f(x, y) * m;
+		minCorner.x = nctl::min(minCorner.x, world.x);
+		minCorner.y = nctl::min(minCorner.y, world.y);
+		maxCorner.x = nctl::max(maxCorner.x, world.x);
+		maxCorner.y = nctl::max(maxCorner.y, world.y);
+	}
+	aabb_.set(minCorner.x, minCorner.y, maxCorner.x - minCorner.x, maxCorner.y - minCorner.y);
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned int ParticleInstances::numFloatsPerInstance() const
+{
+	const size_t instanceStructSize = texture_ ? sizeof(RenderResources::InstanceFormatSprite)
+	                                           : sizeof(RenderResources::InstanceFormatSpriteNoTexture);
+	return instanceStructSize / sizeof(GLfloat);
+}
+
+}
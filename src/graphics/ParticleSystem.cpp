@@ -1,10 +1,18 @@
+#include <cfloat> // for FLT_MAX
+#include <nctl/algorithms.h>
 #include "ParticleSystem.h"
+#include "ParticleInstances.h"
 #include "Random.h"
 #include "Vector2.h"
 #include "ParticleInitializer.h"
 #include "Texture.h"
 #include "Application.h"
 
+#ifdef WITH_JOBSYSTEM
+	#include <nctl/Atomic.h>
+	#include "JobHandle.h"
+#endif
+
 #ifdef WITH_TRACY
 	#include <nctl/StaticString.h>
 #endif
@@ -17,8 +25,28 @@ namespace {
 #ifdef WITH_TRACY
 	nctl::StaticString<128> tracyInfoString;
 #endif
+
+#ifdef WITH_JOBSYSTEM
+	/// The maximum size of the node pointers updated by a single job, as every node needs a lot of work
+	const unsigned int NodesJobDataSize = 256 * sizeof(SceneNode *);
+	/// The maximum size of the particle lives updated by a single job, every other array is processed in the same range
+	const unsigned int ArraysJobDataSize = 4096 * sizeof(float);
+#endif
 }
 
+#ifdef WITH_JOBSYSTEM
+struct ParticleSystem::UpdateJobContext
+{
+	UpdateJobContext(ParticleSystem *system, float frameTime)
+	    : system(system), frameTime(frameTime), poolTop(system->poolTop_) {}
+
+	ParticleSystem *system;
+	float frameTime;
+	/// The index of the next free particle in the pool, shared by the jobs releasing dead particles
+	nctl::Atomic32 poolTop;
+};
+#endif
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -29,11 +57,17 @@ ParticleSystem::ParticleSystem(SceneNode *parent, unsigned int count, Texture *t
 }
 
 ParticleSystem::ParticleSystem(SceneNode *parent, unsigned int count, Texture *texture, Recti texRect)
-    : SceneNode(parent, 0, 0), poolSize_(count), poolTop_(count - 1),
-      particlePool_(poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
-      particleArray_(poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
+    : ParticleSystem(parent, count, texture, texRect, StorageMode::NODES)
+{
+}
+
+ParticleSystem::ParticleSystem(SceneNode *parent, unsigned int count, Texture *texture, Recti texRect, StorageMode storageMode)
+    : SceneNode(parent, 0, 0), storageMode_(storageMode), poolSize_(count), poolTop_(count - 1),
+      particlePool_((storageMode == StorageMode::NODES) ? poolSize_ : 0, nctl::ArrayMode::FIXED_CAPACITY),
+      particleArray_((storageMode == StorageMode::NODES) ? poolSize_ : 0, nctl::ArrayMode::FIXED_CAPACITY),
+      particleArrays_((storageMode == StorageMode::ARRAYS) ? poolSize_ : 0),
       affectors_(4), inLocalSpace_(false),
-      particlesUpdateEnabled_(true), affectorsEnabled_(true)
+      particlesUpdateEnabled_(true), affectorsEnabled_(true), parallelUpdateEnabled_(false)
 {
 	ZoneScoped;
 	if (texture && texture->name() != nullptr)
@@ -43,6 +77,14 @@ ParticleSystem::ParticleSystem(SceneNode *parent, unsigned int count, Texture *t
 	}
 
 	type_ = ObjectType::PARTICLE_SYSTEM;
+	// Particles are updated and visited by the system itself, every frame
+	setAlwaysUpdated(true);
+
+	if (storageMode_ == StorageMode::ARRAYS)
+	{
+		instances_ = nctl::makeUnique<ParticleInstances>(this, poolSize_, texture, texRect);
+		return;
+	}
 
 	children_.setCapacity(poolSize_);
 	for (unsigned int i = 0; i < poolSize_; i++)
@@ -54,6 +96,8 @@ ParticleSystem::ParticleSystem(SceneNode *parent, unsigned int count, Texture *t
 	}
 }
 
+ParticleSystem::~ParticleSystem() = default;
+
 ParticleSystem::ParticleSystem(ParticleSystem &&) = default;
 
 ParticleSystem &ParticleSystem::operator=(ParticleSystem &&) = default;
@@ -84,7 +128,9 @@ void ParticleSystem::emitParticles(const ParticleInitializer &init)
 	for (unsigned int i = 0; i < amount; i++)
 	{
 		// No more unused particles in the pool
-		if (poolTop_ < 0)
+		if (storageMode_ == StorageMode::NODES && poolTop_ < 0)
+			break;
+		else if (storageMode_ == StorageMode::ARRAYS && particleArrays_.size() == particleArrays_.capacity())
 			break;
 
 		const float life = random().real(init.rndLife.x, init.rndLife.y);
@@ -107,6 +153,26 @@ void ParticleSystem::emitParticles(const ParticleInitializer &init)
 		if (inLocalSpace_ == false)
 			position += absPosition();
 
+		if (storageMode_ == StorageMode::ARRAYS)
+		{
+			const unsigned int index = particleArrays_.add();
+			particleArrays_.life[index] = life;
+			particleArrays_.startingLife[index] = life;
+			particleArrays_.startingRotation[index] = rotation;
+			particleArrays_.positionX[index] = position.x;
+			particleArrays_.positionY[index] = position.y;
+			particleArrays_.velocityX[index] = velocity.x;
+			particleArrays_.velocityY[index] = velocity.y;
+			particleArrays_.scaleX[index] = 1.0f;
+			particleArrays_.scaleY[index] = 1.0f;
+			particleArrays_.rotation[index] = rotation;
+			particleArrays_.colorR[index] = 1.0f;
+			particleArrays_.colorG[index] = 1.0f;
+			particleArrays_.colorB[index] = 1.0f;
+			particleArrays_.colorA[index] = 1.0f;
+			continue;
+		}
+
 		// Acquiring a particle from the pool
 		particlePool_[poolTop_]->init(life, position, velocity, rotation, inLocalSpace_);
 		addChildNode(particlePool_[poolTop_]);
@@ -116,6 +182,12 @@ void ParticleSystem::emitParticles(const ParticleInitializer &init)
 
 void ParticleSystem::killParticles()
 {
+	if (storageMode_ == StorageMode::ARRAYS)
+	{
+		particleArrays_.clear();
+		return;
+	}
+
 	for (int i = children_.size() - 1; i >= 0; i--)
 	{
 		Particle *particle = static_cast<Particle *>(children_[i]);
@@ -134,54 +206,81 @@ void ParticleSystem::killParticles()
 
 void ParticleSystem::setTexture(Texture *texture)
 {
+	if (instances_)
+		instances_->setTexture(texture);
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setTexture(texture);
 }
 
 void ParticleSystem::setTexRect(const Recti &rect)
 {
+	if (instances_)
+		instances_->setTexRect(rect);
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setTexRect(rect);
 }
 
 void ParticleSystem::setAnchorPoint(float xx, float yy)
 {
+	if (instances_)
+		instances_->setAnchorPoint(xx, yy);
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setAnchorPoint(xx, yy);
 }
 
 void ParticleSystem::setAnchorPoint(const Vector2f &point)
 {
+	if (instances_)
+		instances_->setAnchorPoint(point);
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setAnchorPoint(point);
 }
 
 void ParticleSystem::setFlippedX(bool flippedX)
 {
+	if (instances_)
+		instances_->setFlippedX(flippedX);
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setFlippedX(flippedX);
 }
 
 void ParticleSystem::setFlippedY(bool flippedY)
 {
+	if (instances_)
+		instances_->setFlippedY(flippedY);
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setFlippedY(flippedY);
 }
 
 void ParticleSystem::setBlendingPreset(DrawableNode::BlendingPreset blendingPreset)
 {
+	if (instances_)
+		instances_->setBlendingPreset(blendingPreset);
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setBlendingPreset(blendingPreset);
 }
 
 void ParticleSystem::setBlendingFactors(DrawableNode::BlendingFactor srcBlendingFactor, DrawableNode::BlendingFactor destBlendingFactor)
 {
+	if (instances_)
+		instances_->setBlendingFactors(srcBlendingFactor, destBlendingFactor);
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setBlendingFactors(srcBlendingFactor, destBlendingFactor);
 }
 
 void ParticleSystem::setLayer(uint16_t layer)
 {
+	if (instances_)
+		instances_->setLayer(layer);
+
 	for (nctl::UniquePtr<Particle> &particle : particleArray_)
 		particle->setLayer(layer);
 }
@@ -195,37 +294,30 @@ void ParticleSystem::update(float frameTime)
 	// Overridden `update()` method should call `transform()` like `SceneNode::update()` does
 	SceneNode::transform();
 
-	for (int i = children_.size() - 1; i >= 0; i--)
+	if (storageMode_ == StorageMode::ARRAYS)
+		updateArrays(frameTime);
+	else
 	{
-		Particle *particle = static_cast<Particle *>(children_[i]);
+		bool updatedInParallel = false;
+#ifdef WITH_JOBSYSTEM
+		if (shouldUpdateInParallel())
+			updatedInParallel = updateNodesInParallel(frameTime);
+#endif
 
-		// Update the particle if it's alive
-		if (particle->isAlive())
+		if (updatedInParallel == false)
 		{
-			if (affectorsEnabled_)
-			{
-				// Calculating the normalized age only once per particle
-				const float normalizedAge = 1.0f - particle->life_ / particle->startingLife;
-				for (nctl::UniquePtr<ParticleAffector> &affector : affectors_)
-					affector->affect(particle, normalizedAge);
-			}
-
-			if (particlesUpdateEnabled_)
+			for (int i = children_.size() - 1; i >= 0; i--)
 			{
-				particle->update(frameTime);
+				Particle *particle = static_cast<Particle *>(children_[i]);
 
-				// Releasing the particle if it has just died
-				if (particle->isAlive() == false)
+				// Update the particle if it's alive, releasing it if it has just died
+				if (particle->isAlive() && updateParticle(particle, frameTime) == false)
 				{
 					poolTop_++;
 					particlePool_[poolTop_] = particle;
 					removeChildNodeAt(i);
-					continue;
 				}
 			}
-
-			// Transforming the particle only if it's still alive
-			particle->transform();
 		}
 	}
 
@@ -242,12 +334,13 @@ void ParticleSystem::update(float frameTime)
 ///////////////////////////////////////////////////////////
 
 ParticleSystem::ParticleSystem(const ParticleSystem &other)
-    : SceneNode(other), poolSize_(other.poolSize_), poolTop_(other.poolSize_ - 1),
-      particlePool_(other.poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
-      particleArray_(other.poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
+    : SceneNode(other), storageMode_(other.storageMode_), poolSize_(other.poolSize_), poolTop_(other.poolSize_ - 1),
+      particlePool_((other.storageMode_ == StorageMode::NODES) ? other.poolSize_ : 0, nctl::ArrayMode::FIXED_CAPACITY),
+      particleArray_((other.storageMode_ == StorageMode::NODES) ? other.poolSize_ : 0, nctl::ArrayMode::FIXED_CAPACITY),
+      particleArrays_((other.storageMode_ == StorageMode::ARRAYS) ? other.poolSize_ : 0),
       affectors_(4), inLocalSpace_(other.inLocalSpace_),
       particlesUpdateEnabled_(other.particlesUpdateEnabled_),
-      affectorsEnabled_(other.affectorsEnabled_)
+      affectorsEnabled_(other.affectorsEnabled_), parallelUpdateEnabled_(other.parallelUpdateEnabled_)
 {
 	ZoneScoped;
 	type_ = ObjectType::PARTICLE_SYSTEM;
@@ -275,6 +368,18 @@ ParticleSystem::ParticleSystem(const ParticleSystem &other)
 		}
 	}
 
+	if (storageMode_ == StorageMode::ARRAYS)
+	{
+		const ParticleInstances &otherInstances = *other.instances_;
+		instances_ = nctl::makeUnique<ParticleInstances>(this, poolSize_, const_cast<Texture *>(otherInstances.texture()), otherInstances.texRect());
+		instances_->setFlippedX(otherInstances.isFlippedX());
+		instances_->setFlippedY(otherInstances.isFlippedY());
+		instances_->setAnchorPoint(otherInstances.anchorPoint());
+		instances_->setBlendingFactors(otherInstances.srcBlendingFactor(), otherInstances.destBlendingFactor());
+		instances_->setLayer(otherInstances.layer());
+		return;
+	}
+
 	children_.setCapacity(poolSize_);
 	if (poolSize_ > 0)
 	{
@@ -294,4 +399,171 @@ ParticleSystem::ParticleSystem(const ParticleSystem &other)
 	}
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool ParticleSystem::updateParticle(Particle *particle, float frameTime)
+{
+	if (affectorsEnabled_)
+	{
+		// Calculating the normalized age only once per particle
+		const float normalizedAge = 1.0f - particle->life_ / particle->startingLife;
+		for (nctl::UniquePtr<ParticleAffector> &affector : affectors_)
+			affector->affect(particle, normalizedAge);
+	}
+
+	if (particlesUpdateEnabled_)
+	{
+		particle->update(frameTime);
+		if (particle->isAlive() == false)
+			return false;
+	}
+
+	// Transforming the particle only if it's still alive
+	particle->transform();
+	return true;
+}
+
+void ParticleSystem::updateArrays(float frameTime)
+{
+	ParticleArrays &particles = particleArrays_;
+
+	bool updatedInParallel = false;
+#ifdef WITH_JOBSYSTEM
+	if (shouldUpdateInParallel())
+		updatedInParallel = updateArraysInParallel(frameTime);
+#endif
+
+	if (updatedInParallel == false)
+		updateArraysRange(0, particles.size(), frameTime);
+
+	if (particlesUpdateEnabled_)
+	{
+		// Releasing dead particles, iterating backwards as the last alive one takes their place
+		for (int i = particles.size() - 1; i >= 0; i--)
+		{
+			if (particles.life[i] <= 0.0f)
+				particles.remove(i);
+		}
+	}
+
+	Vector2f minPosition(FLT_MAX, FLT_MAX);
+	Vector2f maxPosition(-FLT_MAX, -FLT_MAX);
+	float maxScale = 0.0f;
+	for (unsigned int i = 0; i < particles.size(); i++)
+	{
+		minPosition.x = nctl::min(minPosition.x, particles.positionX[i]);
+		minPosition.y = nctl::min(minPosition.y, particles.positionY[i]);
+		maxPosition.x = nctl::max(maxPosition.x, particles.positionX[i]);
+		maxPosition.y = nctl::max(maxPosition.y, particles.positionY[i]);
+		maxScale = nctl::max(maxScale, nctl::max(fabsf(particles.scaleX[i]), fabsf(particles.scaleY[i])));
+	}
+
+	if (particles.isEmpty() == false)
+		instances_->setParticlesBounds(minPosition, maxPosition, maxScale);
+
+	// The child node is not updated by `SceneNode::updateChildren()` as this method is overridden
+	instances_->update(frameTime);
+}
+
+void ParticleSystem::updateArraysRange(unsigned int first, unsigned int count, float frameTime)
+{
+	ParticleArrays &particles = particleArrays_;
+	const unsigned int last = first + count;
+
+	// Every step runs on the whole range of particles, with loops that compilers can vectorize
+	if (affectorsEnabled_)
+	{
+		for (unsigned int i = first; i < last; i++)
+			particles.normalizedAge[i] = 1.0f - particles.life[i] / particles.startingLife[i];
+
+		for (nctl::UniquePtr<ParticleAffector> &affector : affectors_)
+			affector->affectBatch(particles, first, count);
+	}
+
+	if (particlesUpdateEnabled_)
+	{
+		for (unsigned int i = first; i < last; i++)
+		{
+			particles.life[i] -= frameTime;
+			particles.positionX[i] += particles.velocityX[i] * frameTime;
+			particles.positionY[i] += particles.velocityY[i] * frameTime;
+		}
+	}
+}
+
+#ifdef WITH_JOBSYSTEM
+bool ParticleSystem::shouldUpdateInParallel() const
+{
+	return (parallelUpdateEnabled_ && numAliveParticles() >= MinParallelUpdateParticles &&
+	        theServiceLocator().jobSystem().numThreads() > 1);
+}
+
+/*! \note Affectors only read their steps and every job writes a different range of particles. */
+bool ParticleSystem::updateNodesInParallel(float frameTime)
+{
+	UpdateJobContext context(this, frameTime);
+	JobHandle updateJob = JobHandle::createParallelForJob(children_.data(), children_.size(), updateNodesJob,
+	                                                      &context, DataSizeSplitter(NodesJobDataSize));
+	if (updateJob.isValid() == false)
+		return false;
+	updateJob.setPriority(JobPriority::HIGH);
+	if (updateJob.submit() == false)
+	{
+		updateJob.cancel();
+		return false;
+	}
+	updateJob.wait();
+
+	// Dead particles are already back in the pool, they are removed from the children once all jobs have finished
+	const int firstReleased = poolTop_ + 1;
+	poolTop_ = context.poolTop.load();
+	for (int i = firstReleased; i <= poolTop_; i++)
+		removeChildNodeAt(particlePool_[i]->childOrderIndex());
+
+	return true;
+}
+
+void ParticleSystem::updateNodesJob(SceneNode **nodes, unsigned int count, UpdateJobContext *context)
+{
+	ParticleSystem *system = context->system;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		Particle *particle = static_cast<Particle *>(nodes[i]);
+		if (particle->isAlive() && system->updateParticle(particle, context->frameTime) == false)
+		{
+			// Other jobs might be releasing particles at the same time
+			const int poolIndex = context->poolTop.fetchAdd(1) + 1;
+			system->particlePool_[poolIndex] = particle;
+		}
+	}
+}
+
+bool ParticleSystem::updateArraysInParallel(float frameTime)
+{
+	UpdateJobContext context(this, frameTime);
+	JobHandle updateJob = JobHandle::createParallelForJob(particleArrays_.life, particleArrays_.size(), updateArraysJob,
+	                                                      &context, DataSizeSplitter(ArraysJobDataSize));
+	if (updateJob.isValid() == false)
+		return false;
+	updateJob.setPriority(JobPriority::HIGH);
+	if (updateJob.submit() == false)
+	{
+		updateJob.cancel();
+		return false;
+	}
+	updateJob.wait();
+
+	return true;
+}
+
+void ParticleSystem::updateArraysJob(float *lives, unsigned int count, UpdateJobContext *context)
+{
+	ParticleSystem *system = context->system;
+	const unsigned int first = static_cast<unsigned int>(lives - system->particleArrays_.life);
+	system->updateArraysRange(first, count, context->frameTime);
+}
+#endif
+
 }
@@ -1,10 +1,11 @@
-#include <cstring> // for memcpy()
+#include <cstring> // for memcpy() and strcmp()
 #include "GLShaderProgram.h"
 #include "Texture.h"
 #include "RenderBatcher.h"
 #include "RenderCommand.h"
 #include "RenderCommandPool.h"
 #include "RenderResources.h"
+#include "FrameArena.h"
 #include "Application.h"
 #include <nctl/StaticHashMapIterator.h>
 
@@ -148,10 +149,136 @@ void RenderBatcher::reset()
 		buffer.freeSpace = buffer.size;
 }
 
+void RenderBatcher::removeUniformBlocksLayouts(const GLShaderProgram *shaderProgram)
+{
+	for (int i = uniformBlocksLayouts_.size() - 1; i >= 0; i--)
+	{
+		const UniformBlocksLayout &layout = uniformBlocksLayouts_[i];
+		if (layout.shaderProgram == shaderProgram || layout.batchedShaderProgram == shaderProgram)
+			uniformBlocksLayouts_.unorderedRemoveAt(i);
+	}
+}
+
 ///////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+namespace {
+
+	/// Returns the uniform block cache at the specified position when iterating the hashmap
+	template <class T, class HashMapType>
+	T *elementAt(HashMapType &hashMap, int index)
+	{
+		for (T &element : hashMap)
+		{
+			if (index-- == 0)
+				return &element;
+		}
+		return nullptr;
+	}
+
+}
+
+const RenderBatcher::UniformBlocksLayout &RenderBatcher::uniformBlocksLayout(const RenderCommand &refCommand, const RenderCommand &batchCommand)
+{
+	const GLShaderUniformBlocks::UniformHashMapType &refBlocks = refCommand.material().allUniformBlocks();
+	const GLShaderUniformBlocks::UniformHashMapType &batchBlocks = batchCommand.material().allUniformBlocks();
+	const GLShaderUniforms::UniformHashMapType &refUniforms = refCommand.material().allUniforms();
+	const GLShaderUniforms::UniformHashMapType &batchUniforms = batchCommand.material().allUniforms();
+
+	UniformBlocksLayout *layout = nullptr;
+	for (UniformBlocksLayout &cachedLayout : uniformBlocksLayouts_)
+	{
+		if (cachedLayout.shaderProgram == refCommand.material().shaderProgram() &&
+		    cachedLayout.batchedShaderProgram == batchCommand.material().shaderProgram())
+		{
+			layout = &cachedLayout;
+			break;
+		}
+	}
+
+	if (layout != nullptr)
+	{
+		// Also checking the number of blocks and uniforms, in case a material has been set up differently
+		if (layout->numBlocks == refBlocks.size() && layout->numBatchBlocks == batchBlocks.size() &&
+		    layout->numUniforms == refUniforms.size() && layout->numBatchUniforms == batchUniforms.size())
+			return *layout;
+		*layout = UniformBlocksLayout();
+	}
+	else
+	{
+		uniformBlocksLayouts_.emplaceBack();
+		layout = &uniformBlocksLayouts_.back();
+	}
+
+	layout->shaderProgram = refCommand.material().shaderProgram();
+	layout->batchedShaderProgram = batchCommand.material().shaderProgram();
+	layout->numBlocks = refBlocks.size();
+	layout->numBatchBlocks = batchBlocks.size();
+	layout->numUniforms = refUniforms.size();
+	layout->numBatchUniforms = batchUniforms.size();
+
+	int refIndex = 0;
+	for (const GLUniformBlockCache &refBlock : refBlocks)
+	{
+		if (strcmp(refBlock.uniformBlock()->name(), Material::InstanceBlockName) == 0)
+		{
+			// Retrieving the original block instance size without the uniform buffer offset alignment
+			const int singleInstanceBlockSizePacked = refBlock.size() - refBlock.alignAmount(); // remove the uniform buffer offset alignment
+			layout->singleInstanceBlockSize = singleInstanceBlockSizePacked + (16 - singleInstanceBlockSizePacked % 16) % 16; // but add the std140 vec4 layout alignment
+			layout->instanceBlockIndex = refIndex;
+		}
+		refIndex++;
+	}
+
+	int batchIndex = 0;
+	for (const GLUniformBlockCache &batchBlock : batchBlocks)
+	{
+		const char *blockName = batchBlock.uniformBlock()->name();
+		layout->sourceBlockIndices[batchIndex] = -1;
+		if (strcmp(blockName, Material::InstancesBlockName) == 0)
+			layout->instancesBlockIndex = batchIndex;
+		else
+		{
+			refIndex = 0;
+			for (const GLUniformBlockCache &refBlock : refBlocks)
+			{
+				if (refIndex != layout->instanceBlockIndex && strcmp(refBlock.uniformBlock()->name(), blockName) == 0)
+				{
+					layout->sourceBlockIndices[batchIndex] = refIndex;
+					layout->nonInstancesBlocksSize += refBlock.size() - refBlock.alignAmount();
+					break;
+				}
+				refIndex++;
+			}
+		}
+		batchIndex++;
+	}
+
+	refIndex = 0;
+	for (const GLUniformCache &refUniform : refUniforms)
+	{
+		if (refUniform.uniform()->type() == GL_SAMPLER_2D && layout->numSamplers < MaxSamplerUniforms)
+		{
+			batchIndex = 0;
+			for (const GLUniformCache &batchUniform : batchUniforms)
+			{
+				if (strcmp(batchUniform.uniform()->name(), refUniform.uniform()->name()) == 0)
+				{
+					layout->samplerIndices[layout->numSamplers] = refIndex;
+					layout->batchSamplerIndices[layout->numSamplers] = batchIndex;
+					layout->numSamplers++;
+					break;
+				}
+				batchIndex++;
+			}
+		}
+		refIndex++;
+	}
+
+	return *layout;
+}
+
 RenderCommand *RenderBatcher::collectCommandsWithUniforms(
     nctl::Array<RenderCommand *>::ConstIterator start,
     nctl::Array<RenderCommand *>::ConstIterator end,
@@ -180,32 +307,20 @@ RenderCommand *RenderBatcher::collectCommandsWithUniforms(
 	bool commandAdded = false;
 	batchCommand = RenderResources::renderCommandPool().retrieveOrAdd(batchedShader, commandAdded);
 
-	// Retrieving the original block instance size without the uniform buffer offset alignment
-	const GLUniformBlockCache *singleInstanceBlock = (*start)->material().uniformBlock(Material::InstanceBlockName);
-	const int singleInstanceBlockSizePacked = singleInstanceBlock->size() - singleInstanceBlock->alignAmount(); // remove the uniform buffer offset alignment
-	const int singleInstanceBlockSize = singleInstanceBlockSizePacked + (16 - singleInstanceBlockSizePacked % 16) % 16; // but add the std140 vec4 layout alignment
-
 	if (commandAdded)
 		batchCommand->setType(refCommand->type());
-	instancesBlock = batchCommand->material().uniformBlock(Material::InstancesBlockName);
+
+	// The layout of blocks and uniforms only depends on the shader programs and is cached
+	const UniformBlocksLayout &layout = uniformBlocksLayout(*refCommand, *batchCommand);
+	const int singleInstanceBlockSize = layout.singleInstanceBlockSize;
+	FATAL_ASSERT_MSG_X(layout.instanceBlockIndex >= 0, "Shader does not have an \"%s\" uniform block", Material::InstanceBlockName);
+	GLShaderUniformBlocks::UniformHashMapType &batchBlocks = batchCommand->material().allUniformBlocks();
+	instancesBlock = elementAt<GLUniformBlockCache>(batchBlocks, layout.instancesBlockIndex);
 	FATAL_ASSERT_MSG_X(instancesBlock != nullptr, "Batched shader does not have an \"%s\" uniform block", Material::InstancesBlockName);
 
 	const unsigned long nonBlockUniformsSize = batchCommand->material().shaderProgram()->uniformsSize();
-	nctl::StaticString<GLUniformBlock::MaxNameLength> uniformBlockName;
-	// Determine how much memory is needed by uniform blocks that are not for instances
-	unsigned long nonInstancesBlocksSize = 0;
-	const GLShaderUniformBlocks::UniformHashMapType allUniformBlocks = refCommand->material().allUniformBlocks();
-	for (const GLUniformBlockCache &uniformBlockCache : allUniformBlocks)
-	{
-		uniformBlockName = uniformBlockCache.uniformBlock()->name();
-		if (uniformBlockName == Material::InstanceBlockName)
-			continue;
-
-		GLUniformBlockCache *batchBlock = batchCommand->material().uniformBlock(uniformBlockName.data());
-		ASSERT(batchBlock);
-		if (batchBlock)
-			nonInstancesBlocksSize += uniformBlockCache.size() - uniformBlockCache.alignAmount();
-	}
+	// The amount of memory needed by uniform blocks that are not for instances
+	const unsigned long nonInstancesBlocksSize = layout.nonInstancesBlocksSize;
 
 	// Set to true if at least one command in the batch has indices or forced by a rendering settings
 	bool batchingWithIndices = theApplication().renderingSettings().batchingWithIndices;
@@ -229,33 +344,26 @@ RenderCommand *RenderBatcher::collectCommandsWithUniforms(
 
 	batchCommand->material().setUniformsDataPointer(acquireMemory(nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize));
 	// Copying data for non-instances uniform blocks from the first command in the batch
-	for (const GLUniformBlockCache &uniformBlockCache : allUniformBlocks)
+	const GLUniformBlockCache *refBlocks[GLShaderUniformBlocks::UniformBlockCachesHashSize];
+	unsigned int numRefBlocks = 0;
+	for (const GLUniformBlockCache &uniformBlockCache : refCommand->material().allUniformBlocks())
+		refBlocks[numRefBlocks++] = &uniformBlockCache;
+
+	int batchBlockIndex = 0;
+	for (GLUniformBlockCache &batchBlock : batchBlocks)
 	{
-		uniformBlockName = uniformBlockCache.uniformBlock()->name();
-		if (uniformBlockName == Material::InstanceBlockName)
+		const int refBlockIndex = layout.sourceBlockIndices[batchBlockIndex++];
+		if (refBlockIndex < 0)
 			continue;
 
-		GLUniformBlockCache *batchBlock = batchCommand->material().uniformBlock(uniformBlockName.data());
-		const bool dataCopied = batchBlock->copyData(uniformBlockCache.dataPointer());
+		const GLUniformBlockCache *uniformBlockCache = refBlocks[refBlockIndex];
+		ASSERT(strcmp(uniformBlockCache->uniformBlock()->name(), batchBlock.uniformBlock()->name()) == 0);
+		const bool dataCopied = batchBlock.copyData(uniformBlockCache->dataPointer());
 		ASSERT(dataCopied);
-		batchBlock->setUsedSize(uniformBlockCache.usedSize());
+		batchBlock.setUsedSize(uniformBlockCache->usedSize());
 	}
 
-	// Setting sampler uniforms for GL_TEXTURE* units
-	const GLShaderUniforms::UniformHashMapType allUniforms = refCommand->material().allUniforms();
-	for (const GLUniformCache &uniformCache : allUniforms)
-	{
-		if (uniformCache.uniform()->type() == GL_SAMPLER_2D)
-		{
-			GLUniformCache *batchUniformCache = batchCommand->material().uniform(uniformCache.uniform()->name());
-			const int refValue = uniformCache.intValue(0);
-			const int batchValue = batchUniformCache->intValue(0);
-			// Also checking if the command has just been added, as the memory at the
-			// uniforms data pointer is not cleared and might contain the reference value
-			if (batchValue != refValue || commandAdded)
-				batchUniformCache->setIntValue(refValue);
-		}
-	}
+	copySamplerUniforms(layout, *refCommand, *batchCommand, commandAdded);
 
 	const unsigned long maxVertexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ARRAY).maxSize;
 	const unsigned long maxIndexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ELEMENT_ARRAY).maxSize;
@@ -327,7 +435,7 @@ RenderCommand *RenderBatcher::collectCommandsWithUniforms(
 		RenderCommand *command = *it;
 		command->commitNodeTransformation();
 
-		const GLUniformBlockCache *singleInstanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
+		const GLUniformBlockCache *singleInstanceBlock = command->material().instanceBlock();
 		const bool dataCopied = instancesBlock->copyData(instancesBlockOffset, singleInstanceBlock->dataPointer(), singleInstanceBlockSize);
 		ASSERT(dataCopied);
 		instancesBlockOffset += singleInstanceBlockSize;
@@ -427,29 +535,6 @@ RenderCommand *RenderBatcher::collectCommandsWithUniforms(
 	return batchCommand;
 }
 
-namespace {
-
-	struct SpriteInstanceBase
-	{
-		float transform[4];
-		float translation[4];
-
-		uint32_t color;
-		uint32_t spriteSize;
-	};
-
-	struct SpriteInstance : public SpriteInstanceBase
-	{
-		uint32_t uvEndpointsU;
-		uint32_t uvEndpointsV;
-	};
-
-	struct SpriteNoTextureInstance : public SpriteInstanceBase
-	{
-	};
-
-}
-
 RenderCommand *RenderBatcher::collectCommandsWithInstancing(
     nctl::Array<RenderCommand *>::ConstIterator start,
     nctl::Array<RenderCommand *>::ConstIterator end,
@@ -472,7 +557,7 @@ RenderCommand *RenderBatcher::collectCommandsWithInstancing(
 	    : Material::ShaderProgramType::SPRITE_NO_TEXTURE_ATTRIBS;
 	batchCommand = RenderResources::renderCommandPool().retrieveOrAdd(RenderResources::shaderProgram(attribsShaderProgramType), commandAdded);
 
-	const size_t instanceStructSize = withTexture ? sizeof(SpriteInstance) : sizeof(SpriteNoTextureInstance);
+	const size_t instanceStructSize = withTexture ? sizeof(RenderResources::InstanceFormatSprite) : sizeof(RenderResources::InstanceFormatSpriteNoTexture);
 	const unsigned int numFloats = instanceStructSize / sizeof(GLfloat);
 	const unsigned int numInstances = end - start;
 
@@ -481,35 +566,12 @@ RenderCommand *RenderBatcher::collectCommandsWithInstancing(
 		batchCommand->setType(RenderCommand::CommandTypes::SPRITE);
 		batchCommand->material().reserveUniformsDataMemory();
 
-		GLShaderProgram &shaderProgram = *batchCommand->material().shaderProgram();
-		GLVertexFormat::Attribute *transformAttribute = shaderProgram.attribute("aTransform");
-		GLVertexFormat::Attribute *translationAttribute = shaderProgram.attribute("aTranslation");
-		GLVertexFormat::Attribute *colorAttribute = shaderProgram.attribute("aColor");
-		GLVertexFormat::Attribute *spriteSizeAttribute = shaderProgram.attribute("aSpriteSize");
-		GLVertexFormat::Attribute *uvEndpointsUAttribute = withTexture ? shaderProgram.attribute("aUvEndpointsU") : nullptr;
-		GLVertexFormat::Attribute *uvEndpointsVAttribute = withTexture ? shaderProgram.attribute("aUvEndpointsV") : nullptr;
-
-		transformAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(0 * sizeof(GLfloat)));
-		translationAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(4 * sizeof(GLfloat)));
-		colorAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(8 * sizeof(GLfloat)));
-		spriteSizeAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(9 * sizeof(GLfloat)));
-		if (withTexture)
-		{
-			uvEndpointsUAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(10 * sizeof(GLfloat)));
-			uvEndpointsVAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(11 * sizeof(GLfloat)));
-		}
-
-		transformAttribute->setDivisor(1);
-		translationAttribute->setDivisor(1);
-		colorAttribute->setDivisor(1);
-		spriteSizeAttribute->setDivisor(1);
-		if (withTexture)
-		{
-			uvEndpointsUAttribute->setDivisor(1);
-			uvEndpointsVAttribute->setDivisor(1);
-		}
+		RenderResources::setInstanceAttributesParameters(*batchCommand->material().shaderProgram());
 	}
 
+	const UniformBlocksLayout &layout = uniformBlocksLayout(*refCommand, *batchCommand);
+	FATAL_ASSERT_MSG_X(layout.instanceBlockIndex >= 0, "Shader does not have an \"%s\" uniform block", Material::InstanceBlockName);
+
 	// The base pointer should be a multiple of 4 for the vertex ID calculation to work in the shader
 	GLfloat *base = batchCommand->geometry().acquireVertexPointer(numFloats * numInstances, 4);
 	uint8_t *instanceData = reinterpret_cast<uint8_t *>(base);
@@ -523,13 +585,25 @@ RenderCommand *RenderBatcher::collectCommandsWithInstancing(
 
 		const Material &material = command->material();
 
-		const GLUniformBlockCache *instanceBlock = material.uniformBlock(Material::InstanceBlockName);
+		const GLUniformBlockCache *instanceBlock = material.instanceBlock();
 		const int alignedInstanceStructSize = (instanceStructSize + 15) & ~size_t(15);
 		ASSERT(instanceBlock->usedSize() - instanceBlock->alignAmount() == alignedInstanceStructSize);
 
 		uint8_t *dstPtr = instanceData + instanceIndex * instanceStructSize;
-		SpriteInstanceBase *dst = reinterpret_cast<SpriteInstanceBase *>(dstPtr);
-
+		// The textured instance structure shares its first members with the one without a texture
+		RenderResources::InstanceFormatSpriteNoTexture *dst = reinterpret_cast<RenderResources::InstanceFormatSpriteNoTexture *>(dstPtr);
+
+#if NCINE_WITH_COMPACT_TRANSFORMS
+		const AffineTransform2Df &matrix = command->transformation();
+		dst->transform[0] = matrix[0].x;
+		dst->transform[1] = matrix[1].x;
+		dst->transform[2] = matrix[0].y;
+		dst->transform[3] = matrix[1].y;
+
+		dst->translation[0] = matrix[2].x;
+		dst->translation[1] = matrix[2].y;
+		dst->translation[2] = command->depth();
+#else
 		const float *matrix = command->transformation().data();
 		dst->transform[0] = matrix[0];
 		dst->transform[1] = matrix[4];
@@ -539,6 +613,7 @@ RenderCommand *RenderBatcher::collectCommandsWithInstancing(
 		dst->translation[0] = matrix[12];
 		dst->translation[1] = matrix[13];
 		dst->translation[2] = matrix[14];
+#endif
 
 		const size_t bytesToCopyAfterMatrix = (withTexture ? 4 : 2) * sizeof(uint32_t);
 		memcpy(&dst->color, reinterpret_cast<const uint32_t *>(instanceBlock->dataPointer()) + 8, bytesToCopyAfterMatrix);
@@ -550,21 +625,7 @@ RenderCommand *RenderBatcher::collectCommandsWithInstancing(
 
 	batchCommand->geometry().releaseVertexPointer();
 
-	// Setting sampler uniforms for GL_TEXTURE* units
-	const GLShaderUniforms::UniformHashMapType allUniforms = refCommand->material().allUniforms();
-	for (const GLUniformCache &uniformCache : allUniforms)
-	{
-		if (uniformCache.uniform()->type() == GL_SAMPLER_2D)
-		{
-			GLUniformCache *batchUniformCache = batchCommand->material().uniform(uniformCache.uniform()->name());
-			const int refValue = uniformCache.intValue(0);
-			const int batchValue = batchUniformCache->intValue(0);
-			// Also checking if the command has just been added, as the memory at the
-			// uniforms data pointer is not cleared and might contain the reference value
-			if (batchValue != refValue || commandAdded)
-				batchUniformCache->setIntValue(refValue);
-		}
-	}
+	copySamplerUniforms(layout, *refCommand, *batchCommand, commandAdded);
 
 	for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
 		batchCommand->material().setTexture(i, refCommand->material().texture(i));
@@ -580,11 +641,36 @@ RenderCommand *RenderBatcher::collectCommandsWithInstancing(
 	return batchCommand;
 }
 
+void RenderBatcher::copySamplerUniforms(const UniformBlocksLayout &layout, const RenderCommand &refCommand, RenderCommand &batchCommand, bool commandAdded)
+{
+	const GLShaderUniforms::UniformHashMapType &refUniforms = refCommand.material().allUniforms();
+	GLShaderUniforms::UniformHashMapType &batchUniforms = batchCommand.material().allUniforms();
+
+	// Setting sampler uniforms for GL_TEXTURE* units
+	for (unsigned int i = 0; i < layout.numSamplers; i++)
+	{
+		const GLUniformCache *uniformCache = elementAt<const GLUniformCache>(refUniforms, layout.samplerIndices[i]);
+		GLUniformCache *batchUniformCache = elementAt<GLUniformCache>(batchUniforms, layout.batchSamplerIndices[i]);
+		ASSERT(strcmp(uniformCache->uniform()->name(), batchUniformCache->uniform()->name()) == 0);
+
+		const int refValue = uniformCache->intValue(0);
+		const int batchValue = batchUniformCache->intValue(0);
+		// Also checking if the command has just been added, as the memory at the
+		// uniforms data pointer is not cleared and might contain the reference value
+		if (batchValue != refValue || commandAdded)
+			batchUniformCache->setIntValue(refValue);
+	}
+}
+
+/*! \note Only the uniforms data of batches is kept in CPU memory, their vertices and indices are written directly in the mapped buffers of the buffers manager. */
 unsigned char *RenderBatcher::acquireMemory(unsigned int bytes)
 {
 	FATAL_ASSERT(bytes <= UboMaxSize);
 
-	unsigned char *ptr = nullptr;
+	// The uniforms data of batches is only read until the queue is drawn, well before the frame arena is reset
+	unsigned char *ptr = static_cast<unsigned char *>(RenderResources::frameArena().allocate(bytes));
+	if (ptr != nullptr)
+		return ptr;
 
 	for (ManagedBuffer &buffer : buffers_)
 	{
@@ -9,6 +9,48 @@ namespace ncine {
 namespace {
 	/// The string used to output OpenGL debug group information
 	static nctl::StaticString<64> debugString;
+
+#if !defined(WITH_OPENGLES)
+	/// The storage flags of persistently mapped buffers
+	const GLbitfield PersistentStorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+	/// Persistently mapped buffers are mapped once and never unmapped, the regions written by the CPU are flushed explicitly
+	/*! \note The mapping flags in the specifications are not changed, as they are also used to map custom buffers */
+	const GLbitfield PersistentMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+#endif
+
+	/// The fences of a ring of buffer regions, implemented with OpenGL sync objects
+	class GLFenceBackend : public BufferRing::Backend
+	{
+	  public:
+		GLFenceBackend()
+		{
+			for (unsigned int i = 0; i < BufferRing::NumRegions; i++)
+				fences_[i] = nullptr;
+		}
+
+		void insertFence(unsigned int region) override
+		{
+			ASSERT(fences_[region] == nullptr);
+			fences_[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		bool waitFence(unsigned int region, uint64_t timeout) override
+		{
+			ZoneScopedN("Wait buffer fence");
+			const GLenum result = glClientWaitSync(fences_[region], GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+			// A failed wait is not repeated, so that the CPU never blocks forever
+			return (result != GL_TIMEOUT_EXPIRED);
+		}
+
+		void deleteFence(unsigned int region) override
+		{
+			glDeleteSync(fences_[region]);
+			fences_[region] = nullptr;
+		}
+
+	  private:
+		GLsync fences_[BufferRing::NumRegions];
+	};
 }
 
 ///////////////////////////////////////////////////////////
@@ -18,6 +60,19 @@ namespace {
 RenderBuffersManager::RenderBuffersManager(bool useBufferMapping, unsigned long vboMaxSize, unsigned long iboMaxSize)
     : buffers_(4)
 {
+	const IGfxCapabilities &gfxCaps = theServiceLocator().gfxCapabilities();
+
+#if !defined(WITH_OPENGLES)
+	const int glVersion = gfxCaps.glVersion(IGfxCapabilities::GLVersion::MAJOR) * 100 + gfxCaps.glVersion(IGfxCapabilities::GLVersion::MINOR);
+	const bool hasBufferStorage = (glVersion >= 404 || gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_BUFFER_STORAGE));
+	if (useBufferMapping && hasBufferStorage)
+	{
+		ringBackend_ = nctl::makeUnique<GLFenceBackend>();
+		ring_ = nctl::makeUnique<BufferRing>(*ringBackend_);
+		LOGI_X("Buffers are persistently mapped in a ring of %u regions", BufferRing::NumRegions);
+	}
+#endif
+
 	FATAL_ASSERT_MSG_X(vboMaxSize > 0, "vboMaxSize should be greater than zero");
 	BufferSpecifications &vboSpecs = specs_[BufferTypes::ARRAY];
 	vboSpecs.type = BufferTypes::ARRAY;
@@ -36,7 +91,6 @@ RenderBuffersManager::RenderBuffersManager(bool useBufferMapping, unsigned long
 	iboSpecs.maxSize = iboMaxSize;
 	iboSpecs.alignment = sizeof(GLushort);
 
-	const IGfxCapabilities &gfxCaps = theServiceLocator().gfxCapabilities();
 	// Clamped between 16 KB and 64 KB
 	const int uboMaxSize = gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_UNIFORM_BLOCK_SIZE);
 	const int offsetAlignment = gfxCaps.value(IGfxCapabilities::GLIntValues::UNIFORM_BUFFER_OFFSET_ALIGNMENT);
@@ -88,31 +142,16 @@ RenderBuffersManager::Parameters RenderBuffersManager::acquireMemory(BufferTypes
 
 	for (ManagedBuffer &buffer : buffers_)
 	{
-		if (buffer.type == type)
-		{
-			const unsigned long offset = buffer.size - buffer.freeSpace;
-			const unsigned int alignAmount = (alignment - offset % alignment) % alignment;
-
-			if (buffer.freeSpace >= bytes + alignAmount)
-			{
-				params.object = buffer.object.get();
-				params.offset = offset + alignAmount;
-				params.size = bytes;
-				buffer.freeSpace -= bytes + alignAmount;
-				params.mapBase = buffer.mapBase;
-				break;
-			}
-		}
+		if (buffer.type == type && acquireFromBuffer(buffer, bytes, alignment, params))
+			break;
 	}
 
 	if (params.object == nullptr)
 	{
 		createBuffer(specs_[type]);
-		params.object = buffers_.back().object.get();
-		params.offset = 0;
-		params.size = bytes;
-		buffers_.back().freeSpace -= bytes;
-		params.mapBase = buffers_.back().mapBase;
+		const bool acquired = acquireFromBuffer(buffers_.back(), bytes, alignment, params);
+		FATAL_ASSERT_MSG_X(acquired, "Cannot acquire %lu bytes with an alignment of %u from a new buffer of type \"%s\"",
+		                   bytes, alignment, bufferTypeToString(type));
 	}
 
 	return params;
@@ -122,6 +161,25 @@ RenderBuffersManager::Parameters RenderBuffersManager::acquireMemory(BufferTypes
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+/*! \note The offset is aligned from the start of the buffer, as it is also used by OpenGL. With a ring of regions
+ *  the region of the current frame does not start at zero, but the free space is still counted from its start. */
+bool RenderBuffersManager::acquireFromBuffer(ManagedBuffer &buffer, unsigned long bytes, unsigned int alignment, Parameters &params)
+{
+	const unsigned long regionOffset = ring_ ? ring_->regionOffset(buffer.size) : 0;
+	const unsigned long offset = regionOffset + buffer.size - buffer.freeSpace;
+	const unsigned int alignAmount = (alignment - offset % alignment) % alignment;
+
+	if (buffer.freeSpace < bytes + alignAmount)
+		return false;
+
+	params.object = buffer.object.get();
+	params.offset = offset + alignAmount;
+	params.size = bytes;
+	buffer.freeSpace -= bytes + alignAmount;
+	params.mapBase = buffer.mapBase;
+	return true;
+}
+
 void RenderBuffersManager::flushUnmap()
 {
 	ZoneScoped;
@@ -134,6 +192,14 @@ void RenderBuffersManager::flushUnmap()
 		FATAL_ASSERT(usedSize <= specs_[buffer.type].maxSize);
 		buffer.freeSpace = buffer.size;
 
+		if (ring_)
+		{
+			// A persistently mapped buffer stays mapped, the next frame writes in another region
+			if (usedSize > 0)
+				buffer.object->flushMappedBufferRange(ring_->regionOffset(buffer.size), usedSize);
+			continue;
+		}
+
 		if (specs_[buffer.type].mapFlags == 0)
 		{
 			if (usedSize > 0)
@@ -155,6 +221,13 @@ void RenderBuffersManager::remap()
 	ZoneScoped;
 	GLDebug::ScopedGroup scoped("RenderBuffersManager::remap()");
 
+	if (ring_)
+	{
+		// The commands of the frame have been issued, the region can be fenced and the next one can be written
+		ring_->advance();
+		return;
+	}
+
 	for (ManagedBuffer &buffer : buffers_)
 	{
 		ASSERT(buffer.freeSpace == buffer.size);
@@ -180,7 +253,12 @@ void RenderBuffersManager::createBuffer(const BufferSpecifications &specs)
 	managedBuffer.type = specs.type;
 	managedBuffer.size = specs.maxSize;
 	managedBuffer.object = nctl::makeUnique<GLBufferObject>(specs.target);
-	managedBuffer.object->bufferData(managedBuffer.size, nullptr, specs.usageFlags);
+#if !defined(WITH_OPENGLES)
+	if (ring_)
+		managedBuffer.object->bufferStorage(managedBuffer.size * BufferRing::NumRegions, nullptr, PersistentStorageFlags);
+	else
+#endif
+		managedBuffer.object->bufferData(managedBuffer.size, nullptr, specs.usageFlags);
 	managedBuffer.freeSpace = managedBuffer.size;
 
 	switch (managedBuffer.type)
@@ -202,6 +280,14 @@ void RenderBuffersManager::createBuffer(const BufferSpecifications &specs)
 		managedBuffer.hostBuffer = nctl::makeUnique<GLubyte[]>(specs.maxSize);
 		managedBuffer.mapBase = managedBuffer.hostBuffer.get();
 	}
+#if !defined(WITH_OPENGLES)
+	else if (ring_)
+	{
+		// A persistently mapped buffer is mapped as a whole, the region of the current frame is selected by the offset
+		const unsigned long mapSize = managedBuffer.size * BufferRing::NumRegions;
+		managedBuffer.mapBase = static_cast<GLubyte *>(managedBuffer.object->mapBufferRange(0, mapSize, PersistentMapFlags));
+	}
+#endif
 	else
 		managedBuffer.mapBase = static_cast<GLubyte *>(managedBuffer.object->mapBufferRange(0, managedBuffer.size, specs.mapFlags));
 
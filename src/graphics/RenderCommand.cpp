@@ -1,6 +1,6 @@
 #include "RenderCommand.h"
 #include "GLShaderProgram.h"
-#include "GLScissorTest.h"
+#include "RenderStateTracker.h"
 #include "RenderResources.h"
 #include "Camera.h"
 #include "DrawableNode.h"
@@ -19,9 +19,12 @@ const float RenderCommand::LayerStep = 1.0f / static_cast<float>(0xFFFF);
 ///////////////////////////////////////////////////////////
 
 RenderCommand::RenderCommand(CommandTypes::Enum type)
-    : materialSortKey_(0), layer_(0),
+    : materialSortKey_(0), sortGeneration_(0), sortedIndex_(0), layer_(0),
       numInstances_(0), batchSize_(0), transformationCommitted_(false),
       type_(type), modelMatrix_(Matrix4x4f::Identity)
+#if NCINE_WITH_COMPACT_TRANSFORMS
+      , depth_(0.0f)
+#endif
 {
 }
 
@@ -50,10 +53,7 @@ void RenderCommand::issue()
 
 	material_.bind();
 	material_.commitUniforms();
-
-	GLScissorTest::State scissorTestState = GLScissorTest::state();
-	if (scissorRect_.w > 0 && scissorRect_.h > 0)
-		GLScissorTest::enable(scissorRect_);
+	RenderStateTracker::applyScissor(scissorRect_);
 
 	unsigned int offset = 0;
 #if (defined(WITH_OPENGLES) && !GL_ES_VERSION_3_2) || defined(__EMSCRIPTEN__)
@@ -67,8 +67,6 @@ void RenderCommand::issue()
 	material_.defineVertexFormat(geometry_.vboParams().object, geometry_.iboParams().object, offset);
 	geometry_.bind();
 	geometry_.draw(numInstances_);
-
-	GLScissorTest::setState(scissorTestState);
 }
 
 void RenderCommand::setScissor(GLint x, GLint y, GLsizei width, GLsizei height)
@@ -76,7 +74,11 @@ void RenderCommand::setScissor(GLint x, GLint y, GLsizei width, GLsizei height)
 	scissorRect_.set(x, y, width, height);
 }
 
+#if NCINE_WITH_COMPACT_TRANSFORMS
+void RenderCommand::setTransformation(const AffineTransform2Df &modelMatrix)
+#else
 void RenderCommand::setTransformation(const Matrix4x4f &modelMatrix)
+#endif
 {
 	modelMatrix_ = modelMatrix;
 	transformationCommitted_ = false;
@@ -90,39 +92,47 @@ void RenderCommand::commitNodeTransformation()
 	ZoneScoped;
 
 	const Camera::ProjectionValues cameraValues = RenderResources::currentCamera()->projectionValues();
+#if NCINE_WITH_COMPACT_TRANSFORMS
+	depth_ = calculateDepth(layer_, cameraValues.near, cameraValues.far);
+#else
 	modelMatrix_[3][2] = calculateDepth(layer_, cameraValues.near, cameraValues.far);
+#endif
 
 	if (material_.shaderProgram_ && material_.shaderProgram_->status() == GLShaderProgram::Status::LINKED_WITH_INTROSPECTION)
 	{
-		GLUniformBlockCache *instanceBlock = material_.uniformBlock(Material::InstanceBlockName);
-
 		bool setAsTransformAndTranslation = false;
-		GLUniformCache *transformUniform = instanceBlock
-		    ? instanceBlock->uniform(Material::ModelTransformUniformName)
-		    : material_.uniform(Material::ModelTransformUniformName);
-		GLUniformCache *translationUniform = instanceBlock
-		    ? instanceBlock->uniform(Material::ModelTranslationUniformName)
-		    : material_.uniform(Material::ModelTranslationUniformName);
+		GLUniformCache *transformUniform = material_.builtinUniform(Material::BuiltinUniforms::MODEL_TRANSFORM);
+		GLUniformCache *translationUniform = material_.builtinUniform(Material::BuiltinUniforms::MODEL_TRANSLATION);
 
 		if (transformUniform && translationUniform)
 		{
 			ZoneScopedN("Set model matrix");
 
+#if NCINE_WITH_COMPACT_TRANSFORMS
+			const AffineTransform2Df &m = modelMatrix_;
+			setAsTransformAndTranslation = transformUniform->setFloatValue(m[0].x, m[1].x, m[0].y, m[1].y); // m00, m01, m10, m11
+			setAsTransformAndTranslation &= translationUniform->setFloatValue(m[2].x, m[2].y, depth_, 0.0f); // tx, ty, tz
+#else
 			const float *m = modelMatrix_.data();
 			setAsTransformAndTranslation = transformUniform->setFloatValue(m[0], m[4], m[1], m[5]); // m00, m01, m10, m11
 			setAsTransformAndTranslation &= translationUniform->setFloatValue(m[12], m[13], m[14], 0.0f); // tx, ty, tz
+#endif
 		}
 
 		if (setAsTransformAndTranslation == false)
 		{
-			GLUniformCache *matrixUniform = instanceBlock
-			    ? instanceBlock->uniform(Material::ModelMatrixUniformName)
-			    : material_.uniform(Material::ModelMatrixUniformName);
+			GLUniformCache *matrixUniform = material_.builtinUniform(Material::BuiltinUniforms::MODEL_MATRIX);
 
 			if (matrixUniform)
 			{
 				ZoneScopedN("Set model matrix");
+#if NCINE_WITH_COMPACT_TRANSFORMS
+				// The compact matrix is only expanded when the shader needs all of its elements
+				const Matrix4x4f modelMatrix = modelMatrix_.toMatrix4x4(depth_);
+				matrixUniform->setFloatVector(modelMatrix.data());
+#else
 				matrixUniform->setFloatVector(modelMatrix_.data());
+#endif
 			}
 		}
 	}
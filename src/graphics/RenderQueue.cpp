@@ -3,12 +3,18 @@
 #include "RenderQueue.h"
 #include "RenderBatcher.h"
 #include "RenderResources.h"
+#include "FrameArena.h"
 #include "RenderStatistics.h"
 #include "GLDebug.h"
 #include "Application.h"
 #include "GLScissorTest.h"
 #include "GLDepthTest.h"
 #include "GLBlending.h"
+#include "RenderStateTracker.h"
+#include "DrawableNode.h"
+#ifdef WITH_JOBSYSTEM
+	#include "JobHandle.h"
+#endif
 #include "tracy.h"
 #include "tracy_opengl.h"
 
@@ -17,6 +23,12 @@ namespace ncine {
 namespace {
 	/// The string used to output OpenGL debug group information
 	static nctl::StaticString<64> debugString;
+
+	/// Below this number of commands a comparison sort is faster than a radix sort
+	const unsigned int MinRadixSortSize = 512;
+
+	/// The identifier of the last incremental sort, shared by all queues so that their identifiers never collide
+	uint32_t lastSortGeneration = 0;
 }
 
 ///////////////////////////////////////////////////////////
@@ -25,7 +37,8 @@ namespace {
 
 RenderQueue::RenderQueue()
     : opaqueQueue_(16), opaqueBatchedQueue_(16),
-      transparentQueue_(16), transparentBatchedQueue_(16)
+      transparentQueue_(16), transparentBatchedQueue_(16),
+      deferredNodes_(16), isRecording_(false), recordingOpaqueStart_(0), recordingTransparentStart_(0)
 {
 }
 
@@ -35,7 +48,7 @@ RenderQueue::RenderQueue()
 
 bool RenderQueue::isEmpty() const
 {
-	return (opaqueQueue_.isEmpty() && transparentQueue_.isEmpty());
+	return (opaqueQueue_.isEmpty() && transparentQueue_.isEmpty() && frozenCommands_.isEmpty());
 }
 
 void RenderQueue::addCommand(RenderCommand *command)
@@ -49,6 +62,89 @@ void RenderQueue::addCommand(RenderCommand *command)
 		transparentQueue_.pushBack(command);
 }
 
+void RenderQueue::addDeferredNode(DrawableNode *node)
+{
+	deferredNodes_.pushBack(node);
+}
+
+/*! \note The layer and the visit order of the deferred nodes have already been set by the serial visit,
+ *  so the order in which the commands are recorded does not change the sorting result. */
+void RenderQueue::flushDeferredNodes()
+{
+	if (deferredNodes_.isEmpty())
+		return;
+
+	ZoneScoped;
+#ifdef WITH_JOBSYSTEM
+	const Application::RenderingSettings &settings = theApplication().renderingSettings();
+	const unsigned int numThreads = theServiceLocator().jobSystem().numThreads();
+
+	if (numThreads > 1 && deferredNodes_.size() >= settings.minParallelVisitSize && settings.parallelVisitSplitSize > 0)
+	{
+		while (shards_.size() < numThreads)
+			shards_.emplaceBack();
+
+		JobHandle recordJob = JobHandle::createParallelForJob(deferredNodes_.data(), deferredNodes_.size(), recordDeferredNodes,
+		                                                      this, CountSplitter(settings.parallelVisitSplitSize));
+		if (recordJob.isValid())
+		{
+			// The frame waits on the recording of the commands
+			recordJob.setPriority(JobPriority::HIGH);
+			if (recordJob.submit())
+			{
+				recordJob.wait();
+				mergeShards();
+				deferredNodes_.clear();
+				return;
+			}
+			recordJob.cancel();
+		}
+	}
+#endif
+
+	for (DrawableNode *node : deferredNodes_)
+	{
+		node->prepareRenderCommand();
+		addCommand(node->renderCommand_.get());
+	}
+	deferredNodes_.clear();
+}
+
+void RenderQueue::beginRecording()
+{
+	ASSERT(isRecording_ == false);
+	isRecording_ = true;
+	recordingOpaqueStart_ = opaqueQueue_.size();
+	recordingTransparentStart_ = transparentQueue_.size();
+}
+
+/*! \note The recorded commands are sorted once with the same order of the queues, so that they only need to be merged when replayed. */
+void RenderQueue::endRecording(FrozenCommands &frozenCommands)
+{
+	ASSERT(isRecording_ == true);
+	ZoneScoped;
+	isRecording_ = false;
+
+	frozenCommands.opaqueCommands.clear();
+	frozenCommands.opaqueCommands.insertRange(0, opaqueQueue_.data() + recordingOpaqueStart_, opaqueQueue_.data() + opaqueQueue_.size());
+	opaqueQueue_.setSize(recordingOpaqueStart_);
+	sortQueue(frozenCommands.opaqueCommands, true);
+
+	frozenCommands.transparentCommands.clear();
+	frozenCommands.transparentCommands.insertRange(0, transparentQueue_.data() + recordingTransparentStart_, transparentQueue_.data() + transparentQueue_.size());
+	transparentQueue_.setSize(recordingTransparentStart_);
+	sortQueue(frozenCommands.transparentCommands, false);
+
+	RenderStatistics::addFrozenSubtree(frozenCommands.opaqueCommands.size() + frozenCommands.transparentCommands.size(), true);
+	frozenCommands_.pushBack(&frozenCommands);
+}
+
+void RenderQueue::addFrozenCommands(const FrozenCommands &frozenCommands)
+{
+	RenderStatistics::addFrozenSubtree(frozenCommands.opaqueCommands.size() + frozenCommands.transparentCommands.size(), false);
+	frozenCommands_.pushBack(&frozenCommands);
+}
+
 namespace {
 
 	bool descendingOrder(const RenderCommand *a, const RenderCommand *b)
@@ -88,11 +184,35 @@ namespace {
 
 void RenderQueue::sortAndCommit()
 {
-	const bool batchingEnabled = theApplication().renderingSettings().batchingEnabled;
+	const Application::RenderingSettings &settings = theApplication().renderingSettings();
+	const bool batchingEnabled = settings.batchingEnabled;
 
 	// Sorting the queues with the relevant orders
-	nctl::sort(opaqueQueue_.begin(), opaqueQueue_.end(), descendingOrder);
-	nctl::sort(transparentQueue_.begin(), transparentQueue_.end(), ascendingOrder);
+	if (settings.incrementalSortEnabled)
+	{
+		sortQueueIncremental(opaqueQueue_, opaqueSortHistory_, true);
+		sortQueueIncremental(transparentQueue_, transparentSortHistory_, false);
+	}
+	else
+	{
+		sortQueue(opaqueQueue_, true);
+		sortQueue(transparentQueue_, false);
+		RenderStatistics::addSortedQueue(opaqueQueue_.size(), opaqueQueue_.size(), false);
+		RenderStatistics::addSortedQueue(transparentQueue_.size(), transparentQueue_.size(), false);
+
+		// The next incremental sort will start from scratch
+		opaqueSortHistory_ = SortHistory();
+		transparentSortHistory_ = SortHistory();
+	}
+
+	// The commands of frozen subtrees are already sorted, they are merged after the others to not be part of the sort history
+	for (const FrozenCommands *frozenCommands : frozenCommands_)
+	{
+		const nctl::Array<RenderCommand *> &opaqueCommands = frozenCommands->opaqueCommands;
+		const nctl::Array<RenderCommand *> &transparentCommands = frozenCommands->transparentCommands;
+		mergeSortedCommands(opaqueQueue_, opaqueCommands.data(), opaqueCommands.size(), true);
+		mergeSortedCommands(transparentQueue_, transparentCommands.data(), transparentCommands.size(), false);
+	}
 
 	nctl::Array<RenderCommand *> *opaques = batchingEnabled ? &opaqueBatchedQueue_ : &opaqueQueue_;
 	nctl::Array<RenderCommand *> *transparents = batchingEnabled ? &transparentBatchedQueue_ : &transparentQueue_;
@@ -131,6 +251,9 @@ void RenderQueue::draw()
 	nctl::Array<RenderCommand *> *opaques = batchingEnabled ? &opaqueBatchedQueue_ : &opaqueQueue_;
 	nctl::Array<RenderCommand *> *transparents = batchingEnabled ? &transparentBatchedQueue_ : &transparentQueue_;
 
+	// Commands without a scissor rectangle are drawn with the scissor test state of the viewport
+	RenderStateTracker::beginQueue();
+
 	unsigned int commandIndex = 0;
 	// Rendering opaque nodes front to back
 	for (RenderCommand *opaqueRenderCommand : *opaques)
@@ -183,8 +306,8 @@ void RenderQueue::draw()
 		GLDebug::ScopedGroup scoped(debugString.data());
 		commandIndex++;
 
+		RenderStateTracker::applyBlendFunc(transparentRenderCommand->material().srcBlendingFactor(), transparentRenderCommand->material().destBlendingFactor());
 		RenderStatistics::gatherStatistics(*transparentRenderCommand);
-		GLBlending::setBlendFunc(transparentRenderCommand->material().srcBlendingFactor(), transparentRenderCommand->material().destBlendingFactor());
 		transparentRenderCommand->commitCameraTransformation();
 		transparentRenderCommand->issue();
 	}
@@ -198,6 +321,8 @@ void RenderQueue::draw()
 
 void RenderQueue::clear()
 {
+	deferredNodes_.clear();
+	frozenCommands_.clear();
 	opaqueQueue_.clear();
 	opaqueBatchedQueue_.clear();
 	transparentQueue_.clear();
@@ -206,4 +331,190 @@ void RenderQueue::clear()
 	RenderResources::renderBatcher().reset();
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note The radix sort only reads the keys of every command once, instead of dereferencing
+ *  two command pointers for every comparison, and it is stable on the material and id keys. */
+void RenderQueue::sortQueue(nctl::Array<RenderCommand *> &queue, bool descending)
+{
+	const unsigned int count = queue.size();
+	if (count < MinRadixSortSize)
+	{
+		if (descending)
+			nctl::sort(queue.begin(), queue.end(), descendingOrder);
+		else
+			nctl::sort(queue.begin(), queue.end(), ascendingOrder);
+		return;
+	}
+
+	ZoneScoped;
+	// The sorting items are only needed during the sort, the member arrays are used when the frame arena is full
+	FrameArena &frameArena = RenderResources::frameArena();
+	nctl::RadixSortItem *items = frameArena.allocateArray<nctl::RadixSortItem>(count);
+	nctl::RadixSortItem *tempItems = frameArena.allocateArray<nctl::RadixSortItem>(count);
+	if (items == nullptr || tempItems == nullptr)
+	{
+		sortItems_.setSize(count);
+		tempSortItems_.setSize(count);
+		items = sortItems_.data();
+		tempItems = tempSortItems_.data();
+	}
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		items[i].key = queue[i]->materialSortKey();
+		items[i].subKey = queue[i]->idSortKey();
+		items[i].index = i;
+	}
+
+	if (descending)
+		nctl::radixSortDesc(items, tempItems, count);
+	else
+		nctl::radixSort(items, tempItems, count);
+
+	RenderCommand **sortedCommands = acquireCommandsScratch(count);
+	for (unsigned int i = 0; i < count; i++)
+		sortedCommands[i] = queue[items[i].index];
+	for (unsigned int i = 0; i < count; i++)
+		queue[i] = sortedCommands[i];
+}
+
+/*! \note Commands are first placed in the order they had after the last sort, using the position stored in each of them.
+ *  The ones that are now out of order, together with the new ones, are then sorted on their own and merged back.
+ *  The sorting cost is proportional to the number of commands that changed position instead of the size of the queue. */
+void RenderQueue::sortQueueIncremental(nctl::Array<RenderCommand *> &queue, SortHistory &history, bool descending)
+{
+	ZoneScoped;
+	bool (*const comesBefore)(const RenderCommand *, const RenderCommand *) = descending ? descendingOrder : ascendingOrder;
+	const unsigned int count = queue.size();
+
+	// Placing every command that was in the queue at the last sort in its previous position
+	RenderCommand **sortedCommands = acquireCommandsScratch(history.size);
+	for (unsigned int i = 0; i < history.size; i++)
+		sortedCommands[i] = nullptr;
+	movedCommands_.clear();
+	for (RenderCommand *command : queue)
+	{
+		const uint32_t index = command->sortedIndex();
+		if (history.generation != 0 && command->sortGeneration() == history.generation &&
+		    index < history.size && sortedCommands[index] == nullptr)
+		{
+			sortedCommands[index] = command;
+		}
+		else
+			movedCommands_.pushBack(command);
+	}
+
+	// Compacting the previous order, then keeping only the commands that are still in order
+	unsigned int numPrevious = 0;
+	for (unsigned int i = 0; i < history.size; i++)
+	{
+		if (sortedCommands[i] != nullptr)
+			sortedCommands[numPrevious++] = sortedCommands[i];
+	}
+
+	// Both commands of an inversion are removed, so that a single command whose key has increased
+	// does not cause all the following ones to be removed, and at most twice the minimum are moved
+	queue.clear();
+	for (unsigned int i = 0; i < numPrevious; i++)
+	{
+		RenderCommand *command = sortedCommands[i];
+		if (queue.isEmpty() == false && comesBefore(command, queue.back()))
+		{
+			movedCommands_.pushBack(queue.back());
+			movedCommands_.pushBack(command);
+			queue.popBack();
+		}
+		else
+			queue.pushBack(command);
+	}
+
+	const unsigned int numMoved = movedCommands_.size();
+	sortQueue(movedCommands_, descending);
+	mergeSortedCommands(queue, movedCommands_.data(), numMoved, descending);
+
+	lastSortGeneration++;
+	if (lastSortGeneration == 0)
+		lastSortGeneration = 1;
+	for (unsigned int i = 0; i < count; i++)
+		queue[i]->setSortedPosition(lastSortGeneration, i);
+	history.generation = lastSortGeneration;
+	history.size = count;
+
+	RenderStatistics::addSortedQueue(count, numMoved, true);
+}
+
+/*! \note The scratch array is only used during a sort, the member array is used when the frame arena is full */
+RenderCommand **RenderQueue::acquireCommandsScratch(unsigned int count)
+{
+	RenderCommand **commands = RenderResources::frameArena().allocateArray<RenderCommand *>(count);
+	if (commands == nullptr)
+	{
+		sortedQueue_.setSize(count);
+		commands = sortedQueue_.data();
+	}
+	return commands;
+}
+
+/*! \note The merge starts from the end of the queue, so that no command of the queue needs to be moved more than once. */
+void RenderQueue::mergeSortedCommands(nctl::Array<RenderCommand *> &queue, RenderCommand *const *commands, unsigned int numCommands, bool descending)
+{
+	if (numCommands == 0)
+		return;
+
+	bool (*const comesBefore)(const RenderCommand *, const RenderCommand *) = descending ? descendingOrder : ascendingOrder;
+	const unsigned int numQueued = queue.size();
+	const unsigned int count = numQueued + numCommands;
+
+	queue.setSize(count);
+	int queued = static_cast<int>(numQueued) - 1;
+	int merged = static_cast<int>(numCommands) - 1;
+	for (int i = static_cast<int>(count) - 1; merged >= 0; i--)
+	{
+		if (queued >= 0 && comesBefore(commands[merged], queue[queued]))
+			queue[i] = queue[queued--];
+		else
+			queue[i] = commands[merged--];
+	}
+}
+
+#ifdef WITH_JOBSYSTEM
+void RenderQueue::recordDeferredNodes(DrawableNode **nodes, unsigned int count, RenderQueue *renderQueue)
+{
+	ZoneScoped;
+	Shard &shard = renderQueue->shards_[IJobSystem::threadIndex()];
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		nodes[i]->prepareRenderCommand();
+
+		RenderCommand *command = nodes[i]->renderCommand_.get();
+		command->calculateMaterialSortKey();
+		if (command->material().isBlendingEnabled() == false)
+			shard.opaqueQueue.pushBack(command);
+		else
+			shard.transparentQueue.pushBack(command);
+	}
+}
+
+void RenderQueue::mergeShards()
+{
+	for (Shard &shard : shards_)
+	{
+		if (shard.opaqueQueue.isEmpty() == false)
+		{
+			opaqueQueue_.insertRange(opaqueQueue_.size(), shard.opaqueQueue.data(), shard.opaqueQueue.data() + shard.opaqueQueue.size());
+			shard.opaqueQueue.clear();
+		}
+		if (shard.transparentQueue.isEmpty() == false)
+		{
+			transparentQueue_.insertRange(transparentQueue_.size(), shard.transparentQueue.data(), shard.transparentQueue.data() + shard.transparentQueue.size());
+			shard.transparentQueue.clear();
+		}
+	}
+}
+#endif
+
 }
@@ -12,6 +12,8 @@
 #ifdef WITH_SCENEGRAPH
 	#include "RenderCommandPool.h"
 	#include "RenderBatcher.h"
+	#include "SpatialGrid.h"
+	#include "FrameArena.h"
 	#include "Camera.h"
 #endif
 
@@ -40,6 +42,8 @@ nctl::UniquePtr<Hash64> RenderResources::hash64_;
 #ifdef WITH_SCENEGRAPH
 nctl::UniquePtr<RenderCommandPool> RenderResources::renderCommandPool_;
 nctl::UniquePtr<RenderBatcher> RenderResources::renderBatcher_;
+nctl::UniquePtr<SpatialGrid> RenderResources::spatialGrid_;
+nctl::UniquePtr<FrameArena> RenderResources::frameArena_;
 
 RenderResources::ShaderProgramCompileInfo::ShaderCompileInfo RenderResources::defaultVertexShaderInfos_[NumDefaultVertexShaders];
 RenderResources::ShaderProgramCompileInfo::ShaderCompileInfo RenderResources::defaultFragmentShaderInfos_[NumDefaultFragmentShaders];
@@ -295,6 +299,9 @@ bool RenderResources::registerBatchedShader(const GLShaderProgram *shader, GLSha
 bool RenderResources::unregisterBatchedShader(const GLShaderProgram *shader)
 {
 	ASSERT(shader != nullptr);
+	// The uniform blocks layouts might refer to the shader either as the original or as the batched one
+	if (renderBatcher_)
+		renderBatcher_->removeUniformBlocksLayouts(shader);
 	const bool removed = batchedShaders_.remove(shader);
 	return removed;
 }
@@ -368,6 +375,41 @@ void RenderResources::setDefaultAttributesParameters(GLShaderProgram &shaderProg
 	}
 }
 
+/*! \note The parameters match the `InstanceFormatSprite` or the `InstanceFormatSpriteNoTexture` structures */
+void RenderResources::setInstanceAttributesParameters(GLShaderProgram &shaderProgram)
+{
+	GLVertexFormat::Attribute *transformAttribute = shaderProgram.attribute("aTransform");
+	GLVertexFormat::Attribute *translationAttribute = shaderProgram.attribute("aTranslation");
+	GLVertexFormat::Attribute *colorAttribute = shaderProgram.attribute("aColor");
+	GLVertexFormat::Attribute *spriteSizeAttribute = shaderProgram.attribute("aSpriteSize");
+	GLVertexFormat::Attribute *uvEndpointsUAttribute = shaderProgram.attribute("aUvEndpointsU");
+	GLVertexFormat::Attribute *uvEndpointsVAttribute = shaderProgram.attribute("aUvEndpointsV");
+
+	FATAL_ASSERT(transformAttribute && translationAttribute && colorAttribute && spriteSizeAttribute);
+	const bool withTexture = (uvEndpointsUAttribute != nullptr && uvEndpointsVAttribute != nullptr);
+	const GLsizei instanceStructSize = withTexture ? sizeof(InstanceFormatSprite) : sizeof(InstanceFormatSpriteNoTexture);
+
+	transformAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(offsetof(InstanceFormatSprite, transform)));
+	translationAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(offsetof(InstanceFormatSprite, translation)));
+	colorAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(offsetof(InstanceFormatSprite, color)));
+	spriteSizeAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(offsetof(InstanceFormatSprite, spriteSize)));
+	if (withTexture)
+	{
+		uvEndpointsUAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(offsetof(InstanceFormatSprite, uvEndpointsU)));
+		uvEndpointsVAttribute->setVboParameters(instanceStructSize, reinterpret_cast<void *>(offsetof(InstanceFormatSprite, uvEndpointsV)));
+	}
+
+	transformAttribute->setDivisor(1);
+	translationAttribute->setDivisor(1);
+	colorAttribute->setDivisor(1);
+	spriteSizeAttribute->setDivisor(1);
+	if (withTexture)
+	{
+		uvEndpointsUAttribute->setDivisor(1);
+		uvEndpointsVAttribute->setDivisor(1);
+	}
+}
+
 #endif
 
 ///////////////////////////////////////////////////////////
@@ -489,6 +531,8 @@ void RenderResources::create()
 		hash64_ = nctl::makeUnique<Hash64>();
 	renderCommandPool_ = nctl::makeUnique<RenderCommandPool>(openglCfg.renderCommandPoolSize);
 	renderBatcher_ = nctl::makeUnique<RenderBatcher>();
+	spatialGrid_ = nctl::makeUnique<SpatialGrid>(theApplication().renderingSettings().spatialIndexCellSize);
+	frameArena_ = nctl::makeUnique<FrameArena>(openglCfg.frameArenaSize);
 	defaultCamera_ = nctl::makeUnique<Camera>();
 	currentCamera_ = defaultCamera_.get();
 
@@ -622,6 +666,8 @@ void RenderResources::dispose()
 	ASSERT(cameraUniformDataMap_.isEmpty());
 
 	defaultCamera_.reset(nullptr);
+	frameArena_.reset(nullptr);
+	spatialGrid_.reset(nullptr);
 	renderBatcher_.reset(nullptr);
 	renderCommandPool_.reset(nullptr);
 #endif
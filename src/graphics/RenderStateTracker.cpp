@@ -0,0 +1,65 @@
+#include "RenderStateTracker.h"
+#include "GLShaderProgram.h"
+#include "GLBlending.h"
+#include "RenderStatistics.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+GLScissorTest::State RenderStateTracker::queueScissorState_;
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void RenderStateTracker::beginQueue()
+{
+	queueScissorState_ = GLScissorTest::state();
+}
+
+void RenderStateTracker::applyShaderProgram(GLShaderProgram &program)
+{
+	const bool changed = program.use();
+	RenderStatistics::addStateChange(StateTypes::SHADER_PROGRAM, changed);
+}
+
+void RenderStateTracker::applyTextures(const GLTexture *const textures[GLTexture::MaxTextureUnits])
+{
+	for (unsigned int i = 0; i < GLTexture::MaxTextureUnits; i++)
+	{
+		const bool changed = (textures[i] != nullptr) ? textures[i]->bind(i) : GLTexture::unbind(i);
+		RenderStatistics::addStateChange(StateTypes::TEXTURE, changed);
+	}
+}
+
+void RenderStateTracker::applyBlendFunc(GLenum srcFactor, GLenum destFactor)
+{
+	const GLBlending::State current = GLBlending::state();
+	const bool changed = (srcFactor != current.srcRgb || destFactor != current.dstRgb ||
+	                      srcFactor != current.srcAlpha || destFactor != current.dstAlpha);
+	if (changed)
+		GLBlending::setBlendFunc(srcFactor, destFactor);
+	RenderStatistics::addStateChange(StateTypes::BLENDING, changed);
+}
+
+/*! \note The state is not restored after every command, consecutive commands with the same rectangle do not change it. */
+void RenderStateTracker::applyScissor(const Recti &scissorRect)
+{
+	GLScissorTest::State requested = queueScissorState_;
+	if (scissorRect.w > 0 && scissorRect.h > 0)
+	{
+		requested.enabled = true;
+		requested.rect = scissorRect;
+	}
+
+	const GLScissorTest::State current = GLScissorTest::state();
+	const bool changed = (requested.enabled != current.enabled) || (requested.enabled && (requested.rect == current.rect) == false);
+	if (changed)
+		GLScissorTest::setState(requested);
+	RenderStatistics::addStateChange(StateTypes::SCISSOR_TEST, changed);
+}
+
+}
@@ -15,6 +15,12 @@ RenderStatistics::Commands RenderStatistics::allCommands_;
 RenderStatistics::Commands RenderStatistics::typedCommands_[RenderCommand::CommandTypes::COUNT];
 RenderStatistics::CommandPool RenderStatistics::commandPool_;
 RenderStatistics::Textures RenderStatistics::textures_;
+RenderStatistics::Sorting RenderStatistics::sorting_;
+RenderStatistics::SpatialIndex RenderStatistics::spatialIndex_;
+RenderStatistics::FrozenSubtrees RenderStatistics::frozenSubtrees_;
+RenderStatistics::StateChanges RenderStatistics::allStateChanges_;
+RenderStatistics::StateChanges RenderStatistics::typedStateChanges_[RenderStateTracker::StateTypes::COUNT];
+RenderStatistics::Arena RenderStatistics::frameArena_;
 unsigned int RenderStatistics::index_ = 0;
 unsigned int RenderStatistics::culledNodes_[2] = { 0, 0 };
 #endif
@@ -36,12 +42,20 @@ void RenderStatistics::reset()
 
 	TracyPlot("Vertices", static_cast<int64_t>(allCommands_.vertices));
 	TracyPlot("Render Commands", static_cast<int64_t>(allCommands_.commands));
+	TracyPlot("Sorted Commands Moved", static_cast<int64_t>(sorting_.movedCommands));
+	TracyPlot("State Changes Avoided", static_cast<int64_t>(allStateChanges_.avoided()));
 
 	for (unsigned int i = 0; i < RenderCommand::CommandTypes::COUNT; i++)
 		typedCommands_[i].reset();
 	allCommands_.reset();
 
 	commandPool_.reset();
+	sorting_.reset();
+	spatialIndex_.reset();
+	frozenSubtrees_.reset();
+	for (unsigned int i = 0; i < RenderStateTracker::StateTypes::COUNT; i++)
+		typedStateChanges_[i].reset();
+	allStateChanges_.reset();
 #endif
 
 	for (unsigned int i = 0; i < RenderBuffersManager::BufferTypes::COUNT; i++)
@@ -1,9 +1,45 @@
+#include <nctl/Atomic.h>
 #include "SceneNode.h"
+#include "TransformBatch2D.h"
+#include "RenderQueue.h"
+#include "RenderResources.h"
+#include "Viewport.h"
 #include "Application.h"
+#include "RenderStatistics.h"
+#ifdef WITH_JOBSYSTEM
+	#include "JobHandle.h"
+#endif
 #include "tracy.h"
 
 namespace ncine {
 
+namespace {
+
+	/// The arrays used by the batched transformation of children, one per thread as sibling subtrees might be updated in parallel
+	thread_local TransformBatch2D transformBatch;
+	/// The children that are part of the current batched transformation
+	thread_local nctl::Array<SceneNode *> batchedChildren;
+
+	/// Incremented every time the topology of a linearized scene might have changed
+	nctl::AtomicU32 topologyVersionCounter(0);
+	/// The number of frozen nodes, the ancestors of a changed node are not searched for frozen ones when there are none
+	nctl::AtomicU32 numFrozenNodes(0);
+
+	/// Returns the translation of a node matrix, whether it is stored as a four by four matrix or as a 2D affine one
+	inline Vector2f translation(const Matrix4x4f &matrix) { return Vector2f(matrix[3][0], matrix[3][1]); }
+	inline Vector2f translation(const AffineTransform2Df &matrix) { return matrix[2]; }
+
+#ifdef WITH_JOBSYSTEM
+	/// The function executed by the parallel update jobs on a range of sibling nodes
+	void updateNodes(SceneNode **nodes, unsigned int count, const float *frameTime)
+	{
+		for (unsigned int i = 0; i < count; i++)
+			nodes[i]->update(*frameTime);
+	}
+#endif
+
+}
+
 ///////////////////////////////////////////////////////////
 // STATIC DEFINITIONS
 ///////////////////////////////////////////////////////////
@@ -17,14 +53,14 @@ const float SceneNode::MinRotation = 0.5f;
 /*! \param parent The parent can be `nullptr` */
 SceneNode::SceneNode(SceneNode *parent, float x, float y)
     : Object(ObjectType::SCENENODE),
-      updateEnabled_(true), drawEnabled_(true), parent_(nullptr), children_(4),
+      updateEnabled_(true), drawEnabled_(true), alwaysUpdated_(false), frozen_(false), parent_(nullptr), children_(4),
       childOrderIndex_(0), withVisitOrder_(true),
       visitOrderState_(VisitOrderState::SAME_AS_PARENT), visitOrderIndex_(0),
       position_(x, y), anchorPoint_(0.0f, 0.0f), scaleFactor_(1.0f, 1.0f), rotation_(0.0f),
       color_(Color::White), layer_(0), absPosition_(0.0f, 0.0f), absScaleFactor_(1.0f, 1.0f),
       absRotation_(0.0f), absColor_(Color::White), absLayer_(0),
       worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity),
-      shouldDeleteChildrenOnDestruction_(true), dirtyBits_(0xFF), lastFrameUpdated_(0)
+      shouldDeleteChildrenOnDestruction_(true), dirtyBits_(0xFF), transformedInBatch_(false), lastFrameUpdated_(0), lastFrameSubtreeRendered_(0)
 {
 	setParent(parent);
 }
@@ -59,22 +95,27 @@ SceneNode::~SceneNode()
 			child->parent_ = nullptr;
 	}
 
+	setFrozen(false);
 	setParent(nullptr);
 }
 
 SceneNode::SceneNode(SceneNode &&other)
     : Object(nctl::move(other)),
-      updateEnabled_(other.updateEnabled_), drawEnabled_(other.drawEnabled_),
+      updateEnabled_(other.updateEnabled_), drawEnabled_(other.drawEnabled_), alwaysUpdated_(other.alwaysUpdated_),
+      frozen_(other.frozen_), frozenCommands_(nctl::move(other.frozenCommands_)),
       parent_(other.parent_), children_(nctl::move(other.children_)),
       visitOrderState_(other.visitOrderState_),
       position_(other.position_), anchorPoint_(other.anchorPoint_),
       scaleFactor_(other.scaleFactor_), rotation_(other.rotation_), color_(other.color_),
       layer_(other.layer_), shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_),
-      dirtyBits_(other.dirtyBits_), lastFrameUpdated_(other.lastFrameUpdated_)
+      dirtyBits_(other.dirtyBits_), transformedInBatch_(false), lastFrameUpdated_(other.lastFrameUpdated_),
+      lastFrameSubtreeRendered_(other.lastFrameSubtreeRendered_)
 {
 	swapChildPointer(this, &other);
 	for (SceneNode *child : children_)
 		child->parent_ = this;
+	// The address of the node has changed
+	topologyHasChanged();
 }
 
 SceneNode &SceneNode::operator=(SceneNode &&other)
@@ -85,6 +126,11 @@ SceneNode &SceneNode::operator=(SceneNode &&other)
 
 		updateEnabled_ = other.updateEnabled_;
 		drawEnabled_ = other.drawEnabled_;
+		alwaysUpdated_ = other.alwaysUpdated_;
+		// The recorded commands of this node are released before taking the ones of the other node
+		setFrozen(false);
+		frozen_ = other.frozen_;
+		frozenCommands_ = nctl::move(other.frozenCommands_);
 		parent_ = other.parent_;
 		children_ = nctl::move(other.children_);
 		visitOrderState_ = other.visitOrderState_;
@@ -96,11 +142,15 @@ SceneNode &SceneNode::operator=(SceneNode &&other)
 		layer_ = other.layer_;
 		shouldDeleteChildrenOnDestruction_ = other.shouldDeleteChildrenOnDestruction_;
 		dirtyBits_ = other.dirtyBits_;
+		transformedInBatch_ = false;
 		lastFrameUpdated_ = other.lastFrameUpdated_;
+		lastFrameSubtreeRendered_ = other.lastFrameSubtreeRendered_;
 
 		swapChildPointer(this, &other);
 		for (SceneNode *child : children_)
 			child->parent_ = this;
+		// The address of the node has changed
+		topologyHasChanged();
 	}
 	return *this;
 }
@@ -122,11 +172,11 @@ bool SceneNode::setParent(SceneNode *parentNode)
 	{
 		parentNode->children_.pushBack(this);
 		childOrderIndex_ = parentNode->children_.size() - 1;
+		parentNode->topologyHasChanged();
 	}
 	parent_ = parentNode;
 
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 
 	return true;
 }
@@ -144,8 +194,8 @@ bool SceneNode::addChildNode(SceneNode *childNode)
 	children_.pushBack(childNode);
 	childNode->childOrderIndex_ = children_.size() - 1;
 	childNode->parent_ = this;
-	childNode->dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	childNode->dirtyBits_.set(DirtyBitPositions::AabbBit);
+	childNode->setTransformationDirty();
+	topologyHasChanged();
 
 	return true;
 }
@@ -183,13 +233,13 @@ bool SceneNode::removeChildNodeAt(unsigned int index)
 		return false;
 
 	children_[index]->parent_ = nullptr;
-	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	setTransformationDirty();
 	// Fast removal without preserving the order
 	children_.unorderedRemoveAt(index);
 	// The last child has been moved to this index position
 	if (children_.size() > index)
 		children_[index]->childOrderIndex_ = index;
+	topologyHasChanged();
 	return true;
 }
 
@@ -202,10 +252,10 @@ bool SceneNode::removeAllChildrenNodes()
 	for (unsigned int i = 0; i < children_.size(); i++)
 	{
 		children_[i]->parent_ = nullptr;
-		dirtyBits_.set(DirtyBitPositions::TransformationBit);
-		dirtyBits_.set(DirtyBitPositions::AabbBit);
+		setTransformationDirty();
 	}
 	children_.clear();
+	topologyHasChanged();
 
 	return true;
 }
@@ -260,6 +310,7 @@ bool SceneNode::swapChildrenNodes(unsigned int firstIndex, unsigned int secondIn
 
 	nctl::swap(children_[firstIndex], children_[secondIndex]);
 	nctl::swap(children_[firstIndex]->childOrderIndex_, children_[secondIndex]->childOrderIndex_);
+	topologyHasChanged();
 	return true;
 }
 
@@ -281,28 +332,70 @@ bool SceneNode::swapNodeBack()
 	return parent_->swapChildrenNodes(childOrderIndex_, childOrderIndex_ - 1);
 }
 
-/*! \note The frame time is expressed in seconds. */
-void SceneNode::update(float frameTime)
+void SceneNode::setAlwaysUpdated(bool alwaysUpdated)
 {
-	// Early return not needed, the first call to this method is on the root node
+	if (alwaysUpdated_ != alwaysUpdated)
+	{
+		alwaysUpdated_ = alwaysUpdated;
+		// The subtree of an always updated node is not linearized
+		topologyVersionCounter++;
+	}
+	if (alwaysUpdated)
+		setSubtreeDirty();
+}
 
-	if (updateEnabled_)
+void SceneNode::setDrawEnabled(bool drawEnabled)
+{
+	if (drawEnabled_ != drawEnabled)
 	{
-		transform();
-		for (SceneNode *child : children_)
-			child->update(frameTime);
+		drawEnabled_ = drawEnabled;
+		drawingHasChanged();
+	}
+}
 
-		dirtyBits_.reset(DirtyBitPositions::TransformationBit);
-		dirtyBits_.reset(DirtyBitPositions::ColorBit);
+void SceneNode::setFrozen(bool frozen)
+{
+	frozen_ = frozen;
+	if (frozen && frozenCommands_ == nullptr)
+	{
+		frozenCommands_ = nctl::makeUnique<FrozenCommands>();
+		numFrozenNodes.fetchAdd(1);
+	}
+	else if (frozen == false && frozenCommands_ != nullptr)
+	{
+		frozenCommands_.reset(nullptr);
+		numFrozenNodes.fetchSub(1);
+	}
+}
 
-		// A non-drawable scenenode does not have the `updateRenderCommand()` method to reset the flags
-		if (type_ == ObjectType::SCENENODE || type_ == ObjectType::PARTICLE_SYSTEM)
-		{
-			dirtyBits_.reset(DirtyBitPositions::TransformationUploadBit);
-			dirtyBits_.reset(DirtyBitPositions::ColorUploadBit);
-		}
+/*! \note It can be called by the update of sibling subtrees running in parallel, as the commands are only ever invalidated concurrently. */
+void SceneNode::invalidateFrozenCommands()
+{
+	if (frozenCommands_ != nullptr)
+		frozenCommands_->isValid.store(0, nctl::MemoryModel::RELAXED);
+}
 
-		lastFrameUpdated_ = theApplication().numFrames();
+bool SceneNode::hasRecordedCommands() const
+{
+	return (frozenCommands_ != nullptr && frozenCommands_->isValid.load(nctl::MemoryModel::RELAXED) != 0);
+}
+
+/*! \note The frame time is expressed in seconds.
+ *  \note When clean subtrees are skipped, the nodes of a skipped subtree keep the frame of their last actual update. */
+void SceneNode::update(float frameTime)
+{
+	// Early return not needed, the first call to this method is on the root node
+
+	if (updateEnabled_)
+	{
+		const bool skipCleanSubtrees = theApplication().renderingSettings().cleanSubtreeSkipEnabled;
+		if (skipUpdateIfClean(skipCleanSubtrees))
+			return;
+
+		beginUpdate();
+		// Children are updated before resetting the dirty bits, as they need to read the ones of their parent
+		updateChildren(frameTime);
+		endUpdate(skipCleanSubtrees);
 	}
 }
 
@@ -312,16 +405,17 @@ void SceneNode::visit(RenderQueue &renderQueue, unsigned int &visitOrderIndex)
 
 	if (drawEnabled_)
 	{
-		// Increment the index without knowing if the node is going to be rendered or not.
-		// It avoids both a one frame delay when the value changes and calling `DrawableNode::setVisitOrder()` from this function.
-		visitOrderIndex_ = (type_ != ObjectType::PARTICLE) ? visitOrderIndex + 1 : visitOrderIndex;
-		const bool rendered = draw(renderQueue);
+		if (skipVisitIfCulled())
+			return;
 
-		visitOrderIndex_ = visitOrderIndex;
-		// Visit order index only incremented for rendered nodes
-		// Particles get their index incremented only once by their parent particle system
-		const bool incrementIndex = (rendered && type_ != ObjectType::PARTICLE) || type_ == ObjectType::PARTICLE_SYSTEM;
-		visitOrderIndex_ = incrementIndex ? visitOrderIndex++ : visitOrderIndex;
+		// The subtree of a frozen node inside a subtree being recorded is visited as any other
+		if (frozen_ && renderQueue.isRecording() == false)
+		{
+			visitFrozen(renderQueue, visitOrderIndex);
+			return;
+		}
+
+		visitNode(renderQueue, visitOrderIndex);
 
 		for (SceneNode *child : children_)
 			child->visit(renderQueue, visitOrderIndex);
@@ -334,17 +428,90 @@ void SceneNode::visit(RenderQueue &renderQueue, unsigned int &visitOrderIndex)
 
 SceneNode::SceneNode(const SceneNode &other)
     : Object(other), updateEnabled_(other.updateEnabled_),
-      drawEnabled_(other.drawEnabled_), parent_(nullptr), children_(4), childOrderIndex_(0),
+      drawEnabled_(other.drawEnabled_), alwaysUpdated_(other.alwaysUpdated_), frozen_(false), parent_(nullptr), children_(4), childOrderIndex_(0),
       withVisitOrder_(true), visitOrderState_(other.visitOrderState_), visitOrderIndex_(0),
       position_(other.position_), anchorPoint_(other.anchorPoint_),
       scaleFactor_(other.scaleFactor_), rotation_(other.rotation_), color_(other.color_),
       layer_(other.layer_), absPosition_(0.0f, 0.0f), absScaleFactor_(1.0f, 1.0f), absRotation_(0.0f),
       absColor_(Color::White), absLayer_(0), worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity),
-      shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_), dirtyBits_(0xFF)
+      shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_), dirtyBits_(0xFF), transformedInBatch_(false),
+      lastFrameUpdated_(0), lastFrameSubtreeRendered_(0)
 {
+	setFrozen(other.frozen_);
 	setParent(other.parent_);
 }
 
+bool SceneNode::skipUpdateIfClean(bool skipCleanSubtrees)
+{
+	if (skipCleanSubtrees && dirtyBits_.test(DirtyBitPositions::SubtreeBit) == false && inheritsDirtyState() == false)
+	{
+		lastFrameUpdated_ = theApplication().numFrames();
+		return true;
+	}
+	return false;
+}
+
+/*! \note When the spatial index is enabled the viewports mark the ancestors of every node they find overlapping them,
+ *  so that off-screen regions of the scene are skipped as a whole instead of culling each of their nodes. */
+bool SceneNode::skipVisitIfCulled() const
+{
+	const Application::RenderingSettings &settings = theApplication().renderingSettings();
+	if (settings.cullingEnabled && settings.spatialIndexEnabled && lastFrameSubtreeRendered_ < theApplication().numFrames())
+	{
+		RenderStatistics::addSpatialIndexSkippedSubtree();
+		return true;
+	}
+	return false;
+}
+
+void SceneNode::beginUpdate()
+{
+	// Children changing their properties during their update will not need to mark this node, even when updated in parallel
+	dirtyBits_.set(DirtyBitPositions::SubtreeBit);
+	transform();
+	// A transformation or a color inherited from an ancestor above a frozen node has not been seen by the setters in its subtree
+	if (frozenCommands_ != nullptr && (dirtyBits_.test(DirtyBitPositions::TransformationBit) || dirtyBits_.test(DirtyBitPositions::ColorBit)))
+		invalidateFrozenCommands();
+}
+
+void SceneNode::endUpdate(bool skipCleanSubtrees)
+{
+	if (skipCleanSubtrees && alwaysUpdated_ == false)
+	{
+		bool childNeedsUpdate = false;
+		for (unsigned int i = 0; i < children_.size() && childNeedsUpdate == false; i++)
+			childNeedsUpdate = children_[i]->dirtyBits_.test(DirtyBitPositions::SubtreeBit);
+		if (childNeedsUpdate == false)
+			dirtyBits_.reset(DirtyBitPositions::SubtreeBit);
+	}
+
+	dirtyBits_.reset(DirtyBitPositions::TransformationBit);
+	dirtyBits_.reset(DirtyBitPositions::ColorBit);
+
+	// A non-drawable scenenode does not have the `updateRenderCommand()` method to reset the flags
+	if (type_ == ObjectType::SCENENODE || type_ == ObjectType::PARTICLE_SYSTEM)
+	{
+		dirtyBits_.reset(DirtyBitPositions::TransformationUploadBit);
+		dirtyBits_.reset(DirtyBitPositions::ColorUploadBit);
+	}
+
+	lastFrameUpdated_ = theApplication().numFrames();
+}
+
+void SceneNode::visitNode(RenderQueue &renderQueue, unsigned int &visitOrderIndex)
+{
+	// Increment the index without knowing if the node is going to be rendered or not.
+	// It avoids both a one frame delay when the value changes and calling `DrawableNode::setVisitOrder()` from this function.
+	visitOrderIndex_ = (type_ != ObjectType::PARTICLE) ? visitOrderIndex + 1 : visitOrderIndex;
+	const bool rendered = draw(renderQueue);
+
+	visitOrderIndex_ = visitOrderIndex;
+	// Visit order index only incremented for rendered nodes
+	// Particles get their index incremented only once by their parent particle system
+	const bool incrementIndex = (rendered && type_ != ObjectType::PARTICLE) || type_ == ObjectType::PARTICLE_SYSTEM;
+	visitOrderIndex_ = incrementIndex ? visitOrderIndex++ : visitOrderIndex;
+}
+
 /*! \note It is faster than calling `setParent()` on the first child and `removeChildNode()` on the second one */
 void SceneNode::swapChildPointer(SceneNode *first, SceneNode *second)
 {
@@ -395,6 +562,10 @@ void SceneNode::transform()
 		dirtyBits_.set(DirtyBitPositions::ColorUploadBit);
 	}
 
+	// The matrices calculated by the batched transformation of the parent are still valid if no property has changed since then
+	const bool transformedInBatch = transformedInBatch_ && dirtyBits_.test(DirtyBitPositions::TransformationBit) == false;
+	transformedInBatch_ = false;
+
 	const bool parentHasDirtyTransformation = parent_ && parent_->dirtyBits_.test(DirtyBitPositions::TransformationBit);
 	if (parentHasDirtyTransformation)
 	{
@@ -402,14 +573,29 @@ void SceneNode::transform()
 		dirtyBits_.set(DirtyBitPositions::AabbBit);
 	}
 
+	if (transformedInBatch)
+	{
+		// The bit is set again for the children to inherit the dirty transformation
+		dirtyBits_.set(DirtyBitPositions::TransformationBit);
+		dirtyBits_.set(DirtyBitPositions::TransformationUploadBit);
+		return;
+	}
+
 	if (dirtyBits_.test(DirtyBitPositions::TransformationBit) == false)
 		return;
 
 	// Calculating world and local matrices
+#if NCINE_WITH_COMPACT_TRANSFORMS
+	localMatrix_ = AffineTransform2Df::translation(position_.x, position_.y);
+	localMatrix_.rotate(rotation_);
+	localMatrix_.scale(scaleFactor_.x, scaleFactor_.y);
+	localMatrix_.translate(-anchorPoint_.x, -anchorPoint_.y);
+#else
 	localMatrix_ = Matrix4x4f::translation(position_.x, position_.y, 0.0f);
 	localMatrix_.rotateZ(rotation_);
 	localMatrix_.scale(scaleFactor_.x, scaleFactor_.y, 1.0f);
 	localMatrix_.translate(-anchorPoint_.x, -anchorPoint_.y, 0.0f);
+#endif
 
 	absScaleFactor_ = scaleFactor_;
 	absRotation_ = rotation_;
@@ -424,10 +610,163 @@ void SceneNode::transform()
 	else
 		worldMatrix_ = localMatrix_;
 
-	absPosition_.x = worldMatrix_[3][0];
-	absPosition_.y = worldMatrix_[3][1];
+	absPosition_ = translation(worldMatrix_);
 
 	dirtyBits_.set(DirtyBitPositions::TransformationUploadBit);
 }
 
+/*! \note Each child only reads the state of its parent and writes its own subtree, which makes the parallel update deterministic
+ *  and leaves the dirty bits in the same state as the serial one. */
+void SceneNode::updateChildren(float frameTime)
+{
+	const Application::RenderingSettings &settings = theApplication().renderingSettings();
+	if (settings.batchTransformEnabled && children_.size() >= settings.minBatchTransformSize)
+		transformChildrenInBatch(settings.minBatchTransformSize);
+
+#ifdef WITH_JOBSYSTEM
+	if (settings.parallelUpdateEnabled && theServiceLocator().jobSystem().numThreads() > 1 &&
+	    children_.size() >= settings.minParallelUpdateSize && settings.parallelUpdateSplitSize > 0)
+	{
+		JobHandle updateJob = JobHandle::createParallelForJob(children_.data(), children_.size(), updateNodes,
+		                                                      static_cast<const float *>(&frameTime), CountSplitter(settings.parallelUpdateSplitSize));
+		if (updateJob.isValid())
+		{
+			// The frame waits on the update of the nodes
+			updateJob.setPriority(JobPriority::HIGH);
+			if (updateJob.submit())
+			{
+				updateJob.wait();
+				return;
+			}
+			updateJob.cancel();
+		}
+	}
+#endif
+
+	for (SceneNode *child : children_)
+		child->update(frameTime);
+}
+
+/*! \note Only the matrices and the absolute transformation values are calculated, every child still calls `transform()` during its update.
+ *  The child then keeps the batched results unless one of its transformation properties has changed in the meantime. */
+void SceneNode::transformChildrenInBatch(unsigned int minBatchSize)
+{
+	ZoneScoped;
+
+	// This node has already been transformed and its dirty bit tells if the children inherit a dirty transformation
+	const bool hasDirtyTransformation = dirtyBits_.test(DirtyBitPositions::TransformationBit);
+
+	batchedChildren.clear();
+	for (SceneNode *child : children_)
+	{
+		if (child->updateEnabled_ && (hasDirtyTransformation || child->dirtyBits_.test(DirtyBitPositions::TransformationBit)))
+			batchedChildren.pushBack(child);
+	}
+
+	const unsigned int numChildren = batchedChildren.size();
+	if (numChildren < minBatchSize)
+		return;
+
+	transformBatch.resize(numChildren);
+	for (unsigned int i = 0; i < numChildren; i++)
+	{
+		const SceneNode *child = batchedChildren[i];
+		transformBatch.positionX[i] = child->position_.x;
+		transformBatch.positionY[i] = child->position_.y;
+		transformBatch.rotation[i] = child->rotation_;
+		transformBatch.scaleX[i] = child->scaleFactor_.x;
+		transformBatch.scaleY[i] = child->scaleFactor_.y;
+		transformBatch.anchorX[i] = child->anchorPoint_.x;
+		transformBatch.anchorY[i] = child->anchorPoint_.y;
+	}
+
+	transformBatch.transform(worldMatrix());
+
+	for (unsigned int i = 0; i < numChildren; i++)
+	{
+		SceneNode *child = batchedChildren[i];
+		child->localMatrix_ = NodeMatrix(transformBatch.localMatrix(i));
+		child->worldMatrix_ = NodeMatrix(transformBatch.worldMatrix(i));
+
+		child->absScaleFactor_ = child->scaleFactor_ * absScaleFactor_;
+		child->absRotation_ = child->rotation_ + absRotation_;
+		child->absPosition_ = translation(child->worldMatrix_);
+
+		// The bit is reset to detect any change happening before the child calls `transform()`
+		child->dirtyBits_.reset(DirtyBitPositions::TransformationBit);
+		child->dirtyBits_.set(DirtyBitPositions::AabbBit);
+		child->transformedInBatch_ = true;
+	}
+}
+
+/*! \note The walk does not stop at the first frozen ancestor, as the commands of a frozen node are also part of the ones of its frozen ancestors. */
+void SceneNode::drawingHasChanged()
+{
+	if (numFrozenNodes.load(nctl::MemoryModel::RELAXED) == 0)
+		return;
+
+	for (SceneNode *node = this; node != nullptr; node = node->parent_)
+		node->invalidateFrozenCommands();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+unsigned int SceneNode::topologyVersion()
+{
+	return topologyVersionCounter.load();
+}
+
+/*! \note Changes inside the subtree of an always updated node do not count, as that subtree is not linearized.
+ *  The recorded commands of frozen ancestors are discarded, as they might belong to nodes that are no longer in their subtree. */
+void SceneNode::topologyHasChanged()
+{
+	bool isLinearized = true;
+	for (SceneNode *node = this; node != nullptr; node = node->parent_)
+	{
+		node->invalidateFrozenCommands();
+		if (node->alwaysUpdated_)
+			isLinearized = false;
+	}
+
+	if (isLinearized)
+		topologyVersionCounter++;
+}
+
+/*! \note The commands are also recorded again when the subtree is visited by a different viewport,
+ *  with a different culling rectangle, or with a different visit order index, as it is part of their sorting key. */
+void SceneNode::visitFrozen(RenderQueue &renderQueue, unsigned int &visitOrderIndex)
+{
+	FrozenCommands &frozenCommands = *frozenCommands_;
+	const Viewport *viewport = RenderResources::currentViewport();
+	const bool cullingEnabled = theApplication().renderingSettings().cullingEnabled;
+
+	const bool isValid = frozenCommands.isValid.load(nctl::MemoryModel::RELAXED) != 0 &&
+	                     frozenCommands.viewport == viewport && frozenCommands.firstVisitOrder == visitOrderIndex &&
+	                     frozenCommands.cullingEnabled == cullingEnabled &&
+	                     (cullingEnabled == false || frozenCommands.cullingRect == viewport->cullingRect());
+
+	if (isValid)
+	{
+		renderQueue.addFrozenCommands(frozenCommands);
+		visitOrderIndex += frozenCommands.numVisitOrders;
+		return;
+	}
+
+	ZoneScoped;
+	frozenCommands.firstVisitOrder = visitOrderIndex;
+	renderQueue.beginRecording();
+	visitNode(renderQueue, visitOrderIndex);
+	for (SceneNode *child : children_)
+		child->visit(renderQueue, visitOrderIndex);
+	renderQueue.endRecording(frozenCommands);
+
+	frozenCommands.isValid.store(1, nctl::MemoryModel::RELAXED);
+	frozenCommands.numVisitOrders = visitOrderIndex - frozenCommands.firstVisitOrder;
+	frozenCommands.viewport = viewport;
+	frozenCommands.cullingEnabled = cullingEnabled;
+	frozenCommands.cullingRect = viewport->cullingRect();
+}
+
 }
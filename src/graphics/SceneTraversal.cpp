@@ -0,0 +1,141 @@
+#include "SceneTraversal.h"
+#include "SceneNode.h"
+#include "Application.h"
+#include "tracy.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+SceneTraversal::SceneTraversal()
+    : rootNode_(nullptr), topologyVersion_(0)
+{
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note A node is transformed before its children, like in `SceneNode::update()`, and its dirty bits are reset
+ *  only after the last node of its subtree, when it is popped from the stack. */
+void SceneTraversal::update(SceneNode *rootNode, float frameTime)
+{
+	ZoneScoped;
+	rebuildIfChanged(rootNode);
+
+	const Application::RenderingSettings &settings = theApplication().renderingSettings();
+	const bool skipCleanSubtrees = settings.cleanSubtreeSkipEnabled;
+
+	updateStack_.clear();
+	unsigned int index = 0;
+	while (index < nodes_.size())
+	{
+		// The parent of the node is always on the stack, the nodes above it have no more descendants to update
+		const int parentIndex = parentIndices_[index];
+		while (updateStack_.isEmpty() == false && updateStack_.back() != parentIndex)
+		{
+			nodes_[updateStack_.back()]->endUpdate(skipCleanSubtrees);
+			updateStack_.popBack();
+		}
+
+		SceneNode *node = nodes_[index];
+		if (node->updateEnabled_ == false || node->skipUpdateIfClean(skipCleanSubtrees))
+		{
+			index = subtreeEnds_[index];
+			continue;
+		}
+		else if (node->alwaysUpdated_)
+		{
+			// The node might override `update()` and it updates its own subtree
+			node->update(frameTime);
+			index = subtreeEnds_[index];
+			continue;
+		}
+
+		node->beginUpdate();
+		if (settings.batchTransformEnabled && node->children_.size() >= settings.minBatchTransformSize)
+			node->transformChildrenInBatch(settings.minBatchTransformSize);
+
+		updateStack_.pushBack(static_cast<int>(index));
+		index++;
+	}
+
+	while (updateStack_.isEmpty() == false)
+	{
+		nodes_[updateStack_.back()]->endUpdate(skipCleanSubtrees);
+		updateStack_.popBack();
+	}
+}
+
+void SceneTraversal::visit(SceneNode *rootNode, RenderQueue &renderQueue, unsigned int &visitOrderIndex)
+{
+	ZoneScoped;
+	rebuildIfChanged(rootNode);
+
+	unsigned int index = 0;
+	while (index < nodes_.size())
+	{
+		SceneNode *node = nodes_[index];
+		if (node->drawEnabled_ == false || node->skipVisitIfCulled())
+		{
+			index = subtreeEnds_[index];
+			continue;
+		}
+		else if (node->alwaysUpdated_)
+		{
+			// The subtree of the node is not linearized
+			node->visit(renderQueue, visitOrderIndex);
+			index = subtreeEnds_[index];
+			continue;
+		}
+		else if (node->frozen_)
+		{
+			// The node replays the recorded commands of its subtree or records them again
+			node->visit(renderQueue, visitOrderIndex);
+			index = subtreeEnds_[index];
+			continue;
+		}
+
+		node->visitNode(renderQueue, visitOrderIndex);
+		index++;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void SceneTraversal::rebuildIfChanged(SceneNode *rootNode)
+{
+	const unsigned int topologyVersion = SceneNode::topologyVersion();
+	if (rootNode == rootNode_ && topologyVersion == topologyVersion_ && nodes_.isEmpty() == false)
+		return;
+
+	ZoneScoped;
+	nodes_.clear();
+	parentIndices_.clear();
+	subtreeEnds_.clear();
+	appendSubtree(rootNode, -1);
+
+	rootNode_ = rootNode;
+	topologyVersion_ = topologyVersion;
+}
+
+void SceneTraversal::appendSubtree(SceneNode *node, int parentIndex)
+{
+	const unsigned int index = nodes_.size();
+	nodes_.pushBack(node);
+	parentIndices_.pushBack(parentIndex);
+	subtreeEnds_.pushBack(index + 1);
+
+	if (node->alwaysUpdated_ == false)
+	{
+		for (SceneNode *child : node->children_)
+			appendSubtree(child, static_cast<int>(index));
+		subtreeEnds_[index] = nodes_.size();
+	}
+}
+
+}
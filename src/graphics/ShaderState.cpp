@@ -74,8 +74,11 @@ bool ShaderState::setNode(DrawableNode *node)
 		}
 		node_ = node;
 
-		if (shader_ != nullptr)
+		// Without a node the shader cannot be applied, but the handles should not point to the previous material
+		if (node_ != nullptr && shader_ != nullptr)
 			setShader(shader_);
+		else
+			resolveUniforms();
 
 		nodeHasChanged = true;
 	}
@@ -107,6 +110,7 @@ bool ShaderState::setShader(Shader *shader)
 
 		shader_ = shader;
 		node_->shaderHasChanged();
+		resolveUniforms();
 		shaderHasChanged = true;
 	}
 
@@ -121,6 +125,7 @@ bool ShaderState::resetShader()
 		Material &material = node_->renderCommand_->material();
 		material.setShaderProgram(shader_->glShaderProgram_.get());
 		node_->shaderHasChanged();
+		resolveUniforms();
 		return true;
 	}
 	return false;
@@ -413,4 +418,238 @@ bool ShaderState::copyToUniformBlock(const char *blockName, unsigned char *src)
 	return result;
 }
 
+/*! \note The returned handle can be used with the shader state that created it, even after a change of node or shader */
+ShaderState::UniformHandle ShaderState::uniformHandle(const char *blockName, const char *name)
+{
+	if (name == nullptr)
+		return UniformHandle();
+
+	const char *blockString = (blockName != nullptr) ? blockName : "";
+	for (unsigned int i = 0; i < resolvedUniforms_.size(); i++)
+	{
+		const ResolvedUniform &resolved = resolvedUniforms_[i];
+		if (resolved.name == name && resolved.blockName == blockString)
+			return UniformHandle(static_cast<int>(i));
+	}
+
+	resolvedUniforms_.emplaceBack();
+	ResolvedUniform &resolved = resolvedUniforms_.back();
+	resolved.blockName = blockString;
+	resolved.name = name;
+	resolveUniform(resolvedUniforms_.size() - 1);
+
+	return UniformHandle(static_cast<int>(resolvedUniforms_.size() - 1));
+}
+
+/*! \note The returned handle can be used with the shader state that created it, even after a change of node or shader */
+ShaderState::UniformHandle ShaderState::uniformBlockHandle(const char *blockName)
+{
+	if (blockName == nullptr || blockName[0] == '\0')
+		return UniformHandle();
+
+	for (unsigned int i = 0; i < resolvedUniforms_.size(); i++)
+	{
+		const ResolvedUniform &resolved = resolvedUniforms_[i];
+		if (resolved.name.isEmpty() && resolved.blockName == blockName)
+			return UniformHandle(static_cast<int>(i));
+	}
+
+	resolvedUniforms_.emplaceBack();
+	ResolvedUniform &resolved = resolvedUniforms_.back();
+	resolved.blockName = blockName;
+	resolveUniform(resolvedUniforms_.size() - 1);
+
+	return UniformHandle(static_cast<int>(resolvedUniforms_.size() - 1));
+}
+
+bool ShaderState::setUniformInt(UniformHandle handle, const int *vector)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr && vector != nullptr) ? uniform->setIntVector(vector) : false;
+}
+
+bool ShaderState::setUniformInt(UniformHandle handle, int value0)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setIntValue(value0) : false;
+}
+
+bool ShaderState::setUniformInt(UniformHandle handle, int value0, int value1)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setIntValue(value0, value1) : false;
+}
+
+bool ShaderState::setUniformInt(UniformHandle handle, int value0, int value1, int value2)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setIntValue(value0, value1, value2) : false;
+}
+
+bool ShaderState::setUniformInt(UniformHandle handle, int value0, int value1, int value2, int value3)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setIntValue(value0, value1, value2, value3) : false;
+}
+
+bool ShaderState::setUniformInt(UniformHandle handle, const Vector2i &vector)
+{
+	return setUniformInt(handle, vector.x, vector.y);
+}
+
+bool ShaderState::setUniformInt(UniformHandle handle, const Vector3i &vector)
+{
+	return setUniformInt(handle, vector.x, vector.y, vector.z);
+}
+
+bool ShaderState::setUniformInt(UniformHandle handle, const Vector4i &vector)
+{
+	return setUniformInt(handle, vector.x, vector.y, vector.z, vector.w);
+}
+
+bool ShaderState::setUniformUint(UniformHandle handle, const unsigned int *vector)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr && vector != nullptr) ? uniform->setUintVector(vector) : false;
+}
+
+bool ShaderState::setUniformUint(UniformHandle handle, unsigned int value0)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setUintValue(value0) : false;
+}
+
+bool ShaderState::setUniformUint(UniformHandle handle, unsigned int value0, unsigned int value1)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setUintValue(value0, value1) : false;
+}
+
+bool ShaderState::setUniformUint(UniformHandle handle, unsigned int value0, unsigned int value1, unsigned int value2)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setUintValue(value0, value1, value2) : false;
+}
+
+bool ShaderState::setUniformUint(UniformHandle handle, unsigned int value0, unsigned int value1, unsigned int value2, unsigned int value3)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setUintValue(value0, value1, value2, value3) : false;
+}
+
+bool ShaderState::setUniformFloat(UniformHandle handle, const float *vector)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr && vector != nullptr) ? uniform->setFloatVector(vector) : false;
+}
+
+bool ShaderState::setUniformFloat(UniformHandle handle, float value0)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setFloatValue(value0) : false;
+}
+
+bool ShaderState::setUniformFloat(UniformHandle handle, float value0, float value1)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setFloatValue(value0, value1) : false;
+}
+
+bool ShaderState::setUniformFloat(UniformHandle handle, float value0, float value1, float value2)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setFloatValue(value0, value1, value2) : false;
+}
+
+bool ShaderState::setUniformFloat(UniformHandle handle, float value0, float value1, float value2, float value3)
+{
+	GLUniformCache *uniform = handleUniform(handle);
+	return (uniform != nullptr) ? uniform->setFloatValue(value0, value1, value2, value3) : false;
+}
+
+bool ShaderState::setUniformFloat(UniformHandle handle, const Vector2f &vector)
+{
+	return setUniformFloat(handle, vector.x, vector.y);
+}
+
+bool ShaderState::setUniformFloat(UniformHandle handle, const Vector3f &vector)
+{
+	return setUniformFloat(handle, vector.x, vector.y, vector.z);
+}
+
+bool ShaderState::setUniformFloat(UniformHandle handle, const Vector4f &vector)
+{
+	return setUniformFloat(handle, vector.x, vector.y, vector.z, vector.w);
+}
+
+bool ShaderState::setUniformFloat(UniformHandle handle, const Colorf &color)
+{
+	return setUniformFloat(handle, color.r(), color.g(), color.b(), color.a());
+}
+
+unsigned int ShaderState::uniformBlockSize(UniformHandle handle)
+{
+	GLUniformBlockCache *uniformBlock = handleUniformBlock(handle);
+	return (uniformBlock != nullptr) ? static_cast<unsigned int>(uniformBlock->size()) : 0;
+}
+
+bool ShaderState::copyToUniformBlock(UniformHandle handle, unsigned int destIndex, unsigned char *src, unsigned int numBytes)
+{
+	GLUniformBlockCache *uniformBlock = handleUniformBlock(handle);
+	return (uniformBlock != nullptr) ? uniformBlock->copyData(destIndex, src, numBytes) : false;
+}
+
+bool ShaderState::copyToUniformBlock(UniformHandle handle, unsigned char *src, unsigned int numBytes)
+{
+	return copyToUniformBlock(handle, 0, src, numBytes);
+}
+
+bool ShaderState::copyToUniformBlock(UniformHandle handle, unsigned char *src)
+{
+	GLUniformBlockCache *uniformBlock = handleUniformBlock(handle);
+	return (uniformBlock != nullptr) ? uniformBlock->copyData(src) : false;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ShaderState::resolveUniforms()
+{
+	for (unsigned int i = 0; i < resolvedUniforms_.size(); i++)
+		resolveUniform(i);
+}
+
+void ShaderState::resolveUniform(unsigned int index)
+{
+	ResolvedUniform &resolved = resolvedUniforms_[index];
+	resolved.uniform = nullptr;
+	resolved.uniformBlock = nullptr;
+
+	if (node_ == nullptr || shader_ == nullptr)
+		return;
+
+	Material &material = node_->renderCommand_->material();
+	if (resolved.name.isEmpty())
+		resolved.uniformBlock = material.uniformBlock(resolved.blockName.data());
+	else
+		resolved.uniform = retrieveUniform(material, resolved.blockName.data(), resolved.name.data());
+}
+
+GLUniformCache *ShaderState::handleUniform(UniformHandle handle)
+{
+	if (handle.index_ < 0 || static_cast<unsigned int>(handle.index_) >= resolvedUniforms_.size())
+		return nullptr;
+
+	return resolvedUniforms_[handle.index_].uniform;
+}
+
+GLUniformBlockCache *ShaderState::handleUniformBlock(UniformHandle handle)
+{
+	if (handle.index_ < 0 || static_cast<unsigned int>(handle.index_) >= resolvedUniforms_.size())
+		return nullptr;
+
+	return resolvedUniforms_[handle.index_].uniformBlock;
+}
+
 }
@@ -0,0 +1,228 @@
+#include <cmath> // for floorf()
+#include <nctl/algorithms.h>
+#include "common_macros.h"
+#include "SpatialGrid.h"
+#include "DrawableNode.h"
+#include "RenderStatistics.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+	/// Cell coordinates are clamped to avoid overflowing when bounding boxes are far from the origin
+	const float MaxCellCoordinate = static_cast<float>(1 << 24);
+
+	inline int cellCoordinate(float value, float invCellSize)
+	{
+		return static_cast<int>(nctl::clamp(floorf(value * invCellSize), -MaxCellCoordinate, MaxCellCoordinate));
+	}
+
+	/// Returns true if the range covers more cells than the specified number, without overflowing
+	inline bool coversMoreCells(const Recti &cells, unsigned int numCells)
+	{
+		const unsigned int width = static_cast<unsigned int>(cells.w);
+		const unsigned int height = static_cast<unsigned int>(cells.h);
+		return (width > numCells || height > numCells || width * height > numCells);
+	}
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cellSize_(cellSize), numNodes_(0)
+{
+	ASSERT(cellSize > 0.0f);
+}
+
+SpatialGrid::~SpatialGrid()
+{
+	clear();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void SpatialGrid::update(DrawableNode *node)
+{
+	const Recti cells = cellRange(node->aabb_);
+	if (node->spatialGridCells_.w > 0)
+	{
+		if (node->spatialGridCells_ == cells)
+			return;
+		erase(node, node->spatialGridCells_);
+	}
+	else
+		numNodes_++;
+
+	insert(node, cells);
+	node->spatialGridCells_ = cells;
+}
+
+void SpatialGrid::remove(DrawableNode *node)
+{
+	if (node->spatialGridCells_.w == 0)
+		return;
+
+	erase(node, node->spatialGridCells_);
+	node->spatialGridCells_ = Recti();
+	numNodes_--;
+}
+
+void SpatialGrid::clear()
+{
+	// A node is reset once for every cell that contains it
+	for (nctl::Array<DrawableNode *> &nodes : buckets_)
+	{
+		for (DrawableNode *node : nodes)
+			node->spatialGridCells_ = Recti();
+		nodes.clear();
+	}
+	for (DrawableNode *node : largeNodes_)
+		node->spatialGridCells_ = Recti();
+	largeNodes_.clear();
+
+	numNodes_ = 0;
+}
+
+void SpatialGrid::setCellSize(float cellSize)
+{
+	ASSERT(cellSize > 0.0f);
+	if (cellSize != cellSize_)
+	{
+		clear();
+		cellSize_ = cellSize;
+	}
+}
+
+/*! \note Nodes covering more than one cell of the rectangle are tested only once, as marked nodes are skipped */
+void SpatialGrid::markOverlapping(const Rectf &rect, unsigned long int frame)
+{
+	ZoneScoped;
+
+	unsigned int queriedCells = 0;
+	unsigned int hits = 0;
+	unsigned int misses = 0;
+
+	if (numNodes_ > 0)
+	{
+		markNodes(largeNodes_, rect, frame, hits, misses);
+
+		const Recti cells = cellRange(rect);
+		if (coversMoreCells(cells, NumBuckets))
+		{
+			// Visiting every bucket once is cheaper than visiting the same buckets from many different cells
+			for (nctl::Array<DrawableNode *> &nodes : buckets_)
+				markNodes(nodes, rect, frame, hits, misses);
+			queriedCells = NumBuckets;
+		}
+		else
+		{
+			for (int y = cells.y; y < cells.y + cells.h; y++)
+			{
+				for (int x = cells.x; x < cells.x + cells.w; x++)
+					markNodes(bucket(x, y), rect, frame, hits, misses);
+			}
+			queriedCells = static_cast<unsigned int>(cells.w * cells.h);
+		}
+	}
+
+	RenderStatistics::addSpatialIndexQuery(numNodes_, queriedCells, hits, misses);
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+Recti SpatialGrid::cellRange(const Rectf &rect) const
+{
+	const float invCellSize = 1.0f / cellSize_;
+	const Vector2f rectMin = rect.min();
+	const Vector2f rectMax = rect.max();
+	const int minX = cellCoordinate(rectMin.x, invCellSize);
+	const int minY = cellCoordinate(rectMin.y, invCellSize);
+	const int maxX = cellCoordinate(rectMax.x, invCellSize);
+	const int maxY = cellCoordinate(rectMax.y, invCellSize);
+
+	return Recti(minX, minY, maxX - minX + 1, maxY - minY + 1);
+}
+
+nctl::Array<DrawableNode *> &SpatialGrid::bucket(int cellX, int cellY)
+{
+	const uint32_t hash = (static_cast<uint32_t>(cellX) * 73856093u) ^ (static_cast<uint32_t>(cellY) * 19349663u);
+	return buckets_[hash & (NumBuckets - 1)];
+}
+
+void SpatialGrid::insert(DrawableNode *node, const Recti &cells)
+{
+	if (coversMoreCells(cells, MaxCellsPerNode))
+	{
+		largeNodes_.pushBack(node);
+		return;
+	}
+
+	if (buckets_.isEmpty())
+		buckets_.setSize(NumBuckets);
+
+	for (int y = cells.y; y < cells.y + cells.h; y++)
+	{
+		for (int x = cells.x; x < cells.x + cells.w; x++)
+			bucket(x, y).pushBack(node);
+	}
+}
+
+void SpatialGrid::erase(DrawableNode *node, const Recti &cells)
+{
+	if (coversMoreCells(cells, MaxCellsPerNode))
+	{
+		for (unsigned int i = 0; i < largeNodes_.size(); i++)
+		{
+			if (largeNodes_[i] == node)
+			{
+				largeNodes_.unorderedRemoveAt(i);
+				break;
+			}
+		}
+		return;
+	}
+
+	// When two cells of the node share a bucket the node is in that bucket twice, and it is removed once for each cell
+	for (int y = cells.y; y < cells.y + cells.h; y++)
+	{
+		for (int x = cells.x; x < cells.x + cells.w; x++)
+		{
+			nctl::Array<DrawableNode *> &nodes = bucket(x, y);
+			for (unsigned int i = 0; i < nodes.size(); i++)
+			{
+				if (nodes[i] == node)
+				{
+					nodes.unorderedRemoveAt(i);
+					break;
+				}
+			}
+		}
+	}
+}
+
+void SpatialGrid::markNodes(nctl::Array<DrawableNode *> &nodes, const Rectf &rect, unsigned long int frame, unsigned int &hits, unsigned int &misses)
+{
+	for (DrawableNode *node : nodes)
+	{
+		if (node->lastFrameRendered_ >= frame)
+			continue;
+
+		if (node->aabb_.overlaps(rect))
+		{
+			node->lastFrameRendered_ = frame;
+			// The visit skips the subtrees without any overlapping node
+			node->setSubtreeRendered(frame);
+			hits++;
+		}
+		else
+			misses++;
+	}
+}
+
+}
@@ -45,8 +45,7 @@ TextNode::TextNode(SceneNode *parent, Font *font, unsigned int maxStringLength)
       dirtyBoundaries_(true), withKerning_(true), font_(font),
       interleavedVertices_(maxStringLength * 4 + (maxStringLength - 1) * 2),
       xAdvance_(0.0f), yAdvance_(0.0f), lineLengths_(4), alignment_(Alignment::LEFT),
-      lineHeight_(font ? font->lineHeight() : 0.0f), tabSize_(DefaultTabSize),
-      instanceBlock_(nullptr)
+      lineHeight_(font ? font->lineHeight() : 0.0f), tabSize_(DefaultTabSize)
 {
 	ASSERT(maxStringLength > 0);
 	init();
@@ -109,6 +108,7 @@ void TextNode::setFont(Font *font)
 
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		drawingHasChanged();
 	}
 	else
 	{
@@ -148,6 +148,7 @@ void TextNode::enableKerning(bool withKerning)
 		withKerning_ = withKerning;
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		drawingHasChanged();
 	}
 }
 
@@ -158,6 +159,7 @@ void TextNode::setAlignment(Alignment alignment)
 		alignment_ = alignment;
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		drawingHasChanged();
 	}
 }
 
@@ -171,6 +173,7 @@ void TextNode::setTabSize(unsigned int tabSize)
 		tabSize_ = tabSize;
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		drawingHasChanged();
 	}
 }
 
@@ -181,6 +184,7 @@ void TextNode::setString(const nctl::String &string)
 		string_ = string;
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		drawingHasChanged();
 	}
 }
 
@@ -191,6 +195,7 @@ void TextNode::setString(const char *string)
 		string_.assign(string);
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		drawingHasChanged();
 	}
 }
 
@@ -359,7 +364,7 @@ TextNode::TextNode(const TextNode &other)
       withKerning_(other.withKerning_), font_(other.font_),
       interleavedVertices_(string_.capacity() * 4 + (string_.capacity() - 1) * 2),
       xAdvance_(0.0f), yAdvance_(0.0f), lineLengths_(4), alignment_(other.alignment_),
-      lineHeight_(font_ ? font_->lineHeight() : 0.0f), instanceBlock_(nullptr)
+      lineHeight_(font_ ? font_->lineHeight() : 0.0f)
 {
 	init();
 	setBlendingEnabled(other.isBlendingEnabled());
@@ -519,13 +524,12 @@ void TextNode::processGlyph(const FontGlyph *glyph, Degenerate degen)
 void TextNode::shaderHasChanged()
 {
 	renderCommand_->material().reserveUniformsDataMemory();
-	instanceBlock_ = renderCommand_->material().uniformBlock(Material::InstanceBlockName);
-	GLUniformCache *textureUniform = renderCommand_->material().uniform(Material::TextureUniformName);
+	GLUniformCache *textureUniform = renderCommand_->material().builtinUniform(Material::BuiltinUniforms::TEXTURE);
 	if (textureUniform && textureUniform->intValue(0) != 0)
 		textureUniform->setIntValue(0); // GL_TEXTURE0
 
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
-	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	setColorDirty();
 
 	renderCommand_->material().setDefaultAttributesParameters();
 }
@@ -537,7 +541,7 @@ void TextNode::updateRenderCommand()
 
 	if (dirtyBits_.test(DirtyBitPositions::ColorUploadBit))
 	{
-		GLUniformCache *colorUniform = instanceBlock_->uniform(Material::ColorUniformName);
+		GLUniformCache *colorUniform = renderCommand_->material().builtinUniform(Material::BuiltinUniforms::COLOR);
 		if (colorUniform)
 		{
 			const bool setAsUint = colorUniform->setUintValue(absColor_.abgr());
@@ -0,0 +1,152 @@
+#include "common_macros.h"
+#include "TransformBatch2D.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+	/// Quarter turns added to rotations to make them positive before truncating them to integers
+	const int QuadrantOffset = 1024;
+
+	/// Polynomial approximation of the sine in the [-Pi/4, Pi/4] range, with the coefficients of the Cephes library
+	inline float sinPolynomial(float x)
+	{
+		const float x2 = x * x;
+		return x + x * x2 * (-1.6666654611e-1f + x2 * (8.3321608736e-3f + x2 * -1.9515295891e-4f));
+	}
+
+	/// Polynomial approximation of the cosine in the [-Pi/4, Pi/4] range, with the coefficients of the Cephes library
+	inline float cosPolynomial(float x)
+	{
+		const float x2 = x * x;
+		return 1.0f - 0.5f * x2 + x2 * x2 * (4.166664568298827e-2f + x2 * (-1.388731625493765e-3f + x2 * 2.443315711809948e-5f));
+	}
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+TransformBatch2D::TransformBatch2D()
+    : TransformBatch2D(0)
+{
+}
+
+TransformBatch2D::TransformBatch2D(unsigned int capacity)
+    : positionX(nullptr), positionY(nullptr), rotation(nullptr),
+      scaleX(nullptr), scaleY(nullptr), anchorX(nullptr), anchorY(nullptr),
+      capacity_(0), size_(0), local_{}, world_{}, worldColumn2_(0.0f, 0.0f, 1.0f, 0.0f)
+{
+	resize(capacity);
+	size_ = 0;
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void TransformBatch2D::resize(unsigned int size)
+{
+	if (size > capacity_)
+	{
+		// Every array starts at a multiple of four floats from the beginning of the buffer
+		const unsigned int stride = (size + 3) & ~3u;
+		buffer_ = nctl::makeUnique<float[]>(stride * NumArrays);
+		capacity_ = size;
+
+		float *arrays[NumArrays];
+		for (unsigned int i = 0; i < NumArrays; i++)
+			arrays[i] = buffer_.get() + stride * i;
+
+		positionX = arrays[0];
+		positionY = arrays[1];
+		rotation = arrays[2];
+		scaleX = arrays[3];
+		scaleY = arrays[4];
+		anchorX = arrays[5];
+		anchorY = arrays[6];
+		for (unsigned int i = 0; i < NumLocalArrays; i++)
+			local_[i] = arrays[NumInputArrays + i];
+		for (unsigned int i = 0; i < NumWorldArrays; i++)
+			world_[i] = arrays[NumInputArrays + NumLocalArrays + i];
+	}
+
+	size_ = size;
+}
+
+/*! \note Each loop reads and writes only a few arrays, to keep the aliasing checks that guard the vectorized versions cheap */
+void TransformBatch2D::transform(const Matrix4x4f &parentWorldMatrix)
+{
+	ZoneScoped;
+
+	// Pointers are copied locally, or the compiler would assume that writing to the arrays could modify them
+	const unsigned int size = size_;
+	const float *rot = rotation;
+	const float *posX = positionX;
+	const float *posY = positionY;
+	const float *sclX = scaleX;
+	const float *sclY = scaleY;
+	const float *ancX = anchorX;
+	const float *ancY = anchorY;
+	float *a = local_[0];
+	float *b = local_[1];
+	float *c = local_[2];
+	float *d = local_[3];
+	float *tx = local_[4];
+	float *ty = local_[5];
+
+	// Sine and cosine are calculated first, in the arrays of the first two elements of the local matrices.
+	// Rotations are reduced to a quarter turn and the quadrant selects the sign and the function of the result, without branches.
+	for (unsigned int i = 0; i < size; i++)
+	{
+		const int quadrant = static_cast<int>(rot[i] * (1.0f / 90.0f) + (QuadrantOffset + 0.5f));
+		const float radians = (rot[i] - static_cast<float>(quadrant - QuadrantOffset) * 90.0f) * fDegToRad;
+		const float sine = sinPolynomial(radians);
+		const float cosine = cosPolynomial(radians);
+
+		const float swap = static_cast<float>(quadrant & 1);
+		const float sineSign = 1.0f - static_cast<float>(quadrant & 2);
+		const float cosineSign = 1.0f - static_cast<float>((quadrant + 1) & 2);
+		a[i] = cosineSign * (cosine * (1.0f - swap) + sine * swap);
+		b[i] = sineSign * (sine * (1.0f - swap) + cosine * swap);
+	}
+
+	// The same elements calculated by `Matrix4x4f::translation()`, `rotateZ()`, `scale()` and `translate()`
+	for (unsigned int i = 0; i < size; i++)
+	{
+		c[i] = -b[i] * sclY[i];
+		d[i] = a[i] * sclY[i];
+	}
+	for (unsigned int i = 0; i < size; i++)
+	{
+		a[i] *= sclX[i];
+		b[i] *= sclX[i];
+	}
+	for (unsigned int i = 0; i < size; i++)
+		tx[i] = posX[i] - a[i] * ancX[i] - c[i] * ancY[i];
+	for (unsigned int i = 0; i < size; i++)
+		ty[i] = posY[i] - b[i] * ancX[i] - d[i] * ancY[i];
+
+	// The multiplication by the parent world matrix, skipping the products by the zeros of the local matrices
+	const Matrix4x4f &p = parentWorldMatrix;
+	for (unsigned int j = 0; j < 4; j++)
+	{
+		const float p0 = p[0][j];
+		const float p1 = p[1][j];
+		const float p3 = p[3][j];
+		float *world0 = world_[j];
+		float *world1 = world_[4 + j];
+		float *world3 = world_[8 + j];
+
+		for (unsigned int i = 0; i < size; i++)
+		{
+			world0[i] = p0 * a[i] + p1 * b[i];
+			world1[i] = p0 * c[i] + p1 * d[i];
+		}
+		for (unsigned int i = 0; i < size; i++)
+			world3[i] = p0 * tx[i] + p1 * ty[i] + p3;
+	}
+	worldColumn2_ = p[2];
+}
+
+}
@@ -5,6 +5,8 @@
 #include "Application.h"
 #include "IAppEventHandler.h"
 #include "DrawableNode.h"
+#include "SpatialGrid.h"
+#include "SceneTraversal.h"
 #include "Camera.h"
 #include "GLFramebufferObject.h"
 #include "Texture.h"
@@ -70,7 +72,7 @@ Viewport::Viewport(const char *name, Texture *texture, DepthStencilFormat depthS
       depthStencilFormat_(DepthStencilFormat::NONE), lastFrameCleared_(0),
       clearMode_(ClearMode::EVERY_FRAME), clearColor_(Colorf::Black),
       renderQueue_(nctl::makeUnique<RenderQueue>()),
-      fbo_(nullptr), rootNode_(nullptr), camera_(nullptr),
+      fbo_(nullptr), rootNode_(nullptr), sceneTraversal_(nctl::makeUnique<SceneTraversal>()), camera_(nullptr),
       stateBits_(0), numColorAttachments_(0)
 {
 	for (unsigned int i = 0; i < MaxNumTextures; i++)
@@ -358,10 +360,26 @@ void Viewport::update()
 	if (rootNode_)
 	{
 		ZoneScoped;
+		const Application::RenderingSettings &settings = theApplication().renderingSettings();
 		if (rootNode_->lastFrameUpdated() < theApplication().numFrames())
-			rootNode_->update(theApplication().frameTime());
+		{
+			if (settings.linearTraversalEnabled)
+				sceneTraversal_->update(rootNode_, theApplication().frameTime());
+			else
+				rootNode_->update(theApplication().frameTime());
+		}
+
+		SpatialGrid &spatialGrid = RenderResources::spatialGrid();
+		if (settings.spatialIndexEnabled)
+			spatialGrid.setCellSize(settings.spatialIndexCellSize);
+		else if (spatialGrid.isEmpty() == false)
+			spatialGrid.clear();
+
 		// AABBs should update after nodes have been transformed
 		updateCulling(rootNode_);
+		// The index is queried after the culling update has moved the nodes with a changed AABB
+		if (settings.cullingEnabled && settings.spatialIndexEnabled)
+			spatialGrid.markOverlapping(cullingRect_, theApplication().numFrames());
 	}
 
 	stateBits_.set(StateBitPositions::UpdatedBit);
@@ -375,7 +393,12 @@ void Viewport::visit()
 	{
 		ZoneScoped;
 		unsigned int visitOrderIndex = 0;
-		rootNode_->visit(*renderQueue_, visitOrderIndex);
+		if (theApplication().renderingSettings().linearTraversalEnabled)
+			sceneTraversal_->visit(rootNode_, *renderQueue_, visitOrderIndex);
+		else
+			rootNode_->visit(*renderQueue_, visitOrderIndex);
+		// Render commands of nodes deferred by the visit are recorded before sorting
+		renderQueue_->flushDeferredNodes();
 	}
 
 	stateBits_.set(StateBitPositions::VisitedBit);
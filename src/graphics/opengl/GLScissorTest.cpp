@@ -54,14 +54,13 @@ void GLScissorTest::disable()
 	}
 }
 
+/*! \note The rectangle of a disabled state is not applied, the cached one keeps matching the OpenGL scissor box. */
 void GLScissorTest::setState(State newState)
 {
 	if (newState.enabled)
 		enable(newState.rect);
 	else
 		disable();
-
-	state_ = newState;
 }
 
 }
@@ -271,7 +271,7 @@ bool GLShaderProgram::link(Introspection introspection)
 	}
 }
 
-void GLShaderProgram::use()
+bool GLShaderProgram::use()
 {
 	if (boundProgram_ != glHandle_)
 	{
@@ -279,7 +279,9 @@ void GLShaderProgram::use()
 
 		glUseProgram(glHandle_);
 		boundProgram_ = glHandle_;
+		return true;
 	}
+	return false;
 }
 
 bool GLShaderProgram::validate()
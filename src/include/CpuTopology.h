@@ -14,15 +14,41 @@ class CpuTopology
 		unsigned int id = 0;
 		bool isLogical = false;
 		unsigned int tier = 0;
+		/// The CPUs with the same id are hardware threads of the same physical core
+		unsigned int coreId = 0;
+		/// The CPUs with the same id share the second level cache
+		unsigned int l2CacheId = 0;
+		/// The CPUs with the same id share the last level cache
+		unsigned int l3CacheId = 0;
+	};
+
+	/// How close two CPUs are, from the ones that share the most resources to the ones that share the least
+	struct Distance
+	{
+		enum Enum
+		{
+			SAME_CORE = 0,
+			SAME_L2_CACHE,
+			SAME_L3_CACHE,
+			SAME_TIER,
+			DIFFERENT_TIER,
+
+			COUNT
+		};
 	};
 
 	CpuTopology();
 
 	inline unsigned int numTotalCores() const { return numTotalCores_; }
 	inline unsigned int numPhysicalCores() const { return numPhysicalCores_; }
+	/// Returns the number of physical cores of the specified performance tier
+	unsigned int numPhysicalCores(unsigned int tier) const;
 	inline unsigned int numTiers() const { return numTiers_; }
 	const CpuInfo &cpuInfo(unsigned int idx) const;
 
+	/// Returns how close two CPUs are in terms of shared caches and core type
+	static Distance::Enum distance(const CpuInfo &a, const CpuInfo &b);
+
   private:
 	unsigned int numTotalCores_;
 	unsigned int numPhysicalCores_;
@@ -0,0 +1,69 @@
+#ifndef CLASS_NCINE_FRAMEARENA
+#define CLASS_NCINE_FRAMEARENA
+
+#include <nctl/UniquePtr.h>
+#ifdef WITH_ALLOCATORS
+	#include <nctl/LinearAllocator.h>
+#endif
+
+namespace ncine {
+
+/// A linear arena for the transient rendering allocations that only live until the end of a frame
+/*! Allocations are never freed one by one, the whole arena is cleared once per frame by the application.
+ *  When the arena is full an allocation fails and the caller falls back to its own memory. */
+class FrameArena
+{
+  public:
+	/// The alignment of allocations when none is specified
+	static const unsigned int DefaultAlignment = 16;
+
+	explicit FrameArena(unsigned long size);
+	~FrameArena();
+
+	/// Returns the size of the arena in bytes
+	inline unsigned long size() const { return size_; }
+	/// Returns the number of bytes allocated since the last reset, including alignment padding
+	unsigned long usedBytes() const;
+	/// Returns the highest number of bytes allocated in a single frame
+	inline unsigned long peakBytes() const { return peakBytes_; }
+	/// Returns the number of successful allocations since the last reset
+	inline unsigned int numAllocations() const { return numAllocations_; }
+	/// Returns the number of allocations that failed since the last reset because the arena was full
+	inline unsigned int numFailedAllocations() const { return numFailedAllocations_; }
+
+	/// Allocates memory that stays valid until the next reset, or returns `nullptr` if there is not enough space
+	void *allocate(unsigned long bytes, unsigned int alignment = DefaultAlignment);
+	/// Allocates an uninitialized array that stays valid until the next reset, or returns `nullptr`
+	/*! \note No constructor or destructor is ever called, the type should be trivial. */
+	template <class T>
+	inline T *allocateArray(unsigned int numElements)
+	{
+		return static_cast<T *>(allocate(numElements * sizeof(T), alignof(T)));
+	}
+
+	/// Frees all the allocations at once and gathers the statistics of the frame
+	void reset();
+
+  private:
+	unsigned long size_;
+	nctl::UniquePtr<unsigned char[]> buffer_;
+#ifdef WITH_ALLOCATORS
+	nctl::LinearAllocator allocator_;
+#else
+	/// The offset of the first free byte in the buffer
+	unsigned long offset_;
+#endif
+
+	unsigned long peakBytes_;
+	unsigned int numAllocations_;
+	unsigned int numFailedAllocations_;
+
+	/// Deleted copy constructor
+	FrameArena(const FrameArena &) = delete;
+	/// Deleted assignment operator
+	FrameArena &operator=(const FrameArena &) = delete;
+};
+
+}
+
+#endif
@@ -79,7 +79,8 @@ class GLShaderProgram
 	bool attachShaderFromStringsAndFile(GLenum type, const char **strings, const char *filename);
 
 	bool link(Introspection introspection);
-	void use();
+	/// Makes the program current, returns true if it was not current already
+	bool use();
 	bool validate();
 
 	inline unsigned int numAttributes() const { return attributeLocations_.size(); }
@@ -29,7 +29,8 @@ class GLShaderUniformBlocks
 	inline bool hasUniformBlock(const char *name) const { return (uniformBlockCaches_.find(name) != nullptr); }
 	const GLUniformBlockCache *uniformBlock(const char *name) const;
 	GLUniformBlockCache *uniformBlock(const char *name);
-	inline const UniformHashMapType allUniformBlocks() const { return uniformBlockCaches_; }
+	inline const UniformHashMapType &allUniformBlocks() const { return uniformBlockCaches_; }
+	inline UniformHashMapType &allUniformBlocks() { return uniformBlockCaches_; }
 	void commitUniformBlocks();
 
 	void bind();
@@ -28,7 +28,8 @@ class GLShaderUniforms
 	inline bool hasUniform(const char *name) const { return (uniformCaches_.find(name) != nullptr); }
 	const GLUniformCache *uniform(const char *name) const;
 	GLUniformCache *uniform(const char *name);
-	inline const UniformHashMapType allUniforms() const { return uniformCaches_; }
+	inline const UniformHashMapType &allUniforms() const { return uniformCaches_; }
+	inline UniformHashMapType &allUniforms() { return uniformCaches_; }
 	void commitUniforms();
 
   private:
@@ -50,6 +50,8 @@ class Geometry
 	inline const float *hostVertexPointer() const { return hostVertexPointer_; }
 	/// Sets a pointer into host memory containing vertex data to be copied into a VBO
 	void setHostVertexPointer(const float *vertexPointer);
+	/// Sets a pointer into host memory containing the specified number of floats to be copied into a VBO
+	void setHostVertexPointer(const float *vertexPointer, unsigned int numFloats);
 
 	/// Shares the VBO of another `Geometry` object
 	void shareVbo(const Geometry *geometry);
@@ -85,6 +87,8 @@ class Geometry
 	GLushort firstIndex_;
 	unsigned int numIndices_;
 	const float *hostVertexPointer_;
+	/// The number of floats to copy from host memory, or zero to derive it from the number of vertices
+	unsigned int numHostVertexFloats_;
 	const GLushort *hostIndexPointer_;
 
 	nctl::UniquePtr<GLBufferObject> vbo_;
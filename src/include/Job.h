@@ -1,6 +1,7 @@
 #ifndef CLASS_NCINE_JOB
 #define CLASS_NCINE_JOB
 
+#include <cstring> // for memcpy()
 #include <nctl/Atomic.h>
 #include "IJobSystem.h"
 #include "jobsystem_debug.h"
@@ -45,12 +46,30 @@ struct alignas(64) Job
 		CANCELLED = 1u << 31
 	};
 
+	/// Where the data passed to the job function is stored
+	enum DataLocation : uint8_t
+	{
+		/// In the `data` array of the job
+		INLINE = 0,
+		/// In a block of the job data arena of the creating thread, pointed to by the `data` array
+		ARENA,
+		/// In a heap allocation, pointed to by the `data` array
+		HEAP
+	};
+
 	JobFunction function = nullptr;
 	JobId parent = InvalidJobId;
 	nctl::AtomicU32 countersAndState;
 	char data[JobDataSize];
 	JobId continuations[JobNumContinuations];
 	uint16_t generation = 0;
+	/// The `JobPriority::Enum` value of the job
+	uint8_t priority = JobPriority::NORMAL;
+	/// The `DataLocation` value of the job data
+	uint8_t dataLocation = INLINE;
+
+	/// Returns the pointer to the data that is passed to the job function
+	inline const void *functionData() const;
 
 	/// Atomically loads the counter variable and unpacks the unfinished jobs part
 	inline uint16_t loadUnfinishedJobs(nctl::MemoryModel memoryModel);
@@ -124,6 +143,16 @@ uint32_t Job::clearFlag(Flags flags)
 	return (countersAndState.fetchAnd(~flags, nctl::MemoryModel::RELEASE) & FLAGS_MASK);
 }
 
+const void *Job::functionData() const
+{
+	if (dataLocation == INLINE)
+		return data;
+
+	const void *externalData = nullptr;
+	memcpy(&externalData, data, sizeof(externalData));
+	return externalData;
+}
+
 static_assert(JobNumContinuations < (1u << Job::CONTINUATION_BITS), "JobNumContinuations doesn't fit in continuation bits");
 static_assert(sizeof(Job) % 64 == 0, "Job structure size should be a multiple of a cache line");
 static_assert(sizeof(Job) == 64, "Job structure size should be exactly one cache line");
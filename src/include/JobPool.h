@@ -3,11 +3,15 @@
 
 #include <nctl/Array.h>
 #include <nctl/StaticArray.h>
+#include <nctl/UniquePtr.h>
+#include <nctl/Atomic.h>
 #include "Job.h"
 #include "ThreadSync.h"
 
 namespace ncine {
 
+/// The pool of `Job` structures, made of blocks that are added when it is exhausted
+/*! Blocks are never moved or freed until destruction, so that a `JobId` stays valid while the pool grows. */
 class JobPool
 {
   public:
@@ -19,21 +23,33 @@ class JobPool
 	/// Allocates a job from the pool, returns `InvalidJobId` if none available
 	inline JobId allocateJob() { return allocateJob(nullptr); }
 
-	/// Frees a job back to the pool
+	/// Frees a job back to the pool, together with its data if it is not stored in the job itself
 	void freeJob(JobId jobId);
 
+	/// Copies the data of a job in the job itself, or in the job data arena of the calling thread if it does not fit
+	void copyJobData(Job *job, const void *data, unsigned int dataSize);
+
 	/// Accesses the `Job` structure pointer from `JobId`
 	Job *retrieveJob(JobId jobId);
 
+	/// Returns the number of blocks currently allocated
+	inline unsigned int numBlocks() const { return static_cast<unsigned int>(numBlocks_.load(nctl::MemoryModel::ACQUIRE)); }
+	/// Returns the number of jobs that can be allocated without adding a new block
+	inline unsigned int capacity() const { return numBlocks() * JobPoolBlockSize; }
+
   private:
 	/// The number of elements in the per-thread cache of free pool indices
 	static const int ThreadCacheSize = 64;
+	/// The number of blocks of `JobArenaDataSize` bytes in the job data arena of every thread
+	static const unsigned int NumArenaBlocks = 128;
 
 	// The per-thread cache of free pool indices
 	struct ThreadCache
 	{
 		uint16_t indices[ThreadCacheSize];
 		int top = 0;
+		/// The arena block from which the search for a free one starts
+		unsigned int nextArenaBlock = 0;
 	};
 
 	unsigned char numThreads_;
@@ -44,14 +60,30 @@ class JobPool
 	/// Per-thread caches of free pool indices
 	nctl::Array<ThreadCache> threadCaches_;
 
-	/// The contiguous pool of `Job` structures
-	Job jobPool_[MaxNumJobs];
+	/// The blocks of contiguous `Job` structures
+	nctl::UniquePtr<Job[]> blocks_[MaxNumJobPoolBlocks];
+	/// The number of allocated blocks, written before any index of a new block is handed out
+	nctl::Atomic32 numBlocks_;
 
-	/// The mutex protecting access to the global free list
+	/// The mutex protecting access to the global free list and to the blocks
 	Mutex mutex_;
 
+	/// The job data arenas of all the threads, one after the other
+	nctl::UniquePtr<unsigned char[]> arenaBlocks_;
+	/// A non-zero value for every arena block in use, only set by the thread owning the arena
+	nctl::UniquePtr<nctl::Atomic32[]> arenaBlocksInUse_;
+
 	/// Initializes the pool with as many caches as the specified number of threads
 	void initialize(unsigned char numThreads);
+	/// Allocates a new block and adds its indices to the free list, returns `false` if the maximum number of blocks is reached
+	bool addBlock();
+	/// Returns a free block of the job data arena of the specified thread, or `nullptr` if the arena is full
+	unsigned char *allocateArenaBlock(unsigned char threadIndex);
+	/// Frees the data of a job that is not stored in the job itself
+	void freeJobData(Job &job);
+
+	/// Accesses the `Job` structure from its pool index
+	inline Job &jobAt(uint16_t index) { return blocks_[index / JobPoolBlockSize][index % JobPoolBlockSize]; }
 
 	/// Deleted copy constructor
 	JobPool(const JobPool &) = delete;
@@ -59,6 +91,7 @@ class JobPool
 	JobPool &operator=(const JobPool &) = delete;
 
 	friend class JobSystem;
+	friend class SerialJobSystem;
 };
 
 }
@@ -2,15 +2,23 @@
 #define CLASS_NCINE_JOBQUEUE
 
 #include <nctl/Atomic.h>
+#include <nctl/UniquePtr.h>
 #include "IJobSystem.h"
 #include "jobsystem_debug.h"
 
 namespace ncine {
 
 /// The lock-free work stealing job queue
+/*! The circular array doubles its capacity when it is full, up to the maximum number of jobs.
+ *  The previous arrays are kept until destruction, as a concurrent steal might still be reading from one of them. */
 class JobQueue
 {
   public:
+	/// The capacity of the first circular array
+	static const unsigned int InitialCapacity = JobPoolBlockSize;
+	/// The maximum number of circular arrays, the last one can hold all the jobs of the pool
+	static const unsigned int MaxNumArrays = 4;
+
 	JobQueue();
 
 	void push(JobId jobId);
@@ -25,7 +33,15 @@ class JobQueue
 	alignas(64) nctl::Atomic32 bottom_;
 	char pad1[64 - sizeof(nctl::Atomic32)];
 
-	JobId jobs_[MaxNumJobs];
+	/// The circular arrays, each one with double the capacity of the previous one
+	nctl::UniquePtr<JobId[]> arrays_[MaxNumArrays];
+	/// The index of the circular array in use, only changed by the thread that owns the queue
+	nctl::Atomic32 arrayIndex_;
+
+	/// Returns the capacity of the circular array with the specified index
+	static inline unsigned int arrayCapacity(int32_t index) { return InitialCapacity << index; }
+	/// Moves the jobs between the specified top and bottom to a new array with double the capacity
+	bool grow(int32_t top, int32_t bottom);
 
 #if JOB_DEBUG_STATE
 	void setJobPool(JobPool *jobPool);
@@ -20,12 +20,15 @@ class JobSystem : public IJobSystem
 	JobSystem();
 	/// Creates a job system with the specified number of threads for its pool
 	explicit JobSystem(unsigned char numThreads);
+	/// Creates a job system with the specified number of threads, optionally keeping them on the performance cores
+	JobSystem(unsigned char numThreads, bool performanceCoresOnly);
 	~JobSystem() override;
 
-	JobId createJob(JobFunction function, const void *data, unsigned int dataSize) override;
+	JobId createJob(JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority) override;
 	JobId createJobAsChild(JobId parentId, JobFunction function, const void *data, unsigned int dataSize) override;
 
 	bool addContinuation(JobId ancestorId, JobId continuationId) override;
+	bool setPriority(JobId jobId, JobPriority::Enum priority) override;
 
 	bool submit(JobId jobId) override;
 	uint16_t submit(const JobId *jobIds, uint16_t count) override;
@@ -35,7 +38,17 @@ class JobSystem : public IJobSystem
 	uint16_t unfinishedJobs(JobId jobId) override;
 	uint16_t continuationCount(JobId jobId) override;
 
+	void setIdleBackoff(unsigned int spinCount, unsigned int yieldCount) override;
+
+	JobStealPolicy::Enum stealPolicy() const override;
+	void setStealPolicy(JobStealPolicy::Enum policy) override;
+
   private:
+	/// The default number of times an idle worker spins looking for a job before starting to yield
+	static const unsigned int DefaultIdleSpinCount = 256;
+	/// The default number of times an idle worker yields looking for a job before going to sleep
+	static const unsigned int DefaultIdleYieldCount = 16;
+
 #if HAVE_USER_SEMAPHORE
 	using SemType = UserSemaphore;
 #else
@@ -45,23 +58,37 @@ class JobSystem : public IJobSystem
 	struct CommonThreadDataStruct
 	{
 		CommonThreadDataStruct(JobPool &pool, SemType &sem)
-		    : numThreads(0), jobPool(pool), jobQueues(nullptr), queueSem(sem) {}
+		    : numThreads(0), jobPool(pool), jobQueues(nullptr), queueSem(sem),
+		      idleSpinCount(DefaultIdleSpinCount), idleYieldCount(DefaultIdleYieldCount),
+		      numBackgroundThreads(0), maxBackgroundThreads(1) {}
 
 		unsigned char numThreads;
 		JobPool &jobPool;
 		JobQueue *jobQueues;
 		SemType &queueSem;
+		/// Read by the workers every time they become idle, so that the backoff can be changed while they are running
+		nctl::Atomic32 idleSpinCount;
+		nctl::Atomic32 idleYieldCount;
+		/// The number of threads that are executing a background job
+		nctl::Atomic32 numBackgroundThreads;
+		/// The maximum number of threads that can execute a background job at the same time
+		int32_t maxBackgroundThreads;
 	};
 
 	struct ThreadStruct
 	{
-		explicit ThreadStruct(const CommonThreadDataStruct &commonThreadData)
-		    : threadIndex(0), cpuId(0), shouldQuit(false), commonData(commonThreadData) {}
+		explicit ThreadStruct(CommonThreadDataStruct &commonThreadData)
+		    : threadIndex(0), cpuId(0), shouldQuit(false), anyPerformanceCore(false), commonData(commonThreadData) {}
 
 		unsigned char threadIndex;
 		unsigned char cpuId;
 		unsigned char shouldQuit;
-		const CommonThreadDataStruct &commonData;
+		/// True if the thread is not pinned to a single CPU but can run on any performance core
+		bool anyPerformanceCore;
+#ifndef __EMSCRIPTEN__
+		ThreadAffinityMask affinityMask;
+#endif
+		CommonThreadDataStruct &commonData;
 	};
 
 	JobPool jobPool_;
@@ -71,7 +98,21 @@ class JobSystem : public IJobSystem
 	SemType queueSem_;
 	CommonThreadDataStruct commonData_;
 	CpuTopology cpuTopology_;
+	/// For every thread, the indices of the other threads sorted by their distance in the CPU topology
+	nctl::Array<unsigned char> stealOrders_;
+
+	/// Creates an id for a new job, with the priority of its parent if it has one
+	JobId createJobWithPriority(JobId parentId, JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority);
+
+	/// Sorts the other threads for every thread, from the ones that share the most caches to the ones that share the least
+	void initStealOrders(bool performanceCoresOnly);
 
+	/// Returns a job from the queues of the highest priority that is not empty
+	static JobId getJob(CommonThreadDataStruct &commonData, bool withBackgroundJobs);
+	/// Lets another thread execute a background job, after the calling thread has finished the one it was allowed to execute
+	static void backgroundJobFinished(CommonThreadDataStruct &commonData);
+	/// Waits on the queue semaphore after spinning and yielding for the configured number of times
+	static void waitForJobs(const CommonThreadDataStruct &commonData);
 	static void workerFunction(void *arg);
 
 	/// Deleted copy constructor
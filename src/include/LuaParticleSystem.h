@@ -38,6 +38,8 @@ class LuaParticleSystem
 	static int setParticlesUpdateEnabled(lua_State *L);
 	static int areAffectorsEnabled(lua_State *L);
 	static int setAffectorsEnabled(lua_State *L);
+	static int isParallelUpdateEnabled(lua_State *L);
+	static int setParallelUpdateEnabled(lua_State *L);
 
 	static int numParticles(lua_State *L);
 	static int numAliveParticles(lua_State *L);
@@ -63,6 +63,34 @@ class Material
 		CUSTOM
 	};
 
+	/// The uniforms set by the engine, resolved once every time the shader program changes
+	struct BuiltinUniforms
+	{
+		enum Enum
+		{
+			/// The texture sampler uniform, outside of any block
+			TEXTURE = 0,
+			/// The legacy `mat4` model matrix, in the instance block if there is one
+			MODEL_MATRIX,
+			/// The model transform, in the instance block if there is one
+			MODEL_TRANSFORM,
+			/// The model translation, in the instance block if there is one
+			MODEL_TRANSLATION,
+			/// The color, in the instance block if there is one
+			COLOR,
+			/// The sprite size, in the instance block if there is one
+			SPRITE_SIZE,
+			/// The legacy `vec4` texture rectangle, in the instance block if there is one
+			TEX_RECT,
+			/// The packed horizontal texture endpoints, in the instance block if there is one
+			UV_ENDPOINTS_U,
+			/// The packed vertical texture endpoints, in the instance block if there is one
+			UV_ENDPOINTS_V,
+
+			COUNT
+		};
+	};
+
 	// Shader uniform block and model matrix uniform names
 	static const char *InstanceBlockName;
 	static const char *InstancesBlockName; // for batched shaders
@@ -122,10 +150,23 @@ class Material
 	/// Wrapper around `GLShaderUniformBlocks::uniformBlock()`
 	inline GLUniformBlockCache *uniformBlock(const char *name) { return shaderUniformBlocks_.uniformBlock(name); }
 
+	/// Returns the instance uniform block cache resolved when the shader program was set, or `nullptr`
+	inline const GLUniformBlockCache *instanceBlock() const { return instanceBlock_; }
+	/// Returns the instance uniform block cache resolved when the shader program was set, or `nullptr`
+	inline GLUniformBlockCache *instanceBlock() { return instanceBlock_; }
+	/// Returns the cache of a built-in uniform resolved when the shader program was set, or `nullptr`
+	inline const GLUniformCache *builtinUniform(BuiltinUniforms::Enum uniform) const { return builtinUniforms_[uniform]; }
+	/// Returns the cache of a built-in uniform resolved when the shader program was set, or `nullptr`
+	inline GLUniformCache *builtinUniform(BuiltinUniforms::Enum uniform) { return builtinUniforms_[uniform]; }
+
+	/// Wrapper around `GLShaderUniforms::allUniforms()` (constant version)
+	inline const GLShaderUniforms::UniformHashMapType &allUniforms() const { return shaderUniforms_.allUniforms(); }
 	/// Wrapper around `GLShaderUniforms::allUniforms()`
-	inline const GLShaderUniforms::UniformHashMapType allUniforms() const { return shaderUniforms_.allUniforms(); }
+	inline GLShaderUniforms::UniformHashMapType &allUniforms() { return shaderUniforms_.allUniforms(); }
+	/// Wrapper around `GLShaderUniformBlocks::allUniformBlocks()` (constant version)
+	inline const GLShaderUniformBlocks::UniformHashMapType &allUniformBlocks() const { return shaderUniformBlocks_.allUniformBlocks(); }
 	/// Wrapper around `GLShaderUniformBlocks::allUniformBlocks()`
-	inline const GLShaderUniformBlocks::UniformHashMapType allUniformBlocks() const { return shaderUniformBlocks_.allUniformBlocks(); }
+	inline GLShaderUniformBlocks::UniformHashMapType &allUniformBlocks() { return shaderUniformBlocks_.allUniformBlocks(); }
 
 	const GLTexture *texture(unsigned int unit) const;
 	bool setTexture(unsigned int unit, const GLTexture *texture);
@@ -146,12 +187,19 @@ class Material
 	GLShaderUniformBlocks shaderUniformBlocks_;
 	const GLTexture *textures_[GLTexture::MaxTextureUnits];
 
+	/// The instance uniform block cache, resolved by name only when the shader program changes
+	GLUniformBlockCache *instanceBlock_;
+	/// The caches of the built-in uniforms, resolved by name only when the shader program changes
+	GLUniformCache *builtinUniforms_[BuiltinUniforms::COUNT];
+
 	/// The size of the memory buffer containing uniform values
 	unsigned int uniformsHostBufferSize_;
 	/// Memory buffer with uniform values to be sent to the GPU
 	nctl::UniquePtr<GLubyte[]> uniformsHostBuffer_;
 
 	void bind();
+	/// Looks up the instance block and the built-in uniforms of the current shader program by name
+	void resolveBuiltinUniforms();
 	/// Wrapper around `GLShaderUniforms::commitUniforms()`
 	inline void commitUniforms() { shaderUniforms_.commitUniforms(); }
 	/// Wrapper around `GLShaderUniformBlocks::commitUniformBlocks()`
@@ -0,0 +1,62 @@
+#ifndef CLASS_NCINE_PARTICLEINSTANCES
+#define CLASS_NCINE_PARTICLEINSTANCES
+
+#include "BaseSprite.h"
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class ParticleSystem;
+
+/// The drawable node that renders all particles of a structure of arrays with a single instanced command
+/*!
+ * It is created as a child of a `ParticleSystem` in arrays storage mode and it reads particle properties from it.
+ * \note Gray textures are rendered with the RGB sprite shader, as there is no gray variant with per-instance attributes.
+ */
+class ParticleInstances : public BaseSprite
+{
+  public:
+	/// Constructs the node for the specified maximum amount of particles
+	ParticleInstances(ParticleSystem *parent, unsigned int capacity, Texture *texture, const Recti &texRect);
+
+	/// Sets the bounds of particle positions in the particle system space and the maximum particle scale factor
+	void setParticlesBounds(const Vector2f &minPosition, const Vector2f &maxPosition, float maxScale);
+
+	bool draw(RenderQueue &renderQueue) override;
+
+  protected:
+	void shaderHasChanged() override;
+	void textureHasChanged(Texture *newTexture) override;
+	void updateRenderCommand() override;
+	void updateAabb() override;
+
+  private:
+	/// The maximum amount of particle instances
+	unsigned int capacity_;
+	/// The host copy of the instance data, uploaded to the custom VBO
+	nctl::UniquePtr<float[]> instanceData_;
+
+	/// Minimum particle position in the particle system space
+	Vector2f minPosition_;
+	/// Maximum particle position in the particle system space
+	Vector2f maxPosition_;
+	/// Maximum particle scale factor
+	float maxScale_;
+
+	/// Packed horizontal texture coordinates shared by every instance
+	uint32_t uvEndpointsU_;
+	/// Packed vertical texture coordinates shared by every instance
+	uint32_t uvEndpointsV_;
+
+	/// Returns the number of floats in the instance structure of the current shader
+	unsigned int numFloatsPerInstance() const;
+
+	/// Deleted copy constructor
+	ParticleInstances(const ParticleInstances &) = delete;
+	/// Deleted assignment operator
+	ParticleInstances &operator=(const ParticleInstances &) = delete;
+};
+
+}
+
+#endif
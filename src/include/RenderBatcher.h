@@ -3,10 +3,13 @@
 
 #include <nctl/Array.h>
 #include <nctl/UniquePtr.h>
+#include "GLShaderUniforms.h"
+#include "GLShaderUniformBlocks.h"
 
 namespace ncine {
 
 class RenderCommand;
+class GLShaderProgram;
 
 /// A class that batches render commands together
 class RenderBatcher
@@ -18,9 +21,55 @@ class RenderBatcher
 	void createBatches(const nctl::Array<RenderCommand *> &srcQueue, nctl::Array<RenderCommand *> &destQueue);
 	void reset();
 
+	/// Removes the cached uniform blocks layouts that refer to the specified shader program
+	void removeUniformBlocksLayouts(const GLShaderProgram *shaderProgram);
+
   private:
 	static unsigned int UboMaxSize;
 
+	/// The maximum number of sampler uniforms copied from the first command of a batch
+	static const unsigned int MaxSamplerUniforms = 8;
+
+	/// A flat description of how the uniforms of a shader map to the ones of its batched version
+	/*! \note Blocks and uniforms are identified by their position when iterating the hashmaps of a material,
+	 *  which only depends on the shader program, so that assembling a batch requires no string hashing. */
+	struct UniformBlocksLayout
+	{
+		UniformBlocksLayout()
+		    : shaderProgram(nullptr), batchedShaderProgram(nullptr), numBlocks(0), numBatchBlocks(0),
+		      instanceBlockIndex(-1), instancesBlockIndex(-1), singleInstanceBlockSize(0),
+		      nonInstancesBlocksSize(0), numUniforms(0), numBatchUniforms(0), numSamplers(0) {}
+
+		const GLShaderProgram *shaderProgram;
+		const GLShaderProgram *batchedShaderProgram;
+
+		/// Number of uniform blocks of a material with the original shader
+		unsigned int numBlocks;
+		/// Number of uniform blocks of a material with the batched shader
+		unsigned int numBatchBlocks;
+		/// Position of the single instance block in a material with the original shader
+		int instanceBlockIndex;
+		/// Position of the instances block in a material with the batched shader
+		int instancesBlockIndex;
+		/// For each block of the batched shader, the position of the same block with the original shader or -1
+		int sourceBlockIndices[GLShaderUniformBlocks::UniformBlockCachesHashSize];
+		/// Size of the single instance block, without the offset alignment but with the std140 vec4 alignment
+		int singleInstanceBlockSize;
+		/// Total size of the blocks that are not for instances, without the offset alignment
+		unsigned long nonInstancesBlocksSize;
+
+		/// Number of uniforms of a material with the original shader
+		unsigned int numUniforms;
+		/// Number of uniforms of a material with the batched shader
+		unsigned int numBatchUniforms;
+		/// Number of sampler uniforms to copy
+		unsigned int numSamplers;
+		/// Positions of the sampler uniforms with the original shader
+		unsigned int samplerIndices[MaxSamplerUniforms];
+		/// Positions of the sampler uniforms with the batched shader
+		unsigned int batchSamplerIndices[MaxSamplerUniforms];
+	};
+
 	struct ManagedBuffer
 	{
 		ManagedBuffer()
@@ -31,13 +80,22 @@ class RenderBatcher
 		nctl::UniquePtr<unsigned char[]> buffer;
 	};
 
-	/// Memory buffers to collect UBO data before committing it
+	/// Memory buffers to collect UBO data before committing it, when the frame arena is full
 	/*! \note It is a RAM buffer and cannot be handled by the `RenderBuffersManager` */
 	nctl::Array<ManagedBuffer> buffers_;
 
+	/// Uniform blocks layouts for every shader batched with uniforms, created on first use
+	nctl::Array<UniformBlocksLayout> uniformBlocksLayouts_;
+
+	/// Returns the uniform blocks layout for the reference command and the batch command, creating it if needed
+	const UniformBlocksLayout &uniformBlocksLayout(const RenderCommand &refCommand, const RenderCommand &batchCommand);
+
 	RenderCommand *collectCommandsWithUniforms(nctl::Array<RenderCommand *>::ConstIterator start, nctl::Array<RenderCommand *>::ConstIterator end, nctl::Array<RenderCommand *>::ConstIterator &nextStart);
 	RenderCommand *collectCommandsWithInstancing(nctl::Array<RenderCommand *>::ConstIterator start, nctl::Array<RenderCommand *>::ConstIterator end, nctl::Array<RenderCommand *>::ConstIterator &nextStart);
 
+	/// Copies the values of the sampler uniforms from the reference command to the batch command
+	void copySamplerUniforms(const UniformBlocksLayout &layout, const RenderCommand &refCommand, RenderCommand &batchCommand, bool commandAdded);
+
 	unsigned char *acquireMemory(unsigned int bytes);
 	void createBuffer(unsigned int size);
 };
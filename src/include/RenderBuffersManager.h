@@ -2,6 +2,7 @@
 #define CLASS_NCINE_RENDERBUFFERSMANAGER
 
 #include "GLBufferObject.h"
+#include "BufferRing.h"
 #include <nctl/Array.h>
 #include <nctl/UniquePtr.h>
 
@@ -46,6 +47,10 @@ class RenderBuffersManager
 
 	RenderBuffersManager(bool useBufferMapping, unsigned long vboMaxSize, unsigned long iboMaxSize);
 
+	/// Returns the ring of regions of the persistently mapped buffers, or `nullptr` if buffers are mapped every frame
+	/*! \note Buffers are persistently mapped only when buffer mapping is enabled and buffer storage is supported */
+	inline const BufferRing *ring() const { return ring_.get(); }
+
 	/// Returns the specifications for a buffer of the specified type
 	inline const BufferSpecifications &specs(BufferTypes::Enum type) const { return specs_[type]; }
 	/// Requests an amount of bytes from the specified buffer type
@@ -56,6 +61,11 @@ class RenderBuffersManager
   private:
 	BufferSpecifications specs_[BufferTypes::COUNT];
 
+	/// The OpenGL fences used by the ring of regions
+	nctl::UniquePtr<BufferRing::Backend> ringBackend_;
+	/// The ring of regions of persistently mapped buffers, a buffer is as large as all the regions together
+	nctl::UniquePtr<BufferRing> ring_;
+
 	struct ManagedBuffer
 	{
 		ManagedBuffer()
@@ -71,6 +81,9 @@ class RenderBuffersManager
 
 	nctl::Array<ManagedBuffer> buffers_;
 
+	/// Reserves an amount of bytes from the specified buffer, returns false if there is not enough free space
+	bool acquireFromBuffer(ManagedBuffer &buffer, unsigned long bytes, unsigned int alignment, Parameters &params);
+
 	void flushUnmap();
 	void remap();
 	void createBuffer(const BufferSpecifications &specs);
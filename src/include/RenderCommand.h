@@ -2,7 +2,9 @@
 #define CLASS_NCINE_RENDERCOMMAND
 
 #include "Rect.h"
+#include <ncine/config.h>
 #include "Matrix4x4.h"
+#include "AffineTransform2D.h"
 #include "Material.h"
 #include "Geometry.h"
 
@@ -69,6 +71,17 @@ class RenderCommand
 	/// Sets the id based secondary sort key for the queue
 	inline void setIdSortKey(unsigned int idSortKey) { idSortKey_ = idSortKey; }
 
+	/// Returns the identifier of the last queue sort that included this command
+	inline uint32_t sortGeneration() const { return sortGeneration_; }
+	/// Returns the position of this command in the queue after its last sort
+	inline uint32_t sortedIndex() const { return sortedIndex_; }
+	/// Sets the identifier of the queue sort and the position of this command after it
+	inline void setSortedPosition(uint32_t sortGeneration, uint32_t sortedIndex)
+	{
+		sortGeneration_ = sortGeneration;
+		sortedIndex_ = sortedIndex;
+	}
+
 	/// Issues the render command
 	void issue();
 
@@ -80,8 +93,17 @@ class RenderCommand
 	inline void setScissor(Recti scissorRect) { scissorRect_ = scissorRect; }
 	void setScissor(GLint x, GLint y, GLsizei width, GLsizei height);
 
+#if NCINE_WITH_COMPACT_TRANSFORMS
+	inline const AffineTransform2Df &transformation() const { return modelMatrix_; }
+	void setTransformation(const AffineTransform2Df &modelMatrix);
+	/// Returns the Z-depth calculated by the last model matrix commit
+	inline float depth() const { return depth_; }
+#else
 	inline const Matrix4x4f &transformation() const { return modelMatrix_; }
 	void setTransformation(const Matrix4x4f &modelMatrix);
+	/// Returns the Z-depth calculated by the last model matrix commit
+	inline float depth() const { return modelMatrix_[3][2]; }
+#endif
 	inline const Material &material() const { return material_; }
 	inline const Geometry &geometry() const { return geometry_; }
 	inline Material &material() { return material_; }
@@ -107,6 +129,10 @@ class RenderCommand
 	uint64_t materialSortKey_;
 	/// The id based secondary sort key stabilizes render commands sorting
 	uint32_t idSortKey_;
+	/// The identifier of the last queue sort that included this command, used by incremental sorting
+	uint32_t sortGeneration_;
+	/// The position of this command in the queue after its last sort, used by incremental sorting
+	uint32_t sortedIndex_;
 	/// The drawing layer for this command
 	uint16_t layer_;
 	/// The visit order index for this command
@@ -121,7 +147,14 @@ class RenderCommand
 
 	Recti scissorRect_;
 
+#if NCINE_WITH_COMPACT_TRANSFORMS
+	/// The 2D affine part of the model matrix, expanded to four by four only when committed as a whole
+	AffineTransform2Df modelMatrix_;
+	/// The Z-depth of the model matrix
+	float depth_;
+#else
 	Matrix4x4f modelMatrix_;
+#endif
 	Material material_;
 	Geometry geometry_;
 
@@ -10,6 +10,8 @@ namespace ncine {
 class RenderCommand;
 
 /// The class that creates and handles the pool of render commands
+/*! \note The commands are not allocated from the frame arena, as they own the uniform caches of their material and are
+ *  reused across frames by shader program, so that the uniforms of a batch shader are not resolved again every frame. */
 class RenderCommandPool
 {
   public:
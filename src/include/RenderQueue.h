@@ -2,10 +2,42 @@
 #define CLASS_NCINE_RENDERQUEUE
 
 #include "RenderCommand.h"
+#include "Rect.h"
 #include <nctl/Array.h>
+#include <nctl/Atomic.h>
+#include <nctl/algorithms.h>
 
 namespace ncine {
 
+class DrawableNode;
+class Viewport;
+
+/// The sorted render commands of a frozen scene node subtree, recorded once and replayed until the subtree changes
+struct FrozenCommands
+{
+	FrozenCommands()
+	    : isValid(0), firstVisitOrder(0), numVisitOrders(0),
+	      viewport(nullptr), cullingEnabled(false), cullingRect(0.0f, 0.0f, 0.0f, 0.0f) {}
+
+	/// Array of opaque render command pointers, in the order of the opaque queue
+	nctl::Array<RenderCommand *> opaqueCommands;
+	/// Array of transparent render command pointers, in the order of the transparent queue
+	nctl::Array<RenderCommand *> transparentCommands;
+
+	/// Zero if the commands have to be recorded again, it is atomic as the update of parallel subtrees can invalidate it
+	nctl::Atomic32 isValid;
+	/// The visit order index when the subtree was recorded
+	unsigned int firstVisitOrder;
+	/// The number of visit order indices assigned to the nodes of the subtree
+	unsigned int numVisitOrders;
+	/// The viewport that visited the subtree when it was recorded
+	const Viewport *viewport;
+	/// True if culling was enabled when the subtree was recorded
+	bool cullingEnabled;
+	/// The culling rectangle of the viewport when the subtree was recorded
+	Rectf cullingRect;
+};
+
 /// A class that sorts and issues the render commands collected by the scenegraph visit
 class RenderQueue
 {
@@ -18,6 +50,19 @@ class RenderQueue
 
 	/// Adds a draw command to the queue
 	void addCommand(RenderCommand *command);
+	/// Adds a drawable node whose render command will be updated and added to the queue by `flushDeferredNodes()`
+	void addDeferredNode(DrawableNode *node);
+	/// Updates the render commands of all deferred nodes, in parallel if possible, and adds them to the queue
+	void flushDeferredNodes();
+
+	/// Returns true if the commands added to the queue are being recorded for a frozen subtree
+	inline bool isRecording() const { return isRecording_; }
+	/// Starts recording the commands added to the queue, which should not be deferred until the recording ends
+	void beginRecording();
+	/// Moves the commands added since the recording has started to the frozen commands, sorts and replays them
+	void endRecording(FrozenCommands &frozenCommands);
+	/// Adds the commands of a frozen subtree, which are merged in the sorted queues without being sorted again
+	void addFrozenCommands(const FrozenCommands &frozenCommands);
 
 	/// Sorts the queues, create batches and commits commands
 	void sortAndCommit();
@@ -28,6 +73,30 @@ class RenderQueue
 	void clear();
 
   private:
+#ifdef WITH_JOBSYSTEM
+	/// The render command pointers recorded by a single thread during a parallel visit
+	struct alignas(64) Shard
+	{
+		Shard()
+		    : opaqueQueue(16), transparentQueue(16) {}
+
+		nctl::Array<RenderCommand *> opaqueQueue;
+		nctl::Array<RenderCommand *> transparentQueue;
+	};
+#endif
+
+	/// The state of a queue after its last sort, used to repair its order in the next frame
+	struct SortHistory
+	{
+		SortHistory()
+		    : generation(0), size(0) {}
+
+		/// The identifier of the last sort, zero if the queue has never been sorted incrementally
+		uint32_t generation;
+		/// The number of commands in the queue after the last sort
+		unsigned int size;
+	};
+
 	/// Array of opaque render command pointers
 	nctl::Array<RenderCommand *> opaqueQueue_;
 	/// Array of opaque batched render command pointers
@@ -36,6 +105,51 @@ class RenderQueue
 	nctl::Array<RenderCommand *> transparentQueue_;
 	/// Array of transparent batched render command pointers
 	nctl::Array<RenderCommand *> transparentBatchedQueue_;
+
+	/// Array of drawable nodes whose render commands have yet to be updated
+	nctl::Array<DrawableNode *> deferredNodes_;
+
+	/// Array of the commands of frozen subtrees to merge in the sorted queues
+	nctl::Array<const FrozenCommands *> frozenCommands_;
+	/// True while the commands added to the queue are recorded for a frozen subtree
+	bool isRecording_;
+	/// The size of the opaque queue when the recording has started
+	unsigned int recordingOpaqueStart_;
+	/// The size of the transparent queue when the recording has started
+	unsigned int recordingTransparentStart_;
+
+	/// Array of sorting keys and indices gathered from a queue before radix sorting it, when the frame arena is full
+	nctl::Array<nctl::RadixSortItem> sortItems_;
+	/// Scratch array used by the radix sort passes, when the frame arena is full
+	nctl::Array<nctl::RadixSortItem> tempSortItems_;
+	/// Scratch array of render command pointers used to apply the sorted order to a queue, when the frame arena is full
+	nctl::Array<RenderCommand *> sortedQueue_;
+
+	/// The state of the opaque queue after its last incremental sort
+	SortHistory opaqueSortHistory_;
+	/// The state of the transparent queue after its last incremental sort
+	SortHistory transparentSortHistory_;
+	/// Array of render commands that are new or out of place since the last incremental sort
+	nctl::Array<RenderCommand *> movedCommands_;
+
+	/// Sorts a queue by material and id keys, using a radix sort for large queues
+	void sortQueue(nctl::Array<RenderCommand *> &queue, bool descending);
+	/// Sorts a queue by repairing the order it had after its last sort, only sorting the commands that moved
+	void sortQueueIncremental(nctl::Array<RenderCommand *> &queue, SortHistory &history, bool descending);
+	/// Returns a scratch array of command pointers from the frame arena, or from the member array if the arena is full
+	RenderCommand **acquireCommandsScratch(unsigned int count);
+	/// Merges an array of sorted commands in a sorted queue
+	void mergeSortedCommands(nctl::Array<RenderCommand *> &queue, RenderCommand *const *commands, unsigned int numCommands, bool descending);
+
+#ifdef WITH_JOBSYSTEM
+	/// One array of recorded render commands for each job system thread, merged before sorting
+	nctl::Array<Shard> shards_;
+
+	/// Updates the render commands of a range of deferred nodes and records them in the shard of the calling thread
+	static void recordDeferredNodes(DrawableNode **nodes, unsigned int count, RenderQueue *renderQueue);
+	/// Moves the render commands recorded in every shard to the queues
+	void mergeShards();
+#endif
 };
 
 }
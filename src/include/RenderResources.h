@@ -20,6 +20,8 @@ class RenderBuffersManager;
 class RenderVaoPool;
 class RenderCommandPool;
 class RenderBatcher;
+class SpatialGrid;
+class FrameArena;
 class Hash64;
 class Camera;
 class Viewport;
@@ -56,6 +58,29 @@ class RenderResources
 		GLfloat texcoords[2];
 		int drawindex;
 	};
+
+	/// An instance format structure for sprites with a solid color and no texture, drawn with per-instance attributes
+	struct InstanceFormatSpriteNoTexture
+	{
+		GLfloat transform[4];
+		GLfloat translation[4];
+
+		uint32_t color;
+		uint32_t spriteSize;
+	};
+
+	/// An instance format structure for textured sprites, drawn with per-instance attributes
+	/*! \note Its first members are laid out like the ones of the `InstanceFormatSpriteNoTexture` structure */
+	struct InstanceFormatSprite
+	{
+		GLfloat transform[4];
+		GLfloat translation[4];
+
+		uint32_t color;
+		uint32_t spriteSize;
+		uint32_t uvEndpointsU;
+		uint32_t uvEndpointsV;
+	};
 #endif
 
 	/// A structure used by the `compileShader()` method to load and compile a shader program
@@ -163,6 +188,8 @@ class RenderResources
 #ifdef WITH_SCENEGRAPH
 	static inline RenderCommandPool &renderCommandPool() { return *renderCommandPool_; }
 	static inline RenderBatcher &renderBatcher() { return *renderBatcher_; }
+	static inline SpatialGrid &spatialGrid() { return *spatialGrid_; }
+	static inline FrameArena &frameArena() { return *frameArena_; }
 #endif
 
 	/// The function compiles a shader ex-novo or load it from the binary cache
@@ -192,6 +219,8 @@ class RenderResources
 	static inline const Viewport *currentViewport() { return currentViewport_; }
 
 	static void setDefaultAttributesParameters(GLShaderProgram &shaderProgram);
+	/// Sets the VBO parameters and the divisors of the per-instance attributes of a sprite attributes shader program
+	static void setInstanceAttributesParameters(GLShaderProgram &shaderProgram);
 #endif
 
   private:
@@ -203,6 +232,8 @@ class RenderResources
 #ifdef WITH_SCENEGRAPH
 	static nctl::UniquePtr<RenderCommandPool> renderCommandPool_;
 	static nctl::UniquePtr<RenderBatcher> renderBatcher_;
+	static nctl::UniquePtr<SpatialGrid> spatialGrid_;
+	static nctl::UniquePtr<FrameArena> frameArena_;
 
 	static const unsigned int NumDefaultVertexShaders = static_cast<unsigned int>(DefaultVertexShader::COUNT);
 	static ShaderProgramCompileInfo::ShaderCompileInfo defaultVertexShaderInfos_[NumDefaultVertexShaders];
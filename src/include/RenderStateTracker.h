@@ -0,0 +1,60 @@
+#ifndef CLASS_NCINE_RENDERSTATETRACKER
+#define CLASS_NCINE_RENDERSTATETRACKER
+
+#include "GLScissorTest.h"
+#include "GLTexture.h"
+
+namespace ncine {
+
+class GLShaderProgram;
+
+/// A class that applies the state requested by every render command, only changing what differs from the current one
+/*! The current state is the one cached by the OpenGL wrapper classes, so it is never out of sync with them.
+ *  Every request is counted in the rendering statistics, together with the ones that actually changed the state. */
+class RenderStateTracker
+{
+  public:
+	/// The kinds of state requested by render commands
+	struct StateTypes
+	{
+		enum Enum
+		{
+			SHADER_PROGRAM = 0,
+			TEXTURE,
+			BLENDING,
+			SCISSOR_TEST,
+
+			COUNT
+		};
+	};
+
+	/// Records the scissor test state of a queue, the one requested by the commands without a scissor rectangle
+	static void beginQueue();
+
+	/// Makes the shader program current
+	static void applyShaderProgram(GLShaderProgram &program);
+	/// Binds a texture, or no texture, to each texture unit
+	static void applyTextures(const GLTexture *const textures[GLTexture::MaxTextureUnits]);
+	/// Sets the blending factors
+	static void applyBlendFunc(GLenum srcFactor, GLenum destFactor);
+	/// Enables the scissor test with the specified rectangle, or restores the queue state if it has a zero area
+	static void applyScissor(const Recti &scissorRect);
+
+  private:
+	/// The scissor test state at the beginning of the queue being drawn
+	static GLScissorTest::State queueScissorState_;
+
+	/// Deleted default constructor
+	RenderStateTracker() = delete;
+	/// Deleted destructor
+	~RenderStateTracker() = delete;
+
+	/// Deleted copy constructor
+	RenderStateTracker(const RenderStateTracker &) = delete;
+	/// Deleted assignment operator
+	RenderStateTracker &operator=(const RenderStateTracker &) = delete;
+};
+
+}
+
+#endif
@@ -3,6 +3,9 @@
 
 #include <nctl/String.h>
 #include "RenderCommand.h"
+#ifdef WITH_SCENEGRAPH
+	#include "RenderStateTracker.h"
+#endif
 
 namespace ncine {
 
@@ -73,6 +76,109 @@ class RenderStatistics
 		friend RenderStatistics;
 	};
 
+	class Sorting
+	{
+	  public:
+		unsigned int sortedCommands;
+		unsigned int movedCommands;
+		unsigned int incrementalSorts;
+
+		Sorting()
+		    : sortedCommands(0), movedCommands(0), incrementalSorts(0) {}
+
+	  private:
+		void reset()
+		{
+			sortedCommands = 0;
+			movedCommands = 0;
+			incrementalSorts = 0;
+		}
+		friend RenderStatistics;
+	};
+
+	class SpatialIndex
+	{
+	  public:
+		unsigned int indexedNodes;
+		unsigned int queries;
+		unsigned int queriedCells;
+		unsigned int hits;
+		unsigned int misses;
+		/// The number of subtrees skipped by the visit, as no node in them overlaps a viewport
+		unsigned int skippedSubtrees;
+
+		SpatialIndex()
+		    : indexedNodes(0), queries(0), queriedCells(0), hits(0), misses(0), skippedSubtrees(0) {}
+
+	  private:
+		void reset()
+		{
+			indexedNodes = 0;
+			queries = 0;
+			queriedCells = 0;
+			hits = 0;
+			misses = 0;
+			skippedSubtrees = 0;
+		}
+		friend RenderStatistics;
+	};
+
+	class StateChanges
+	{
+	  public:
+		/// The number of times a command requested the state
+		unsigned int requested;
+		/// The number of requests that actually changed the state
+		unsigned int applied;
+
+		StateChanges()
+		    : requested(0), applied(0) {}
+
+		/// Returns the number of redundant state changes avoided
+		inline unsigned int avoided() const { return requested - applied; }
+
+	  private:
+		void reset()
+		{
+			requested = 0;
+			applied = 0;
+		}
+		friend RenderStatistics;
+	};
+
+	class FrozenSubtrees
+	{
+	  public:
+		unsigned int recorded;
+		unsigned int replayed;
+		unsigned int commands;
+
+		FrozenSubtrees()
+		    : recorded(0), replayed(0), commands(0) {}
+
+	  private:
+		void reset()
+		{
+			recorded = 0;
+			replayed = 0;
+			commands = 0;
+		}
+		friend RenderStatistics;
+	};
+
+	class Arena
+	{
+	  public:
+		unsigned long size;
+		unsigned long usedBytes;
+		unsigned long peakBytes;
+		unsigned int allocations;
+		unsigned int failedAllocations;
+
+		Arena()
+		    : size(0), usedBytes(0), peakBytes(0), allocations(0), failedAllocations(0) {}
+	};
+
 	/// Returns the aggregated command statistics for all types
 	static inline const Commands &allCommands() { return allCommands_; }
 	/// Returns the commnad statistics for the specified type
@@ -84,6 +190,26 @@ class RenderStatistics
 	/// Returns aggregated texture statistics
 	static inline const Textures &textures() { return textures_; }
 
+	/// Returns statistics about the sorting of render queues
+	/// \note When sorting is not incremental every command counts as moved
+	static inline const Sorting &sorting() { return sorting_; }
+
+	/// Returns statistics about the spatial index queries of the viewports
+	/// \note Hits are the nodes found overlapping a viewport, misses are the nodes in the queried cells that do not overlap it
+	static inline const SpatialIndex &spatialIndex() { return spatialIndex_; }
+
+	/// Returns the state change statistics for the specified type of state
+	static inline const StateChanges &stateChanges(RenderStateTracker::StateTypes::Enum type) { return typedStateChanges_[type]; }
+	/// Returns the aggregated state change statistics for all types of state
+	static inline const StateChanges &allStateChanges() { return allStateChanges_; }
+
+	/// Returns statistics about the frozen subtrees whose commands have been recorded or replayed
+	static inline const FrozenSubtrees &frozenSubtrees() { return frozenSubtrees_; }
+
+	/// Returns statistics about the transient allocations of the last frame in the frame arena
+	/// \note The peak is the highest number of bytes used in a single frame since the arena was created
+	static inline const Arena &frameArena() { return frameArena_; }
+
 	/// Returns the number of `DrawableNodes` culled because outside of the screen
 	static inline unsigned int culled() { return culledNodes_[(index_ + 1) % 2]; }
 #endif
@@ -168,6 +294,12 @@ class RenderStatistics
 	static Commands typedCommands_[RenderCommand::CommandTypes::COUNT];
 	static CommandPool commandPool_;
 	static Textures textures_;
+	static Sorting sorting_;
+	static SpatialIndex spatialIndex_;
+	static FrozenSubtrees frozenSubtrees_;
+	static StateChanges allStateChanges_;
+	static StateChanges typedStateChanges_[RenderStateTracker::StateTypes::COUNT];
+	static Arena frameArena_;
 	static unsigned int index_;
 	static unsigned int culledNodes_[2];
 #endif
@@ -201,6 +333,54 @@ class RenderStatistics
 	}
 
 	static inline void addCulledNode() { culledNodes_[index_]++; }
+
+	static inline void addSortedQueue(unsigned int sortedCommands, unsigned int movedCommands, bool incremental)
+	{
+		sorting_.sortedCommands += sortedCommands;
+		sorting_.movedCommands += movedCommands;
+		sorting_.incrementalSorts += incremental ? 1 : 0;
+	}
+
+	static inline void addSpatialIndexQuery(unsigned int indexedNodes, unsigned int queriedCells, unsigned int hits, unsigned int misses)
+	{
+		spatialIndex_.indexedNodes = indexedNodes;
+		spatialIndex_.queries++;
+		spatialIndex_.queriedCells += queriedCells;
+		spatialIndex_.hits += hits;
+		spatialIndex_.misses += misses;
+	}
+
+	static inline void addSpatialIndexSkippedSubtree() { spatialIndex_.skippedSubtrees++; }
+
+	static inline void addStateChange(RenderStateTracker::StateTypes::Enum type, bool applied)
+	{
+		typedStateChanges_[type].requested++;
+		allStateChanges_.requested++;
+		if (applied)
+		{
+			typedStateChanges_[type].applied++;
+			allStateChanges_.applied++;
+		}
+	}
+
+	static inline void addFrozenSubtree(unsigned int numCommands, bool recorded)
+	{
+		if (recorded)
+			frozenSubtrees_.recorded++;
+		else
+			frozenSubtrees_.replayed++;
+		frozenSubtrees_.commands += numCommands;
+	}
+
+	static inline void gatherFrameArenaStatistics(unsigned long size, unsigned long usedBytes, unsigned long peakBytes,
+	                                              unsigned int allocations, unsigned int failedAllocations)
+	{
+		frameArena_.size = size;
+		frameArena_.usedBytes = usedBytes;
+		frameArena_.peakBytes = peakBytes;
+		frameArena_.allocations = allocations;
+		frameArena_.failedAllocations = failedAllocations;
+	}
 #endif
 
 	static void gatherStatistics(const RenderBuffersManager::ManagedBuffer &buffer);
@@ -240,9 +420,13 @@ class RenderStatistics
 	friend class RenderBuffersManager;
 	friend class Texture;
 	friend class Geometry;
+	friend class SceneNode;
 	friend class DrawableNode;
 	friend class RenderVaoPool;
 	friend class RenderCommandPool;
+	friend class SpatialGrid;
+	friend class FrameArena;
+	friend class RenderStateTracker;
 };
 
 }
@@ -0,0 +1,51 @@
+#ifndef CLASS_NCINE_SCENETRAVERSAL
+#define CLASS_NCINE_SCENETRAVERSAL
+
+#include <nctl/Array.h>
+
+namespace ncine {
+
+class SceneNode;
+class RenderQueue;
+
+/// A linearized pre-order traversal of a scene, to update and visit its nodes by iterating on arrays
+/*! The arrays are only rebuilt when the topology of a scene changes, which should not happen while the scene is updated.
+ *  The subtree of an always updated node is not linearized, as the node updates and visits its own children. */
+class SceneTraversal
+{
+  public:
+	SceneTraversal();
+
+	/// Returns the number of nodes in the traversal arrays
+	inline unsigned int numNodes() const { return nodes_.size(); }
+
+	/// Updates the scene nodes in pre-order, completing the update of a node when its subtree ends
+	/*! \note Sibling subtrees are never updated in parallel. */
+	void update(SceneNode *rootNode, float frameTime);
+	/// Visits the scene nodes in pre-order
+	void visit(SceneNode *rootNode, RenderQueue &renderQueue, unsigned int &visitOrderIndex);
+
+  private:
+	/// The nodes of the scene in pre-order
+	nctl::Array<SceneNode *> nodes_;
+	/// The index of the parent of each node, or -1 for the root
+	nctl::Array<int> parentIndices_;
+	/// The index that follows the last node of each subtree, to skip it
+	nctl::Array<unsigned int> subtreeEnds_;
+	/// The indices of the nodes that are waiting for the end of their subtree to complete the update
+	nctl::Array<int> updateStack_;
+
+	/// The root node of the scene when the arrays were built
+	SceneNode *rootNode_;
+	/// The topology version of the scenes when the arrays were built
+	unsigned int topologyVersion_;
+
+	/// Rebuilds the arrays if the root node is different or if the topology has changed since the last build
+	void rebuildIfChanged(SceneNode *rootNode);
+	/// Appends a node and its linearized subtree to the arrays
+	void appendSubtree(SceneNode *node, int parentIndex);
+};
+
+}
+
+#endif
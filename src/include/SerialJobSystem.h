@@ -2,8 +2,8 @@
 #define CLASS_NCINE_SERIALJOBSYSTEM
 
 #include "IJobSystem.h"
-#include "Job.h"
-#include <nctl/StaticArray.h>
+#include "JobPool.h"
+#include <nctl/UniquePtr.h>
 
 namespace ncine {
 
@@ -15,10 +15,11 @@ class SerialJobSystem : public IJobSystem
   public:
 	SerialJobSystem();
 
-	JobId createJob(JobFunction function, const void *data, unsigned int dataSize) override;
+	JobId createJob(JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority) override;
 	JobId createJobAsChild(JobId parentId, JobFunction function, const void *data, unsigned int dataSize) override;
 
 	bool addContinuation(JobId ancestorId, JobId continuationId) override;
+	bool setPriority(JobId jobId, JobPriority::Enum priority) override;
 
 	bool submit(JobId jobId) override;
 	uint16_t submit(const JobId *jobIds, uint16_t count) override;
@@ -28,23 +29,25 @@ class SerialJobSystem : public IJobSystem
 	uint16_t unfinishedJobs(JobId jobId) override;
 	uint16_t continuationCount(JobId jobId) override;
 
-  private:
-	/// The stack of free pool indices
-	nctl::StaticArray<uint16_t, MaxNumJobs> freeList_;
+	/// There are no worker threads to put to sleep in the serial job system
+	inline void setIdleBackoff(unsigned int spinCount, unsigned int yieldCount) override {}
+
+	/// There are no other threads to steal jobs from in the serial job system
+	inline JobStealPolicy::Enum stealPolicy() const override { return JobStealPolicy::ROUND_ROBIN; }
+	inline void setStealPolicy(JobStealPolicy::Enum policy) override {}
 
-	/// The contiguous pool of `Job` structures
-	Job jobPool_[MaxNumJobs];
+  private:
+	/// The same growable pool used by the multi-threaded job system, with a single thread cache
+	JobPool jobPool_;
 
 	unsigned int top_;
 	unsigned int bottom_;
-	JobId jobQueue_[MaxNumJobs];
-
-	/// Allocates a job from the pool, returns `InvalidJobId` if none available
-	JobId allocateJob(Job **newJob);
-	/// Frees a job back to the pool
-	void freeJob(JobId jobId);
-	/// Accesses the `Job` structure pointer from `JobId`
-	Job *retrieveJob(JobId jobId);
+	/// The capacity of the circular job queue, doubled when it is full
+	unsigned int queueCapacity_;
+	nctl::UniquePtr<JobId[]> jobQueue_;
+
+	/// Creates an id for a new job, with the priority of its parent if it has one
+	JobId createJobWithPriority(JobId parentId, JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority);
 
 	/// Pushes a job in the queue
 	void pushJob(JobId jobId);
@@ -0,0 +1,73 @@
+#ifndef CLASS_NCINE_SPATIALGRID
+#define CLASS_NCINE_SPATIALGRID
+
+#include <nctl/Array.h>
+#include "Rect.h"
+
+namespace ncine {
+
+class DrawableNode;
+
+/// A uniform grid that indexes drawable nodes by their axis-aligned bounding box
+/*! Cells are hashed into a fixed number of buckets to cover an unbounded world.
+ *  Nodes in a bucket shared with a different cell only cost an additional bounding box test.
+ *  Each node stores the range of cells that contain it, with a zero width when it is not in the grid. */
+class SpatialGrid
+{
+  public:
+	/// Creates an empty grid with cells of the specified size
+	explicit SpatialGrid(float cellSize);
+	/// Removes the remaining nodes, so that they do not refer to the grid anymore
+	~SpatialGrid();
+
+	/// Returns the side of a grid cell in world units
+	inline float cellSize() const { return cellSize_; }
+	/// Returns the number of nodes in the grid
+	inline unsigned int numNodes() const { return numNodes_; }
+	/// Returns true if no node is in the grid
+	inline bool isEmpty() const { return numNodes_ == 0; }
+
+	/// Inserts the node in the grid, or moves it if its bounding box now covers different cells
+	void update(DrawableNode *node);
+	/// Removes the node from the grid, if it is there
+	void remove(DrawableNode *node);
+
+	/// Removes every node from the grid
+	void clear();
+	/// Changes the side of a grid cell, removing every node if the size is different
+	void setCellSize(float cellSize);
+
+	/// Marks as rendered in the specified frame every node whose bounding box overlaps the rectangle
+	void markOverlapping(const Rectf &rect, unsigned long int frame);
+
+  private:
+	/// Number of buckets in which the cells are hashed, a power of two
+	static const unsigned int NumBuckets = 4096;
+	/// Nodes covering more cells than this number are tested by every query instead of being hashed
+	static const unsigned int MaxCellsPerNode = 16;
+
+	/// Side of a grid cell in world units
+	float cellSize_;
+	/// Number of nodes in the grid
+	unsigned int numNodes_;
+
+	/// The nodes of each bucket, allocated when the first node is inserted
+	nctl::Array<nctl::Array<DrawableNode *>> buckets_;
+	/// The nodes whose bounding box covers too many cells
+	nctl::Array<DrawableNode *> largeNodes_;
+
+	/// Returns the range of cells covered by a rectangle
+	Recti cellRange(const Rectf &rect) const;
+	/// Returns the bucket of the cell at the specified coordinates
+	nctl::Array<DrawableNode *> &bucket(int cellX, int cellY);
+
+	void insert(DrawableNode *node, const Recti &cells);
+	void erase(DrawableNode *node, const Recti &cells);
+
+	/// Marks the nodes not yet marked in the frame whose bounding box overlaps the rectangle, counting the tests
+	static void markNodes(nctl::Array<DrawableNode *> &nodes, const Rectf &rect, unsigned long int frame, unsigned int &hits, unsigned int &misses);
+};
+
+}
+
+#endif
@@ -194,6 +194,8 @@ namespace ThisThread {
 
 	/// Yields the calling thread in favour of another one with the same priority
 	void yield();
+	/// Hints the processor that the calling thread is busy waiting, without giving up its time slice
+	void relax();
 
 	/// Terminates the calling thread
 	[[noreturn]] void exit();
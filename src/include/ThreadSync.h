@@ -173,7 +173,13 @@ class UserSemaphore
 
   private:
 	#if !defined(__APPLE__)
+	/// The number of available resources, or the number of resources waited for when negative
 	nctl::Atomic32 count_;
+	/// The number of wake-ups handed out by signals to the waiting threads and not yet consumed
+	nctl::Atomic32 wakeUps_;
+
+	/// Sleeps until the specified number of wake-ups has been consumed
+	void consumeWakeUps(int32_t numWakeUps);
 	#else
 	dispatch_semaphore_t sem_;
 	#endif
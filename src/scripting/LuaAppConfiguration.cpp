@@ -58,6 +58,7 @@ namespace OpenGL {
 	static const char *iboSize = "ibo_size";
 	static const char *vaoPoolSize = "vao_pool_size";
 	static const char *renderCommandPoolSize = "rendercommand_pool_size";
+	static const char *frameArenaSize = "frame_arena_size";
 
 	static const char *deferShaderQueries = "defer_shader_queries";
 	static const char *fixedBatchSize = "fixed_batch_size";
@@ -81,6 +82,10 @@ namespace Audio {
 namespace JobSystem {
 	static const char *enabled = "enabled";
 	static const char *numThreads = "num_threads";
+	static const char *spinCount = "spin_count";
+	static const char *yieldCount = "yield_count";
+	static const char *topologyAwareStealing = "topology_aware_stealing";
+	static const char *performanceCoresOnly = "performance_cores_only";
 } // JobSystem
 
 	// ----- Features -----
@@ -154,7 +159,7 @@ void LuaAppConfiguration::push(lua_State *L, const AppConfiguration &appCfg)
 	lua_setfield(L, -2, LuaNames::AppConfiguration::Graphics::openglCapabilities);
 
 	// ----- Graphics.OpenGL -----
-	lua_createtable(L, 0, 11);
+	lua_createtable(L, 0, 12);
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::Graphics::OpenGL::debugContext, appCfg.graphics.opengl.debugContext);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::Graphics::OpenGL::useBufferMapping, appCfg.graphics.opengl.useBufferMapping);
@@ -163,6 +168,7 @@ void LuaAppConfiguration::push(lua_State *L, const AppConfiguration &appCfg)
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::Graphics::OpenGL::iboSize, static_cast<int64_t>(appCfg.graphics.opengl.iboSize));
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::Graphics::OpenGL::vaoPoolSize, appCfg.graphics.opengl.vaoPoolSize);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::Graphics::OpenGL::renderCommandPoolSize, appCfg.graphics.opengl.renderCommandPoolSize);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::Graphics::OpenGL::frameArenaSize, static_cast<int64_t>(appCfg.graphics.opengl.frameArenaSize));
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::Graphics::OpenGL::deferShaderQueries, appCfg.graphics.opengl.deferShaderQueries);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::Graphics::OpenGL::fixedBatchSize, appCfg.graphics.opengl.fixedBatchSize);
@@ -185,10 +191,14 @@ void LuaAppConfiguration::push(lua_State *L, const AppConfiguration &appCfg)
 	lua_setfield(L, -2, LuaNames::AppConfiguration::audio);
 
 	// ----- JobSystem -----
-	lua_createtable(L, 0, 2);
+	lua_createtable(L, 0, 6);
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::JobSystem::enabled, appCfg.jobSystem.enabled);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::JobSystem::numThreads, appCfg.jobSystem.numThreads);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::JobSystem::spinCount, appCfg.jobSystem.spinCount);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::JobSystem::yieldCount, appCfg.jobSystem.yieldCount);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::JobSystem::topologyAwareStealing, appCfg.jobSystem.topologyAwareStealing);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::JobSystem::performanceCoresOnly, appCfg.jobSystem.performanceCoresOnly);
 
 	lua_setfield(L, -2, LuaNames::AppConfiguration::jobSystem);
 
@@ -294,6 +304,8 @@ void LuaAppConfiguration::retrieveAndSet(lua_State *L, AppConfiguration &appCfg)
 			appCfg.graphics.opengl.vaoPoolSize = vaoPoolSize;
 			const unsigned int renderCommandPoolSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::Graphics::OpenGL::renderCommandPoolSize);
 			appCfg.graphics.opengl.renderCommandPoolSize = renderCommandPoolSize;
+			const unsigned long frameArenaSize = LuaUtils::retrieveField<uint64_t>(L, -1, LuaNames::AppConfiguration::Graphics::OpenGL::frameArenaSize);
+			appCfg.graphics.opengl.frameArenaSize = frameArenaSize;
 
 			const bool deferShaderQueries = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::Graphics::OpenGL::deferShaderQueries);
 			appCfg.graphics.opengl.deferShaderQueries = deferShaderQueries;
@@ -336,6 +348,14 @@ void LuaAppConfiguration::retrieveAndSet(lua_State *L, AppConfiguration &appCfg)
 		appCfg.jobSystem.enabled = enabled;
 		const unsigned int numThreads = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::JobSystem::numThreads);
 		appCfg.jobSystem.numThreads = numThreads;
+		const unsigned int spinCount = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::JobSystem::spinCount);
+		appCfg.jobSystem.spinCount = spinCount;
+		const unsigned int yieldCount = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::AppConfiguration::JobSystem::yieldCount);
+		appCfg.jobSystem.yieldCount = yieldCount;
+		const bool topologyAwareStealing = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::JobSystem::topologyAwareStealing);
+		appCfg.jobSystem.topologyAwareStealing = topologyAwareStealing;
+		const bool performanceCoresOnly = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::JobSystem::performanceCoresOnly);
+		appCfg.jobSystem.performanceCoresOnly = performanceCoresOnly;
 
 		lua_pop(L, 1);
 	}
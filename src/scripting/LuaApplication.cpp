@@ -52,10 +52,23 @@ namespace Application {
 		static const char *batchingWithIndices = "batching_with_indices";
 		static const char *instancingEnabled = "instancing";
 		static const char *cullingEnabled = "culling";
+		static const char *spatialIndexEnabled = "spatial_index";
+		static const char *spatialIndexCellSize = "spatial_index_cell_size";
 		static const char *minBatchSize = "min_batch_size";
 		static const char *maxBatchSize = "max_batch_size";
 		static const char *minInstancedBatchSize = "min_instanced_batch_size";
 		static const char *maxInstancedBatchSize = "max_instanced_batch_size";
+		static const char *incrementalSortEnabled = "incremental_sort";
+		static const char *batchTransformEnabled = "batch_transform";
+		static const char *minBatchTransformSize = "min_batch_transform_size";
+		static const char *cleanSubtreeSkipEnabled = "clean_subtree_skip";
+		static const char *linearTraversalEnabled = "linear_traversal";
+		static const char *parallelUpdateEnabled = "parallel_update";
+		static const char *minParallelUpdateSize = "min_parallel_update_size";
+		static const char *parallelUpdateSplitSize = "parallel_update_split_size";
+		static const char *parallelVisitEnabled = "parallel_visit";
+		static const char *minParallelVisitSize = "min_parallel_visit_size";
+		static const char *parallelVisitSplitSize = "parallel_visit_split_size";
 	}
 
 	namespace GuiSettings {
@@ -133,15 +146,28 @@ int LuaApplication::renderingSettings(lua_State *L)
 {
 	const Application::RenderingSettings &settings = theApplication().renderingSettings();
 
-	lua_createtable(L, 0, 8);
+	lua_createtable(L, 0, 21);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::batchingEnabled, settings.batchingEnabled);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::batchingWithIndices, settings.batchingWithIndices);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::instancingEnabled, settings.instancingEnabled);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::cullingEnabled, settings.cullingEnabled);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::spatialIndexEnabled, settings.spatialIndexEnabled);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::spatialIndexCellSize, settings.spatialIndexCellSize);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::minBatchSize, settings.minBatchSize);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::maxBatchSize, settings.maxBatchSize);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::minInstancedBatchSize, settings.minInstancedBatchSize);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::maxInstancedBatchSize, settings.maxInstancedBatchSize);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::incrementalSortEnabled, settings.incrementalSortEnabled);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::batchTransformEnabled, settings.batchTransformEnabled);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::minBatchTransformSize, settings.minBatchTransformSize);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::cleanSubtreeSkipEnabled, settings.cleanSubtreeSkipEnabled);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::linearTraversalEnabled, settings.linearTraversalEnabled);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::parallelUpdateEnabled, settings.parallelUpdateEnabled);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::minParallelUpdateSize, settings.minParallelUpdateSize);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::parallelUpdateSplitSize, settings.parallelUpdateSplitSize);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::parallelVisitEnabled, settings.parallelVisitEnabled);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::minParallelVisitSize, settings.minParallelVisitSize);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::parallelVisitSplitSize, settings.parallelVisitSplitSize);
 
 	return 1;
 }
@@ -160,10 +186,23 @@ int LuaApplication::setRenderingSettings(lua_State *L)
 	settings.batchingWithIndices = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::batchingWithIndices);
 	settings.instancingEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::instancingEnabled);
 	settings.cullingEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::cullingEnabled);
+	settings.spatialIndexEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::spatialIndexEnabled);
+	settings.spatialIndexCellSize = LuaUtils::retrieveField<float>(L, -1, LuaNames::Application::RenderingSettings::spatialIndexCellSize);
 	settings.minBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::minBatchSize);
 	settings.maxBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::maxBatchSize);
 	settings.minInstancedBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::minInstancedBatchSize);
 	settings.maxInstancedBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::maxInstancedBatchSize);
+	settings.incrementalSortEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::incrementalSortEnabled);
+	settings.batchTransformEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::batchTransformEnabled);
+	settings.minBatchTransformSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::minBatchTransformSize);
+	settings.cleanSubtreeSkipEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::cleanSubtreeSkipEnabled);
+	settings.linearTraversalEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::linearTraversalEnabled);
+	settings.parallelUpdateEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::parallelUpdateEnabled);
+	settings.minParallelUpdateSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::minParallelUpdateSize);
+	settings.parallelUpdateSplitSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::parallelUpdateSplitSize);
+	settings.parallelVisitEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::parallelVisitEnabled);
+	settings.minParallelVisitSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::minParallelVisitSize);
+	settings.parallelVisitSplitSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::parallelVisitSplitSize);
 
 	return 0;
 }
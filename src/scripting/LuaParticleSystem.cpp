@@ -37,6 +37,8 @@ namespace ParticleSystem {
 	static const char *setParticlesUpdateEnabled = "set_particles_update_enabled";
 	static const char *areAffectorsEnabled = "get_affectors_enabled";
 	static const char *setAffectorsEnabled = "set_affectors_enabled";
+	static const char *isParallelUpdateEnabled = "get_parallel_update_enabled";
+	static const char *setParallelUpdateEnabled = "set_parallel_update_enabled";
 
 	static const char *numParticles = "num_particles";
 	static const char *numAliveParticles = "num_alive_particles";
@@ -97,6 +99,8 @@ void LuaParticleSystem::expose(LuaStateManager *stateManager)
 	LuaUtils::addFunction(L, LuaNames::ParticleSystem::setParticlesUpdateEnabled, setParticlesUpdateEnabled);
 	LuaUtils::addFunction(L, LuaNames::ParticleSystem::areAffectorsEnabled, areAffectorsEnabled);
 	LuaUtils::addFunction(L, LuaNames::ParticleSystem::setAffectorsEnabled, setAffectorsEnabled);
+	LuaUtils::addFunction(L, LuaNames::ParticleSystem::isParallelUpdateEnabled, isParallelUpdateEnabled);
+	LuaUtils::addFunction(L, LuaNames::ParticleSystem::setParallelUpdateEnabled, setParallelUpdateEnabled);
 
 	LuaUtils::addFunction(L, LuaNames::ParticleSystem::numParticles, numParticles);
 	LuaUtils::addFunction(L, LuaNames::ParticleSystem::numAliveParticles, numAliveParticles);
@@ -601,6 +605,29 @@ int LuaParticleSystem::setAffectorsEnabled(lua_State *L)
 	return 0;
 }
 
+int LuaParticleSystem::isParallelUpdateEnabled(lua_State *L)
+{
+	ParticleSystem *particleSys = LuaUntrackedUserData<ParticleSystem>::retrieve(L, -1);
+
+	if (particleSys)
+		LuaUtils::push(L, particleSys->isParallelUpdateEnabled());
+	else
+		LuaUtils::pushNil(L);
+
+	return 1;
+}
+
+int LuaParticleSystem::setParallelUpdateEnabled(lua_State *L)
+{
+	ParticleSystem *particleSys = LuaUntrackedUserData<ParticleSystem>::retrieve(L, -2);
+	const bool parallelUpdateEnabled = LuaUtils::retrieve<bool>(L, -1);
+
+	if (particleSys)
+		particleSys->setParallelUpdateEnabled(parallelUpdateEnabled);
+
+	return 0;
+}
+
 int LuaParticleSystem::numParticles(lua_State *L)
 {
 	ParticleSystem *particleSys = LuaUntrackedUserData<ParticleSystem>::retrieve(L, -1);
@@ -35,7 +35,8 @@ CpuTopology::CpuTopology()
 	unsigned int maxTier = 0;
 	for (unsigned int i = 0; i < cpuInfos_.size(); i++)
 	{
-		LOGD_X("CPU #%02u (tier: %u) - logical: %d", cpuInfos_[i].id, cpuInfos_[i].tier, cpuInfos_[i].isLogical);
+		LOGD_X("CPU #%02u (tier: %u) - logical: %d, core: %u, L2: %u, L3: %u", cpuInfos_[i].id, cpuInfos_[i].tier,
+		       cpuInfos_[i].isLogical, cpuInfos_[i].coreId, cpuInfos_[i].l2CacheId, cpuInfos_[i].l3CacheId);
 
 		if (cpuInfos_[i].isLogical == false)
 			numPhysicalCores_++;
@@ -52,11 +53,35 @@ CpuTopology::CpuTopology()
 const CpuTopology::CpuInfo &CpuTopology::cpuInfo(unsigned int idx) const
 {
 	ASSERT(idx < cpuInfos_.size());
-	if (idx <= cpuInfos_.size())
+	if (idx < cpuInfos_.size())
 		return cpuInfos_[idx];
 	return cpuInfos_[0];
 }
 
+unsigned int CpuTopology::numPhysicalCores(unsigned int tier) const
+{
+	unsigned int numCores = 0;
+	for (unsigned int i = 0; i < cpuInfos_.size(); i++)
+	{
+		if (cpuInfos_[i].isLogical == false && cpuInfos_[i].tier == tier)
+			numCores++;
+	}
+	return numCores;
+}
+
+CpuTopology::Distance::Enum CpuTopology::distance(const CpuInfo &a, const CpuInfo &b)
+{
+	if (a.coreId == b.coreId)
+		return Distance::SAME_CORE;
+	if (a.l2CacheId == b.l2CacheId)
+		return Distance::SAME_L2_CACHE;
+	if (a.l3CacheId == b.l3CacheId)
+		return Distance::SAME_L3_CACHE;
+	if (a.tier == b.tier)
+		return Distance::SAME_TIER;
+	return Distance::DIFFERENT_TIER;
+}
+
 ///////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -84,6 +109,10 @@ bool CpuTopology::discoverDummyTopology()
 		info.id = i;
 		info.isLogical = false;
 		info.tier = 0;
+		// Without any information every core has its own second level cache and shares the last level one
+		info.coreId = i;
+		info.l2CacheId = i;
+		info.l3CacheId = 0;
 	}
 
 	return true;
@@ -12,6 +12,7 @@ struct AppleCpuInfo
 	int coreId;
 	int efficiencyClass;
 	bool isLogical;
+	int l2CacheId;
 };
 
 // Helper function to read integer sysctl values
@@ -48,6 +49,11 @@ bool fillAppleCpuInfo(nctl::Array<AppleCpuInfo> &appleCpuInfos)
 	if (pCores == 0 && eCores == 0)
 		return false;
 
+	// The cores of a cluster share the second level cache, all clusters share the system level cache
+	const int pCpusPerL2 = sysctlInt("hw.perflevel0.cpusperl2");
+	const int eCpusPerL2 = sysctlInt("hw.perflevel1.cpusperl2");
+	int l2CacheId = 0;
+
 	int logicalId = 0;
 	int coreId = 0;
 	for (int i = 0; i < eCores; ++i)
@@ -60,9 +66,11 @@ bool fillAppleCpuInfo(nctl::Array<AppleCpuInfo> &appleCpuInfos)
 			info.coreId = coreId;
 			info.efficiencyClass = 0;
 			info.isLogical = (t > 0);
+			info.l2CacheId = l2CacheId + ((eCpusPerL2 > 0) ? (i * threadsPerCore + t) / eCpusPerL2 : 0);
 		}
 		++coreId;
 	}
+	l2CacheId += eCores * threadsPerCore;
 
 	for (int i = 0; i < pCores; ++i)
 	{
@@ -74,6 +82,7 @@ bool fillAppleCpuInfo(nctl::Array<AppleCpuInfo> &appleCpuInfos)
 			info.coreId = coreId;
 			info.efficiencyClass = 1;
 			info.isLogical = (t > 0);
+			info.l2CacheId = l2CacheId + ((pCpusPerL2 > 0) ? (i * threadsPerCore + t) / pCpusPerL2 : 0);
 		}
 		++coreId;
 	}
@@ -94,6 +103,9 @@ void fillCpuInfos(nctl::Array<AppleCpuInfo> &appleCpuInfos, nctl::Array<CpuTopol
 		CpuTopology::CpuInfo &info = cpuInfos.back();
 		info.id = appleInfo.id;
 		info.isLogical = appleInfo.isLogical;
+		info.coreId = appleInfo.coreId;
+		info.l2CacheId = appleInfo.l2CacheId;
+		info.l3CacheId = 0;
 		if (i > 0)
 		{
 			CpuTopology::CpuInfo &prevInfo = cpuInfos[i - 1];
@@ -104,8 +116,8 @@ void fillCpuInfos(nctl::Array<AppleCpuInfo> &appleCpuInfos, nctl::Array<CpuTopol
 				info.tier++;
 		}
 
-		LOGD_X("CPU #%02d (tier %u) - core: %d, efficiencyClass: %d, logical: %d",
-		       appleInfo.id, info.tier, appleInfo.coreId, appleInfo.efficiencyClass, appleInfo.isLogical);
+		LOGD_X("CPU #%02d (tier %u) - core: %d, L2: %d, efficiencyClass: %d, logical: %d",
+		       appleInfo.id, info.tier, appleInfo.coreId, appleInfo.l2CacheId, appleInfo.efficiencyClass, appleInfo.isLogical);
 	}
 }
 
@@ -16,9 +16,17 @@ struct LinuxCpuInfo
 	int capacity;
 	int maxFreqKhz;
 	bool isLogical;
+	/// The first hardware thread of the physical core
+	int firstSiblingId;
+	/// The first CPU sharing the second level cache
+	int l2CacheId;
+	/// The first CPU sharing the last level cache
+	int l3CacheId;
 };
 
 const unsigned int MaxCpus = 256;
+/// The maximum number of cache description directories read for every CPU
+const unsigned int MaxCacheIndices = 8;
 
 const unsigned int BufferSize = 256;
 char buffer[BufferSize];
@@ -118,12 +126,42 @@ bool fillLinuxCpuInfo(LinuxCpuInfo &info, unsigned char cpuId)
 
 	snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", cpuId);
 	if (readFile(path, buffer, sizeof(buffer)) == false)
+	{
 		info.isLogical = false;
+		info.firstSiblingId = cpuId;
+	}
 	else
 	{
 		const int firstSibling = parseInt(buffer); // parsing only the first int from the list
 		info.isLogical = (firstSibling != cpuId);
+		info.firstSiblingId = firstSibling;
+	}
+
+	// A cache is identified by the first CPU in the list of the ones sharing it
+	info.l2CacheId = -1;
+	info.l3CacheId = -1;
+	for (unsigned int index = 0; index < MaxCacheIndices; index++)
+	{
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", cpuId, index);
+		if (readFile(path, buffer, sizeof(buffer)) == false)
+			break;
+		const int level = parseInt(buffer);
+		if (level != 2 && level != 3)
+			continue;
+
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", cpuId, index);
+		if (readFile(path, buffer, sizeof(buffer)) == false)
+			continue;
+		if (level == 2)
+			info.l2CacheId = parseInt(buffer);
+		else
+			info.l3CacheId = parseInt(buffer);
 	}
+	// Falling back to the cluster and the package when the caches are not described
+	if (info.l2CacheId < 0)
+		info.l2CacheId = (info.clusterId != 65535) ? info.clusterId : info.firstSiblingId;
+	if (info.l3CacheId < 0)
+		info.l3CacheId = info.packageId;
 
 	// `cpu_capacity` is not always available, but ARM usually has it
 	snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cpu_capacity", cpuId);
@@ -163,6 +201,9 @@ void fillCpuInfos(nctl::Array<LinuxCpuInfo> &linuxCpuInfos, nctl::Array<CpuTopol
 		CpuTopology::CpuInfo &info = cpuInfos.back();
 		info.id = linuxInfo.id;
 		info.isLogical = linuxInfo.isLogical;
+		info.coreId = linuxInfo.firstSiblingId;
+		info.l2CacheId = linuxInfo.l2CacheId;
+		info.l3CacheId = linuxInfo.l3CacheId;
 		if (i > 0)
 		{
 			CpuTopology::CpuInfo &prevInfo = cpuInfos[i - 1];
@@ -173,9 +214,9 @@ void fillCpuInfos(nctl::Array<LinuxCpuInfo> &linuxCpuInfos, nctl::Array<CpuTopol
 				info.tier++;
 		}
 
-		LOGD_X("CPU #%02d (tier %u) - core: %d, cluster: %d, package: %d, capacity: %d, max freq: %d Mhz, logical: %d",
-		       linuxInfo.id, info.tier, linuxInfo.coreId, linuxInfo.clusterId, linuxInfo.packageId, linuxInfo.capacity,
-		       linuxInfo.maxFreqKhz / 1024, linuxInfo.isLogical);
+		LOGD_X("CPU #%02d (tier %u) - core: %d, cluster: %d, package: %d, L2: %d, L3: %d, capacity: %d, max freq: %d Mhz, logical: %d",
+		       linuxInfo.id, info.tier, linuxInfo.coreId, linuxInfo.clusterId, linuxInfo.packageId, linuxInfo.l2CacheId, linuxInfo.l3CacheId,
+		       linuxInfo.capacity, linuxInfo.maxFreqKhz / 1024, linuxInfo.isLogical);
 	}
 }
 
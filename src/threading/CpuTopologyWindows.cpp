@@ -15,6 +15,8 @@ struct WindowsCpuInfo
 	int packageId;
 	int efficiencyClass;
 	bool isLogical;
+	int l2CacheId;
+	int l3CacheId;
 };
 
 int countBits(ULONG_PTR mask)
@@ -93,6 +95,9 @@ bool fillWindowsCpuInfo(nctl::Array<WindowsCpuInfo> &winCpuInfos)
 						cpu.packageId = group;
 						cpu.efficiencyClass = proc->EfficiencyClass;
 						cpu.isLogical = (smtCount > 1 && bitIndex > 0);
+						// Falling back to the core and the group if no cache is described
+						cpu.l2CacheId = coreId;
+						cpu.l3CacheId = group;
 
 						bitIndex++;
 					}
@@ -105,6 +110,34 @@ bool fillWindowsCpuInfo(nctl::Array<WindowsCpuInfo> &winCpuInfos)
 		ptr += entry->Size;
 	}
 
+	// Every second and third level cache gets an id that is assigned to all the processors sharing it
+	int cacheId = 0;
+	ptr = reinterpret_cast<char *>(info);
+	while (ptr < end)
+	{
+		SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *entry = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *>(ptr);
+		if (entry->Relationship == RelationCache && (entry->Cache.Level == 2 || entry->Cache.Level == 3))
+		{
+			const KAFFINITY mask = entry->Cache.GroupMask.Mask;
+			const WORD group = entry->Cache.GroupMask.Group;
+
+			for (unsigned int i = 0; i < winCpuInfos.size(); i++)
+			{
+				WindowsCpuInfo &cpu = winCpuInfos[i];
+				if (cpu.packageId == group && (mask & (KAFFINITY(1) << cpu.id)))
+				{
+					if (entry->Cache.Level == 2)
+						cpu.l2CacheId = cacheId;
+					else
+						cpu.l3CacheId = cacheId;
+				}
+			}
+			cacheId++;
+		}
+
+		ptr += entry->Size;
+	}
+
 	return true;
 }
 
@@ -128,6 +161,9 @@ void fillCpuInfos(nctl::Array<WindowsCpuInfo> &winCpuInfos, nctl::Array<CpuTopol
 		CpuTopology::CpuInfo &info = cpuInfos.back();
 		info.id = winInfo.id;
 		info.isLogical = winInfo.isLogical;
+		info.coreId = winInfo.coreId;
+		info.l2CacheId = winInfo.l2CacheId;
+		info.l3CacheId = winInfo.l3CacheId;
 		if (i > 0)
 		{
 			CpuTopology::CpuInfo &prevInfo = cpuInfos[i - 1];
@@ -138,8 +174,8 @@ void fillCpuInfos(nctl::Array<WindowsCpuInfo> &winCpuInfos, nctl::Array<CpuTopol
 				info.tier++;
 		}
 
-		LOGD_X("CPU #%02d (tier %u) - core: %d, package: %d, efficiencyClass: %d, logical: %d",
-		       winInfo.id, info.tier, winInfo.coreId, winInfo.packageId, winInfo.efficiencyClass, winInfo.isLogical);
+		LOGD_X("CPU #%02d (tier %u) - core: %d, package: %d, L2: %d, L3: %d, efficiencyClass: %d, logical: %d",
+		       winInfo.id, info.tier, winInfo.coreId, winInfo.packageId, winInfo.l2CacheId, winInfo.l3CacheId, winInfo.efficiencyClass, winInfo.isLogical);
 	}
 }
 
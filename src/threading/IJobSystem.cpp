@@ -1,4 +1,5 @@
 #include "IJobSystem.h"
+#include "JobStatistics.h"
 
 namespace ncine {
 
@@ -31,4 +32,10 @@ bool IJobSystem::isMainThread()
 	return threadIndex_ == MainThreadIndex;
 }
 
+void IJobSystem::executeInPlace(JobId jobId, JobFunction function, const void *data)
+{
+	function(jobId, data);
+	theJobStatistics().jobSystemStatsMut().incrementJobsExecutedInline();
+}
+
 }
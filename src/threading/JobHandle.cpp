@@ -54,6 +54,12 @@ NODISCARD JobHandle JobHandle::createJob(JobFunction function, const void *data,
 	return JobHandle(jobId);
 }
 
+NODISCARD JobHandle JobHandle::createJob(JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority)
+{
+	JobId jobId = theServiceLocator().jobSystem().createJob(function, data, dataSize, priority);
+	return JobHandle(jobId);
+}
+
 JobHandle JobHandle::createChildJob(JobFunction function, const void *data, unsigned int dataSize)
 {
 	if (isValid() == false)
@@ -63,6 +69,21 @@ JobHandle JobHandle::createChildJob(JobFunction function, const void *data, unsi
 	return JobHandle(childId);
 }
 
+/*! \note The work of the child is never dropped, not even when the job pool is exhausted. */
+bool JobHandle::submitChildOrExecute(JobFunction function, const void *data, unsigned int dataSize)
+{
+	IJobSystem &jobSystem = theServiceLocator().jobSystem();
+
+	const JobId childId = isValid() ? jobSystem.createJobAsChild(jobId_, function, data, dataSize) : InvalidJobId;
+	if (childId != InvalidJobId && jobSystem.submit(childId))
+		return true;
+
+	if (childId != InvalidJobId)
+		jobSystem.cancel(childId);
+	IJobSystem::executeInPlace(jobId_, function, data);
+	return false;
+}
+
 JobHandle JobHandle::createContinuationJob(JobFunction function, const void *data, unsigned int dataSize)
 {
 	if (isValid() == false)
@@ -78,6 +99,15 @@ JobHandle JobHandle::createContinuationJob(JobFunction function, const void *dat
 	}
 }
 
+/*! \note The children of a job inherit its priority when they are created */
+bool JobHandle::setPriority(JobPriority::Enum priority)
+{
+	if (isValid() == false)
+		return false;
+
+	return theServiceLocator().jobSystem().setPriority(jobId_, priority);
+}
+
 bool JobHandle::submit()
 {
 	return theServiceLocator().jobSystem().submit(jobId_);
@@ -7,8 +7,10 @@ namespace ncine {
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
 
+static_assert((JobPoolBlockSize & (JobPoolBlockSize - 1)) == 0, "The size of a job pool block needs to be a power of two");
+
 JobPool::JobPool()
-    : numThreads_(0)
+    : numThreads_(0), numBlocks_(0)
 {
 }
 
@@ -26,7 +28,7 @@ JobId JobPool::allocateJob(Job **newJob)
 	if (cache.top > 0)
 	{
 		const uint16_t index = cache.indices[--cache.top];
-		Job &job = jobPool_[index];
+		Job &job = jobAt(index);
 
 		JobId jobId = Job::makeJobId(index, job.generation);
 		FATAL_ASSERT_MSG(jobId != InvalidJobId, "Generated an invalid job id");
@@ -46,8 +48,15 @@ JobId JobPool::allocateJob(Job **newJob)
 			count = ThreadCacheSize;
 		if (count == 0)
 		{
-			theJobStatistics().jobPoolStatsMut().incrementJobAllocationFails();
-			return InvalidJobId;
+			if (addBlock() == false)
+			{
+				theJobStatistics().jobPoolStatsMut().incrementJobAllocationFails();
+				return InvalidJobId;
+			}
+
+			count = freeList_.size();
+			if (ThreadCacheSize < count)
+				count = ThreadCacheSize;
 		}
 
 		for (uint16_t i = 0; i < count; ++i)
@@ -69,12 +78,14 @@ void JobPool::freeJob(JobId jobId)
 	const unsigned char threadIndex = IJobSystem::threadIndex();
 
 	const uint16_t index = Job::unpackIndex(jobId);
-	ASSERT(index < MaxNumJobs);
+	ASSERT(index < capacity());
 
-	Job *job = &jobPool_[index];
+	Job *job = &jobAt(index);
 	jobStateFinishedToFree(job, jobId); // Job debug state transition
 	JOB_LOG_POOL_FREE(jobId, index, job->generation);
 
+	if (job->dataLocation != Job::INLINE)
+		freeJobData(*job);
 	job->function = nullptr;
 	job->parent = InvalidJobId;
 	job->countersAndState.store(0, nctl::MemoryModel::RELEASE);
@@ -97,19 +108,52 @@ void JobPool::freeJob(JobId jobId)
 	theJobStatistics().jobPoolStatsMut().incrementJobsFreed();
 }
 
+/*! \note No heap allocation is performed unless the data is bigger than `JobArenaDataSize` or the arena is full. */
+void JobPool::copyJobData(Job *job, const void *data, unsigned int dataSize)
+{
+	ASSERT(job->dataLocation == Job::INLINE);
+	if (data == nullptr || dataSize == 0)
+		return;
+
+	if (dataSize <= JobDataSize)
+	{
+		memcpy(job->data, data, dataSize);
+		return;
+	}
+
+	unsigned char *externalData = nullptr;
+	if (dataSize <= JobArenaDataSize)
+		externalData = allocateArenaBlock(IJobSystem::threadIndex());
+
+	if (externalData != nullptr)
+	{
+		job->dataLocation = Job::ARENA;
+		theJobStatistics().jobPoolStatsMut().incrementArenaDataAllocations();
+	}
+	else
+	{
+		externalData = new unsigned char[dataSize];
+		job->dataLocation = Job::HEAP;
+		theJobStatistics().jobPoolStatsMut().incrementHeapDataAllocations();
+	}
+
+	memcpy(externalData, data, dataSize);
+	memcpy(job->data, &externalData, sizeof(externalData));
+}
+
 Job *JobPool::retrieveJob(JobId jobId)
 {
 	FATAL_ASSERT(numThreads_ > 0);
 	ASSERT(jobId != InvalidJobId);
 
 	const uint16_t index = Job::unpackIndex(jobId);
-	if (jobId == InvalidJobId || index >= MaxNumJobs)
+	if (jobId == InvalidJobId || index >= capacity())
 	{
 		theJobStatistics().jobPoolStatsMut().incrementJobRetrievalFails();
 		return nullptr;
 	}
 
-	Job *job = &jobPool_[index];
+	Job *job = &jobAt(index);
 	if (job->generation == Job::unpackGeneration(jobId))
 	{
 		theJobStatistics().jobPoolStatsMut().incrementJobsRetrieved();
@@ -127,15 +171,75 @@ Job *JobPool::retrieveJob(JobId jobId)
 void JobPool::initialize(unsigned char numThreads)
 {
 	FATAL_ASSERT(numThreads > 0);
-	// Initialize the free list with all job indices (backwards)
-	for (unsigned int i = 0; i < MaxNumJobs; i++)
-		freeList_.pushBack(MaxNumJobs - 1 - i);
+	addBlock();
 
 	threadCaches_.setCapacity(numThreads);
 	for (unsigned char i = 0; i < numThreads; i++)
 		threadCaches_.emplaceBack();
 
+	arenaBlocks_ = nctl::makeUnique<unsigned char[]>(numThreads * NumArenaBlocks * JobArenaDataSize);
+	arenaBlocksInUse_ = nctl::makeUnique<nctl::Atomic32[]>(numThreads * NumArenaBlocks);
+
 	numThreads_ = numThreads;
 }
 
+/*! \note It is called with the mutex locked, or before any other thread can access the pool. */
+bool JobPool::addBlock()
+{
+	const int32_t numBlocks = numBlocks_.load(nctl::MemoryModel::RELAXED);
+	if (numBlocks >= MaxNumJobPoolBlocks)
+		return false;
+
+	blocks_[numBlocks] = nctl::makeUnique<Job[]>(JobPoolBlockSize);
+	// The block needs to be visible to any thread that retrieves one of its jobs
+	numBlocks_.store(numBlocks + 1, nctl::MemoryModel::RELEASE);
+
+	// Initialize the free list with all the job indices of the block (backwards)
+	const unsigned int firstIndex = numBlocks * JobPoolBlockSize;
+	for (unsigned int i = 0; i < JobPoolBlockSize; i++)
+		freeList_.pushBack(static_cast<uint16_t>(firstIndex + JobPoolBlockSize - 1 - i));
+
+	theJobStatistics().jobPoolStatsMut().incrementBlocksAdded();
+	return true;
+}
+
+/*! \note Only the owning thread allocates from an arena, while any thread can free a block by finishing or cancelling a job.
+ *  As jobs tend to finish in the order they are created, the search starts after the last allocated block. */
+unsigned char *JobPool::allocateArenaBlock(unsigned char threadIndex)
+{
+	ThreadCache &cache = threadCaches_[threadIndex];
+	const unsigned int firstBlock = threadIndex * NumArenaBlocks;
+
+	for (unsigned int i = 0; i < NumArenaBlocks; i++)
+	{
+		const unsigned int arenaBlock = (cache.nextArenaBlock + i) % NumArenaBlocks;
+		nctl::Atomic32 &inUse = arenaBlocksInUse_[firstBlock + arenaBlock];
+		// Acquiring the release of the thread that freed the block, after the data has been read by the job function
+		if (inUse.load(nctl::MemoryModel::ACQUIRE) == 0)
+		{
+			inUse.store(1, nctl::MemoryModel::RELAXED);
+			cache.nextArenaBlock = (arenaBlock + 1) % NumArenaBlocks;
+			return arenaBlocks_.get() + (firstBlock + arenaBlock) * JobArenaDataSize;
+		}
+	}
+
+	return nullptr;
+}
+
+void JobPool::freeJobData(Job &job)
+{
+	unsigned char *externalData = nullptr;
+	memcpy(&externalData, job.data, sizeof(externalData));
+
+	if (job.dataLocation == Job::ARENA)
+	{
+		const unsigned int blockIndex = static_cast<unsigned int>(externalData - arenaBlocks_.get()) / JobArenaDataSize;
+		arenaBlocksInUse_[blockIndex].store(0, nctl::MemoryModel::RELEASE);
+	}
+	else
+		delete[] externalData;
+
+	job.dataLocation = Job::INLINE;
+}
+
 }
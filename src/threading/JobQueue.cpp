@@ -11,8 +11,9 @@
 
 namespace ncine {
 
-static_assert(MaxNumJobs > 1 && (MaxNumJobs & (MaxNumJobs - 1)) == 0, "The number of jobs needs to be a power of two for the mask to work");
-static const unsigned int Mask = MaxNumJobs - 1u;
+static_assert(JobQueue::InitialCapacity > 1 && (JobQueue::InitialCapacity & (JobQueue::InitialCapacity - 1)) == 0,
+              "The capacity of the queue needs to be a power of two for the mask to work");
+static_assert((JobQueue::InitialCapacity << (JobQueue::MaxNumArrays - 1)) >= MaxNumJobs, "The last array should hold all the jobs of the pool");
 
 namespace {
 	JobPool *jobPool_ = nullptr;
@@ -23,10 +24,11 @@ namespace {
 ///////////////////////////////////////////////////////////
 
 JobQueue::JobQueue()
-    : top_(0), bottom_(0)
+    : top_(0), bottom_(0), arrayIndex_(0)
 {
-	for (unsigned int i = 0; i < MaxNumJobs; i++)
-		jobs_[i] = InvalidJobId;
+	arrays_[0] = nctl::makeUnique<JobId[]>(InitialCapacity);
+	for (unsigned int i = 0; i < InitialCapacity; i++)
+		arrays_[0][i] = InvalidJobId;
 }
 
 ///////////////////////////////////////////////////////////
@@ -38,13 +40,18 @@ void JobQueue::push(JobId jobId)
 	const int32_t b = bottom_.load(nctl::MemoryModel::RELAXED);
 	const int32_t t = top_.load(nctl::MemoryModel::RELAXED);
 
-	if ((b - t) >= static_cast<int32_t>(MaxNumJobs))
+	int32_t index = arrayIndex_.load(nctl::MemoryModel::RELAXED);
+	if ((b - t) >= static_cast<int32_t>(arrayCapacity(index)))
 	{
-		LOGE_X("JobQueue overflow: bottom=%d, top=%d, capacity=%u", b, t, MaxNumJobs);
-		return;
+		if (grow(t, b) == false)
+		{
+			LOGE_X("JobQueue overflow: bottom=%d, top=%d, capacity=%u", b, t, arrayCapacity(index));
+			return;
+		}
+		index++;
 	}
 
-	jobs_[b & Mask] = jobId;
+	arrays_[index][b & (arrayCapacity(index) - 1)] = jobId;
 	jobStateFreeToPushed(jobPool_, jobId); // Job debug state transition
 
 	bottom_.store(b + 1, nctl::MemoryModel::RELEASE);
@@ -59,13 +66,17 @@ JobId JobQueue::pop()
 	b = b - 1;
 	bottom_.store(b, nctl::MemoryModel::RELAXED);
 
-	nctl::AtomicFences::threadFence(nctl::MemoryModel::ACQUIRE);
+	// The new bottom needs to be visible before the top is read, or a thief could take the same job
+	nctl::AtomicFences::threadFence(nctl::MemoryModel::SEQ_CST);
 
 	int32_t t = top_.load(nctl::MemoryModel::ACQUIRE);
 	if (t <= b)
 	{
 		// Non-empty queue
-		JobId jobId = jobs_[b & Mask];
+		const int32_t index = arrayIndex_.load(nctl::MemoryModel::RELAXED);
+		JobId *jobs = arrays_[index].get();
+		const unsigned int mask = arrayCapacity(index) - 1;
+		JobId jobId = jobs[b & mask];
 
 		if (t != b)
 		{
@@ -73,13 +84,13 @@ JobId JobQueue::pop()
 			JOB_LOG_QUEUE_POP(jobId, Job::unpackIndex(jobId), Job::unpackGeneration(jobId), bottom_.load(), top_.load());
 			theJobStatistics().jobQueueStatsMut().incrementPops();
 
-			jobs_[b & Mask] = InvalidJobId;
+			jobs[b & mask] = InvalidJobId;
 			// There's still more than one item left in the queue
 			return jobId;
 		}
 
 		// This is the last item in the queue
-		if (top_.cmpExchange(t, t + 1, nctl::MemoryModel::ACQ_REL) == false)
+		if (top_.cmpExchange(t, t + 1, nctl::MemoryModel::SEQ_CST) == false)
 		{
 			// Failed race against steal operation
 			jobId = InvalidJobId;
@@ -94,7 +105,7 @@ JobId JobQueue::pop()
 		else
 			theJobStatistics().jobQueueStatsMut().incrementPopFails();
 
-		jobs_[b & Mask] = InvalidJobId;
+		jobs[b & mask] = InvalidJobId;
 		bottom_.store(t + 1, nctl::MemoryModel::RELAXED);
 		return jobId;
 	}
@@ -110,25 +121,29 @@ JobId JobQueue::pop()
 JobId JobQueue::steal()
 {
 	int32_t t = top_.load(nctl::MemoryModel::ACQUIRE);
+	nctl::AtomicFences::threadFence(nctl::MemoryModel::SEQ_CST);
 	const int32_t b = bottom_.load(nctl::MemoryModel::ACQUIRE);
+	// Loaded after the bottom, so that the array is at least as recent as the last push that was observed
+	const int32_t index = arrayIndex_.load(nctl::MemoryModel::ACQUIRE);
 
 	if (t < b)
 	{
-		if (top_.cmpExchange(t, t + 1, nctl::MemoryModel::ACQUIRE) == false)
+		// Non-empty queue, the job is read before the top is incremented, as the owner is free to reuse the slot afterwards
+		JobId *jobs = arrays_[index].get();
+		const unsigned int mask = arrayCapacity(index) - 1;
+		const JobId jobId = jobs[t & mask];
+
+		if (top_.cmpExchange(t, t + 1, nctl::MemoryModel::SEQ_CST) == false)
 		{
 			theJobStatistics().jobQueueStatsMut().incrementStealFails();
 			// A concurrent steal or pop operation removed an element from the deque in the meantime.
 			return InvalidJobId;
 		}
 
-		// Non-empty queue
-		JobId jobId = jobs_[t & Mask];
-
 		jobStatePushedToPopped(jobPool_, jobId); // Job debug state transition
 		JOB_LOG_QUEUE_STEAL(jobId, Job::unpackIndex(jobId), Job::unpackGeneration(jobId), bottom_.load(), top_.load());
 		theJobStatistics().jobQueueStatsMut().incrementSteals();
 
-		jobs_[t & Mask] = InvalidJobId;
 		return jobId;
 	}
 	else
@@ -143,6 +158,29 @@ JobId JobQueue::steal()
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+/*! \note Only called by the thread that owns the queue. The jobs are copied, not moved, so that a concurrent steal can still read them from the previous array. */
+bool JobQueue::grow(int32_t top, int32_t bottom)
+{
+	const int32_t index = arrayIndex_.load(nctl::MemoryModel::RELAXED);
+	if (index + 1 >= static_cast<int32_t>(MaxNumArrays))
+		return false;
+
+	const unsigned int oldMask = arrayCapacity(index) - 1;
+	const unsigned int newCapacity = arrayCapacity(index + 1);
+	const unsigned int newMask = newCapacity - 1;
+
+	arrays_[index + 1] = nctl::makeUnique<JobId[]>(newCapacity);
+	JobId *oldJobs = arrays_[index].get();
+	JobId *newJobs = arrays_[index + 1].get();
+	for (unsigned int i = 0; i < newCapacity; i++)
+		newJobs[i] = InvalidJobId;
+	for (int32_t i = top; i < bottom; i++)
+		newJobs[i & newMask] = oldJobs[i & oldMask];
+
+	arrayIndex_.store(index + 1, nctl::MemoryModel::RELEASE);
+	return true;
+}
+
 #if JOB_DEBUG_STATE
 void JobQueue::setJobPool(JobPool *jobPool)
 {
@@ -63,6 +63,13 @@ namespace {
 		char const * const ChildJobsFinished = "ChildJobsFinished#%02d";
 		char const * const ContinuationJobsPushed = "ContinuationJobsPushed#%02d";
 		char const * const ParentJobsFinished = "ParentJobsFinished#%02d";
+		char const * const JobsExecutedInline = "JobsExecutedInline#%02d";
+		char const * const SpinWakeUps = "SpinWakeUps#%02d";
+		char const * const YieldWakeUps = "YieldWakeUps#%02d";
+		char const * const SleepWakeUps = "SleepWakeUps#%02d";
+		char const * const SpinTime = "SpinTime#%02d";
+		char const * const SleepTime = "SleepTime#%02d";
+		char const * const WakeUpLatency = "WakeUpLatency#%02d";
 	#endif
 
 	#if WITH_JOBPOOL_TRACY_PLOTS
@@ -73,6 +80,9 @@ namespace {
 		char const * const JobRetrievalFailsPool = "JobRetrievalFails#%02d";
 		char const * const ThreadCacheEmptyPool = "ThreadCacheEmpty#%02d";
 		char const * const ThreadCacheFullPool = "ThreadCacheFull#%02d";
+		char const * const BlocksAddedPool = "BlocksAddedPool#%02d";
+		char const * const ArenaDataAllocationsPool = "ArenaDataAllocationsPool#%02d";
+		char const * const HeapDataAllocationsPool = "HeapDataAllocationsPool#%02d";
 	#endif
 
 	#if WITH_JOBQUEUE_TRACY_PLOTS
@@ -93,6 +103,13 @@ namespace {
 	nctl::Array<nctl::StaticString<32>> childJobsFinishedPlotStrings;
 	nctl::Array<nctl::StaticString<32>> continuationJobsPushedPlotStrings;
 	nctl::Array<nctl::StaticString<32>> parentJobsFinishedPlotStrings;
+	nctl::Array<nctl::StaticString<32>> jobsExecutedInlinePlotStrings;
+	nctl::Array<nctl::StaticString<32>> spinWakeUpsPlotStrings;
+	nctl::Array<nctl::StaticString<32>> yieldWakeUpsPlotStrings;
+	nctl::Array<nctl::StaticString<32>> sleepWakeUpsPlotStrings;
+	nctl::Array<nctl::StaticString<32>> spinTimePlotStrings;
+	nctl::Array<nctl::StaticString<32>> sleepTimePlotStrings;
+	nctl::Array<nctl::StaticString<32>> wakeUpLatencyPlotStrings;
 	#endif
 
 	#if WITH_JOBPOOL_TRACY_PLOTS
@@ -103,6 +120,9 @@ namespace {
 	nctl::Array<nctl::StaticString<32>> jobRetrievalFailsPoolPlotStrings;
 	nctl::Array<nctl::StaticString<32>> threadCacheEmptyPoolPlotStrings;
 	nctl::Array<nctl::StaticString<32>> threadCacheFullPoolPlotStrings;
+	nctl::Array<nctl::StaticString<32>> blocksAddedPoolPlotStrings;
+	nctl::Array<nctl::StaticString<32>> arenaDataAllocationsPoolPlotStrings;
+	nctl::Array<nctl::StaticString<32>> heapDataAllocationsPoolPlotStrings;
 	#endif
 
 	#if WITH_JOBQUEUE_TRACY_PLOTS
@@ -191,6 +211,72 @@ void JobStatistics::JobSystemStats::incrementParentJobsFinished()
 	          static_cast<int64_t>(parentJobsFinished));
 	#endif
 }
+
+void JobStatistics::JobSystemStats::incrementJobsExecutedInline()
+{
+	jobsExecutedInline++;
+	#if WITH_JOBSYSTEM_TRACY_PLOTS
+	TracyPlot(jobsExecutedInlinePlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(jobsExecutedInline));
+	#endif
+}
+
+void JobStatistics::JobSystemStats::incrementSpinWakeUps()
+{
+	spinWakeUps++;
+	#if WITH_JOBSYSTEM_TRACY_PLOTS
+	TracyPlot(spinWakeUpsPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(spinWakeUps));
+	#endif
+}
+
+void JobStatistics::JobSystemStats::incrementYieldWakeUps()
+{
+	yieldWakeUps++;
+	#if WITH_JOBSYSTEM_TRACY_PLOTS
+	TracyPlot(yieldWakeUpsPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(yieldWakeUps));
+	#endif
+}
+
+void JobStatistics::JobSystemStats::incrementSleepWakeUps()
+{
+	sleepWakeUps++;
+	#if WITH_JOBSYSTEM_TRACY_PLOTS
+	TracyPlot(sleepWakeUpsPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(sleepWakeUps));
+	#endif
+}
+
+void JobStatistics::JobSystemStats::addSpinTime(uint64_t nanoseconds)
+{
+	spinNanoseconds += nanoseconds;
+	#if WITH_JOBSYSTEM_TRACY_PLOTS
+	TracyPlot(spinTimePlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(spinNanoseconds));
+	#endif
+}
+
+void JobStatistics::JobSystemStats::addSleepTime(uint64_t nanoseconds)
+{
+	sleepNanoseconds += nanoseconds;
+	#if WITH_JOBSYSTEM_TRACY_PLOTS
+	TracyPlot(sleepTimePlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(sleepNanoseconds));
+	#endif
+}
+
+void JobStatistics::JobSystemStats::addWakeUpLatency(uint64_t nanoseconds)
+{
+	wakeUpLatencyNanoseconds += nanoseconds;
+	if (nanoseconds > maxWakeUpLatencyNanoseconds)
+		maxWakeUpLatencyNanoseconds = nanoseconds;
+	#if WITH_JOBSYSTEM_TRACY_PLOTS
+	// The latency of the single wake-up is plotted, not the accumulated one
+	TracyPlot(wakeUpLatencyPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(nanoseconds));
+	#endif
+}
 #else
 // Empty functions that are completely optimized-out in release when the define is not set
 void JobStatistics::JobSystemStats::incrementJobsCreated() {}
@@ -201,6 +287,13 @@ void JobStatistics::JobSystemStats::incrementJobsFinished() {}
 void JobStatistics::JobSystemStats::incrementChildJobsFinished() {}
 void JobStatistics::JobSystemStats::incrementContinuationJobsPushed() {}
 void JobStatistics::JobSystemStats::incrementParentJobsFinished() {}
+void JobStatistics::JobSystemStats::incrementJobsExecutedInline() {}
+void JobStatistics::JobSystemStats::incrementSpinWakeUps() {}
+void JobStatistics::JobSystemStats::incrementYieldWakeUps() {}
+void JobStatistics::JobSystemStats::incrementSleepWakeUps() {}
+void JobStatistics::JobSystemStats::addSpinTime(uint64_t nanoseconds) {}
+void JobStatistics::JobSystemStats::addSleepTime(uint64_t nanoseconds) {}
+void JobStatistics::JobSystemStats::addWakeUpLatency(uint64_t nanoseconds) {}
 #endif
 
 void JobStatistics::JobSystemStats::add(const JobSystemStats &other)
@@ -213,6 +306,15 @@ void JobStatistics::JobSystemStats::add(const JobSystemStats &other)
 	childJobsFinished += other.childJobsFinished;
 	continuationJobsPushed += other.continuationJobsPushed;
 	parentJobsFinished += other.parentJobsFinished;
+	jobsExecutedInline += other.jobsExecutedInline;
+	spinWakeUps += other.spinWakeUps;
+	yieldWakeUps += other.yieldWakeUps;
+	sleepWakeUps += other.sleepWakeUps;
+	spinNanoseconds += other.spinNanoseconds;
+	sleepNanoseconds += other.sleepNanoseconds;
+	wakeUpLatencyNanoseconds += other.wakeUpLatencyNanoseconds;
+	if (other.maxWakeUpLatencyNanoseconds > maxWakeUpLatencyNanoseconds)
+		maxWakeUpLatencyNanoseconds = other.maxWakeUpLatencyNanoseconds;
 }
 
 void JobStatistics::JobSystemStats::reset()
@@ -225,6 +327,14 @@ void JobStatistics::JobSystemStats::reset()
 	childJobsFinished = 0;
 	continuationJobsPushed = 0;
 	parentJobsFinished = 0;
+	jobsExecutedInline = 0;
+	spinWakeUps = 0;
+	yieldWakeUps = 0;
+	sleepWakeUps = 0;
+	spinNanoseconds = 0;
+	sleepNanoseconds = 0;
+	wakeUpLatencyNanoseconds = 0;
+	maxWakeUpLatencyNanoseconds = 0;
 
 #if WITH_JOBSYSTEM_TRACY_PLOTS
 	TracyPlot(jobsCreatedPlotStrings[IJobSystem::threadIndex()].data(),
@@ -243,6 +353,20 @@ void JobStatistics::JobSystemStats::reset()
 	          static_cast<int64_t>(continuationJobsPushed));
 	TracyPlot(parentJobsFinishedPlotStrings[IJobSystem::threadIndex()].data(),
 	          static_cast<int64_t>(parentJobsFinished));
+	TracyPlot(jobsExecutedInlinePlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(jobsExecutedInline));
+	TracyPlot(spinWakeUpsPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(spinWakeUps));
+	TracyPlot(yieldWakeUpsPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(yieldWakeUps));
+	TracyPlot(sleepWakeUpsPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(sleepWakeUps));
+	TracyPlot(spinTimePlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(spinNanoseconds));
+	TracyPlot(sleepTimePlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(sleepNanoseconds));
+	TracyPlot(wakeUpLatencyPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(0));
 #endif
 }
 
@@ -318,6 +442,33 @@ void JobStatistics::JobPoolStats::incrementThreadCacheFull()
 	          static_cast<int64_t>(threadCacheFull));
 	#endif
 }
+
+void JobStatistics::JobPoolStats::incrementBlocksAdded()
+{
+	blocksAdded++;
+	#if WITH_JOBPOOL_TRACY_PLOTS
+	TracyPlot(blocksAddedPoolPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(blocksAdded));
+	#endif
+}
+
+void JobStatistics::JobPoolStats::incrementArenaDataAllocations()
+{
+	arenaDataAllocations++;
+	#if WITH_JOBPOOL_TRACY_PLOTS
+	TracyPlot(arenaDataAllocationsPoolPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(arenaDataAllocations));
+	#endif
+}
+
+void JobStatistics::JobPoolStats::incrementHeapDataAllocations()
+{
+	heapDataAllocations++;
+	#if WITH_JOBPOOL_TRACY_PLOTS
+	TracyPlot(heapDataAllocationsPoolPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(heapDataAllocations));
+	#endif
+}
 #else
 // Empty functions that are completely optimized-out in release when the define is not set
 void JobStatistics::JobPoolStats::incrementJobsAllocated() {}
@@ -327,6 +478,9 @@ void JobStatistics::JobPoolStats::incrementJobsRetrieved() {}
 void JobStatistics::JobPoolStats::incrementJobRetrievalFails() {}
 void JobStatistics::JobPoolStats::incrementThreadCacheEmpty() {}
 void JobStatistics::JobPoolStats::incrementThreadCacheFull() {}
+void JobStatistics::JobPoolStats::incrementBlocksAdded() {}
+void JobStatistics::JobPoolStats::incrementArenaDataAllocations() {}
+void JobStatistics::JobPoolStats::incrementHeapDataAllocations() {}
 #endif
 
 void JobStatistics::JobPoolStats::add(const JobPoolStats &other)
@@ -338,6 +492,9 @@ void JobStatistics::JobPoolStats::add(const JobPoolStats &other)
 	jobRetrievalFails += other.jobRetrievalFails;
 	threadCacheEmpty += other.threadCacheEmpty;
 	threadCacheFull += other.threadCacheFull;
+	blocksAdded += other.blocksAdded;
+	arenaDataAllocations += other.arenaDataAllocations;
+	heapDataAllocations += other.heapDataAllocations;
 }
 
 void JobStatistics::JobPoolStats::reset()
@@ -349,6 +506,9 @@ void JobStatistics::JobPoolStats::reset()
 	jobRetrievalFails = 0;
 	threadCacheEmpty = 0;
 	threadCacheFull = 0;
+	blocksAdded = 0;
+	arenaDataAllocations = 0;
+	heapDataAllocations = 0;
 
 #if WITH_JOBPOOL_TRACY_PLOTS
 	TracyPlot(jobsAllocatedPoolPlotStrings[IJobSystem::threadIndex()].data(),
@@ -365,6 +525,12 @@ void JobStatistics::JobPoolStats::reset()
 	          static_cast<int64_t>(threadCacheEmpty));
 	TracyPlot(threadCacheFullPoolPlotStrings[IJobSystem::threadIndex()].data(),
 	          static_cast<int64_t>(threadCacheFull));
+	TracyPlot(blocksAddedPoolPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(blocksAdded));
+	TracyPlot(arenaDataAllocationsPoolPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(arenaDataAllocations));
+	TracyPlot(heapDataAllocationsPoolPlotStrings[IJobSystem::threadIndex()].data(),
+	          static_cast<int64_t>(heapDataAllocations));
 #endif
 }
 
@@ -641,6 +807,13 @@ void JobStatistics::initialize(unsigned char numThreads)
 		childJobsFinishedPlotStrings.setSize(numThreads);
 		continuationJobsPushedPlotStrings.setSize(numThreads);
 		parentJobsFinishedPlotStrings.setSize(numThreads);
+		jobsExecutedInlinePlotStrings.setSize(numThreads);
+		spinWakeUpsPlotStrings.setSize(numThreads);
+		yieldWakeUpsPlotStrings.setSize(numThreads);
+		sleepWakeUpsPlotStrings.setSize(numThreads);
+		spinTimePlotStrings.setSize(numThreads);
+		sleepTimePlotStrings.setSize(numThreads);
+		wakeUpLatencyPlotStrings.setSize(numThreads);
 		for (unsigned char i = 0; i < numThreads; i++)
 		{
 			jobsCreatedPlotStrings[i].format(PlotNameFormat::JobsCreated, i);
@@ -651,6 +824,13 @@ void JobStatistics::initialize(unsigned char numThreads)
 			childJobsFinishedPlotStrings[i].format(PlotNameFormat::ChildJobsFinished, i);
 			continuationJobsPushedPlotStrings[i].format(PlotNameFormat::ContinuationJobsPushed, i);
 			parentJobsFinishedPlotStrings[i].format(PlotNameFormat::ParentJobsFinished, i);
+			jobsExecutedInlinePlotStrings[i].format(PlotNameFormat::JobsExecutedInline, i);
+			spinWakeUpsPlotStrings[i].format(PlotNameFormat::SpinWakeUps, i);
+			yieldWakeUpsPlotStrings[i].format(PlotNameFormat::YieldWakeUps, i);
+			sleepWakeUpsPlotStrings[i].format(PlotNameFormat::SleepWakeUps, i);
+			spinTimePlotStrings[i].format(PlotNameFormat::SpinTime, i);
+			sleepTimePlotStrings[i].format(PlotNameFormat::SleepTime, i);
+			wakeUpLatencyPlotStrings[i].format(PlotNameFormat::WakeUpLatency, i);
 		}
 	#endif
 
@@ -662,6 +842,9 @@ void JobStatistics::initialize(unsigned char numThreads)
 		jobRetrievalFailsPoolPlotStrings.setSize(numThreads);
 		threadCacheEmptyPoolPlotStrings.setSize(numThreads);
 		threadCacheFullPoolPlotStrings.setSize(numThreads);
+		blocksAddedPoolPlotStrings.setSize(numThreads);
+		arenaDataAllocationsPoolPlotStrings.setSize(numThreads);
+		heapDataAllocationsPoolPlotStrings.setSize(numThreads);
 		for (unsigned char i = 0; i < numThreads; i++)
 		{
 			jobsAllocatedPoolPlotStrings[i].format(PlotNameFormat::JobsAllocatedPool, i);
@@ -671,6 +854,9 @@ void JobStatistics::initialize(unsigned char numThreads)
 			jobRetrievalFailsPoolPlotStrings[i].format(PlotNameFormat::JobRetrievalFailsPool, i);
 			threadCacheEmptyPoolPlotStrings[i].format(PlotNameFormat::ThreadCacheEmptyPool, i);
 			threadCacheFullPoolPlotStrings[i].format(PlotNameFormat::ThreadCacheFullPool, i);
+			blocksAddedPoolPlotStrings[i].format(PlotNameFormat::BlocksAddedPool, i);
+			arenaDataAllocationsPoolPlotStrings[i].format(PlotNameFormat::ArenaDataAllocationsPool, i);
+			heapDataAllocationsPoolPlotStrings[i].format(PlotNameFormat::HeapDataAllocationsPool, i);
 		}
 	#endif
 
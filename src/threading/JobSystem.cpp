@@ -3,6 +3,10 @@
 #include "JobStatistics.h"
 #include <nctl/StaticString.h>
 
+#if JOB_DEBUG_COUNTERS
+	#include "Clock.h"
+#endif
+
 #if JOB_DEBUG_TRACY_ZONES
 	#include "tracy.h"
 #endif
@@ -15,7 +19,70 @@ namespace {
 	nctl::StaticString<64> zoneTextString;
 #endif
 
-	JobId getJob(JobQueue *jobQueues, unsigned char numThreads)
+	/// True while the calling thread is executing a background job, and counts as one of the background threads
+	thread_local bool holdsBackgroundSlot = false;
+
+	/// The order in which a thread looks into the queues of the other threads to steal a job
+	nctl::Atomic32 currentStealPolicy(JobStealPolicy::TOPOLOGY);
+	/// For every thread, the indices of the other threads sorted by their distance in the CPU topology
+	const unsigned char *stealOrders = nullptr;
+
+#if JOB_DEBUG_COUNTERS
+	/// The time of the last signal of the queue semaphore, the wake-up latency of the workers is measured from it
+	nctl::AtomicU64 lastSignalTicks(0);
+
+	/// Converts clock ticks to nanoseconds without overflowing the intermediate product
+	uint64_t ticksToNanoseconds(uint64_t ticks)
+	{
+		const uint64_t frequency = clock().frequency();
+		return (ticks / frequency) * 1000000000ULL + ((ticks % frequency) * 1000000000ULL) / frequency;
+	}
+
+	/// Gathers the statistics of an idle worker that has acquired the queue semaphore
+	/*! \note The latency is measured from the start of the wait if the semaphore was already signaled before it. */
+	void gatherWakeUpStatistics(uint64_t idleStartTicks, uint64_t sleepStartTicks, uint64_t wakeUpTicks)
+	{
+		JobStatistics::JobSystemStats &stats = statsHelper->jobSystemStatsMut();
+		stats.addSpinTime(ticksToNanoseconds(sleepStartTicks - idleStartTicks));
+		stats.addSleepTime(ticksToNanoseconds(wakeUpTicks - sleepStartTicks));
+
+		uint64_t signalTicks = lastSignalTicks.load(nctl::MemoryModel::RELAXED);
+		if (signalTicks < idleStartTicks)
+			signalTicks = idleStartTicks;
+		stats.addWakeUpLatency(wakeUpTicks > signalTicks ? ticksToNanoseconds(wakeUpTicks - signalTicks) : 0);
+	}
+#endif
+
+	/// Returns the queue of the specified thread for jobs of the specified priority
+	inline JobQueue &jobQueue(JobQueue *jobQueues, unsigned char numThreads, unsigned int threadIndex, unsigned int priority)
+	{
+		return jobQueues[priority * numThreads + threadIndex];
+	}
+
+	/// Steals a job from the queues of the other threads, starting from the ones running on the nearest cores
+	JobId stealFromNearestThreads(JobQueue *jobQueues, unsigned char numThreads, unsigned char threadIndex)
+	{
+		const unsigned char *stealOrder = stealOrders + threadIndex * (numThreads - 1);
+		for (unsigned char i = 0; i < numThreads - 1; i++)
+		{
+			const unsigned char stealIndex = stealOrder[i];
+			JobId stolenJob = jobQueues[stealIndex].steal();
+			if (stolenJob != InvalidJobId)
+			{
+#if JOB_DEBUG_TRACY_ZONES
+				zoneTextString.format("Stolen from thread #%02d (nearest #%u), JobId: %u", stealIndex, i, stolenJob);
+				ZoneText(zoneTextString.data(), zoneTextString.length());
+#endif
+				statsHelper->jobSystemStatsMut().incrementJobsStolen();
+				return stolenJob;
+			}
+		}
+
+		return InvalidJobId;
+	}
+
+	/// Pops or steals a job from the queues of a single priority level
+	JobId getJobWithPriority(JobQueue *jobQueues, unsigned char numThreads)
 	{
 #if JOB_DEBUG_TRACY_ZONES
 		ZoneScoped;
@@ -36,6 +103,9 @@ namespace {
 			return jobId;
 		}
 
+		if (currentStealPolicy.load(nctl::MemoryModel::RELAXED) == JobStealPolicy::TOPOLOGY)
+			return stealFromNearestThreads(jobQueues, numThreads, threadIndex);
+
 		// Then try to steal from main thread's queue
 		if (threadIndex != mainThreadIndex)
 		{
@@ -77,7 +147,7 @@ namespace {
 		return InvalidJobId;
 	}
 
-	void finish(JobId jobId, JobPool &jobPool, JobQueue *jobQueues)
+	void finish(JobId jobId, JobPool &jobPool, JobQueue *jobQueues, unsigned char numThreads)
 	{
 #if JOB_DEBUG_TRACY_ZONES
 		ZoneScoped;
@@ -99,7 +169,7 @@ namespace {
 			{
 				JOB_LOG_DEP("Child %u finished, decrementing parent", jobId);
 				statsHelper->jobSystemStatsMut().incrementChildJobsFinished();
-				finish(job->parent, jobPool, jobQueues);
+				finish(job->parent, jobPool, jobQueues, numThreads);
 			}
 			else
 				statsHelper->jobSystemStatsMut().incrementParentJobsFinished();
@@ -108,7 +178,9 @@ namespace {
 			const uint16_t continuationCount = job->loadContinuationCount(nctl::MemoryModel::ACQUIRE);
 			for (uint16_t i = 0; i < continuationCount; i++)
 			{
-				jobQueues[JobSystem::threadIndex()].push(job->continuations[i]);
+				const Job *continuationJob = jobPool.retrieveJob(job->continuations[i]);
+				const unsigned int priority = (continuationJob != nullptr) ? continuationJob->priority : static_cast<uint8_t>(JobPriority::NORMAL);
+				jobQueue(jobQueues, numThreads, JobSystem::threadIndex(), priority).push(job->continuations[i]);
 				statsHelper->jobSystemStatsMut().incrementContinuationJobsPushed();
 			}
 
@@ -122,15 +194,18 @@ namespace {
 		}
 	}
 
-	void execute(JobId jobId, JobPool &jobPool, JobQueue *jobQueues)
+	/// Executes a job and returns its priority
+	JobPriority::Enum execute(JobId jobId, JobPool &jobPool, JobQueue *jobQueues, unsigned char numThreads)
 	{
 #if JOB_DEBUG_TRACY_ZONES
 		ZoneScoped;
 #endif
 
+		JobPriority::Enum priority = JobPriority::NORMAL;
 		Job *job = jobPool.retrieveJob(jobId);
 		if (job != nullptr)
 		{
+			priority = static_cast<JobPriority::Enum>(job->priority);
 			jobStatePoppedToExcuting(job, jobId); // Job debug state transition
 			statsHelper->jobSystemStatsMut().incrementJobsExecuted();
 
@@ -140,15 +215,17 @@ namespace {
 			{
 				// A job might have no function to execute
 				if (job->function != nullptr)
-					(job->function)(jobId, job->data);
+					(job->function)(jobId, job->functionData());
 
 #if JOB_DEBUG_TRACY_ZONES
 				zoneTextString.format("JobId: %u", jobId);
 				ZoneText(zoneTextString.data(), zoneTextString.length());
 #endif
 			}
-			finish(jobId, jobPool, jobQueues);
+			finish(jobId, jobPool, jobQueues, numThreads);
 		}
+
+		return priority;
 	}
 }
 
@@ -162,11 +239,16 @@ JobSystem::JobSystem()
 }
 
 JobSystem::JobSystem(unsigned char numThreads)
+    : JobSystem(numThreads, false)
+{
+}
+
+JobSystem::JobSystem(unsigned char numThreads, bool performanceCoresOnly)
     : IJobSystem(numThreads), commonData_(jobPool_, queueSem_)
 {
 	// Zero threads means automatic
 	if (numThreads_ == 0)
-		numThreads_ = cpuTopology_.numPhysicalCores();
+		numThreads_ = performanceCoresOnly ? cpuTopology_.numPhysicalCores(0) : cpuTopology_.numPhysicalCores();
 	if (numThreads > cpuTopology_.numTotalCores())
 		numThreads_ = cpuTopology_.numTotalCores();
 
@@ -174,18 +256,37 @@ JobSystem::JobSystem(unsigned char numThreads)
 	statsHelper = theJobStatistics().jobSystemStatsHelper();
 
 	jobPool_.initialize(numThreads_);
-	jobQueues_.setCapacity(numThreads_);
-	for (unsigned char i = 0; i < numThreads_; i++)
+	// One queue for every thread and priority level, grouped by priority
+	const unsigned int numQueues = numThreads_ * JobPriority::COUNT;
+	jobQueues_.setCapacity(numQueues);
+	for (unsigned int i = 0; i < numQueues; i++)
 		jobQueues_.emplaceBack();
 
 #if JOB_DEBUG_STATE
-	for (unsigned char i = 0; i < numThreads_; i++)
+	for (unsigned int i = 0; i < numQueues; i++)
 		jobQueues_[i].setJobPool(&jobPool_);
 #endif
 
+	// At least one worker thread is always left for the frame jobs, when there are at least two of them
+	const int32_t numWorkerThreads = numThreads_ - 1;
+	commonData_.maxBackgroundThreads = (numWorkerThreads > 1) ? numWorkerThreads - 1 : 1;
+
 	commonData_.numThreads = numThreads_;
 	commonData_.jobQueues = jobQueues_.data();
 
+	initStealOrders(performanceCoresOnly);
+	stealOrders = stealOrders_.data();
+	currentStealPolicy.store(JobStealPolicy::TOPOLOGY);
+
+#ifndef __EMSCRIPTEN__
+	ThreadAffinityMask performanceCoresMask;
+	for (unsigned int i = 0; i < cpuTopology_.numTotalCores(); i++)
+	{
+		if (cpuTopology_.cpuInfo(i).tier == 0)
+			performanceCoresMask.set(cpuTopology_.cpuInfo(i).id);
+	}
+#endif
+
 	threadStructs_.setCapacity(numThreads_ - 1); // Capacity needs to be set to avoid reallocation and pointer invalidation
 	threads_.setCapacity(numThreads_ - 1);
 	for (unsigned char i = 0; i < numThreads_ - 1; i++)
@@ -194,6 +295,14 @@ JobSystem::JobSystem(unsigned char numThreads)
 		threadStructs_.emplaceBack(commonData_);
 		threadStructs_.back().threadIndex = threadIndex;
 		threadStructs_.back().cpuId = cpuTopology_.cpuInfo(threadIndex).id;
+		// A thread that would be pinned to a slower core can run on any performance one instead
+		threadStructs_.back().anyPerformanceCore = (performanceCoresOnly && cpuTopology_.cpuInfo(threadIndex).tier > 0);
+#ifndef __EMSCRIPTEN__
+		if (threadStructs_.back().anyPerformanceCore)
+			threadStructs_.back().affinityMask = performanceCoresMask;
+		else
+			threadStructs_.back().affinityMask = ThreadAffinityMask(threadStructs_.back().cpuId);
+#endif
 
 		threads_.emplaceBack();
 		// Create a thread before setting its name and affinity mask
@@ -225,61 +334,16 @@ JobSystem::~JobSystem()
 
 /*! \warning Always check that the returned `JobId` is valid
  *  \note The `function` can be `nullptr` for synchronization-only jobs */
-JobId JobSystem::createJob(JobFunction function, const void *data, unsigned int dataSize)
+JobId JobSystem::createJob(JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority)
 {
-	return createJobAsChild(InvalidJobId, function, data, dataSize);
+	return createJobWithPriority(InvalidJobId, function, data, dataSize, priority);
 }
 
 /*! \warning Always check that the returned `JobId` is valid
  *  \note The `function` can be `nullptr` for synchronization-only jobs */
 JobId JobSystem::createJobAsChild(JobId parentId, JobFunction function, const void *data, unsigned int dataSize)
 {
-#if JOB_DEBUG_TRACY_ZONES
-	ZoneScoped;
-#endif
-
-	Job *parent = nullptr;
-	if (parentId != InvalidJobId)
-	{
-		parent = jobPool_.retrieveJob(parentId);
-		if (parent == nullptr)
-			return InvalidJobId;
-
-		const uint32_t state = parent->countersAndState.load(nctl::MemoryModel::ACQUIRE);
-		if ((state & Job::Flags::CANCELLED) != 0)
-			return InvalidJobId;
-
-#if JOB_DEBUG_TRACY_ZONES
-		zoneTextString.format("Parent: %u", parentId);
-		ZoneText(zoneTextString.data(), zoneTextString.length());
-#endif
-	}
-
-	Job *job = nullptr;
-	JobId jobId = jobPool_.allocateJob(&job);
-	if (jobId == InvalidJobId)
-		return InvalidJobId;
-
-	job->function = function;
-	job->parent = parentId;
-	job->countersAndState.store(0, nctl::MemoryModel::RELEASE);
-	job->incrementUnfinishedJobs();
-
-	if (data != nullptr && dataSize > 0)
-	{
-		FATAL_ASSERT(dataSize <= JobDataSize);
-		memcpy(job->data, data, dataSize);
-	}
-
-	if (parent != nullptr)
-	{
-		parent->incrementUnfinishedJobs();
-		statsHelper->jobSystemStatsMut().incrementChildJobsCreated();
-		JOB_LOG_DEP("Child job %u attached to parent %u", jobId, parentId);
-	}
-
-	statsHelper->jobSystemStatsMut().incrementJobsCreated();
-	return jobId;
+	return createJobWithPriority(parentId, function, data, dataSize, JobPriority::NORMAL);
 }
 
 bool JobSystem::addContinuation(JobId ancestorId, JobId continuationId)
@@ -323,6 +387,25 @@ bool JobSystem::addContinuation(JobId ancestorId, JobId continuationId)
 	return continuationAdded;
 }
 
+bool JobSystem::setPriority(JobId jobId, JobPriority::Enum priority)
+{
+	ASSERT(jobId != InvalidJobId);
+	if (jobId == InvalidJobId)
+		return false;
+
+	Job *job = jobPool_.retrieveJob(jobId);
+	if (job == nullptr)
+		return false;
+
+	// A submitted job is already in the queue of its priority
+	const uint32_t state = job->countersAndState.load(nctl::MemoryModel::ACQUIRE);
+	if ((state & Job::Flags::SUBMITTED) != 0)
+		return false;
+
+	job->priority = static_cast<uint8_t>(priority);
+	return true;
+}
+
 bool JobSystem::submit(JobId jobId)
 {
 	return (submit(&jobId, 1) == 1);
@@ -337,7 +420,7 @@ uint16_t JobSystem::submit(const JobId *jobIds, uint16_t count)
 	ASSERT(jobIds != nullptr);
 	ASSERT(count > 0);
 
-	JobQueue &queue = jobQueues_[threadIndex()];
+	const unsigned char threadIdx = threadIndex();
 	uint16_t numSubmitted = 0;
 
 	for (uint16_t i = 0; i < count; i++)
@@ -359,12 +442,17 @@ uint16_t JobSystem::submit(const JobId *jobIds, uint16_t count)
 		ZoneText(zoneTextString.data(), zoneTextString.length());
 #endif
 
-		queue.push(jobIds[i]);
+		jobQueue(jobQueues_.data(), numThreads_, threadIdx, job->priority).push(jobIds[i]);
 		numSubmitted++;
 	}
 
 	if (numSubmitted > 0)
+	{
+#if JOB_DEBUG_COUNTERS
+		lastSignalTicks.store(clock().now(), nctl::MemoryModel::RELAXED);
+#endif
 		queueSem_.signal(numSubmitted);
+	}
 
 	return numSubmitted;
 }
@@ -396,8 +484,13 @@ bool JobSystem::cancel(JobId jobId)
 			// If the job has not been submitted yet, we can free it immediately
 			if ((oldState & Job::Flags::SUBMITTED) == 0)
 			{
+				const JobId parentId = job->parent;
 				jobStateForceToFinished(job, jobId); // Job debug state transition
 				jobPool_.freeJob(jobId);
+
+				// The job will never be executed and finished, its parent would otherwise wait for it forever
+				if (parentId != InvalidJobId)
+					finish(parentId, jobPool_, jobQueues_.data(), numThreads_);
 			}
 
 #if JOB_DEBUG_TRACY_ZONES
@@ -432,6 +525,12 @@ void JobSystem::wait(JobId jobId)
 	ZoneText(zoneTextString.data(), zoneTextString.length());
 #endif
 
+	// Waiting on a job that is not a background one never executes a background job, as it might take a long time,
+	// unless there are no worker threads that could execute it
+	const bool withBackgroundJobs = (job->priority == JobPriority::BACKGROUND || numThreads_ == 1);
+	// A background job that waits, for example on its children, executes other background jobs in its own slot
+	const bool waitingInBackgroundJob = holdsBackgroundSlot;
+
 	unsigned int spinCount = 0;
 	unsigned int yieldCount = 0;
 	unsigned int spinDebugCount = 0;
@@ -444,10 +543,11 @@ void JobSystem::wait(JobId jobId)
 		if (unfinishedJobs == 0 || (state & Job::Flags::CANCELLED) != 0)
 			break;
 
-		JobId nextJob = getJob(jobQueues_.data(), numThreads_);
+		JobId nextJob = getJob(commonData_, withBackgroundJobs);
 		if (nextJob != InvalidJobId)
 		{
-			execute(nextJob, jobPool_, jobQueues_.data());
+			if (execute(nextJob, jobPool_, jobQueues_.data(), numThreads_) == JobPriority::BACKGROUND && waitingInBackgroundJob == false)
+				backgroundJobFinished(commonData_);
 			spinCount = 0;
 			yieldCount = 0;
 			spinDebugCount = 0;
@@ -494,15 +594,205 @@ uint16_t JobSystem::continuationCount(JobId jobId)
 	return job->loadContinuationCount(nctl::MemoryModel::ACQUIRE);
 }
 
+JobStealPolicy::Enum JobSystem::stealPolicy() const
+{
+	return static_cast<JobStealPolicy::Enum>(currentStealPolicy.load(nctl::MemoryModel::RELAXED));
+}
+
+void JobSystem::setStealPolicy(JobStealPolicy::Enum policy)
+{
+	ASSERT(policy < JobStealPolicy::COUNT);
+	if (policy < JobStealPolicy::COUNT)
+		currentStealPolicy.store(policy, nctl::MemoryModel::RELAXED);
+}
+
+/*! \note The new values are used by the workers the next time they become idle. */
+void JobSystem::setIdleBackoff(unsigned int spinCount, unsigned int yieldCount)
+{
+	commonData_.idleSpinCount.store(static_cast<int32_t>(spinCount), nctl::MemoryModel::RELAXED);
+	commonData_.idleYieldCount.store(static_cast<int32_t>(yieldCount), nctl::MemoryModel::RELAXED);
+}
+
 ///////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
+/*! \note Threads at the same distance are sorted starting from the next index, so that they do not all steal from the same one.
+ *  \note A thread that can run on any performance core is considered at the same tier distance from all the others. */
+void JobSystem::initStealOrders(bool performanceCoresOnly)
+{
+	if (numThreads_ < 2)
+		return;
+
+	stealOrders_.setCapacity(numThreads_ * (numThreads_ - 1));
+	for (unsigned int threadIndex = 0; threadIndex < numThreads_; threadIndex++)
+	{
+		const CpuTopology::CpuInfo &cpuInfo = cpuTopology_.cpuInfo(threadIndex);
+		const bool anyPerformanceCore = (performanceCoresOnly && cpuInfo.tier > 0);
+
+		for (unsigned int distance = 0; distance < CpuTopology::Distance::COUNT; distance++)
+		{
+			for (unsigned int i = 1; i < numThreads_; i++)
+			{
+				const unsigned int otherIndex = (threadIndex + i) % numThreads_;
+				const CpuTopology::CpuInfo &otherCpuInfo = cpuTopology_.cpuInfo(otherIndex);
+				const bool otherAnyPerformanceCore = (performanceCoresOnly && otherCpuInfo.tier > 0);
+
+				const CpuTopology::Distance::Enum otherDistance = (anyPerformanceCore || otherAnyPerformanceCore)
+				                                                      ? CpuTopology::Distance::SAME_TIER
+				                                                      : CpuTopology::distance(cpuInfo, otherCpuInfo);
+				if (otherDistance == distance)
+					stealOrders_.pushBack(static_cast<unsigned char>(otherIndex));
+			}
+		}
+	}
+}
+
+JobId JobSystem::createJobWithPriority(JobId parentId, JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority)
+{
+#if JOB_DEBUG_TRACY_ZONES
+	ZoneScoped;
+#endif
+
+	Job *parent = nullptr;
+	if (parentId != InvalidJobId)
+	{
+		parent = jobPool_.retrieveJob(parentId);
+		if (parent == nullptr)
+			return InvalidJobId;
+
+		const uint32_t state = parent->countersAndState.load(nctl::MemoryModel::ACQUIRE);
+		if ((state & Job::Flags::CANCELLED) != 0)
+			return InvalidJobId;
+
+#if JOB_DEBUG_TRACY_ZONES
+		zoneTextString.format("Parent: %u", parentId);
+		ZoneText(zoneTextString.data(), zoneTextString.length());
+#endif
+	}
+
+	Job *job = nullptr;
+	JobId jobId = jobPool_.allocateJob(&job);
+	if (jobId == InvalidJobId)
+		return InvalidJobId;
+
+	job->function = function;
+	job->parent = parentId;
+	// A child job has the same priority of its parent
+	job->priority = (parent != nullptr) ? parent->priority : static_cast<uint8_t>(priority);
+	job->countersAndState.store(0, nctl::MemoryModel::RELEASE);
+	job->incrementUnfinishedJobs();
+
+	jobPool_.copyJobData(job, data, dataSize);
+
+	if (parent != nullptr)
+	{
+		parent->incrementUnfinishedJobs();
+		statsHelper->jobSystemStatsMut().incrementChildJobsCreated();
+		JOB_LOG_DEP("Child job %u attached to parent %u", jobId, parentId);
+	}
+
+	statsHelper->jobSystemStatsMut().incrementJobsCreated();
+	return jobId;
+}
+
+/*! \note A background job is never returned if the caller is not allowed to execute one,
+ *  or if too many threads are already executing one, so that some are always left for the frame jobs.
+ *  \note A thread that is already executing a background job does not need another slot to execute a nested one while it waits. */
+JobId JobSystem::getJob(CommonThreadDataStruct &commonData, bool withBackgroundJobs)
+{
+	JobQueue *jobQueues = commonData.jobQueues;
+	const unsigned char numThreads = commonData.numThreads;
+
+	for (unsigned int priority = JobPriority::HIGH; priority < JobPriority::BACKGROUND; priority++)
+	{
+		const JobId jobId = getJobWithPriority(jobQueues + priority * numThreads, numThreads);
+		if (jobId != InvalidJobId)
+			return jobId;
+	}
+
+	if (withBackgroundJobs)
+	{
+		if (holdsBackgroundSlot)
+			return getJobWithPriority(jobQueues + JobPriority::BACKGROUND * numThreads, numThreads);
+
+		// The thread counts as a background one before looking for a job, so that the limit is never exceeded
+		if (commonData.numBackgroundThreads.fetchAdd(1) < commonData.maxBackgroundThreads)
+		{
+			const JobId jobId = getJobWithPriority(jobQueues + JobPriority::BACKGROUND * numThreads, numThreads);
+			if (jobId != InvalidJobId)
+			{
+				holdsBackgroundSlot = true;
+				return jobId;
+			}
+		}
+		commonData.numBackgroundThreads.fetchSub(1);
+	}
+
+	return InvalidJobId;
+}
+
+/*! \note The semaphore is signaled as a worker might have left a background job in the queues because of the limit. */
+void JobSystem::backgroundJobFinished(CommonThreadDataStruct &commonData)
+{
+	holdsBackgroundSlot = false;
+	commonData.numBackgroundThreads.fetchSub(1);
+	commonData.queueSem.signal(1);
+}
+
+/*! \note Spinning and yielding avoid the wake-up latency of the semaphore on bursts of small jobs,
+ *  while sleeping after a bounded number of attempts avoids wasting power when there is no work. */
+void JobSystem::waitForJobs(const CommonThreadDataStruct &commonData)
+{
+	SemType &queueSem = commonData.queueSem;
+	const int32_t spinCount = commonData.idleSpinCount.load(nctl::MemoryModel::RELAXED);
+	const int32_t yieldCount = commonData.idleYieldCount.load(nctl::MemoryModel::RELAXED);
+#if JOB_DEBUG_COUNTERS
+	const uint64_t idleStartTicks = clock().now();
+#endif
+
+	for (int32_t i = 0; i < spinCount; i++)
+	{
+		if (queueSem.tryWait())
+		{
+#if JOB_DEBUG_COUNTERS
+			const uint64_t wakeUpTicks = clock().now();
+			statsHelper->jobSystemStatsMut().incrementSpinWakeUps();
+			gatherWakeUpStatistics(idleStartTicks, wakeUpTicks, wakeUpTicks);
+#endif
+			return;
+		}
+		ThisThread::relax();
+	}
+
+	for (int32_t i = 0; i < yieldCount; i++)
+	{
+		if (queueSem.tryWait())
+		{
+#if JOB_DEBUG_COUNTERS
+			const uint64_t wakeUpTicks = clock().now();
+			statsHelper->jobSystemStatsMut().incrementYieldWakeUps();
+			gatherWakeUpStatistics(idleStartTicks, wakeUpTicks, wakeUpTicks);
+#endif
+			return;
+		}
+		ThisThread::yield();
+	}
+
+#if JOB_DEBUG_COUNTERS
+	const uint64_t sleepStartTicks = clock().now();
+#endif
+	queueSem.wait();
+#if JOB_DEBUG_COUNTERS
+	statsHelper->jobSystemStatsMut().incrementSleepWakeUps();
+	gatherWakeUpStatistics(idleStartTicks, sleepStartTicks, clock().now());
+#endif
+}
+
 void JobSystem::workerFunction(void *arg)
 {
 	const ThreadStruct *threadStruct = static_cast<const ThreadStruct *>(arg);
 	const unsigned char numThreads = threadStruct->commonData.numThreads;
-	SemType &queueSem = threadStruct->commonData.queueSem;
 	JobPool &jobPool = threadStruct->commonData.jobPool;
 	JobQueue *jobQueues = threadStruct->commonData.jobQueues;
 
@@ -511,27 +801,34 @@ void JobSystem::workerFunction(void *arg)
 	threadName.format("WorkerThread#%02d", threadStruct->threadIndex);
 #ifndef __EMSCRIPTEN__
 	ThisThread::setName(threadName.data());
-	ThisThread::setAffinityMask(ThreadAffinityMask(threadStruct->cpuId));
+	ThisThread::setAffinityMask(threadStruct->affinityMask);
 #endif
 
-	LOGI_X("WorkerThread#%02d (id: %lu) is starting on CPU#%02u", threadStruct->threadIndex, ThisThread::threadId(), threadStruct->cpuId);
+	if (threadStruct->anyPerformanceCore)
+		LOGI_X("WorkerThread#%02d (id: %lu) is starting on any performance core", threadStruct->threadIndex, ThisThread::threadId());
+	else
+		LOGI_X("WorkerThread#%02d (id: %lu) is starting on CPU#%02u", threadStruct->threadIndex, ThisThread::threadId(), threadStruct->cpuId);
 
 	while (true)
 	{
 		// Wait until a job is available or we are asked to quit
-		queueSem.wait();
+		waitForJobs(threadStruct->commonData);
 
 		if (threadStruct->shouldQuit)
 			break;
 
-		JobId jobId = getJob(jobQueues, numThreads);
+		JobId jobId = getJob(threadStruct->commonData, true);
 		if (jobId == InvalidJobId)
 			continue; // Spurious wake-up or nothing to steal, just wait again
 
-		execute(jobId, jobPool, jobQueues);
+		if (execute(jobId, jobPool, jobQueues, numThreads) == JobPriority::BACKGROUND)
+			backgroundJobFinished(threadStruct->commonData);
 	}
 
-	LOGI_X("WorkerThread#%02d (id: %lu) on CPU#%02u is exiting", threadStruct->threadIndex, ThisThread::threadId(), threadStruct->cpuId);
+	if (threadStruct->anyPerformanceCore)
+		LOGI_X("WorkerThread#%02d (id: %lu) on any performance core is exiting", threadStruct->threadIndex, ThisThread::threadId());
+	else
+		LOGI_X("WorkerThread#%02d (id: %lu) on CPU#%02u is exiting", threadStruct->threadIndex, ThisThread::threadId(), threadStruct->cpuId);
 }
 
 }
@@ -271,6 +271,15 @@ void ThisThread::yield()
 #endif
 }
 
+void ThisThread::relax()
+{
+#if defined(__i386__) || defined(__x86_64__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7)
+	__asm__ __volatile__("yield");
+#endif
+}
+
 [[noreturn]] void ThisThread::exit()
 {
 	pthread_exit(nullptr);
@@ -174,7 +174,7 @@ UserSemaphore::UserSemaphore()
 
 	#if !defined(__APPLE__)
 UserSemaphore::UserSemaphore(int initialCount)
-    : count_(initialCount)
+    : count_(initialCount), wakeUps_(0)
 {
 }
 	#else
@@ -210,22 +210,17 @@ void UserSemaphore::wait()
 {
 	const int32_t c = count_.fetchSub(1, nctl::MemoryModel::ACQUIRE);
 	if (c <= 0)
-	{
-		while (true)
-		{
-			const int32_t expected = count_.load(nctl::MemoryModel::RELAXED);
-			if (expected >= 0)
-				break;
-			futexWait(reinterpret_cast<int *>(&count_), expected);
-		}
-	}
+		consumeWakeUps(1);
 }
 
 void UserSemaphore::signal()
 {
 	const int32_t c = count_.fetchAdd(1, nctl::MemoryModel::RELEASE);
 	if (c < 0)
-		futexWake(reinterpret_cast<int *>(&count_), 1);
+	{
+		wakeUps_.fetchAdd(1, nctl::MemoryModel::RELEASE);
+		futexWake(reinterpret_cast<int *>(&wakeUps_), 1);
+	}
 }
 
 bool UserSemaphore::tryWait()
@@ -243,23 +238,43 @@ void UserSemaphore::wait(unsigned int count)
 {
 	const int32_t c = count_.fetchSub(count, nctl::MemoryModel::ACQUIRE);
 	if (c < static_cast<int32_t>(count))
-	{
-		while (true)
-		{
-			const int32_t expected = count_.load(nctl::MemoryModel::RELAXED);
-			if (expected >= 0)
-				break;
-			futexWait(reinterpret_cast<int *>(&count_), expected);
-		}
-	}
+		consumeWakeUps(static_cast<int32_t>(count) - (c > 0 ? c : 0));
 }
 
+/*! \note Only the resources that were waited for are handed out as wake-ups, the rest stay available in the count. */
 void UserSemaphore::signal(unsigned int count)
 {
 	const int32_t c = count_.fetchAdd(count, nctl::MemoryModel::RELEASE);
 	if (c < 0)
-		futexWake(reinterpret_cast<int *>(&count_), count);
+	{
+		const int32_t numWakeUps = (-c < static_cast<int32_t>(count)) ? -c : static_cast<int32_t>(count);
+		wakeUps_.fetchAdd(numWakeUps, nctl::MemoryModel::RELEASE);
+		futexWake(reinterpret_cast<int *>(&wakeUps_), numWakeUps);
+	}
 }
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note Every waiter consumes its own wake-ups, so a thread woken up cannot take the place of another one that is still sleeping. */
+void UserSemaphore::consumeWakeUps(int32_t numWakeUps)
+{
+	while (numWakeUps > 0)
+	{
+		int32_t available = wakeUps_.load(nctl::MemoryModel::ACQUIRE);
+		if (available == 0)
+		{
+			futexWait(reinterpret_cast<int *>(&wakeUps_), 0);
+			continue;
+		}
+
+		const int32_t consumed = (available < numWakeUps) ? available : numWakeUps;
+		if (wakeUps_.cmpExchange(available, available - consumed, nctl::MemoryModel::ACQUIRE))
+			numWakeUps -= consumed;
+	}
+}
+
 	#else
 void UserSemaphore::wait()
 {
@@ -8,8 +8,7 @@
 
 namespace ncine {
 
-static_assert(MaxNumJobs > 1 && (MaxNumJobs & (MaxNumJobs - 1)) == 0, "The number of jobs needs to be a power of two for the mask to work");
-static const unsigned int Mask = MaxNumJobs - 1u;
+static_assert(JobPoolBlockSize > 1 && (JobPoolBlockSize & (JobPoolBlockSize - 1)) == 0, "The capacity of the queue needs to be a power of two for the mask to work");
 
 namespace {
 #if JOB_DEBUG_TRACY_ZONES
@@ -23,14 +22,11 @@ namespace {
 
 SerialJobSystem::SerialJobSystem()
     : IJobSystem(1),
-      freeList_(nctl::StaticArrayMode::EXTEND_SIZE),
-      top_(0), bottom_(0)
+      top_(0), bottom_(0), queueCapacity_(JobPoolBlockSize),
+      jobQueue_(nctl::makeUnique<JobId[]>(JobPoolBlockSize))
 {
-	// Initialize the free list with all job indices (backwards)
-	for (unsigned int i = 0; i < MaxNumJobs; i++)
-		freeList_[i] = MaxNumJobs - 1 - i;
-
 	theJobStatistics().initialize(numThreads_);
+	jobPool_.initialize(numThreads_);
 }
 
 ///////////////////////////////////////////////////////////
@@ -39,61 +35,16 @@ SerialJobSystem::SerialJobSystem()
 
 /*! \warning Always check that the returned `JobId` is valid
  *  \note The `function` can be `nullptr` for synchronization-only jobs */
-JobId SerialJobSystem::createJob(JobFunction function, const void *data, unsigned int dataSize)
+JobId SerialJobSystem::createJob(JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority)
 {
-	return createJobAsChild(InvalidJobId, function, data, dataSize);
+	return createJobWithPriority(InvalidJobId, function, data, dataSize, priority);
 }
 
 /*! \warning Always check that the returned `JobId` is valid
  *  \note The `function` can be `nullptr` for synchronization-only jobs */
 JobId SerialJobSystem::createJobAsChild(JobId parentId, JobFunction function, const void *data, unsigned int dataSize)
 {
-#if JOB_DEBUG_TRACY_ZONES
-	ZoneScoped;
-#endif
-
-	Job *parent = nullptr;
-	if (parentId != InvalidJobId)
-	{
-		parent = retrieveJob(parentId);
-		if (parent == nullptr)
-			return InvalidJobId;
-
-		const uint32_t state = parent->countersAndState.load(nctl::MemoryModel::ACQUIRE);
-		if ((state & Job::Flags::CANCELLED) != 0)
-			return InvalidJobId;
-
-#if JOB_DEBUG_TRACY_ZONES
-		zoneTextString.format("Parent: %u", parentId);
-		ZoneText(zoneTextString.data(), zoneTextString.length());
-#endif
-	}
-
-	Job *job = nullptr;
-	JobId jobId = allocateJob(&job);
-	if (jobId == InvalidJobId)
-		return InvalidJobId;
-
-	job->function = function;
-	job->parent = parentId;
-	job->countersAndState.store(0, nctl::MemoryModel::RELEASE);
-	job->incrementUnfinishedJobs();
-
-	if (data != nullptr && dataSize > 0)
-	{
-		FATAL_ASSERT(dataSize <= JobDataSize);
-		memcpy(job->data, data, dataSize);
-	}
-
-	if (parent != nullptr)
-	{
-		parent->incrementUnfinishedJobs();
-		theJobStatistics().jobSystemStatsMut().incrementChildJobsCreated();
-		JOB_LOG_DEP("Child job %u attached to parent %u", jobId, parentId);
-	}
-
-	theJobStatistics().jobSystemStatsMut().incrementJobsCreated();
-	return jobId;
+	return createJobWithPriority(parentId, function, data, dataSize, JobPriority::NORMAL);
 }
 
 bool SerialJobSystem::addContinuation(JobId ancestorId, JobId continuationId)
@@ -105,10 +56,10 @@ bool SerialJobSystem::addContinuation(JobId ancestorId, JobId continuationId)
 	if (ancestorId == InvalidJobId || continuationId == InvalidJobId)
 		return false;
 
-	Job *ancestorJob = retrieveJob(ancestorId);
+	Job *ancestorJob = jobPool_.retrieveJob(ancestorId);
 	if (ancestorJob == nullptr)
 		return false;
-	Job *continuationJob =  retrieveJob(continuationId);
+	Job *continuationJob =  jobPool_.retrieveJob(continuationId);
 	if (continuationJob == nullptr)
 		return false;
 
@@ -133,6 +84,25 @@ bool SerialJobSystem::addContinuation(JobId ancestorId, JobId continuationId)
 	return continuationAdded;
 }
 
+bool SerialJobSystem::setPriority(JobId jobId, JobPriority::Enum priority)
+{
+	ASSERT(jobId != InvalidJobId);
+	if (jobId == InvalidJobId)
+		return false;
+
+	Job *job = jobPool_.retrieveJob(jobId);
+	if (job == nullptr)
+		return false;
+
+	// The priority of a job cannot change after its submission, like in the multi-threaded job system
+	const uint32_t state = job->countersAndState.load(nctl::MemoryModel::ACQUIRE);
+	if ((state & Job::Flags::SUBMITTED) != 0)
+		return false;
+
+	job->priority = static_cast<uint8_t>(priority);
+	return true;
+}
+
 bool SerialJobSystem::submit(JobId jobId)
 {
 	return (submit(&jobId, 1) == 1);
@@ -154,7 +124,7 @@ uint16_t SerialJobSystem::submit(const JobId *jobIds, uint16_t count)
 		if (jobIds[i] == InvalidJobId)
 			continue;
 
-		Job *job = retrieveJob(jobIds[i]);
+		Job *job = jobPool_.retrieveJob(jobIds[i]);
 		if (job == nullptr)
 			continue;
 
@@ -184,7 +154,7 @@ bool SerialJobSystem::cancel(JobId jobId)
 	if (jobId == InvalidJobId)
 		return false;
 
-	Job *job = retrieveJob(jobId);
+	Job *job = jobPool_.retrieveJob(jobId);
 	if (job == nullptr)
 		return false;
 
@@ -201,8 +171,13 @@ bool SerialJobSystem::cancel(JobId jobId)
 			// If the job has not been submitted yet, we can free it immediately
 			if ((oldState & Job::Flags::SUBMITTED) == 0)
 			{
+				const JobId parentId = job->parent;
 				jobStateForceToFinished(job, jobId); // Job debug state transition
-				freeJob(jobId);
+				jobPool_.freeJob(jobId);
+
+				// The job will never be executed and finished, its parent would otherwise wait for it forever
+				if (parentId != InvalidJobId)
+					finish(parentId, *this);
 			}
 
 #if JOB_DEBUG_TRACY_ZONES
@@ -226,7 +201,7 @@ void SerialJobSystem::wait(JobId jobId)
 	if (jobId == InvalidJobId)
 		return;
 
-	Job *job = retrieveJob(jobId);
+	Job *job = jobPool_.retrieveJob(jobId);
 	// Not asserting here as a valid job may complete and be recycled before
 	// the caller reaches `wait()`, so `retrieveJob()` can return `nullptr`.
 	if (job == nullptr)
@@ -257,7 +232,7 @@ uint16_t SerialJobSystem::unfinishedJobs(JobId jobId)
 	if (jobId == InvalidJobId)
 		return 0;
 
-	Job *job = retrieveJob(jobId);
+	Job *job = jobPool_.retrieveJob(jobId);
 	return job->loadUnfinishedJobs(nctl::MemoryModel::ACQUIRE);
 }
 
@@ -267,7 +242,7 @@ uint16_t SerialJobSystem::continuationCount(JobId jobId)
 	if (jobId == InvalidJobId)
 		return 0;
 
-	Job *job = retrieveJob(jobId);
+	Job *job = jobPool_.retrieveJob(jobId);
 	return job->loadContinuationCount(nctl::MemoryModel::ACQUIRE);
 }
 
@@ -275,79 +250,74 @@ uint16_t SerialJobSystem::continuationCount(JobId jobId)
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
-JobId SerialJobSystem::allocateJob(Job **newJob)
+JobId SerialJobSystem::createJobWithPriority(JobId parentId, JobFunction function, const void *data, unsigned int dataSize, JobPriority::Enum priority)
 {
-	if (freeList_.isEmpty() == false)
-	{
-		const uint16_t index = freeList_.back();
-		freeList_.popBack();
-		Job &job = jobPool_[index];
-
-		JobId jobId = Job::makeJobId(index, job.generation);
-		FATAL_ASSERT_MSG(jobId != InvalidJobId, "Generated an invalid job id");
-		if (newJob != nullptr)
-			*newJob = &job;
-
-		JOB_LOG_POOL_ALLOC(jobId, index, job.generation);
-		theJobStatistics().jobPoolStatsMut().incrementJobsAllocated();
-		return jobId;
-	}
-	else
-	{
-		theJobStatistics().jobPoolStatsMut().incrementJobAllocationFails();
-		return InvalidJobId;
-	}
-}
+#if JOB_DEBUG_TRACY_ZONES
+	ZoneScoped;
+#endif
 
-void SerialJobSystem::freeJob(JobId jobId)
-{
-	const uint16_t index = Job::unpackIndex(jobId);
-	ASSERT(index < MaxNumJobs);
+	Job *parent = nullptr;
+	if (parentId != InvalidJobId)
+	{
+		parent = jobPool_.retrieveJob(parentId);
+		if (parent == nullptr)
+			return InvalidJobId;
 
-	Job *job = &jobPool_[index];
-	jobStateFinishedToFree(job, jobId);
-	JOB_LOG_POOL_FREE(jobId, index, job->generation);
+		const uint32_t state = parent->countersAndState.load(nctl::MemoryModel::ACQUIRE);
+		if ((state & Job::Flags::CANCELLED) != 0)
+			return InvalidJobId;
 
-	job->function = nullptr;
-	job->parent = InvalidJobId;
-	job->countersAndState.store(0, nctl::MemoryModel::RELEASE);
-	job->generation++;
+#if JOB_DEBUG_TRACY_ZONES
+		zoneTextString.format("Parent: %u", parentId);
+		ZoneText(zoneTextString.data(), zoneTextString.length());
+#endif
+	}
 
-	freeList_.pushBack(index);
-	theJobStatistics().jobPoolStatsMut().incrementJobsFreed();
-}
+	Job *job = nullptr;
+	JobId jobId = jobPool_.allocateJob(&job);
+	if (jobId == InvalidJobId)
+		return InvalidJobId;
 
-Job *SerialJobSystem::retrieveJob(JobId jobId)
-{
-	ASSERT(jobId != InvalidJobId);
+	job->function = function;
+	job->parent = parentId;
+	// A child job has the same priority of its parent
+	job->priority = (parent != nullptr) ? parent->priority : static_cast<uint8_t>(priority);
+	job->countersAndState.store(0, nctl::MemoryModel::RELEASE);
+	job->incrementUnfinishedJobs();
 
-	const uint16_t index = Job::unpackIndex(jobId);
-	if (jobId == InvalidJobId || index >= MaxNumJobs)
-	{
-		theJobStatistics().jobPoolStatsMut().incrementJobRetrievalFails();
-		return nullptr;
-	}
+	jobPool_.copyJobData(job, data, dataSize);
 
-	Job *job = &jobPool_[index];
-	if (job->generation == Job::unpackGeneration(jobId))
+	if (parent != nullptr)
 	{
-		theJobStatistics().jobPoolStatsMut().incrementJobsRetrieved();
-		return job;
+		parent->incrementUnfinishedJobs();
+		theJobStatistics().jobSystemStatsMut().incrementChildJobsCreated();
+		JOB_LOG_DEP("Child job %u attached to parent %u", jobId, parentId);
 	}
 
-	theJobStatistics().jobPoolStatsMut().incrementJobRetrievalFails();
-	return nullptr;
+	theJobStatistics().jobSystemStatsMut().incrementJobsCreated();
+	return jobId;
 }
 
 void SerialJobSystem::pushJob(JobId jobId)
 {
-	const unsigned int nextBottom = (bottom_ + 1) & Mask;
-	if (nextBottom == (top_ & Mask))
-		return; // Job queue overflow
+	if (bottom_ - top_ == queueCapacity_)
+	{
+		// The queue is full, the jobs are moved in order to a new one with double the capacity
+		const unsigned int newCapacity = queueCapacity_ * 2;
+		nctl::UniquePtr<JobId[]> newJobQueue = nctl::makeUnique<JobId[]>(newCapacity);
+		for (unsigned int i = top_; i != bottom_; i++)
+			newJobQueue[i - top_] = jobQueue_[i & (queueCapacity_ - 1)];
+
+		bottom_ -= top_;
+		top_ = 0;
+		queueCapacity_ = newCapacity;
+		jobQueue_ = nctl::move(newJobQueue);
+	}
 
-	jobQueue_[bottom_ & Mask] = jobId;
+	const unsigned int nextBottom = bottom_ + 1;
+	jobQueue_[bottom_ & (queueCapacity_ - 1)] = jobId;
 
-	jobStateFreeToPushed(retrieveJob(jobId), jobId); // Job debug state transition
+	jobStateFreeToPushed(jobPool_.retrieveJob(jobId), jobId); // Job debug state transition
 	JOB_LOG_QUEUE_PUSH(jobId, Job::unpackIndex(jobId), Job::unpackGeneration(jobId), bottom_);
 	theJobStatistics().jobQueueStatsMut().incrementPushes();
 
@@ -362,10 +332,10 @@ JobId SerialJobSystem::popJob()
 		return InvalidJobId;
 	}
 
-	JobId jobId = jobQueue_[top_ & Mask];
-	top_ = (top_ + 1) & Mask;
+	JobId jobId = jobQueue_[top_ & (queueCapacity_ - 1)];
+	top_++;
 
-	jobStatePushedToPopped(retrieveJob(jobId), jobId); // Job debug state transition
+	jobStatePushedToPopped(jobPool_.retrieveJob(jobId), jobId); // Job debug state transition
 	JOB_LOG_QUEUE_POP(jobId, Job::unpackIndex(jobId), Job::unpackGeneration(jobId), bottom_, top_);
 	theJobStatistics().jobQueueStatsMut().incrementPops();
 
@@ -382,7 +352,7 @@ void SerialJobSystem::finish(JobId jobId, SerialJobSystem &jobSystem)
 	if (jobId == InvalidJobId)
 		return;
 
-	Job *job = jobSystem.retrieveJob(jobId);
+	Job *job = jobSystem.jobPool_.retrieveJob(jobId);
 	if (job == nullptr)
 		return;
 
@@ -413,7 +383,7 @@ void SerialJobSystem::finish(JobId jobId, SerialJobSystem &jobSystem)
 #endif
 		jobStateExcutingToFinished(job, jobId); // Job debug state transition
 		theJobStatistics().jobSystemStatsMut().incrementJobsFinished();
-		jobSystem.freeJob(jobId);
+		jobSystem.jobPool_.freeJob(jobId);
 	}
 }
 
@@ -423,7 +393,7 @@ void SerialJobSystem::execute(JobId jobId, SerialJobSystem &jobSystem)
 		ZoneScoped;
 #endif
 
-	Job *job = jobSystem.retrieveJob(jobId);
+	Job *job = jobSystem.jobPool_.retrieveJob(jobId);
 	if (job != nullptr)
 	{
 		jobStatePoppedToExcuting(job, jobId); // Job debug state transition
@@ -435,7 +405,7 @@ void SerialJobSystem::execute(JobId jobId, SerialJobSystem &jobSystem)
 		{
 			// A job might have no function to execute
 			if (job->function != nullptr)
-				(job->function)(jobId, job->data);
+				(job->function)(jobId, job->functionData());
 
 #if JOB_DEBUG_TRACY_ZONES
 			zoneTextString.format("JobId: %u", jobId);
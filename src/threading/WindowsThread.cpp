@@ -197,6 +197,11 @@ void ThisThread::yield()
 	SwitchToThread();
 }
 
+void ThisThread::relax()
+{
+	YieldProcessor();
+}
+
 [[noreturn]] void ThisThread::exit()
 {
 	_endthreadex(0);
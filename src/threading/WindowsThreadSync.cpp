@@ -163,7 +163,7 @@ UserSemaphore::UserSemaphore()
 }
 
 UserSemaphore::UserSemaphore(int initialCount)
-    : count_(initialCount)
+    : count_(initialCount), wakeUps_(0)
 {
 }
 
@@ -175,21 +175,17 @@ void UserSemaphore::wait()
 {
 	const int32_t c = count_.fetchSub(1, nctl::MemoryModel::ACQUIRE);
 	if (c <= 0)
-	{
-		int32_t expected = c - 1;
-		while (count_.load(nctl::MemoryModel::RELAXED) < 0)
-		{
-			WaitOnAddress(&count_, &expected, sizeof(expected), INFINITE);
-			expected = count_.load(nctl::MemoryModel::RELAXED);
-		}
-	}
+		consumeWakeUps(1);
 }
 
 void UserSemaphore::signal()
 {
 	const int32_t c = count_.fetchAdd(1, nctl::MemoryModel::RELEASE);
 	if (c < 0)
-		WakeByAddressSingle(&count_);
+	{
+		wakeUps_.fetchAdd(1, nctl::MemoryModel::RELEASE);
+		WakeByAddressSingle(&wakeUps_);
+	}
 }
 
 bool UserSemaphore::tryWait()
@@ -207,21 +203,45 @@ void UserSemaphore::wait(unsigned int count)
 {
 	const int32_t c = count_.fetchSub(count, nctl::MemoryModel::ACQUIRE);
 	if (c < static_cast<int32_t>(count))
-	{
-		int32_t expected = count_.load(nctl::MemoryModel::RELAXED);
-		while (count_.load(nctl::MemoryModel::RELAXED) < 0)
-		{
-			WaitOnAddress(&count_, &expected, sizeof(expected), INFINITE);
-			expected = count_.load(nctl::MemoryModel::RELAXED);
-		}
-	}
+		consumeWakeUps(static_cast<int32_t>(count) - (c > 0 ? c : 0));
 }
 
+/*! \note Only the resources that were waited for are handed out as wake-ups, the rest stay available in the count. */
 void UserSemaphore::signal(unsigned int count)
 {
 	const int32_t c = count_.fetchAdd(count, nctl::MemoryModel::RELEASE);
 	if (c < 0)
-		WakeByAddressAll(&count_);
+	{
+		const int32_t numWakeUps = (-c < static_cast<int32_t>(count)) ? -c : static_cast<int32_t>(count);
+		wakeUps_.fetchAdd(numWakeUps, nctl::MemoryModel::RELEASE);
+		if (numWakeUps == 1)
+			WakeByAddressSingle(&wakeUps_);
+		else
+			WakeByAddressAll(&wakeUps_);
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note Every waiter consumes its own wake-ups, so a thread woken up cannot take the place of another one that is still sleeping. */
+void UserSemaphore::consumeWakeUps(int32_t numWakeUps)
+{
+	int32_t noWakeUps = 0;
+	while (numWakeUps > 0)
+	{
+		int32_t available = wakeUps_.load(nctl::MemoryModel::ACQUIRE);
+		if (available == 0)
+		{
+			WaitOnAddress(&wakeUps_, &noWakeUps, sizeof(noWakeUps), INFINITE);
+			continue;
+		}
+
+		const int32_t consumed = (available < numWakeUps) ? available : numWakeUps;
+		if (wakeUps_.cmpExchange(available, available - consumed, nctl::MemoryModel::ACQUIRE))
+			numWakeUps -= consumed;
+	}
 }
 #endif
 
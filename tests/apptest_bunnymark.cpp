@@ -84,6 +84,7 @@ void MyEventHandler::onInit()
 	const unsigned int refreshRate = static_cast<unsigned int>(nc::theApplication().gfxDevice().currentVideoMode().refreshRate);
 	const unsigned int numFrames = nctl::min(refreshRate * MaxStatsSeconds, MaxStatsFrames);
 	frameStats_.setCapacity(numFrames);
+	updateStats_.setCapacity(numFrames);
 
 	nc::theApplication().screenViewport().setClearColor(0.392f, 0.584f, 0.929f, 1.0f);
 
@@ -148,6 +149,13 @@ void MyEventHandler::onFrameStart()
 			ImGui::Checkbox("Instancing", &instancingEnabled);
 			nc::theApplication().renderingSettings().instancingEnabled = instancingEnabled;
 
+	#if NCINE_WITH_JOBSYSTEM
+			ImGui::SameLine();
+			bool parallelUpdateEnabled = nc::theApplication().renderingSettings().parallelUpdateEnabled;
+			ImGui::Checkbox("Parallel update", &parallelUpdateEnabled);
+			nc::theApplication().renderingSettings().parallelUpdateEnabled = parallelUpdateEnabled;
+	#endif
+
 	#ifndef __ANDROID__
 			ImGui::SameLine();
 			ImGui::Checkbox("V-Sync", &withVSync_);
@@ -190,16 +198,25 @@ void MyEventHandler::onFrameStart()
 				appendSize = (appendSize <= transforms_.size()) ? appendSize : transforms_.size();
 				setNumBunnies(transforms_.size() - appendSize);
 			}
+			if (ImGui::Button("10K bunnies"))
+				setNumBunnies(10000);
+			ImGui::SameLine();
+			if (ImGui::Button("100K bunnies"))
+				setNumBunnies(100000);
 
 			if (ImGui::TreeNodeEx("Statistics", ImGuiTreeNodeFlags_DefaultOpen))
 			{
 				// If the tree node is closed, no statistics are collected
 				const float frameTimeMs = frameTimer.lastFrameTime() * 1000;
 				frameStats_.addValueWrap(frameTimeMs);
+				// The scenegraph update timing of the previous frame, to compare the serial and the parallel update
+				const float updateTimeMs = nc::theApplication().timings()[nc::Application::Timings::UPDATE] * 1000;
+				updateStats_.addValueWrap(updateTimeMs);
 
 				static nc::TimeStamp timestamp = nc::TimeStamp::now();
 				static bool sorted = false;
 				ImGui::PlotHistogram("Frame time", frameStats_.values(sorted), frameStats_.size(), 0, nullptr, 0.0f, frameStats_.maximum() * 1.1f);
+				ImGui::PlotHistogram("Update time", updateStats_.values(sorted), updateStats_.size(), 0, nullptr, 0.0f, updateStats_.maximum() * 1.1f);
 
 				ImGui::Checkbox("Sorted", &sorted);
 				ImGui::SameLine();
@@ -207,6 +224,8 @@ void MyEventHandler::onFrameStart()
 				{
 					frameStats_.clearValues();
 					frameStats_.resetStats();
+					updateStats_.clearValues();
+					updateStats_.resetStats();
 				}
 				ImGui::SameLine();
 				static float updateStats = 1.0f;
@@ -216,38 +235,50 @@ void MyEventHandler::onFrameStart()
 				if (timestamp.secondsSince() >= updateStats)
 				{
 					frameStats_.calculateStats();
+					updateStats_.calculateStats();
 					timestamp.toNow();
 				}
 
-				if (ImGui::BeginTable("FrameTimingsTable", 2, ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable |
+				if (ImGui::BeginTable("FrameTimingsTable", 3, ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable |
 				                      ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchProp))
 				{
 					ImGui::TableSetupScrollFreeze(0, 1);
 					ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_NoReorder | ImGuiTableColumnFlags_NoHide);
-					ImGui::TableSetupColumn("Timings");
+					ImGui::TableSetupColumn("Frame");
+					ImGui::TableSetupColumn("Update");
 					ImGui::TableHeadersRow();
 
 					ImGui::TableNextRow();
 					ImGui::TableNextColumn(); ImGui::TextUnformatted("Mean");
 					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", frameStats_.mean());
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", updateStats_.mean());
 					ImGui::TableNextColumn(); ImGui::TextUnformatted("Median");
 					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", frameStats_.median());
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", updateStats_.median());
 					ImGui::TableNextColumn(); ImGui::TextUnformatted("Mode");
 					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", frameStats_.mode());
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", updateStats_.mode());
 					ImGui::TableNextColumn(); ImGui::TextUnformatted("P75");
 					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", frameStats_.percentile(0.75f));
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", updateStats_.percentile(0.75f));
 					ImGui::TableNextColumn(); ImGui::TextUnformatted("P90");
 					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", frameStats_.percentile(0.9f));
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", updateStats_.percentile(0.9f));
 					ImGui::TableNextColumn(); ImGui::TextUnformatted("Sigma");
 					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", frameStats_.sigma());
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", updateStats_.sigma());
 					ImGui::TableNextColumn(); ImGui::TextUnformatted("Rel. Sigma");
 					ImGui::TableNextColumn(); ImGui::Text("%.3f%%", frameStats_.relativeSigma());
+					ImGui::TableNextColumn(); ImGui::Text("%.3f%%", updateStats_.relativeSigma());
 					ImGui::TableNextColumn(); ImGui::TextUnformatted("Min");
 					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", frameStats_.minimum());
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", updateStats_.minimum());
 					ImGui::TableNextColumn(); ImGui::TextUnformatted("Max");
 					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", frameStats_.maximum());
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", updateStats_.maximum());
 					ImGui::TableNextColumn(); ImGui::TextUnformatted("Range");
 					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", frameStats_.range());
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", updateStats_.range());
 
 					ImGui::EndTable();
 				}
@@ -299,6 +330,13 @@ void MyEventHandler::onKeyReleased(const nc::KeyboardEvent &event)
 		const bool instancingEnabled = nc::theApplication().renderingSettings().instancingEnabled;
 		nc::theApplication().renderingSettings().instancingEnabled = !instancingEnabled;
 	}
+#if NCINE_WITH_JOBSYSTEM
+	else if (event.sym == nc::KeySym::U)
+	{
+		const bool parallelUpdateEnabled = nc::theApplication().renderingSettings().parallelUpdateEnabled;
+		nc::theApplication().renderingSettings().parallelUpdateEnabled = !parallelUpdateEnabled;
+	}
+#endif
 #ifndef __ANDROID__
 	else if (event.sym == nc::KeySym::V)
 		withVSync_ = !withVSync_;
@@ -48,6 +48,7 @@ class MyEventHandler :
 	bool pause_;
 
 	Statistics frameStats_;
+	Statistics updateStats_;
 	nctl::UniquePtr<nc::Texture> texture_;
 	nctl::Array<nctl::UniquePtr<nc::Sprite>> sprites_;
 	nctl::Array<Transform> transforms_;
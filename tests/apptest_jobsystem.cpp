@@ -31,7 +31,13 @@ const char *jobTypeComboString = "Empty\0Dummy\0FastDummy\0SpawnChildren\0\0";
 int numJobsToQueue = 256;
 int dataArraySize = 16 * 1024;
 int countSplitterValue = 128;
+bool lambdaParallelFor = false;
 int childrenCount = 10;
+int numBackgroundJobs = 256;
+bool nestedBackgroundWait = false;
+int frameJobsPriority = nc::JobPriority::HIGH;
+const char *jobPriorityComboString = "High\0Normal\0Background\0\0";
+const char *stealPolicyComboString = "Round robin\0Topology\0\0";
 bool showImGui = true;
 
 // ----- Statistics -----
@@ -42,6 +48,9 @@ const unsigned int MaxNumRepetitions = 64;
 Statistics submitStats(MaxNumRepetitions);
 Statistics waitStats(MaxNumRepetitions);
 Statistics totalStats(MaxNumRepetitions);
+Statistics latencyStats(MaxNumRepetitions);
+Statistics stealPolicyStats[nc::JobStealPolicy::COUNT];
+unsigned int stealPolicyJobsStolen[nc::JobStealPolicy::COUNT] = {};
 
 // ----- WorkerStatistics -----
 
@@ -130,6 +139,23 @@ void guiJobSystemStatsTable(const nc::JobStatistics::JobSystemStats &systemStats
 		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.continuationJobsPushed);
 		ImGui::TableNextColumn(); ImGui::TextUnformatted("Parent jobs finished");
 		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.parentJobsFinished);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Jobs executed inline");
+		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.jobsExecutedInline);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Wake-ups while spinning");
+		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.spinWakeUps);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Wake-ups while yielding");
+		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.yieldWakeUps);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Wake-ups after sleeping");
+		ImGui::TableNextColumn(); ImGui::Text("%u", systemStats.sleepWakeUps);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Spin time");
+		ImGui::TableNextColumn(); ImGui::Text("%.3f ms", systemStats.spinNanoseconds / 1000000.0);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Sleep time");
+		ImGui::TableNextColumn(); ImGui::Text("%.3f ms", systemStats.sleepNanoseconds / 1000000.0);
+		const uint32_t numWakeUps = systemStats.spinWakeUps + systemStats.yieldWakeUps + systemStats.sleepWakeUps;
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Average wake-up latency");
+		ImGui::TableNextColumn(); ImGui::Text("%.3f us", (numWakeUps > 0) ? systemStats.wakeUpLatencyNanoseconds / (1000.0 * numWakeUps) : 0.0);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Maximum wake-up latency");
+		ImGui::TableNextColumn(); ImGui::Text("%.3f us", systemStats.maxWakeUpLatencyNanoseconds / 1000.0);
 
 		ImGui::EndTable();
 	}
@@ -160,6 +186,12 @@ void guiJobPoolStatsTable(const nc::JobStatistics::JobPoolStats &poolStats, cons
 		ImGui::TableNextColumn(); ImGui::Text("%u", poolStats.threadCacheEmpty);
 		ImGui::TableNextColumn(); ImGui::TextUnformatted("Thread cache found full");
 		ImGui::TableNextColumn(); ImGui::Text("%u", poolStats.threadCacheFull);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Blocks added");
+		ImGui::TableNextColumn(); ImGui::Text("%u", poolStats.blocksAdded);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Job data in the arena");
+		ImGui::TableNextColumn(); ImGui::Text("%u", poolStats.arenaDataAllocations);
+		ImGui::TableNextColumn(); ImGui::TextUnformatted("Job data on the heap");
+		ImGui::TableNextColumn(); ImGui::Text("%u", poolStats.heapDataAllocations);
 
 		ImGui::EndTable();
 	}
@@ -307,6 +339,19 @@ void spawnChildrenJob(nc::JobId jobId, const void *)
 	workerStats[threadIndex].end();
 }
 
+void nestedWaitJob(nc::JobId jobId, const void *)
+{
+	ZoneScoped;
+	nc::IJobSystem &jobSystem = nc::theServiceLocator().jobSystem();
+	for (int i = 0; i < numSpawnedJobs; i++)
+	{
+		// Children inherit the background priority of their parent, and are waited on while the parent holds a background slot
+		nc::JobId childJobId = jobSystem.createJobAsChild(jobId, fastDummyJob);
+		jobSystem.submit(childJobId);
+		jobSystem.wait(childJobId);
+	}
+}
+
 struct MyData
 {
 	uint32_t icalc0 = 0;
@@ -376,6 +421,8 @@ void MyEventHandler::onInit()
 	nc::IJobSystem &jobSystem = nc::theServiceLocator().jobSystem();
 	for (unsigned char i = 0; i < jobSystem.numThreads(); i++)
 		workerStats.emplaceBack(256);
+	for (unsigned int i = 0; i < nc::JobStealPolicy::COUNT; i++)
+		stealPolicyStats[i].setCapacity(MaxNumRepetitions);
 }
 
 void MyEventHandler::onFrameStart()
@@ -558,15 +605,27 @@ void MyEventHandler::onFrameStart()
 
 			ImGui::SliderInt("Data array size", &dataArraySize, 1, MaxDataArraySize, "%d", ImGuiSliderFlags_AlwaysClamp);
 			ImGui::SliderInt("Count splitter", &countSplitterValue, 1, 1024, "%d", ImGuiSliderFlags_AlwaysClamp);
+			ImGui::Checkbox("Lambda", &lambdaParallelFor);
+			ImGui::SameLine();
 			if (ImGui::Button("Parallel for"))
 			{
 				ZoneScopedN("Parallel For");
 				if (autoResetStatistics)
 					resetStatistics();
 
+				// The lambda captures more than the job can hold, so the data of every sub-range job goes to the job data arena
+				const nc::CountSplitter splitter(countSplitterValue);
+				const MyData *firstData = dataArray;
+				const MyData *lastData = dataArray + dataArraySize;
+				auto dataLambda = [firstData, lastData](MyData *data, unsigned int count) {
+					if (data >= firstData && data + count <= lastData)
+						myDataFunc(data, count);
+				};
+
 				for (int rep = 0; rep < numRepetitions; rep++)
 				{
-					nc::JobId rootJobId = nc::parallelFor(dataArray, dataArraySize, &myDataFunc, nc::CountSplitter(countSplitterValue));
+					nc::JobId rootJobId = lambdaParallelFor ? nc::parallelFor(dataArray, dataArraySize, dataLambda, splitter)
+					                                        : nc::parallelFor(dataArray, dataArraySize, &myDataFunc, splitter);
 					totalTimestamp = nc::TimeStamp::now();
 					{
 						ZoneScopedN("Job Submission");
@@ -588,7 +647,7 @@ void MyEventHandler::onFrameStart()
 #ifdef NCINE_WITH_TRACY
 				auxString.format("Repetitions: %d", numRepetitions);
 				ZoneText(auxString.data(), auxString.length());
-				auxString.format("Data Array Size: %d, Count Splitter: %d", dataArraySize, countSplitterValue);
+				auxString.format("Data Array Size: %d, Count Splitter: %d%s", dataArraySize, countSplitterValue, lambdaParallelFor ? ", Lambda" : "");
 				ZoneText(auxString.data(), auxString.length());
 				auxString.format("\nTotal Time: %.3f ms (%.2f%%)\nSubmit Time: %.3f ms (%.2f%%)\nWait Time: %.3f ms (%.2f%%)",
 				                 totalStats.mean(), totalStats.relativeSigma(), submitStats.mean(), submitStats.relativeSigma(), waitStats.mean(), waitStats.relativeSigma());
@@ -679,6 +738,149 @@ void MyEventHandler::onFrameStart()
 			ImGui::SameLine();
 			ImGui::Text("Total jobs: %u (%u x %u x %u)", totalChildrenJobs, childrenCount, childrenCount, childrenCount);
 
+			ImGui::SliderInt("Background jobs", &numBackgroundJobs, 0, 1024, "%d", ImGuiSliderFlags_AlwaysClamp);
+			ImGui::SameLine();
+			ImGui::Checkbox("Nested wait", &nestedBackgroundWait);
+			ImGui::Combo("Frame jobs priority", &frameJobsPriority, jobPriorityComboString);
+			if (ImGui::Button("Frame latency"))
+			{
+				ZoneScopedN("Frame Latency");
+				if (autoResetStatistics)
+					resetStatistics();
+				latencyStats.clearValues();
+				latencyStats.resetStats();
+
+				// Saturating the workers with long background jobs that are not waited until the end
+				nc::JobId backgroundRootJobId = jobSystem.createJob(nullptr, nc::JobPriority::BACKGROUND);
+				{
+					ZoneScopedN("Background Submission");
+					jobIds.clear();
+					for (int i = 0; i < numBackgroundJobs; i++)
+					{
+						// Children inherit the background priority of their parent
+						nc::JobId jobId = jobSystem.createJobAsChild(backgroundRootJobId, nestedBackgroundWait ? nestedWaitJob : dummyJob);
+						jobIds.pushBack(jobId);
+					}
+					jobSystem.submit(jobIds.data(), jobIds.size());
+					jobSystem.submit(backgroundRootJobId);
+				}
+
+				const nc::JobPriority::Enum priority = static_cast<nc::JobPriority::Enum>(frameJobsPriority);
+				for (int rep = 0; rep < numRepetitions; rep++)
+				{
+					totalTimestamp = nc::TimeStamp::now();
+
+					nc::JobId rootJobId = jobSystem.createJob(nullptr, priority);
+					{
+						ZoneScopedN("Frame Jobs Submission");
+						jobIds.clear();
+						for (int i = 0; i < numJobsToQueue; i++)
+						{
+							nc::JobId jobId = jobSystem.createJobAsChild(rootJobId, jobFn);
+							jobIds.pushBack(jobId);
+						}
+						jobSystem.submit(jobIds.data(), jobIds.size());
+					}
+					jobSystem.submit(rootJobId);
+
+					{
+						ZoneScopedN("Frame Jobs Wait");
+						jobSystem.wait(rootJobId);
+					}
+
+					latencyStats.addValueWrap(totalTimestamp.millisecondsSince());
+				}
+				latencyStats.calculateStats();
+
+				{
+					ZoneScopedN("Background Wait");
+					jobSystem.wait(backgroundRootJobId);
+				}
+				calculateStatistics();
+
+#ifdef NCINE_WITH_TRACY
+				auxString.format("Repetitions: %d, Frame jobs: %d, Background jobs: %d", numRepetitions, numJobsToQueue, numBackgroundJobs);
+				ZoneText(auxString.data(), auxString.length());
+				auxString.format("\nLatency: %.3f ms (%.2f%%)\nP90: %.3f ms\nMax: %.3f ms",
+				                 latencyStats.mean(), latencyStats.relativeSigma(), latencyStats.percentile(0.9f), latencyStats.maximum());
+				ZoneText(auxString.data(), auxString.length());
+#endif
+			}
+			ImGui::SameLine();
+			ImGui::Text("Latency: %.3f ms (P90: %.3f ms, Max: %.3f ms)", latencyStats.mean(), latencyStats.percentile(0.9f), latencyStats.maximum());
+
+			int stealPolicy = jobSystem.stealPolicy();
+			if (ImGui::Combo("Steal policy", &stealPolicy, stealPolicyComboString))
+				jobSystem.setStealPolicy(static_cast<nc::JobStealPolicy::Enum>(stealPolicy));
+			if (ImGui::Button("Compare steal policies"))
+			{
+				ZoneScopedN("Compare Steal Policies");
+				const nc::JobStealPolicy::Enum previousPolicy = jobSystem.stealPolicy();
+				// The parallel for workload splits the range recursively, and most of its jobs are stolen
+				for (unsigned int policy = 0; policy < nc::JobStealPolicy::COUNT; policy++)
+				{
+					jobSystem.setStealPolicy(static_cast<nc::JobStealPolicy::Enum>(policy));
+					resetJobSystemStatistics();
+					stealPolicyStats[policy].clearValues();
+					stealPolicyStats[policy].resetStats();
+
+					for (int rep = 0; rep < numRepetitions; rep++)
+					{
+						nc::JobId rootJobId = nc::parallelFor(dataArray, dataArraySize, &myDataFunc, nc::CountSplitter(countSplitterValue));
+						totalTimestamp = nc::TimeStamp::now();
+						jobSystem.submit(rootJobId);
+						jobSystem.wait(rootJobId);
+						stealPolicyStats[policy].addValueWrap(totalTimestamp.millisecondsSince());
+					}
+					stealPolicyStats[policy].calculateStats();
+
+					stealPolicyJobsStolen[policy] = 0;
+					if (nc::theJobStatistics().isAvailable())
+					{
+						nc::JobStatistics::JobSystemStats systemStats;
+						nc::theJobStatistics().collectAllJobSystemStats(systemStats);
+						stealPolicyJobsStolen[policy] = systemStats.jobsStolen;
+					}
+				}
+				jobSystem.setStealPolicy(previousPolicy);
+
+#ifdef NCINE_WITH_TRACY
+				auxString.format("Repetitions: %d, Data Array Size: %d, Count Splitter: %d", numRepetitions, dataArraySize, countSplitterValue);
+				ZoneText(auxString.data(), auxString.length());
+				auxString.format("\nRound robin: %.3f ms (%.2f%%)\nTopology: %.3f ms (%.2f%%)",
+				                 stealPolicyStats[nc::JobStealPolicy::ROUND_ROBIN].mean(), stealPolicyStats[nc::JobStealPolicy::ROUND_ROBIN].relativeSigma(),
+				                 stealPolicyStats[nc::JobStealPolicy::TOPOLOGY].mean(), stealPolicyStats[nc::JobStealPolicy::TOPOLOGY].relativeSigma());
+				ZoneText(auxString.data(), auxString.length());
+#endif
+			}
+			ImGui::SameLine();
+			ImGui::Text("Parallel for with %d repetitions per policy", numRepetitions);
+
+			if (ImGui::BeginTable("StealPoliciesTable", 5, ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable |
+			                      ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchProp))
+			{
+				ImGui::TableSetupScrollFreeze(0, 1);
+				ImGui::TableSetupColumn("Policy", ImGuiTableColumnFlags_NoReorder | ImGuiTableColumnFlags_NoHide);
+				ImGui::TableSetupColumn("Mean");
+				ImGui::TableSetupColumn("P90");
+				ImGui::TableSetupColumn("Max");
+				ImGui::TableSetupColumn("Jobs stolen");
+				ImGui::TableHeadersRow();
+
+				ImGui::TableNextRow();
+				const char *policyNames[nc::JobStealPolicy::COUNT] = { "Round robin", "Topology" };
+				for (unsigned int policy = 0; policy < nc::JobStealPolicy::COUNT; policy++)
+				{
+					ImGui::TableNextColumn(); ImGui::TextUnformatted(policyNames[policy]);
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", stealPolicyStats[policy].mean());
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", stealPolicyStats[policy].percentile(0.9f));
+					ImGui::TableNextColumn(); ImGui::Text("%.3f ms", stealPolicyStats[policy].maximum());
+					ImGui::TableNextColumn(); ImGui::Text("%u", stealPolicyJobsStolen[policy]);
+				}
+
+				ImGui::EndTable();
+			}
+
 			if (ImGui::TreeNodeEx("Repetition timings", ImGuiTreeNodeFlags_DefaultOpen))
 			{
 				static bool sorted = false;
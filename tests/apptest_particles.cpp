@@ -1,6 +1,7 @@
 #include <ncine/config.h>
 
 #include "apptest_particles.h"
+#include <nctl/algorithms.h>
 #include <ncine/Application.h>
 #include <ncine/Texture.h>
 #include <ncine/ParticleSystem.h>
@@ -29,6 +30,8 @@ const float JoySpeed = 200.0f;
 nc::ParticleInitializer particleInit;
 float emitTime = 0.085f;
 bool autoEmit = true;
+bool withArrays = false;
+bool stressTest = false;
 
 bool captureMouse = true;
 #if NCINE_WITH_IMGUI
@@ -77,15 +80,13 @@ void MyEventHandler::onPreInit(nc::AppConfiguration &config)
 
 void MyEventHandler::onInit()
 {
-	nc::SceneNode &rootNode = nc::theApplication().rootNode();
-
 #ifdef __ANDROID__
 	nc::AndroidApplication &application = static_cast<nc::AndroidApplication &>(nc::theApplication());
 	application.enableAccelerometer(true);
 #endif
 
 	texture_ = nctl::makeUnique<nc::Texture>((prefixDataPath("textures", TextureFile)).data());
-	particleSystem_ = nctl::makeUnique<nc::ParticleSystem>(&rootNode, unsigned(NumParticles), texture_.get(), texture_->rect());
+	recreateParticleSystem(NumParticles, withArrays);
 	particleSystem_->setPosition(nc::theApplication().width() * 0.5f, nc::theApplication().height() * 0.33f);
 
 	nctl::UniquePtr<nc::ColorAffector> colorAffector = nctl::makeUnique<nc::ColorAffector>();
@@ -440,7 +441,8 @@ void MyEventHandler::onFrameStart()
 				emitVector_ = tempEmitVector;
 			ImGui::Dummy(ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * LineHeightSpacing));
 
-			ImGui::SliderInt2("Init amount", particleInit.rndAmount.data(), 1, 10, "%d", ImGuiSliderFlags_AlwaysClamp);
+			const int maxAmount = stressTest ? static_cast<int>(NumStressParticles / 10) : 10;
+			ImGui::SliderInt2("Init amount", particleInit.rndAmount.data(), 1, maxAmount, "%d", ImGuiSliderFlags_AlwaysClamp);
 			ImGui::SliderFloat2("Init life", particleInit.rndLife.data(), 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp);
 			ImGui::InputFloat2("Init position X", particleInit.rndPositionX.data(), "%.2f");
 			ImGui::InputFloat2("Init position Y", particleInit.rndPositionY.data(), "%.2f");
@@ -462,6 +464,9 @@ void MyEventHandler::onFrameStart()
 			bool affectorsEnabled = particleSystem_->areAffectorsEnabled();
 			if (ImGui::Checkbox("Affectors enabled", &affectorsEnabled))
 				particleSystem_->setAffectorsEnabled(affectorsEnabled);
+			bool parallelUpdateEnabled = particleSystem_->isParallelUpdateEnabled();
+			if (ImGui::Checkbox("Parallel update", &parallelUpdateEnabled))
+				particleSystem_->setParallelUpdateEnabled(parallelUpdateEnabled);
 			ImGui::Dummy(ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing() * LineHeightSpacing));
 
 			ImGui::SliderFloat("Emit time", &emitTime, 0.0f, 1.0f, "%.3f s", ImGuiSliderFlags_AlwaysClamp);
@@ -473,6 +478,17 @@ void MyEventHandler::onFrameStart()
 			ImGui::SameLine();
 			ImGui::Checkbox("Auto emit", &autoEmit);
 
+			ImGui::Separator();
+			int storageMode = withArrays ? 1 : 0;
+			bool recreate = ImGui::Combo("Storage mode", &storageMode, "Nodes\0Arrays\0");
+			recreate |= ImGui::Checkbox("Stress test", &stressTest);
+			if (recreate)
+			{
+				withArrays = (storageMode == 1);
+				recreateParticleSystem(stressTest ? NumStressParticles : NumParticles, withArrays);
+			}
+			ImGui::Text("Frame time: %.2f ms", nc::theApplication().frameTime() * 1000.0f);
+
 			const float aliveFraction = particleSystem_->numAliveParticles() / static_cast<float>(particleSystem_->numParticles());
 			ImGui::ProgressBar(aliveFraction, ImVec2(0.0f, 0.0f));
 			ImGui::Text("Particles: %d / %d", particleSystem_->numAliveParticles(), particleSystem_->numParticles());
@@ -621,3 +637,27 @@ void MyEventHandler::onJoyDisconnected(const nc::JoyConnectionEvent &event)
 	joyVectorLeft_ = nc::Vector2f::Zero;
 	joyVectorRight_ = nc::Vector2f::Zero;
 }
+
+void MyEventHandler::recreateParticleSystem(unsigned int count, bool withArrays)
+{
+	const nc::ParticleSystem::StorageMode storageMode = withArrays ? nc::ParticleSystem::StorageMode::ARRAYS
+	                                                               : nc::ParticleSystem::StorageMode::NODES;
+	nctl::UniquePtr<nc::ParticleSystem> particleSystem = nctl::makeUnique<nc::ParticleSystem>(&nc::theApplication().rootNode(),
+	                                                                                          count, texture_.get(), texture_->rect(), storageMode);
+
+	// Keeping the affectors and the settings of the previous particle system
+	if (particleSystem_ != nullptr)
+	{
+		for (nctl::UniquePtr<nc::ParticleAffector> &affector : particleSystem_->affectors())
+			particleSystem->addAffector(nctl::move(affector));
+		particleSystem->setPosition(particleSystem_->position());
+		particleSystem->setInLocalSpace(particleSystem_->inLocalSpace());
+		particleSystem->setAffectorsEnabled(particleSystem_->areAffectorsEnabled());
+		particleSystem->setParallelUpdateEnabled(particleSystem_->isParallelUpdateEnabled());
+	}
+	particleSystem_ = nctl::move(particleSystem);
+
+	// Emitting enough particles to keep most of the pool alive
+	const int amount = static_cast<int>(count * emitTime / particleInit.rndLife.y);
+	particleInit.setAmount(nctl::max(amount / 2, 1), nctl::max(amount, 1));
+}
@@ -42,6 +42,7 @@ class MyEventHandler :
 
   private:
 	static const unsigned int NumParticles = 50;
+	static const unsigned int NumStressParticles = 100000;
 
 	bool pause_;
 	nctl::UniquePtr<nc::Texture> texture_;
@@ -52,6 +53,8 @@ class MyEventHandler :
 
 	nc::Vector2f joyVectorLeft_;
 	nc::Vector2f joyVectorRight_;
+
+	void recreateParticleSystem(unsigned int count, bool withArrays);
 };
 
 #endif
@@ -4,6 +4,17 @@
 	#include <ncine/imgui.h>
 #endif
 
+// The global operator new is already replaced by the engine when using custom allocators or Tracy,
+// and a replacement in the application does not see the allocations of the engine on Windows and Android
+#if !NCINE_WITH_ALLOCATORS && !NCINE_WITH_TRACY && !defined(_WIN32) && !defined(__ANDROID__)
+	#define COUNT_ALLOCATIONS (1)
+	#include <new>
+	#include <cstdlib>
+	#include <nctl/Atomic.h>
+#else
+	#define COUNT_ALLOCATIONS (0)
+#endif
+
 #include "apptest_shaders.h"
 #include "apptest_shaders_sources.h"
 #include <ncine/Application.h>
@@ -87,8 +98,48 @@ const char *stringOnOff(bool enabled)
 	return enabled ? "on" : "off";
 }
 
+#if COUNT_ALLOCATIONS
+/// Counts the allocations made through the global operator new, like the ones of strings and arrays without custom allocators
+nctl::AtomicU32 numAllocations;
+/// The number of allocations before the scene is visited, its render queues are sorted and its commands are batched
+uint32_t allocationsBeforeVisit = 0;
+/// The number of allocations between the end of the update and the drawing of the first viewport in the last frame
+uint32_t visitAllocations = 0;
+unsigned long int lastCountedFrame = 0;
+#endif
+
 }
 
+#if COUNT_ALLOCATIONS
+void *operator new(std::size_t count)
+{
+	numAllocations.fetchAdd(1, nctl::MemoryModel::RELAXED);
+	void *ptr = malloc(count);
+	if (ptr == nullptr)
+		abort();
+	return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+	free(ptr);
+}
+
+void *operator new[](std::size_t count)
+{
+	numAllocations.fetchAdd(1, nctl::MemoryModel::RELAXED);
+	void *ptr = malloc(count);
+	if (ptr == nullptr)
+		abort();
+	return ptr;
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	free(ptr);
+}
+#endif
+
 nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
 {
 	return nctl::makeUnique<MyEventHandler>();
@@ -331,6 +382,10 @@ void MyEventHandler::onFrameStart()
 	debugString_->clear();
 	debugString_->format("batching: %s, culling: %s, texture atlas: %s, viewport: %s", stringOnOff(settings.batchingEnabled),
 	                     stringOnOff(settings.cullingEnabled), stringOnOff(withAtlas_), stringOnOff(currentViewportSetup_ != ViewportSetup::NONE));
+#if COUNT_ALLOCATIONS
+	// With batching enabled, the allocations include the ones made by the render batcher when assembling the batches
+	debugString_->formatAppend("\nallocations from visit to draw: %u", visitAllocations);
+#endif
 	debugText_->setString(*debugString_);
 
 	if (pause_ == false)
@@ -385,10 +440,24 @@ void MyEventHandler::onPostUpdate()
 				multitextureShaderStates_[i]->setUniformFloat("InstanceBlock", "rotation", multitextureSprite->absRotation() * ncine::fDegToRad);
 		}
 	}
+
+#if COUNT_ALLOCATIONS
+	allocationsBeforeVisit = numAllocations.load(nctl::MemoryModel::RELAXED);
+#endif
 }
 
 void MyEventHandler::onDrawViewport(nc::Viewport &viewport)
 {
+#if COUNT_ALLOCATIONS
+	// All the render queues have been sorted and batched before the first viewport of the frame is drawn
+	const unsigned long int numFrames = nc::theApplication().numFrames();
+	if (lastCountedFrame < numFrames)
+	{
+		visitAllocations = numAllocations.load(nctl::MemoryModel::RELAXED) - allocationsBeforeVisit;
+		lastCountedFrame = numFrames;
+	}
+#endif
+
 	// Dirtying the uniform cache value at each blur pass
 	if (&viewport == pingViewport_.get())
 	{
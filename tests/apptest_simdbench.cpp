@@ -9,6 +9,7 @@
 #include <ncine/TimeStamp.h>
 #include <ncine/Vector4.h>
 #include <ncine/Quaternion.h>
+#include <ncine/simd.h>
 #include "apptest_datapath.h"
 #include "Statistics.h"
 
@@ -20,6 +21,7 @@ namespace Names {
 
 const char *testSet = "test_set";
 const char *testSystem = "system";
+const char *testSimd = "simd";
 const char *testName = "name";
 const char *testIterations = "iterations";
 const char *testTimings = "timings";
@@ -53,6 +55,7 @@ enum Tests
 	MatrixMult,
 	MatrixTrans,
 	MatrixVecMult,
+	MatrixInverse,
 
 	Count
 };
@@ -79,6 +82,7 @@ struct TestRun
 {
 	nctl::String filename = nctl::String(128);
 	nctl::String system;
+	nctl::String simd;
 	TestInfo testInfos[Tests::Count];
 };
 
@@ -352,6 +356,20 @@ float benchMatrixVecMult(unsigned int iterations)
 	return testStartTime.millisecondsSince();
 }
 
+float benchMatrixInverse(unsigned int iterations)
+{
+	resetMats(iterations);
+
+	testStartTime = nc::TimeStamp::now();
+	for (unsigned int i = 0; i < iterations; i++)
+	{
+		const unsigned int index = i % MaxDataElements;
+		mats[index] = mats[index].inverse();
+	}
+
+	return testStartTime.millisecondsSince();
+}
+
 nctl::String &indent(nctl::String &string, int amount)
 {
 	FATAL_ASSERT(amount >= 0);
@@ -382,6 +400,10 @@ bool loadTestRun(const char *filename, unsigned int index)
 	testRuns[index].filename = filename;
 	nc::LuaUtils::retrieveGlobalTable(L, Names::testSet);
 	testRuns[index].system = nc::LuaUtils::retrieveField<const char *>(L, -1, Names::testSystem);
+	// Files saved before the SIMD math classes have no instruction set field
+	nc::LuaUtils::getField(L, -1, Names::testSimd);
+	testRuns[index].simd = nc::LuaUtils::isString(L, -1) ? nc::LuaUtils::retrieve<const char *>(L, -1) : "N/A";
+	nc::LuaUtils::pop(L);
 
 	const unsigned int numTests = nc::LuaUtils::rawLen(L, -1);
 	for (unsigned int testIndex = 0; testIndex < numTests; testIndex++)
@@ -422,6 +444,7 @@ void saveTestRun(const char *filename, bool includeStatistics)
 
 	amount++;
 	indent(file, amount).formatAppend("%s = \"%s\",\n", Names::testSystem, system());
+	indent(file, amount).formatAppend("%s = \"%s\",\n", Names::testSimd, nc::simd::instructionSet());
 
 	for (unsigned int testIndex = 0; testIndex < Tests::Count; testIndex++)
 	{
@@ -533,6 +556,8 @@ void MyEventHandler::onInit()
 	testInfos[Tests::MatrixTrans].name = "Matrix Trans";
 	testInfos[Tests::MatrixVecMult].func = benchMatrixVecMult;
 	testInfos[Tests::MatrixVecMult].name = "MatrixVec Mult";
+	testInfos[Tests::MatrixInverse].func = benchMatrixInverse;
+	testInfos[Tests::MatrixInverse].name = "Matrix Inverse";
 
 	for (unsigned int i = 0; i < Tests::Count; i++)
 		testNames[i] = testInfos[i].name.data();
@@ -614,11 +639,13 @@ void MyEventHandler::onFrameStart()
 			const bool notLoaded = tr.filename.isEmpty();
 			ImGui::Text("Filename: %s", notLoaded ? "N/A" : tr.filename.data());
 			ImGui::Text("System: %s", notLoaded ? "N/A" : tr.system.data());
+			ImGui::Text("SIMD: %s", notLoaded ? "N/A" : tr.simd.data());
 		}
 
 		if (ImGui::CollapsingHeader("Test Run", ImGuiTreeNodeFlags_DefaultOpen))
 		{
 			ImGui::Text("System: %s", system());
+			ImGui::Text("SIMD: %s", nc::simd::instructionSet());
 			ImGui::Combo("Test", &currentTest, testNames, Tests::Count);
 			int thousandIterations = numIterations / 1000;
 			ImGui::SliderInt("Iterations", &thousandIterations, 1, MaxIterations / 1000, "%d K");
@@ -0,0 +1,214 @@
+#include <ncine/config.h>
+
+#include "apptest_staticscene.h"
+#include <nctl/StaticString.h>
+#include <ncine/Application.h>
+#include <ncine/Texture.h>
+#include <ncine/Sprite.h>
+#include <ncine/TimeStamp.h>
+#include "apptest_datapath.h"
+
+#if NCINE_WITH_IMGUI
+	#include <ncine/imgui.h>
+#endif
+
+namespace {
+
+#ifdef __ANDROID__
+const char *TextureFile = "texture1_ETC2.ktx";
+#else
+const char *TextureFile = "texture1.png";
+#endif
+
+const char *InitialWindowTitle = "Static Scene";
+const float TileScale = 0.08f;
+const float AngleSpeed = 2.0f;
+
+const unsigned int NumStatsFrames = 300;
+const float StatsInterval = 1.0f;
+
+nctl::StaticString<256> windowTitle;
+
+#if NCINE_WITH_IMGUI
+bool showImGui = true;
+#endif
+
+}
+
+nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
+{
+	return nctl::makeUnique<MyEventHandler>();
+}
+
+void MyEventHandler::onPreInit(nc::AppConfiguration &config)
+{
+	setDataPath(config);
+	config.window.title = InitialWindowTitle;
+#ifndef __ANDROID__
+	config.graphics.vsync = false;
+#endif
+}
+
+void MyEventHandler::onInit()
+{
+	nc::theApplication().renderingSettings().cleanSubtreeSkipEnabled = true;
+	updateStats_.setCapacity(NumStatsFrames);
+
+	nc::SceneNode &rootNode = nc::theApplication().rootNode();
+	texture_ = nctl::makeUnique<nc::Texture>((prefixDataPath("textures", TextureFile)).data());
+
+	const float chunkWidth = nc::theApplication().width() / static_cast<float>(NumChunksX);
+	const float chunkHeight = nc::theApplication().height() / static_cast<float>(NumChunksY);
+	const float tileWidth = chunkWidth / static_cast<float>(NumTilesX);
+	const float tileHeight = chunkHeight / static_cast<float>(NumTilesY);
+
+	// Every chunk is a subtree of tiles, like a piece of a tilemap
+	chunks_.setCapacity(NumChunks);
+	tiles_.setCapacity(NumChunks * NumTilesPerChunk);
+	for (unsigned int i = 0; i < NumChunks; i++)
+	{
+		const float chunkX = (i % NumChunksX) * chunkWidth;
+		const float chunkY = (i / NumChunksX) * chunkHeight;
+		chunks_.pushBack(nctl::makeUnique<nc::SceneNode>(&rootNode, chunkX, chunkY));
+
+		for (unsigned int j = 0; j < NumTilesPerChunk; j++)
+		{
+			const float tileX = ((j % NumTilesX) + 0.5f) * tileWidth;
+			const float tileY = ((j / NumTilesX) + 0.5f) * tileHeight;
+			tiles_.pushBack(nctl::makeUnique<nc::Sprite>(chunks_[i].get(), texture_.get(), tileX, tileY));
+			tiles_.back()->setScale(TileScale);
+		}
+	}
+
+	pause_ = false;
+	angle_ = 0.0f;
+	numRecordedChunks_ = 0;
+	numFramesFrozen_ = 0;
+	setChunksFrozen(true);
+}
+
+void MyEventHandler::onFrameStart()
+{
+	if (pause_ == false)
+	{
+		angle_ += AngleSpeed * nc::theApplication().frameTime() * 60.0f;
+		for (unsigned int i = 0; i < NumChunks; i += AnimatedChunkInterval)
+			animateChunk(i);
+	}
+	checkRecordedChunks();
+
+	// The scenegraph update timing of the previous frame, to compare the update with and without the skipping of clean subtrees
+	const float updateTimeMs = nc::theApplication().timings()[nc::Application::Timings::UPDATE] * 1000;
+	updateStats_.addValueWrap(updateTimeMs);
+
+	static nc::TimeStamp timestamp = nc::TimeStamp::now();
+	if (timestamp.secondsSince() >= StatsInterval)
+	{
+		updateStats_.calculateStats();
+		timestamp.toNow();
+
+		const bool skipCleanSubtrees = nc::theApplication().renderingSettings().cleanSubtreeSkipEnabled;
+		windowTitle.format("%s - %u nodes, %s, %u/%u chunks replayed (update: %.3f ms)", InitialWindowTitle, chunks_.size() + tiles_.size(),
+		                   skipCleanSubtrees ? "skipping clean subtrees" : "updating every subtree", numRecordedChunks_, chunks_.size(), updateStats_.mean());
+		nc::theApplication().gfxDevice().setWindowTitle(windowTitle.data());
+	}
+
+#if NCINE_WITH_IMGUI
+	if (showImGui)
+	{
+		ImGui::SetNextWindowSize(ImVec2(400.0f, 220.0f), ImGuiCond_FirstUseEver);
+		ImGui::SetNextWindowPos(ImVec2(40.0f, 40.0f), ImGuiCond_FirstUseEver);
+		if (ImGui::Begin("apptest_staticscene", &showImGui))
+		{
+			nc::Application::RenderingSettings &settings = nc::theApplication().renderingSettings();
+			const unsigned int numAnimatedTiles = (NumChunks / AnimatedChunkInterval) * NumTilesPerChunk;
+
+			ImGui::Text("Nodes: %u, animated tiles: %u (%.0f%%)", chunks_.size() + tiles_.size(), numAnimatedTiles,
+			            100.0f * numAnimatedTiles / static_cast<float>(tiles_.size()));
+			ImGui::Checkbox("Skip clean subtrees", &settings.cleanSubtreeSkipEnabled);
+			ImGui::SameLine();
+			ImGui::Checkbox("Linear traversal", &settings.linearTraversalEnabled);
+			ImGui::SameLine();
+			ImGui::Checkbox("Pause", &pause_);
+			bool frozenChunks = frozenChunks_;
+			if (ImGui::Checkbox("Frozen chunks", &frozenChunks))
+				setChunksFrozen(frozenChunks);
+			ImGui::SameLine();
+			ImGui::Text("Replayed chunks: %u/%u", numRecordedChunks_, chunks_.size());
+
+			ImGui::PlotHistogram("Update time", updateStats_.values(), updateStats_.size(), 0, nullptr, 0.0f, updateStats_.maximum() * 1.1f);
+			ImGui::Text("Mean: %.3f ms, median: %.3f ms, P90: %.3f ms", updateStats_.mean(), updateStats_.median(), updateStats_.percentile(0.9f));
+			if (ImGui::Button("Reset"))
+			{
+				updateStats_.clearValues();
+				updateStats_.resetStats();
+			}
+		}
+		ImGui::End();
+	}
+#endif
+}
+
+void MyEventHandler::onKeyReleased(const nc::KeyboardEvent &event)
+{
+	if (event.sym == nc::KeySym::S)
+	{
+		nc::Application::RenderingSettings &settings = nc::theApplication().renderingSettings();
+		settings.cleanSubtreeSkipEnabled = !settings.cleanSubtreeSkipEnabled;
+	}
+	else if (event.sym == nc::KeySym::L)
+	{
+		nc::Application::RenderingSettings &settings = nc::theApplication().renderingSettings();
+		settings.linearTraversalEnabled = !settings.linearTraversalEnabled;
+	}
+	else if (event.sym == nc::KeySym::P)
+		pause_ = !pause_;
+	else if (event.sym == nc::KeySym::F)
+		setChunksFrozen(!frozenChunks_);
+#if NCINE_WITH_IMGUI
+	else if (event.mod & nc::KeyMod::CTRL && event.sym == nc::KeySym::H)
+		showImGui = !showImGui;
+#endif
+	else if (event.sym == nc::KeySym::ESCAPE)
+		nc::theApplication().quit();
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void MyEventHandler::animateChunk(unsigned int chunkIndex)
+{
+	const unsigned int firstTile = chunkIndex * NumTilesPerChunk;
+	for (unsigned int i = 0; i < NumTilesPerChunk; i++)
+		tiles_[firstTile + i]->setRotation(angle_ + i * 10.0f);
+}
+
+void MyEventHandler::setChunksFrozen(bool frozen)
+{
+	frozenChunks_ = frozen;
+	numFramesFrozen_ = 0;
+	for (unsigned int i = 0; i < NumChunks; i++)
+		chunks_[i]->setFrozen(frozen);
+}
+
+/*! \note Every chunk has been visited by the last frame, only the animated ones should need to record their commands again */
+void MyEventHandler::checkRecordedChunks()
+{
+	unsigned int numExpected = 0;
+	numRecordedChunks_ = 0;
+	for (unsigned int i = 0; i < NumChunks; i++)
+	{
+		const bool isAnimated = (pause_ == false && i % AnimatedChunkInterval == 0);
+		if (frozenChunks_ && isAnimated == false)
+			numExpected++;
+		if (chunks_[i]->hasRecordedCommands())
+			numRecordedChunks_++;
+	}
+
+	// The chunks have nothing to replay before their first visit after being frozen
+	if (frozenChunks_)
+		numFramesFrozen_++;
+	if (numFramesFrozen_ > 1 && numRecordedChunks_ != numExpected)
+		LOGW_X("%u frozen chunks are going to be replayed instead of %u", numRecordedChunks_, numExpected);
+}
@@ -0,0 +1,61 @@
+#ifndef CLASS_MYEVENTHANDLER
+#define CLASS_MYEVENTHANDLER
+
+#include <ncine/IAppEventHandler.h>
+#include <ncine/IInputEventHandler.h>
+#include <nctl/Array.h>
+#include <nctl/UniquePtr.h>
+#include "Statistics.h"
+
+namespace ncine {
+
+class AppConfiguration;
+class Texture;
+class SceneNode;
+class Sprite;
+
+}
+
+namespace nc = ncine;
+
+/// My nCine event handler
+class MyEventHandler :
+    public nc::IAppEventHandler,
+    public nc::IInputEventHandler
+{
+  public:
+	void onPreInit(nc::AppConfiguration &config) override;
+	void onInit() override;
+	void onFrameStart() override;
+
+	void onKeyReleased(const nc::KeyboardEvent &event) override;
+
+  private:
+	static const unsigned int NumChunksX = 10;
+	static const unsigned int NumChunksY = 10;
+	static const unsigned int NumChunks = NumChunksX * NumChunksY;
+	static const unsigned int NumTilesX = 12;
+	static const unsigned int NumTilesY = 12;
+	static const unsigned int NumTilesPerChunk = NumTilesX * NumTilesY;
+	/// One chunk every ten is animated, the other ones are static
+	static const unsigned int AnimatedChunkInterval = 10;
+
+	bool pause_;
+	bool frozenChunks_;
+	float angle_;
+	/// The number of frozen chunks whose recorded render commands are going to be replayed
+	unsigned int numRecordedChunks_;
+	/// The number of frames since the chunks have been frozen
+	unsigned int numFramesFrozen_;
+
+	Statistics updateStats_;
+	nctl::UniquePtr<nc::Texture> texture_;
+	nctl::Array<nctl::UniquePtr<nc::SceneNode>> chunks_;
+	nctl::Array<nctl::UniquePtr<nc::Sprite>> tiles_;
+
+	void animateChunk(unsigned int chunkIndex);
+	void setChunksFrozen(bool frozen);
+	void checkRecordedChunks();
+};
+
+#endif
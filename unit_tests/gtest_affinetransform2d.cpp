@@ -0,0 +1,146 @@
+#include "gtest_matrix4x4.h"
+#include <ncine/AffineTransform2D.h>
+
+namespace {
+
+const float AbsError = 0.0001f;
+
+void printTransform(const char *message, const nc::AffineTransform2Df &t)
+{
+	printf("%s(%.2f,\t%.2f,\n %.2f,\t%.2f,\n %.2f,\t%.2f)\n", message, t[0].x, t[0].y, t[1].x, t[1].y, t[2].x, t[2].y);
+}
+
+/// Asserts that a compact transformation has the same 2D elements of a four by four matrix
+void assertSameAsMatrix(const nc::AffineTransform2Df &t, const nc::Matrix4x4f &m)
+{
+	ASSERT_NEAR(t[0].x, m[0].x, AbsError);
+	ASSERT_NEAR(t[0].y, m[0].y, AbsError);
+	ASSERT_NEAR(t[1].x, m[1].x, AbsError);
+	ASSERT_NEAR(t[1].y, m[1].y, AbsError);
+	ASSERT_NEAR(t[2].x, m[3].x, AbsError);
+	ASSERT_NEAR(t[2].y, m[3].y, AbsError);
+}
+
+class AffineTransform2DTest : public ::testing::Test
+{
+  public:
+	AffineTransform2DTest()
+	    : m1_(nc::Matrix4x4f::translation(10.0f, -20.0f, 0.0f)), m2_(nc::Matrix4x4f::rotationZ(30.0f))
+	{
+		m1_.rotateZ(45.0f);
+		m1_.scale(2.0f, 0.5f, 1.0f);
+		m2_.translate(-5.0f, 7.5f, 0.0f);
+		m2_.scale(1.5f, 3.0f, 1.0f);
+
+		t1_ = nc::AffineTransform2Df(m1_);
+		t2_ = nc::AffineTransform2Df(m2_);
+	}
+
+  protected:
+	nc::Matrix4x4f m1_;
+	nc::Matrix4x4f m2_;
+	nc::AffineTransform2Df t1_;
+	nc::AffineTransform2Df t2_;
+};
+
+TEST(AffineTransform2DCreationTest, DefaultIsIdentity)
+{
+	const nc::AffineTransform2Df t;
+	printTransform("Constructing a default transformation: ", t);
+
+	ASSERT_TRUE(t == nc::AffineTransform2Df::Identity);
+	assertSameAsMatrix(t, nc::Matrix4x4f::Identity);
+}
+
+TEST(AffineTransform2DCreationTest, Size)
+{
+	printf("Size of a compact transformation: %u bytes, size of a four by four matrix: %u bytes\n",
+	       static_cast<unsigned int>(sizeof(nc::AffineTransform2Df)), static_cast<unsigned int>(sizeof(nc::Matrix4x4f)));
+
+	ASSERT_EQ(sizeof(nc::AffineTransform2Df), 6 * sizeof(float));
+}
+
+TEST(AffineTransform2DCreationTest, Translation)
+{
+	const nc::AffineTransform2Df t = nc::AffineTransform2Df::translation(3.0f, -4.0f);
+	printTransform("Constructing a translation transformation: ", t);
+
+	assertSameAsMatrix(t, nc::Matrix4x4f::translation(3.0f, -4.0f, 0.0f));
+}
+
+TEST(AffineTransform2DCreationTest, Rotation)
+{
+	const nc::AffineTransform2Df t = nc::AffineTransform2Df::rotation(60.0f);
+	printTransform("Constructing a rotation transformation: ", t);
+
+	assertSameAsMatrix(t, nc::Matrix4x4f::rotationZ(60.0f));
+}
+
+TEST(AffineTransform2DCreationTest, Scaling)
+{
+	const nc::AffineTransform2Df t = nc::AffineTransform2Df::scaling(2.0f, -0.5f);
+	printTransform("Constructing a scaling transformation: ", t);
+
+	assertSameAsMatrix(t, nc::Matrix4x4f::scaling(2.0f, -0.5f, 1.0f));
+}
+
+TEST_F(AffineTransform2DTest, FromMatrix)
+{
+	printTransform("Constructing a transformation from a matrix: ", t1_);
+
+	assertSameAsMatrix(t1_, m1_);
+}
+
+TEST_F(AffineTransform2DTest, ToMatrix)
+{
+	const nc::Matrix4x4f m = t1_.toMatrix4x4(0.25f);
+	printMatrix("Expanding a transformation to a matrix with a Z translation of 0.25:\n", m);
+
+	assertVectorsAreNear(m[0], m1_[0], AbsError);
+	assertVectorsAreNear(m[1], m1_[1], AbsError);
+	assertVectorsAreEqual(m[2], 0.0f, 0.0f, 1.0f, 0.0f);
+	assertVectorsAreNear(m[3], nc::Vector4f(m1_[3].x, m1_[3].y, 0.25f, 1.0f), AbsError);
+}
+
+TEST_F(AffineTransform2DTest, Multiplication)
+{
+	const nc::AffineTransform2Df t = t1_ * t2_;
+	printTransform("Multiplying two transformations: ", t);
+
+	assertSameAsMatrix(t, m1_ * m2_);
+}
+
+TEST_F(AffineTransform2DTest, MultiplyVector)
+{
+	const nc::Vector2f v = nc::Vector2f(3.0f, -2.0f) * t1_;
+	const nc::Vector4f mv = nc::Vector4f(3.0f, -2.0f, 0.0f, 1.0f) * m1_;
+	printf("Multiplying a vector by a transformation: <%.2f, %.2f>\n", v.x, v.y);
+
+	ASSERT_NEAR(v.x, mv.x, AbsError);
+	ASSERT_NEAR(v.y, mv.y, AbsError);
+}
+
+TEST_F(AffineTransform2DTest, InPlaceOperations)
+{
+	t1_.rotate(-20.0f);
+	t1_.scale(0.75f, 1.25f);
+	t1_.translate(-8.0f, 16.0f);
+	m1_.rotateZ(-20.0f);
+	m1_.scale(0.75f, 1.25f, 1.0f);
+	m1_.translate(-8.0f, 16.0f, 0.0f);
+	printTransform("Rotating, scaling and translating a transformation in place: ", t1_);
+
+	assertSameAsMatrix(t1_, m1_);
+}
+
+TEST_F(AffineTransform2DTest, Equality)
+{
+	const nc::AffineTransform2Df t = t1_;
+	printf("Comparing two transformations for equality\n");
+
+	ASSERT_TRUE(t == t1_);
+	ASSERT_FALSE(t != t1_);
+	ASSERT_TRUE(t != t2_);
+}
+
+}
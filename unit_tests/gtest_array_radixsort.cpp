@@ -0,0 +1,91 @@
+#include "gtest_array.h"
+#include <nctl/algorithms.h>
+
+namespace {
+
+const unsigned int NumItems = 1000;
+
+class ArrayRadixSortTest : public ::testing::Test
+{
+  public:
+	ArrayRadixSortTest()
+	    : items_(NumItems), tempItems_(NumItems) {}
+
+  protected:
+	void SetUp() override
+	{
+		nc::random().init(0, 0);
+		items_.setSize(NumItems);
+		tempItems_.setSize(NumItems);
+		for (unsigned int i = 0; i < NumItems; i++)
+		{
+			// Few distinct keys to test the tie-breaking on the secondary key
+			items_[i].key = (static_cast<uint64_t>(nc::random().integer(0, 4)) << 48) + nc::random().integer(0, 8);
+			items_[i].subKey = nc::random().integer(0, 16);
+			items_[i].index = i;
+		}
+	}
+
+	nctl::Array<nctl::RadixSortItem> items_;
+	nctl::Array<nctl::RadixSortItem> tempItems_;
+};
+
+bool isAscending(const nctl::RadixSortItem &a, const nctl::RadixSortItem &b)
+{
+	if (a.key != b.key)
+		return a.key < b.key;
+	if (a.subKey != b.subKey)
+		return a.subKey < b.subKey;
+	return a.index < b.index;
+}
+
+bool isDescending(const nctl::RadixSortItem &a, const nctl::RadixSortItem &b)
+{
+	if (a.key != b.key)
+		return a.key > b.key;
+	if (a.subKey != b.subKey)
+		return a.subKey > b.subKey;
+	return a.index < b.index;
+}
+
+TEST_F(ArrayRadixSortTest, RadixSort)
+{
+	printf("Sorting %u items in ascending order with a radix sort\n", NumItems);
+	nctl::radixSort(items_.data(), tempItems_.data(), NumItems);
+
+	// Items with equal keys should retain their relative order
+	for (unsigned int i = 1; i < NumItems; i++)
+		ASSERT_TRUE(isAscending(items_[i - 1], items_[i]));
+}
+
+TEST_F(ArrayRadixSortTest, RadixSortDescending)
+{
+	printf("Sorting %u items in descending order with a radix sort\n", NumItems);
+	nctl::radixSortDesc(items_.data(), tempItems_.data(), NumItems);
+
+	// Items with equal keys should retain their relative order
+	for (unsigned int i = 1; i < NumItems; i++)
+		ASSERT_TRUE(isDescending(items_[i - 1], items_[i]));
+}
+
+TEST_F(ArrayRadixSortTest, RadixSortSorted)
+{
+	printf("Sorting %u already sorted items with a radix sort\n", NumItems);
+	nctl::radixSort(items_.data(), tempItems_.data(), NumItems);
+	for (unsigned int i = 0; i < NumItems; i++)
+		items_[i].index = i;
+	nctl::radixSort(items_.data(), tempItems_.data(), NumItems);
+
+	for (unsigned int i = 0; i < NumItems; i++)
+		ASSERT_EQ(items_[i].index, i);
+}
+
+TEST_F(ArrayRadixSortTest, RadixSortEmpty)
+{
+	printf("Sorting zero items with a radix sort\n");
+	nctl::radixSort(items_.data(), tempItems_.data(), 0);
+
+	ASSERT_EQ(items_[0].index, 0u);
+}
+
+}
@@ -0,0 +1,192 @@
+#include <ncine/BufferRing.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned long RegionSize = 1024;
+
+/// A fence backend that records the calls and whose fences are signaled only when the test says so
+class FakeBackend : public nc::BufferRing::Backend
+{
+  public:
+	FakeBackend()
+	    : numInserts(0), numWaits(0), numDeletes(0), pendingWaits(0)
+	{
+		for (unsigned int i = 0; i < nc::BufferRing::NumRegions; i++)
+		{
+			fenceInserted[i] = false;
+			fenceSignaled[i] = false;
+		}
+	}
+
+	void insertFence(unsigned int region) override
+	{
+		ASSERT_FALSE(fenceInserted[region]);
+		fenceInserted[region] = true;
+		fenceSignaled[region] = false;
+		numInserts++;
+	}
+
+	/// A fence that has not been signaled is signaled after the number of waits specified by `pendingWaits`
+	bool waitFence(unsigned int region, uint64_t timeout) override
+	{
+		EXPECT_TRUE(fenceInserted[region]);
+		numWaits++;
+		if (fenceSignaled[region] == false && pendingWaits > 0)
+		{
+			pendingWaits--;
+			if (pendingWaits == 0)
+				fenceSignaled[region] = true;
+		}
+		return fenceSignaled[region];
+	}
+
+	void deleteFence(unsigned int region) override
+	{
+		ASSERT_TRUE(fenceInserted[region]);
+		fenceInserted[region] = false;
+		numDeletes++;
+	}
+
+	void signalAll()
+	{
+		for (unsigned int i = 0; i < nc::BufferRing::NumRegions; i++)
+			fenceSignaled[i] = true;
+	}
+
+	bool fenceInserted[nc::BufferRing::NumRegions];
+	bool fenceSignaled[nc::BufferRing::NumRegions];
+	unsigned int numInserts;
+	unsigned int numWaits;
+	unsigned int numDeletes;
+	unsigned int pendingWaits;
+};
+
+class BufferRingTest : public ::testing::Test
+{
+  public:
+	BufferRingTest()
+	    : ring_(backend_) {}
+
+  protected:
+	FakeBackend backend_;
+	nc::BufferRing ring_;
+};
+
+TEST_F(BufferRingTest, InitialState)
+{
+	printf("Creating a ring of %u regions\n", nc::BufferRing::NumRegions);
+
+	ASSERT_EQ(ring_.currentRegion(), 0u);
+	ASSERT_EQ(ring_.regionOffset(RegionSize), 0u);
+	ASSERT_EQ(ring_.numAdvances(), 0u);
+	ASSERT_EQ(ring_.numBlockingWaits(), 0u);
+	for (unsigned int i = 0; i < nc::BufferRing::NumRegions; i++)
+		ASSERT_FALSE(ring_.isFencePending(i));
+}
+
+TEST_F(BufferRingTest, AdvanceFencesCurrentRegion)
+{
+	printf("Advancing the ring once\n");
+	ring_.advance();
+
+	ASSERT_EQ(ring_.currentRegion(), 1u);
+	ASSERT_EQ(ring_.regionOffset(RegionSize), RegionSize);
+	ASSERT_TRUE(ring_.isFencePending(0));
+	ASSERT_TRUE(backend_.fenceInserted[0]);
+	ASSERT_EQ(backend_.numInserts, 1u);
+	ASSERT_EQ(backend_.numWaits, 0u);
+}
+
+TEST_F(BufferRingTest, RegionsWrapAround)
+{
+	printf("Advancing the ring for two complete cycles\n");
+	backend_.signalAll();
+	for (unsigned int i = 0; i < nc::BufferRing::NumRegions * 2; i++)
+	{
+		ASSERT_EQ(ring_.currentRegion(), i % nc::BufferRing::NumRegions);
+		ASSERT_EQ(ring_.regionOffset(RegionSize), (i % nc::BufferRing::NumRegions) * RegionSize);
+		ring_.advance();
+		backend_.signalAll();
+	}
+
+	ASSERT_EQ(ring_.currentRegion(), 0u);
+	ASSERT_EQ(ring_.numAdvances(), nc::BufferRing::NumRegions * 2);
+}
+
+TEST_F(BufferRingTest, NoWaitBeforeFirstCycle)
+{
+	printf("Advancing the ring until every region has been written once\n");
+	for (unsigned int i = 0; i < nc::BufferRing::NumRegions - 1; i++)
+		ring_.advance();
+
+	// The regions that follow have never been fenced
+	ASSERT_EQ(backend_.numWaits, 0u);
+	ASSERT_EQ(ring_.numBlockingWaits(), 0u);
+}
+
+TEST_F(BufferRingTest, SignaledFenceIsDeletedWithoutBlocking)
+{
+	printf("Coming back to a region whose fence has already been signaled\n");
+	for (unsigned int i = 0; i < nc::BufferRing::NumRegions; i++)
+	{
+		backend_.signalAll();
+		ring_.advance();
+	}
+
+	ASSERT_EQ(ring_.currentRegion(), 0u);
+	ASSERT_EQ(backend_.numWaits, 1u);
+	ASSERT_EQ(backend_.numDeletes, 1u);
+	ASSERT_FALSE(ring_.isFencePending(0));
+	ASSERT_FALSE(backend_.fenceInserted[0]);
+	ASSERT_EQ(ring_.numBlockingWaits(), 0u);
+}
+
+TEST_F(BufferRingTest, UnsignaledFenceBlocks)
+{
+	const unsigned int numWaits = 3;
+	printf("Coming back to a region whose fence is signaled after %u waits\n", numWaits);
+	for (unsigned int i = 0; i < nc::BufferRing::NumRegions - 1; i++)
+		ring_.advance();
+	backend_.pendingWaits = numWaits;
+	ring_.advance();
+
+	ASSERT_EQ(ring_.currentRegion(), 0u);
+	ASSERT_EQ(backend_.numWaits, numWaits);
+	ASSERT_EQ(backend_.numDeletes, 1u);
+	ASSERT_FALSE(ring_.isFencePending(0));
+	ASSERT_EQ(ring_.numBlockingWaits(), 1u);
+}
+
+TEST_F(BufferRingTest, OnlyNextRegionIsWaited)
+{
+	printf("Checking that the fences of the other regions are left pending\n");
+	for (unsigned int i = 0; i < nc::BufferRing::NumRegions; i++)
+	{
+		backend_.signalAll();
+		ring_.advance();
+	}
+
+	for (unsigned int i = 1; i < nc::BufferRing::NumRegions; i++)
+		ASSERT_TRUE(ring_.isFencePending(i));
+}
+
+TEST(BufferRingDestructionTest, PendingFencesAreDeleted)
+{
+	printf("Destroying a ring with pending fences\n");
+	FakeBackend backend;
+	{
+		nc::BufferRing ring(backend);
+		ring.advance();
+		ring.advance();
+	}
+
+	ASSERT_EQ(backend.numInserts, 2u);
+	ASSERT_EQ(backend.numDeletes, 2u);
+	for (unsigned int i = 0; i < nc::BufferRing::NumRegions; i++)
+		ASSERT_FALSE(backend.fenceInserted[i]);
+}
+
+}
@@ -0,0 +1,197 @@
+#include <cmath>
+#include "gtest_matrix4x4.h"
+#include <ncine/TransformBatch2D.h>
+
+namespace {
+
+const unsigned int Capacity = 64;
+const float AbsError = 0.0001f;
+const float RelError = 0.00001f;
+
+struct NodeProperties
+{
+	float x, y, rotation, scaleX, scaleY, anchorX, anchorY;
+};
+
+/// Calculates the local matrix with the same steps of `SceneNode::transform()`
+nc::Matrix4x4f scalarLocalMatrix(const NodeProperties &node)
+{
+	nc::Matrix4x4f localMatrix = nc::Matrix4x4f::translation(node.x, node.y, 0.0f);
+	localMatrix.rotateZ(node.rotation);
+	localMatrix.scale(node.scaleX, node.scaleY, 1.0f);
+	localMatrix.translate(-node.anchorX, -node.anchorY, 0.0f);
+	return localMatrix;
+}
+
+/// Rotations are kept in the same range of `SceneNode::setRotation()`
+NodeProperties nodeProperties(unsigned int index)
+{
+	const float i = static_cast<float>(index);
+	return NodeProperties{ i * 10.0f - 300.0f, 200.0f - i * 7.5f, fmodf(i * 37.0f, 720.0f) - 360.0f,
+		                   0.25f + i * 0.05f, 2.0f - i * 0.03f, i * 1.5f - 16.0f, 8.0f - i * 0.5f };
+}
+
+/// The error is relative to the magnitude of each column, as translations are much larger than the other elements
+void assertMatricesAreNear(const nc::Matrix4x4f &m1, const nc::Matrix4x4f &m2)
+{
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		float magnitude = 1.0f;
+		for (unsigned int j = 0; j < 4; j++)
+			magnitude = fmaxf(magnitude, fabsf(m2[i][j]));
+		assertVectorsAreNear(m1[i], m2[i], RelError * magnitude);
+	}
+}
+
+class TransformBatch2DTest : public ::testing::Test
+{
+  public:
+	TransformBatch2DTest()
+	    : batch_(Capacity) {}
+
+  protected:
+	void fillBatch(unsigned int size)
+	{
+		batch_.resize(size);
+		for (unsigned int i = 0; i < size; i++)
+		{
+			const NodeProperties node = nodeProperties(i);
+			batch_.positionX[i] = node.x;
+			batch_.positionY[i] = node.y;
+			batch_.rotation[i] = node.rotation;
+			batch_.scaleX[i] = node.scaleX;
+			batch_.scaleY[i] = node.scaleY;
+			batch_.anchorX[i] = node.anchorX;
+			batch_.anchorY[i] = node.anchorY;
+		}
+	}
+
+	void assertSameAsScalar(const nc::Matrix4x4f &parentWorldMatrix)
+	{
+		for (unsigned int i = 0; i < batch_.size(); i++)
+		{
+			const nc::Matrix4x4f localMatrix = scalarLocalMatrix(nodeProperties(i));
+			const nc::Matrix4x4f worldMatrix = parentWorldMatrix * localMatrix;
+			assertMatricesAreNear(batch_.localMatrix(i), localMatrix);
+			assertMatricesAreNear(batch_.worldMatrix(i), worldMatrix);
+		}
+	}
+
+	nc::TransformBatch2D batch_;
+};
+
+TEST(TransformBatch2DEmptyTest, ZeroCapacity)
+{
+	nc::TransformBatch2D batch;
+	printf("Creating a batch with zero capacity\n");
+
+	ASSERT_EQ(batch.capacity(), 0u);
+	ASSERT_EQ(batch.size(), 0u);
+	ASSERT_EQ(batch.positionX, nullptr);
+	batch.transform(nc::Matrix4x4f::Identity);
+}
+
+TEST_F(TransformBatch2DTest, Capacity)
+{
+	printf("Creating a batch with a capacity of %u\n", Capacity);
+
+	ASSERT_EQ(batch_.capacity(), Capacity);
+	ASSERT_EQ(batch_.size(), 0u);
+}
+
+TEST_F(TransformBatch2DTest, ResizeGrowsCapacity)
+{
+	const unsigned int newSize = Capacity * 2 + 1;
+	printf("Resizing a batch with a capacity of %u to %u nodes\n", Capacity, newSize);
+	batch_.resize(newSize);
+
+	ASSERT_EQ(batch_.capacity(), newSize);
+	ASSERT_EQ(batch_.size(), newSize);
+	batch_.resize(1);
+	ASSERT_EQ(batch_.capacity(), newSize);
+	ASSERT_EQ(batch_.size(), 1u);
+}
+
+TEST_F(TransformBatch2DTest, SingleNodeWithIdentityParent)
+{
+	printf("Transforming a single node with an identity parent\n");
+	batch_.resize(1);
+	batch_.positionX[0] = 10.0f;
+	batch_.positionY[0] = 20.0f;
+	batch_.rotation[0] = 90.0f;
+	batch_.scaleX[0] = 2.0f;
+	batch_.scaleY[0] = 3.0f;
+	batch_.anchorX[0] = 0.0f;
+	batch_.anchorY[0] = 0.0f;
+	batch_.transform(nc::Matrix4x4f::Identity);
+
+	const nc::Matrix4x4f worldMatrix = batch_.worldMatrix(0);
+	printMatrix("World matrix:\n", worldMatrix);
+	assertVectorsAreNear(worldMatrix[0], nc::Vector4f(0.0f, 2.0f, 0.0f, 0.0f), AbsError);
+	assertVectorsAreNear(worldMatrix[1], nc::Vector4f(-3.0f, 0.0f, 0.0f, 0.0f), AbsError);
+	assertVectorsAreNear(worldMatrix[2], nc::Vector4f(0.0f, 0.0f, 1.0f, 0.0f), AbsError);
+	assertVectorsAreNear(worldMatrix[3], nc::Vector4f(10.0f, 20.0f, 0.0f, 1.0f), AbsError);
+}
+
+TEST_F(TransformBatch2DTest, SameAsScalarWithIdentityParent)
+{
+	printf("Comparing %u nodes with the scalar path and an identity parent\n", Capacity);
+	fillBatch(Capacity);
+	batch_.transform(nc::Matrix4x4f::Identity);
+
+	assertSameAsScalar(nc::Matrix4x4f::Identity);
+}
+
+TEST_F(TransformBatch2DTest, SameAsScalarWith2DParent)
+{
+	nc::Matrix4x4f parentWorldMatrix = nc::Matrix4x4f::translation(400.0f, 300.0f, 0.0f);
+	parentWorldMatrix.rotateZ(30.0f);
+	parentWorldMatrix.scale(1.5f, 0.75f, 1.0f);
+	parentWorldMatrix.translate(-20.0f, -10.0f, 0.0f);
+	printMatrix("Comparing nodes with the scalar path and a parent world matrix:\n", parentWorldMatrix);
+
+	fillBatch(Capacity);
+	batch_.transform(parentWorldMatrix);
+
+	assertSameAsScalar(parentWorldMatrix);
+}
+
+TEST_F(TransformBatch2DTest, SameAsScalarWith3DParent)
+{
+	nc::Matrix4x4f parentWorldMatrix = nc::Matrix4x4f::rotationX(60.0f);
+	parentWorldMatrix.translate(5.0f, -5.0f, 50.0f);
+	printMatrix("Comparing nodes with the scalar path and a parent world matrix:\n", parentWorldMatrix);
+
+	fillBatch(Capacity);
+	batch_.transform(parentWorldMatrix);
+
+	assertSameAsScalar(parentWorldMatrix);
+}
+
+TEST_F(TransformBatch2DTest, SameAsScalarWithOddSize)
+{
+	const unsigned int size = Capacity - 3;
+	const nc::Matrix4x4f parentWorldMatrix = nc::Matrix4x4f::rotationZ(-45.0f);
+	printf("Comparing %u nodes with the scalar path, a size that is not a multiple of four\n", size);
+
+	fillBatch(size);
+	batch_.transform(parentWorldMatrix);
+
+	assertSameAsScalar(parentWorldMatrix);
+}
+
+TEST_F(TransformBatch2DTest, SameAsScalarAfterGrowing)
+{
+	const unsigned int size = Capacity * 4;
+	const nc::Matrix4x4f parentWorldMatrix = nc::Matrix4x4f::translation(-100.0f, 50.0f, 0.0f);
+	printf("Comparing %u nodes with the scalar path after growing the batch\n", size);
+
+	fillBatch(Capacity);
+	batch_.transform(parentWorldMatrix);
+	fillBatch(size);
+	batch_.transform(parentWorldMatrix);
+
+	assertSameAsScalar(parentWorldMatrix);
+}
+
+}